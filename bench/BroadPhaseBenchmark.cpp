@@ -0,0 +1,153 @@
+// 宽阶段碰撞检测基准
+// 用法：broad_phase_benchmark [每种规模模拟的帧数=600]
+// 合成场景：两块 4K 屏幕并排（7680x2160），实体中 80% 是 96x96 的宠物（每帧随机游走几个像素），
+// 20% 是 48x48 的桌面图标（不动），另有一个鼠标碰撞体
+// 报告 10/100/1000 个实体时每帧 findPairs() 的耗时，以及 y 方向比较次数，并与逐对检测对比
+// 第二组按实体数缩放桌面面积（密度不变），用来观察耗时是否随实体数线性增长
+#include "model/BroadPhase.h"
+#include <QRandomGenerator>
+#include <QRect>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+namespace
+{
+
+using Clock = std::chrono::steady_clock;
+
+const QRect FULL_DESKTOP(0, 0, 7680, 2160);
+
+double microsecondsSince(Clock::time_point start)
+{
+    return std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+}
+
+struct Scene
+{
+    QRect desktop;
+    std::vector<QRect> rects;
+    std::vector<CollisionLayer> layers;
+    std::vector<QPoint> velocity;
+};
+
+Scene makeScene(const QRect &desktop, int entities, QRandomGenerator &rng)
+{
+    Scene scene;
+    scene.desktop = desktop;
+    for (int i = 0; i < entities; ++i)
+    {
+        const CollisionLayer layer = i == 0 ? CollisionLayer::Cursor
+                                     : i % 5 == 0 ? CollisionLayer::Obstacle
+                                                  : CollisionLayer::Pet;
+        const int size = layer == CollisionLayer::Pet ? 96 : layer == CollisionLayer::Obstacle ? 48 : 49;
+        scene.rects.push_back(QRect(rng.bounded(desktop.width() - size), rng.bounded(desktop.height() - size), size, size));
+        scene.layers.push_back(layer);
+        scene.velocity.push_back(layer == CollisionLayer::Obstacle ? QPoint() : QPoint(rng.bounded(-4, 5), rng.bounded(-4, 5)));
+    }
+    return scene;
+}
+
+void advance(Scene &scene)
+{
+    for (size_t i = 0; i < scene.rects.size(); ++i)
+    {
+        QRect &rect = scene.rects[i];
+        rect.translate(scene.velocity[i]);
+        // 碰到桌面边缘反弹
+        if (rect.left() < scene.desktop.left() || rect.right() > scene.desktop.right())
+        {
+            scene.velocity[i].setX(-scene.velocity[i].x());
+        }
+        if (rect.top() < scene.desktop.top() || rect.bottom() > scene.desktop.bottom())
+        {
+            scene.velocity[i].setY(-scene.velocity[i].y());
+        }
+    }
+}
+
+size_t bruteForce(const Scene &scene, long long &tests)
+{
+    size_t pairs = 0;
+    const size_t count = scene.rects.size();
+    for (size_t i = 0; i < count; ++i)
+    {
+        for (size_t j = i + 1; j < count; ++j)
+        {
+            if (!SweepAndPrune::shouldTest(scene.layers[i], scene.layers[j]))
+            {
+                continue;
+            }
+            ++tests;
+            pairs += scene.rects[i].intersects(scene.rects[j]) ? 1 : 0;
+        }
+    }
+    return pairs;
+}
+
+void run(const QRect &desktop, int entities, int frames)
+{
+    QRandomGenerator rng(4000 + entities);
+    Scene scene = makeScene(desktop, entities, rng);
+    SweepAndPrune broadPhase;
+    for (size_t i = 0; i < scene.rects.size(); ++i)
+    {
+        broadPhase.add(scene.rects[i], scene.layers[i]);
+    }
+
+    std::vector<double> sweepSamples;
+    std::vector<double> bruteSamples;
+    long long sweepTests = 0;
+    long long bruteTests = 0;
+    size_t pairs = 0;
+    size_t mismatches = 0;
+    for (int frame = 0; frame < frames; ++frame)
+    {
+        advance(scene);
+
+        auto begin = Clock::now();
+        for (size_t i = 0; i < scene.rects.size(); ++i)
+        {
+            broadPhase.update(static_cast<int>(i), scene.rects[i]);
+        }
+        const size_t found = broadPhase.findPairs().size();
+        sweepSamples.push_back(microsecondsSince(begin));
+        sweepTests += broadPhase.lastTestCount();
+        pairs += found;
+
+        begin = Clock::now();
+        const size_t expected = bruteForce(scene, bruteTests);
+        bruteSamples.push_back(microsecondsSince(begin));
+        mismatches += expected != found ? 1 : 0;
+    }
+    std::sort(sweepSamples.begin(), sweepSamples.end());
+    std::sort(bruteSamples.begin(), bruteSamples.end());
+
+    std::printf("%5dx%-4d %5d entities  sweep median %8.2f us  p99 %8.2f us  tests/frame %8.0f  |  all-pairs median %9.2f us  tests/frame %9.0f  |  pairs/frame %.1f%s\n",
+                desktop.width(), desktop.height(), entities, sweepSamples[frames / 2], sweepSamples[frames * 99 / 100], double(sweepTests) / frames,
+                bruteSamples[frames / 2], double(bruteTests) / frames, double(pairs) / frames,
+                mismatches ? "  MISMATCH" : "");
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    const int frames = argc > 1 ? std::max(100, std::atoi(argv[1])) : 600;
+    std::printf("%d frames per size\n\nfixed desktop:\n", frames);
+    for (int entities : {10, 100, 1000})
+    {
+        run(FULL_DESKTOP, entities, frames);
+    }
+
+    std::printf("\nconstant density (desktop area grows with entity count):\n");
+    for (int entities : {10, 100, 1000})
+    {
+        const double scale = std::sqrt(entities / 1000.0);
+        run(QRect(0, 0, int(FULL_DESKTOP.width() * scale), int(FULL_DESKTOP.height() * scale)), entities, frames);
+    }
+    return 0;
+}
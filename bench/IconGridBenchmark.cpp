@@ -0,0 +1,143 @@
+// 桌面图标邻近检测基准
+// 用法：icon_grid_benchmark [每种布局的查询次数=1000000]
+// 合成布局：规则排列的桌面（按列从左上角排布）和全屏随机散布，图标数 100/1000/10000
+// 对比网格查询与旧实现（逐个图标 qSqrt(qPow) + QVector::contains）
+#include "model/IconSpatialGrid.h"
+#include <QRandomGenerator>
+#include <QRect>
+#include <QVector>
+#include <QtMath>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+namespace
+{
+
+using Clock = std::chrono::steady_clock;
+
+const int SCREEN_WIDTH = 3840;
+const int SCREEN_HEIGHT = 2160;
+const int ICON_SIZE = 48;
+const int DETECTION_RADIUS = 50;
+
+double secondsSince(Clock::time_point start)
+{
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+// 按列排列的桌面，超出屏幕后从头开始叠放
+QVector<QRect> regularLayout(int count)
+{
+    QVector<QRect> rects;
+    const int step = 96;
+    const int rows = SCREEN_HEIGHT / step;
+    const int cols = SCREEN_WIDTH / step;
+    for (int i = 0; i < count; ++i)
+    {
+        const int slot = i % (rows * cols);
+        rects.append(QRect(16 + (slot / rows) * step, 16 + (slot % rows) * step, ICON_SIZE, ICON_SIZE));
+    }
+    return rects;
+}
+
+QVector<QRect> scatteredLayout(int count, QRandomGenerator &rng)
+{
+    QVector<QRect> rects;
+    for (int i = 0; i < count; ++i)
+    {
+        rects.append(QRect(rng.bounded(SCREEN_WIDTH - ICON_SIZE), rng.bounded(SCREEN_HEIGHT - ICON_SIZE),
+                           ICON_SIZE, ICON_SIZE));
+    }
+    return rects;
+}
+
+// 旧实现：每次都遍历所有图标并开方
+int legacyFind(const QVector<QRect> &rects, const QVector<int> &interacted, const QPoint &pos)
+{
+    for (int i = 0; i < rects.size(); ++i)
+    {
+        if (interacted.contains(i))
+        {
+            continue;
+        }
+        QPoint iconCenter = rects[i].center();
+        int distance = qSqrt(qPow(pos.x() - iconCenter.x(), 2) + qPow(pos.y() - iconCenter.y(), 2));
+        if (distance <= DETECTION_RADIUS)
+        {
+            return i;
+        }
+    }
+    return -1;
+}
+
+void runLayout(const char *name, const QVector<QRect> &rects, long long queries)
+{
+    // 模拟已经交互过一部分图标
+    QVector<int> interacted;
+    std::vector<bool> interactedMask(rects.size(), false);
+    for (int i = 0; i < rects.size(); i += 10)
+    {
+        interacted.append(i);
+        interactedMask[i] = true;
+    }
+
+    // 宠物沿屏幕做连续移动，相邻两次查询位置接近，和实际移动一致
+    std::vector<QPoint> path;
+    QRandomGenerator rng(42);
+    QPoint pos(SCREEN_WIDTH / 2, SCREEN_HEIGHT / 2);
+    for (int i = 0; i < 4096; ++i)
+    {
+        pos += QPoint(rng.bounded(-10, 11), rng.bounded(-10, 11));
+        pos.setX(qBound(0, pos.x(), SCREEN_WIDTH));
+        pos.setY(qBound(0, pos.y(), SCREEN_HEIGHT));
+        path.push_back(pos);
+    }
+
+    auto buildStart = Clock::now();
+    IconSpatialGrid grid;
+    grid.build(rects, DETECTION_RADIUS);
+    const double buildSeconds = secondsSince(buildStart);
+
+    long long legacyHits = 0;
+    auto start = Clock::now();
+    for (long long i = 0; i < queries; ++i)
+    {
+        legacyHits += legacyFind(rects, interacted, path[i & 4095]) >= 0;
+    }
+    const double legacySeconds = secondsSince(start);
+
+    long long gridHits = 0;
+    start = Clock::now();
+    for (long long i = 0; i < queries; ++i)
+    {
+        bool found = false;
+        grid.query(path[i & 4095], DETECTION_RADIUS, [&](int index) {
+            found = found || !interactedMask[index];
+        });
+        gridHits += found;
+    }
+    const double gridSeconds = secondsSince(start);
+
+    std::printf("%-10s %6d icons  build %8.3f ms  legacy %9.1f ns/query  grid %7.1f ns/query  speedup %7.1fx  hits %lld/%lld\n",
+                name, int(rects.size()), buildSeconds * 1e3,
+                legacySeconds * 1e9 / queries, gridSeconds * 1e9 / queries,
+                legacySeconds / gridSeconds, legacyHits, gridHits);
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    const long long queries = argc > 1 ? std::atoll(argv[1]) : 1000000LL;
+    std::printf("queries per layout: %lld, detection radius: %d\n\n", queries, DETECTION_RADIUS);
+
+    QRandomGenerator rng(2024);
+    for (int count : {100, 1000, 10000})
+    {
+        runLayout("regular", regularLayout(count), queries);
+        runLayout("scattered", scatteredLayout(count, rng), queries);
+    }
+    return 0;
+}
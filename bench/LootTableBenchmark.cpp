@@ -0,0 +1,124 @@
+// 掉落表抽样基准
+// 用法：loot_table_benchmark [抽样次数=100000000] [loot_tables.csv路径]
+#include "model/LootTableLoader.h"
+#include <QRandomGenerator>
+#include <QString>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+namespace
+{
+
+using Clock = std::chrono::steady_clock;
+
+double secondsSince(Clock::time_point start)
+{
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+// 旧实现：光合作用的if/else阶梯 + QRandomGenerator::global()
+LootDrop legacySunshineDraw(QRandomGenerator *rng)
+{
+    int random = rng->bounded(100);
+    if (random < 60)
+    {
+        return {6, rng->bounded(1, 4)};
+    }
+    if (random < 85)
+    {
+        return {7, rng->bounded(1, 3)};
+    }
+    if (random < 97)
+    {
+        return {rng->bounded(8, 10), 1};
+    }
+    return {10, 1};
+}
+
+const char *workTypeName(WorkType type)
+{
+    switch (type)
+    {
+    case WorkType::Photosynthesis:
+        return "Photosynthesis";
+    case WorkType::Mining:
+        return "Mining";
+    case WorkType::Adventure:
+        return "Adventure";
+    }
+    return "?";
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    const long long draws = argc > 1 ? std::atoll(argv[1]) : 100000000LL;
+    const QString csvPath = argc > 2 ? QString::fromLocal8Bit(argv[2])
+                                     : QStringLiteral(DESKTOPPET_SOURCE_DIR "/resources/csv/loot_tables.csv");
+
+    LootTableRows rows;
+    if (!LootTableLoader::loadFromCSV(csvPath, rows))
+    {
+        std::fprintf(stderr, "failed to load %s\n", qPrintable(csvPath));
+        return 1;
+    }
+
+    std::printf("draws per table: %lld\n\n", draws);
+
+    // 旧实现基线
+    {
+        QRandomGenerator *rng = QRandomGenerator::global();
+        long long checksum = 0;
+        auto start = Clock::now();
+        for (long long i = 0; i < draws; ++i)
+        {
+            LootDrop drop = legacySunshineDraw(rng);
+            checksum += drop.itemId + drop.count;
+        }
+        double elapsed = secondsSince(start);
+        std::printf("%-16s %8.2f ns/draw  %7.3f s  (checksum %lld)\n\n", "legacy cascade",
+                    elapsed * 1e9 / draws, elapsed, checksum);
+    }
+
+    // 别名表：基础表和大师级(品质+60%)各测一次，并核对经验分布
+    RandomEngine rng(20240501);
+    for (auto it = rows.constBegin(); it != rows.constEnd(); ++it)
+    {
+        if (!it.value().contains(0))
+        {
+            continue;
+        }
+
+        for (double qualityBonus : {0.0, 0.6})
+        {
+            LootTable table = LootTable::compile(it.value()[0], qualityBonus, 1.0);
+
+            std::vector<long long> observed(256, 0);
+            long long checksum = 0;
+            auto start = Clock::now();
+            for (long long i = 0; i < draws; ++i)
+            {
+                LootDrop drop = table.draw(rng);
+                checksum += drop.itemId + drop.count;
+                observed[drop.itemId & 0xff]++;
+            }
+            double elapsed = secondsSince(start);
+
+            std::printf("%-16s bonus %.1f %8.2f ns/draw  %7.3f s  (checksum %lld)\n", workTypeName(it.key()),
+                        qualityBonus, elapsed * 1e9 / draws, elapsed, checksum);
+            for (int itemId = 0; itemId < 256; ++itemId)
+            {
+                if (observed[itemId] > 0)
+                {
+                    std::printf("    item %3d  observed %7.4f%%  expected %7.4f%%\n", itemId,
+                                100.0 * observed[itemId] / draws, 100.0 * table.itemProbability(itemId));
+                }
+            }
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,91 @@
+// 导航网格寻路基准
+// 用法：nav_grid_benchmark [每种布局的寻路次数=20000]
+// 合成布局：两块 4K 屏幕并排（7680x2160），随机摆放的窗口 + 300 个桌面图标
+// 报告单次寻路耗时的中位数、p99 和最大值，以及一次障碍物增量更新的耗时
+#include "model/NavGrid.h"
+#include <QRandomGenerator>
+#include <QRect>
+#include <QVector>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+namespace
+{
+
+using Clock = std::chrono::steady_clock;
+
+const QRect DESKTOP(0, 0, 7680, 2160);
+
+double microsecondsSince(Clock::time_point start)
+{
+    return std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+}
+
+QVector<QRect> makeObstacles(int windows, QRandomGenerator &rng)
+{
+    QVector<QRect> rects;
+    for (int i = 0; i < windows; ++i)
+    {
+        rects.append(QRect(rng.bounded(DESKTOP.width() - 600), rng.bounded(DESKTOP.height() - 400),
+                           rng.bounded(300, 1400), rng.bounded(200, 900)));
+    }
+    for (int i = 0; i < 300; ++i)
+    {
+        rects.append(QRect(rng.bounded(DESKTOP.width() - 48), rng.bounded(DESKTOP.height() - 48), 48, 48));
+    }
+    return rects;
+}
+
+void runLayout(int windows, int queries)
+{
+    QRandomGenerator rng(1000 + windows);
+    NavGrid grid;
+    grid.reset(DESKTOP);
+    QVector<QRect> obstacles = makeObstacles(windows, rng);
+    grid.setObstacles(obstacles);
+
+    std::vector<double> samples;
+    samples.reserve(queries);
+    QVector<QPoint> path;
+    long long waypoints = 0;
+    int failures = 0;
+    for (int i = 0; i < queries; ++i)
+    {
+        const QPoint start(rng.bounded(DESKTOP.width()), rng.bounded(DESKTOP.height()));
+        const QPoint goal(rng.bounded(DESKTOP.width()), rng.bounded(DESKTOP.height()));
+        auto begin = Clock::now();
+        const bool found = grid.findPath(start, goal, path);
+        samples.push_back(microsecondsSince(begin));
+        waypoints += path.size();
+        failures += found ? 0 : 1;
+    }
+    std::sort(samples.begin(), samples.end());
+
+    // 增量更新：移动一个窗口
+    obstacles[0].translate(200, 100);
+    auto begin = Clock::now();
+    grid.setObstacles(obstacles);
+    const double updateUs = microsecondsSince(begin);
+
+    std::printf("%3d windows  median %7.1f us  p99 %7.1f us  max %7.1f us  waypoints %.1f  unreachable %d  update %.1f us\n",
+                windows, samples[queries / 2], samples[queries * 99 / 100], samples.back(),
+                double(waypoints) / queries, failures, updateUs);
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    const int queries = argc > 1 ? std::max(1, std::atoi(argv[1])) : 20000;
+    std::printf("desktop %dx%d, cell %d px, %d paths per layout\n\n", DESKTOP.width(), DESKTOP.height(),
+                NavGrid::DEFAULT_CELL_SIZE, queries);
+
+    for (int windows : {0, 10, 40})
+    {
+        runLayout(windows, queries);
+    }
+    return 0;
+}
@@ -0,0 +1,229 @@
+// 群体宠物帧耗时基准
+// 用法：pet_swarm_benchmark [每种规模模拟的帧数=3600] [GIF路径=resources/gif/spider.gif]
+// 合成场景：两块 1080p 屏幕并排，300 个桌面图标，每帧 1/60 秒
+// 每帧先批量 step()（含宠物/鼠标/图标碰撞检测），再按 PetSwarmWindow 的规则重绘：
+// 动画换帧时整个覆盖层重绘，否则只重绘宠物移动经过的区域；绘制目标是覆盖整个桌面的 ARGB32_Premultiplied QImage
+// 报告 10/100/1000 只宠物时 step、重绘和整帧的耗时中位数、p99 和最大值（不含合成器把窗口送上屏幕的时间），
+// 并与每只宠物各自持有一个 MotionIntegrator 逐个推进（只计移动）的耗时对比
+#include "model/MotionIntegrator.h"
+#include "model/PetSwarm.h"
+#include "view/AnimationCache.h"
+#include <QGuiApplication>
+#include <QImage>
+#include <QPainter>
+#include <QRandomGenerator>
+#include <QRect>
+#include <QRegion>
+#include <QVector>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+namespace
+{
+
+using Clock = std::chrono::steady_clock;
+
+const double FRAME = 1.0 / 60.0;
+const QSize PET_SIZE(200, 200);
+
+double microsecondsSince(Clock::time_point start)
+{
+    return std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+}
+
+QVector<ScreenInfo> makeScreens()
+{
+    ScreenInfo left;
+    left.geometry = QRect(0, 0, 1920, 1080);
+    ScreenInfo right;
+    right.geometry = QRect(1920, 0, 1920, 1080);
+    return {left, right};
+}
+
+QVector<QRect> makeIcons(QRandomGenerator &rng)
+{
+    QVector<QRect> rects;
+    for (int i = 0; i < 300; ++i)
+    {
+        rects.append(QRect(rng.bounded(3840 - 48), rng.bounded(1080 - 48), 48, 48));
+    }
+    return rects;
+}
+
+void report(const char *label, int pets, std::vector<double> &samples)
+{
+    std::sort(samples.begin(), samples.end());
+    std::printf("%-12s %5d pets  median %8.2f us  p99 %8.2f us  max %8.2f us  per pet %.3f us\n", label, pets,
+                samples[samples.size() / 2], samples[samples.size() * 99 / 100], samples.back(),
+                samples[samples.size() / 2] / pets);
+}
+
+// 与 PetSwarmWindow::tick() 相同的脏区域：动画换帧时整个画布，否则是宠物上一帧和这一帧覆盖的区域
+QRegion dirtyRegion(const PetSwarm &swarm, const QVector<QRect> &lastRects)
+{
+    QRegion dirty;
+    for (int i = 0; i < swarm.size(); ++i)
+    {
+        const QRect rect = swarm.rect(i);
+        if (i >= lastRects.size() || rect != lastRects[i])
+        {
+            dirty += rect;
+            if (i < lastRects.size())
+            {
+                dirty += lastRects[i];
+            }
+        }
+    }
+    for (int i : swarm.changed())
+    {
+        dirty += swarm.rect(i);
+    }
+    return dirty;
+}
+
+// 与 PetSwarmWindow::paintEvent() 相同的绘制：透明窗口先清空重绘区域，再画出与重绘范围相交的宠物
+void paintSwarm(const PetSwarm &swarm, const QPixmap &frame, const QRegion &dirty, QImage &canvas)
+{
+    QPainter painter(&canvas);
+    painter.setClipRegion(dirty);
+    painter.setCompositionMode(QPainter::CompositionMode_Clear);
+    painter.fillRect(dirty.boundingRect(), Qt::transparent);
+    painter.setCompositionMode(QPainter::CompositionMode_SourceOver);
+    const QRect exposed = dirty.boundingRect();
+    for (int i = 0; i < swarm.size(); ++i)
+    {
+        const QRect rect = swarm.rect(i);
+        if (!exposed.intersects(rect))
+        {
+            continue;
+        }
+        painter.drawPixmap(rect.x() + (rect.width() - frame.width()) / 2,
+                           rect.y() + (rect.height() - frame.height()) / 2, frame);
+    }
+}
+
+void runSwarm(int pets, int frames, const AnimationFrames &animation, QImage &canvas)
+{
+    QRandomGenerator rng(2000 + pets);
+    PetSwarm swarm(pets);
+    swarm.setScreens(makeScreens());
+    swarm.setPetSize(PET_SIZE);
+    swarm.setObstacles(makeIcons(rng));
+    swarm.spawnRandom(pets);
+    canvas.fill(Qt::transparent);
+
+    std::vector<double> stepSamples;
+    std::vector<double> paintSamples;
+    std::vector<double> frameSamples;
+    stepSamples.reserve(frames);
+    paintSamples.reserve(frames);
+    frameSamples.reserve(frames);
+    QVector<QRect> lastRects;
+    int animationFrame = -1;
+    size_t stateChanges = 0;
+    for (int frame = 0; frame < frames; ++frame)
+    {
+        const auto begin = Clock::now();
+        swarm.step(FRAME);
+        stepSamples.push_back(microsecondsSince(begin));
+
+        const auto paintBegin = Clock::now();
+        const int index = animation.frameAt(qint64(frame * FRAME * 1000.0));
+        QRegion dirty;
+        if (index != animationFrame)
+        {
+            animationFrame = index;
+            dirty = canvas.rect();
+        }
+        else
+        {
+            dirty = dirtyRegion(swarm, lastRects);
+        }
+        lastRects.resize(swarm.size());
+        for (int i = 0; i < swarm.size(); ++i)
+        {
+            lastRects[i] = swarm.rect(i);
+        }
+        if (!dirty.isEmpty())
+        {
+            paintSwarm(swarm, animation.frames[animationFrame], dirty, canvas);
+        }
+        paintSamples.push_back(microsecondsSince(paintBegin));
+        frameSamples.push_back(microsecondsSince(begin));
+        stateChanges += swarm.changed().size();
+    }
+    report("swarm step", pets, stepSamples);
+    report("swarm paint", pets, paintSamples);
+    report("swarm frame", pets, frameSamples);
+    std::printf("%-12s %5s       interactions %lld  state changes %zu\n", "", "", swarm.interactionCount(),
+                stateChanges);
+}
+
+void runPerPet(int pets, int frames)
+{
+    // 旧做法的移动部分：每只宠物一个对象，目标用完后随机换一个
+    QRandomGenerator rng(3000 + pets);
+    std::vector<MotionIntegrator> motions(pets);
+    for (MotionIntegrator &motion : motions)
+    {
+        motion.setLimits(200.0, 800.0);
+        motion.reset(QPointF(rng.bounded(3640), rng.bounded(880)));
+        motion.setTarget(QPointF(rng.bounded(3640), rng.bounded(880)));
+    }
+
+    std::vector<double> samples;
+    samples.reserve(frames);
+    for (int frame = 0; frame < frames; ++frame)
+    {
+        auto begin = Clock::now();
+        for (MotionIntegrator &motion : motions)
+        {
+            motion.step(FRAME);
+            if (motion.hasArrived())
+            {
+                motion.setTarget(QPointF(rng.bounded(3640), rng.bounded(880)));
+            }
+        }
+        samples.push_back(microsecondsSince(begin));
+    }
+    report("per-pet", pets, samples);
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    // 不需要真正的窗口
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM"))
+    {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+    QGuiApplication app(argc, argv);
+
+    const int frames = argc > 1 ? std::max(100, std::atoi(argv[1])) : 3600;
+    const QString gifPath = argc > 2 ? QString::fromLocal8Bit(argv[2])
+                                     : QStringLiteral(DESKTOPPET_SOURCE_DIR "/resources/gif/spider.gif");
+
+    // 与 PetSwarmWindow 一样使用按宠物大小缩放好的帧
+    const auto animation = AnimationCache::decode(gifPath, PET_SIZE);
+    if (animation->isEmpty())
+    {
+        std::fprintf(stderr, "cannot decode %s\n", qPrintable(gifPath));
+        return 1;
+    }
+
+    QImage canvas(QSize(3840, 1080), QImage::Format_ARGB32_Premultiplied);
+    std::printf("desktop 3840x1080, 300 icons, %d frames at 60 Hz (budget %.0f us per frame)\n\n", frames,
+                FRAME * 1e6);
+
+    for (int pets : {10, 100, 1000})
+    {
+        runSwarm(pets, frames, *animation, canvas);
+        runPerPet(pets, frames);
+        std::printf("\n");
+    }
+    return 0;
+}
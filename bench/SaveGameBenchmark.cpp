@@ -0,0 +1,248 @@
+// 存档基准：大背包、长锻造历史下，旧的分文件存档、JSON快照与二进制快照的保存/读取耗时，
+// 以及自动存档时GUI线程采集快照的耗时
+// 用法：save_game_benchmark [规模列表=100,10000,100000] [重复次数=5]
+// 规模N表示背包N种物品、锻造历史N条；存档写入测试模式下的临时数据目录，不影响真实存档
+#include "common/AutoSaver.h"
+#include "common/SaveGame.h"
+#include "model/BackpackModel.h"
+#include "model/CollectionModel.h"
+#include "model/ForgeModel.h"
+#include "model/PetModel.h"
+#include "model/WorkModel.h"
+#include <QCoreApplication>
+#include <QDir>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QStandardPaths>
+#include <QStringList>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <vector>
+
+namespace
+{
+
+using Clock = std::chrono::steady_clock;
+
+void quietMessages(QtMsgType type, const QMessageLogContext &, const QString &msg)
+{
+    if (type != QtDebugMsg && type != QtInfoMsg)
+    {
+        std::fprintf(stderr, "%s\n", qPrintable(msg));
+    }
+}
+
+// 重复执行，返回耗时中位数（毫秒）
+double medianMs(int repeats, const std::function<void()> &fn)
+{
+    std::vector<double> samples;
+    for (int i = 0; i < repeats; ++i)
+    {
+        auto start = Clock::now();
+        fn();
+        samples.push_back(std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+    }
+    std::sort(samples.begin(), samples.end());
+    return samples[samples.size() / 2];
+}
+
+QJsonArray makeBackpack(int count)
+{
+    QJsonArray items;
+    for (int i = 0; i < count; ++i)
+    {
+        QJsonObject item;
+        item["itemId"] = i + 1;
+        item["count"] = (i * 7919) % 999 + 1;
+        items.append(item);
+    }
+    return items;
+}
+
+QJsonObject makeForge(int historyCount)
+{
+    QJsonArray history;
+    for (int i = 0; i < historyCount; ++i)
+    {
+        QJsonObject material;
+        material["itemId"] = 6 + i % 15;
+        material["count"] = 5;
+        material["isCatalyst"] = false;
+
+        QJsonObject entry;
+        entry["recipeId"] = 1 + i % 12;
+        entry["forgeTime"] = "2024-05-01T12:00:00";
+        entry["success"] = true;
+        entry["materialsCost"] = QJsonArray{material};
+        entry["productsGained"] = QJsonArray{7 + i % 14};
+        history.append(entry);
+    }
+
+    QJsonObject forge;
+    forge["totalForgeCount"] = historyCount;
+    forge["successfulForgeCount"] = historyCount;
+    forge["forgeHistory"] = history;
+    return forge;
+}
+
+qint64 fileSize(const QString &path)
+{
+    return QFile(path).size();
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("DesktopPetSaveBenchmark");
+    QStandardPaths::setTestModeEnabled(true);
+    qInstallMessageHandler(quietMessages);
+
+    const QStringList sizes = QString(argc > 1 ? argv[1] : "100,10000,100000").split(',', Qt::SkipEmptyParts);
+    const int repeats = std::max(1, argc > 2 ? std::atoi(argv[2]) : 5);
+
+    const QString dataDir = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
+    QDir(dataDir).mkpath(".");
+    // ForgeModel 的旧存档使用相对路径，这里统一放到数据目录
+    const QString forgeLegacyPath = dataDir + "/forge_data.json";
+
+    PetModel pet;
+    WorkModel work;
+    CollectionModel collection;
+    collection.loadItemsFromCSV(DESKTOPPET_SOURCE_DIR "/resources/csv/collection_items.csv");
+    BackpackModel backpack;
+    ForgeModel forge;
+
+    std::printf("%-8s %-9s %10s %10s %12s %12s %12s\n", "size", "format", "save ms", "load ms", "bytes",
+                "save MB/s", "load MB/s");
+
+    for (const QString &sizeText : sizes)
+    {
+        const int n = sizeText.toInt();
+        backpack.fromJson(makeBackpack(n));
+        forge.fromJson(makeForge(n));
+
+        // 旧格式：五个模型各写一个文件，直接覆盖写入
+        const double legacySave = medianMs(repeats, [&]() {
+            pet.save_to_file("pet_data.json");
+            backpack.saveToFile("backpack_data.json");
+            collection.saveToFile("collection_data.json");
+            work.saveToFile("work_data.json");
+            forge.saveToFile(forgeLegacyPath);
+        });
+        const double legacyLoad = medianMs(repeats, [&]() {
+            pet.load_from_file("pet_data.json");
+            backpack.loadFromFile("backpack_data.json");
+            collection.loadFromFile("collection_data.json");
+            work.loadFromFile("work_data.json");
+            forge.loadFromFile(forgeLegacyPath);
+        });
+        const qint64 legacyBytes = fileSize(dataDir + "/pet_data.json") + fileSize(dataDir + "/backpack_data.json") +
+                                   fileSize(dataDir + "/collection_data.json") + fileSize(dataDir + "/work_data.json") +
+                                   fileSize(forgeLegacyPath);
+
+        // JSON快照：采集 + 序列化 + 临时文件/fsync/rename
+        const QString jsonPath = SaveGame::fullPath(SaveGame::JSON_FILENAME);
+        const double jsonSave = medianMs(repeats, [&]() {
+            SaveGame snapshot;
+            snapshot.setSection(SaveGame::SECTION_PET, pet.to_json());
+            snapshot.setSection(SaveGame::SECTION_BACKPACK, backpack.toJson());
+            snapshot.setSection(SaveGame::SECTION_COLLECTION, collection.toJson());
+            snapshot.setSection(SaveGame::SECTION_WORK, work.toJson());
+            snapshot.setSection(SaveGame::SECTION_FORGE, forge.toJson());
+            snapshot.saveJson(jsonPath);
+        });
+        const double jsonLoad = medianMs(repeats, [&]() {
+            SaveGame loaded;
+            if (!loaded.loadFile(jsonPath))
+            {
+                std::fprintf(stderr, "failed to load json snapshot\n");
+                std::exit(1);
+            }
+            pet.from_json(loaded.section(SaveGame::SECTION_PET).toObject());
+            backpack.fromJson(loaded.section(SaveGame::SECTION_BACKPACK).toArray());
+            collection.fromJson(loaded.section(SaveGame::SECTION_COLLECTION).toObject());
+            work.fromJson(loaded.section(SaveGame::SECTION_WORK).toObject());
+            forge.fromJson(loaded.section(SaveGame::SECTION_FORGE).toObject());
+        });
+        const qint64 jsonBytes = fileSize(jsonPath);
+
+        // 二进制快照：与 PetViewModel::save_all_data 的写法相同
+        auto writeSection = [](BinaryWriter &out, const char *key, const std::function<void(BinaryWriter &)> &fn) {
+            out.beginMessage(SaveGame::sectionField(key));
+            fn(out);
+            out.endMessage();
+        };
+        const double binarySave = medianMs(repeats, [&]() {
+            BinaryWriter out;
+            writeSection(out, SaveGame::SECTION_PET, [&](BinaryWriter &w) { pet.write_binary(w); });
+            writeSection(out, SaveGame::SECTION_BACKPACK, [&](BinaryWriter &w) { backpack.writeBinary(w); });
+            writeSection(out, SaveGame::SECTION_COLLECTION, [&](BinaryWriter &w) { collection.writeBinary(w); });
+            writeSection(out, SaveGame::SECTION_WORK, [&](BinaryWriter &w) { work.writeBinary(w); });
+            writeSection(out, SaveGame::SECTION_FORGE, [&](BinaryWriter &w) { forge.writeBinary(w); });
+            SaveGame snapshot;
+            snapshot.save(out);
+        });
+        const double binaryLoad = medianMs(repeats, [&]() {
+            SaveGame loaded;
+            if (!loaded.loadFile(SaveGame::fullPath(SaveGame::DEFAULT_FILENAME)))
+            {
+                std::fprintf(stderr, "failed to load binary snapshot\n");
+                std::exit(1);
+            }
+            BinaryReader in = loaded.binarySection(SaveGame::SECTION_PET);
+            pet.read_binary(in);
+            in = loaded.binarySection(SaveGame::SECTION_BACKPACK);
+            backpack.readBinary(in);
+            in = loaded.binarySection(SaveGame::SECTION_COLLECTION);
+            collection.readBinary(in);
+            in = loaded.binarySection(SaveGame::SECTION_WORK);
+            work.readBinary(in);
+            in = loaded.binarySection(SaveGame::SECTION_FORGE);
+            forge.readBinary(in);
+        });
+        const qint64 binaryBytes = fileSize(SaveGame::fullPath(SaveGame::DEFAULT_FILENAME));
+
+        // 自动存档：GUI线程只采集快照，编码和写盘在存档线程
+        AutoSaver autosaver;
+        autosaver.start(SaveGame::fullPath(SaveGame::DEFAULT_FILENAME), [&](bool) {
+            AutoSaver::Sections sections;
+            sections[SaveGame::sectionField(SaveGame::SECTION_PET)] =
+                [snapshot = pet.save_snapshot()](BinaryWriter &w) { PetModel::write_binary(snapshot, w); };
+            sections[SaveGame::sectionField(SaveGame::SECTION_BACKPACK)] =
+                [snapshot = backpack.saveSnapshot()](BinaryWriter &w) { BackpackModel::writeBinary(snapshot, w); };
+            sections[SaveGame::sectionField(SaveGame::SECTION_COLLECTION)] =
+                [snapshot = collection.saveSnapshot()](BinaryWriter &w) { CollectionModel::writeBinary(snapshot, w); };
+            sections[SaveGame::sectionField(SaveGame::SECTION_WORK)] =
+                [snapshot = work.saveSnapshot()](BinaryWriter &w) { WorkModel::writeBinary(snapshot, w); };
+            sections[SaveGame::sectionField(SaveGame::SECTION_FORGE)] =
+                [snapshot = forge.saveSnapshot()](BinaryWriter &w) { ForgeModel::writeBinary(snapshot, w); };
+            return sections;
+        });
+        autosaver.flush();
+        const double autosaveGui = medianMs(repeats, [&]() { autosaver.saveNow(); });
+        const double autosaveTotal = medianMs(repeats, [&]() {
+            autosaver.saveNow();
+            autosaver.flush();
+        });
+        autosaver.stop();
+
+ [](qint64 bytes, double ms) { return ms > 0.0 ? bytes / 1048576.0 / (ms / 1000.0) : 0.0; };
+        std::printf("%-8d %-9s %10.2f %10.2f %12lld %12.1f %12.1f\n", n, "legacy", legacySave, legacyLoad,
+                    (long long)legacyBytes, mbps(legacyBytes, legacySave), mbps(legacyBytes, legacyLoad));
+        std::printf("%-8d %-9s %10.2f %10.2f %12lld %12.1f %12.1f\n", n, "json", jsonSave, jsonLoad,
+                    (long long)jsonBytes, mbps(jsonBytes, jsonSave), mbps(jsonBytes, jsonLoad));
+        std::printf("%-8d %-9s %10.2f %10.2f %12lld %12.1f %12.1f\n", n, "binary", binarySave, binaryLoad,
+                    (long long)binaryBytes, mbps(binaryBytes, binarySave), mbps(binaryBytes, binaryLoad));
+        std::printf("%-8d %-9s %10.3f (GUI thread) %10.2f (with background write)\n", n, "autosave", autosaveGui,
+                    autosaveTotal);
+    }
+
+    QDir(dataDir).removeRecursively();
+    return 0;
+}
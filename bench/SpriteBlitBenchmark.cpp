@@ -0,0 +1,195 @@
+// 宠物动画绘制基准
+// 用法：sprite_blit_benchmark [GIF路径=resources/gif/spider.gif] [帧数=2000]
+// 把 GIF 逐帧拆成精灵图集（图集 PNG + JSON 帧表，写到临时目录），再模拟透明窗口的重绘：
+//   QMovie：每帧 jumpToNextFrame() 解码并转换为 QPixmap，清空整个控件后绘制整帧（QLabel 的做法）
+//   精灵图集：帧已在 AnimationCache 中解码好并转换为预乘 ARGB，只清空并重绘与上一帧不同的矩形
+// 绘制目标是与窗口缓冲区相同格式（ARGB32_Premultiplied）的 QImage
+// 报告每帧耗时（中位数/p99）和平均每帧 CPU 时间，以及首次使用时的解码耗时
+#include "common/SpriteSheet.h"
+#include "view/AnimationCache.h"
+#include <QGuiApplication>
+#include <QFile>
+#include <QImage>
+#include <QImageReader>
+#include <QMovie>
+#include <QPainter>
+#include <QTemporaryDir>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <vector>
+
+namespace
+{
+
+using Clock = std::chrono::steady_clock;
+
+double microsecondsSince(Clock::time_point start)
+{
+    return std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+}
+
+struct Result
+{
+    std::vector<double> samples;
+    double cpuUsPerFrame = 0.0;
+};
+
+void report(const char *name, Result &result)
+{
+    std::sort(result.samples.begin(), result.samples.end());
+    const size_t n = result.samples.size();
+    std::printf("%-12s median %8.2f us  p99 %8.2f us  cpu/frame %8.2f us\n", name, result.samples[n / 2],
+                result.samples[n * 99 / 100], result.cpuUsPerFrame);
+}
+
+// 把 GIF 的每一帧排成网格写成图集，返回 JSON 帧表路径
+QString writeSpriteSheet(const QString &gifPath, const QString &dir)
+{
+    QImageReader reader(gifPath);
+    QVector<QImage> images;
+    SpriteSheet sheet;
+    sheet.loopCount = reader.loopCount();
+    QImage image;
+    while (reader.read(&image))
+    {
+        images.append(image.convertToFormat(QImage::Format_ARGB32));
+        sheet.frames.append({QRect(), std::max(10, reader.nextImageDelay())});
+    }
+    if (images.isEmpty())
+    {
+        return QString();
+    }
+
+    const int columns = int(std::ceil(std::sqrt(double(images.size()))));
+    const QSize cell = images[0].size();
+    QImage atlas(cell.width() * columns, cell.height() * ((images.size() + columns - 1) / columns), QImage::Format_ARGB32);
+    atlas.fill(Qt::transparent);
+    QPainter painter(&atlas);
+    painter.setCompositionMode(QPainter::CompositionMode_Source);
+    for (int i = 0; i < images.size(); ++i)
+    {
+        const QPoint at((i % columns) * cell.width(), (i / columns) * cell.height());
+        painter.drawImage(at, images[i]);
+        sheet.frames[i].rect = QRect(at, images[i].size());
+    }
+    painter.end();
+
+    atlas.save(dir + "/atlas.png");
+    QFile json(dir + "/atlas.json");
+    json.open(QIODevice::WriteOnly);
+    json.write(sheet.toJson("atlas.png"));
+    return json.fileName();
+}
+
+void clear(QPainter &painter, const QRect &rect)
+{
+    painter.setCompositionMode(QPainter::CompositionMode_Clear);
+    painter.fillRect(rect, Qt::transparent);
+    painter.setCompositionMode(QPainter::CompositionMode_SourceOver);
+}
+
+Result runMovie(const QString &gifPath, QImage &canvas, int frames)
+{
+    Result result;
+    QMovie movie(gifPath);
+    movie.setCacheMode(QMovie::CacheNone);
+    movie.jumpToFrame(0);
+    const std::clock_t cpuStart = std::clock();
+    for (int frame = 0; frame < frames; ++frame)
+    {
+        const auto begin = Clock::now();
+        if (!movie.jumpToNextFrame())
+        {
+            movie.jumpToFrame(0);
+        }
+        const QPixmap pixmap = movie.currentPixmap();
+        QPainter painter(&canvas);
+        clear(painter, canvas.rect());
+        painter.drawPixmap((canvas.width() - pixmap.width()) / 2, (canvas.height() - pixmap.height()) / 2, pixmap);
+        painter.end();
+        result.samples.push_back(microsecondsSince(begin));
+    }
+    result.cpuUsPerFrame = double(std::clock() - cpuStart) * 1e6 / CLOCKS_PER_SEC / frames;
+    return result;
+}
+
+Result runSprite(const AnimationFrames &animation, QImage &canvas, int frames)
+{
+    Result result;
+    int current = 0;
+    const std::clock_t cpuStart = std::clock();
+    for (int frame = 0; frame < frames; ++frame)
+    {
+        const auto begin = Clock::now();
+        current = (current + 1) % animation.frames.size();
+        const QPixmap &pixmap = animation.frames[current];
+        const QPoint origin((canvas.width() - pixmap.width()) / 2, (canvas.height() - pixmap.height()) / 2);
+        const QRect dirty = animation.changed[current].translated(origin);
+        if (!dirty.isEmpty())
+        {
+            QPainter painter(&canvas);
+            painter.setClipRect(dirty);
+            clear(painter, dirty);
+            painter.drawPixmap(origin, pixmap);
+        }
+        result.samples.push_back(microsecondsSince(begin));
+    }
+    result.cpuUsPerFrame = double(std::clock() - cpuStart) * 1e6 / CLOCKS_PER_SEC / frames;
+    return result;
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    // 不需要真正的窗口
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM"))
+    {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+    QGuiApplication app(argc, argv);
+
+    const QString gifPath = argc > 1 ? QString::fromLocal8Bit(argv[1])
+                                     : QStringLiteral(DESKTOPPET_SOURCE_DIR "/resources/gif/spider.gif");
+    const int frames = argc > 2 ? std::max(100, std::atoi(argv[2])) : 2000;
+
+    QTemporaryDir dir;
+    const QString sheetPath = writeSpriteSheet(gifPath, dir.path());
+    if (sheetPath.isEmpty())
+    {
+        std::fprintf(stderr, "cannot decode %s\n", qPrintable(gifPath));
+        return 1;
+    }
+
+    auto begin = Clock::now();
+    const auto fromGif = AnimationCache::decode(gifPath, QSize());
+    const double gifDecodeUs = microsecondsSince(begin);
+    begin = Clock::now();
+    const auto fromSheet = AnimationCache::decode(sheetPath, QSize());
+    const double sheetDecodeUs = microsecondsSince(begin);
+    if (fromSheet->isEmpty() || fromSheet->frames.size() != fromGif->frames.size())
+    {
+        std::fprintf(stderr, "sprite sheet does not match %s\n", qPrintable(gifPath));
+        return 1;
+    }
+
+    const QSize frameSize = fromSheet->frames[0].size();
+    std::printf("%s: %d frames of %dx%d, %d frames drawn per path\n", qPrintable(gifPath), int(fromSheet->frames.size()),
+                frameSize.width(), frameSize.height(), frames);
+    std::printf("first use: decode GIF %.0f us, decode sprite sheet %.0f us\n\n", gifDecodeUs, sheetDecodeUs);
+
+    // 与宠物窗口一样略大于帧，帧居中
+    QImage canvas(frameSize + QSize(40, 40), QImage::Format_ARGB32_Premultiplied);
+    canvas.fill(Qt::transparent);
+    Result movie = runMovie(gifPath, canvas, frames);
+    canvas.fill(Qt::transparent);
+    Result sprite = runSprite(*fromSheet, canvas, frames);
+
+    report("QMovie", movie);
+    report("sprite", sprite);
+    return 0;
+}
@@ -0,0 +1,168 @@
+// 启动/退出基准：以 offscreen 平台反复启动主程序（--profile 模式，启动完成后自动退出），
+// 汇总每次运行的剖析结果，报告各阶段耗时的中位数和 p95
+// 用法：startup_benchmark [运行次数=20] [主程序路径] [--json 汇总结果路径]
+// 存档写入临时目录，第一次运行生成存档后不计入统计，之后每次都从存档启动
+#include <QCoreApplication>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMap>
+#include <QProcess>
+#include <QStringList>
+#include <QTemporaryDir>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+#ifndef DESKTOPPET_APP_PATH
+#define DESKTOPPET_APP_PATH ""
+#endif
+
+namespace
+{
+
+// 阶段名 -> 每次运行的耗时（毫秒）；标记点取其时间
+using Samples = QMap<QString, std::vector<double>>;
+
+double percentile(std::vector<double> values, double p)
+{
+    std::sort(values.begin(), values.end());
+    const size_t index = size_t(std::ceil(p * values.size())) - 1;
+    return values[std::min(index, values.size() - 1)];
+}
+
+// 运行一次主程序，返回各阶段耗时；失败时返回空
+QMap<QString, double> runOnce(const QString &app, const QString &dataDir, const QString &profilePath, double &wallMs)
+{
+    QProcessEnvironment env = QProcessEnvironment::systemEnvironment();
+    env.insert("QT_QPA_PLATFORM", "offscreen");
+    env.insert("DESKTOPPET_DATA_DIR", dataDir);
+    env.insert("QT_LOGGING_RULES", "*.debug=false");
+
+    QProcess process;
+    process.setProcessEnvironment(env);
+    process.setProcessChannelMode(QProcess::ForwardedErrorChannel);
+    process.setStandardOutputFile(QProcess::nullDevice());
+
+    QElapsedTimer timer;
+    timer.start();
+    process.start(app, {"--profile", profilePath});
+    if (!process.waitForFinished(60000) || process.exitStatus() != QProcess::NormalExit || process.exitCode() != 0)
+    {
+        std::fprintf(stderr, "主程序运行失败: %s\n", qPrintable(process.errorString()));
+        process.kill();
+        return {};
+    }
+    wallMs = timer.nsecsElapsed() / 1e6;
+
+    QFile file(profilePath);
+    if (!file.open(QIODevice::ReadOnly))
+    {
+        std::fprintf(stderr, "没有剖析结果: %s\n", qPrintable(profilePath));
+        return {};
+    }
+
+    // 同名区间（如多次解码）在一次运行内累加
+    QMap<QString, double> stages;
+    const QJsonArray entries = QJsonDocument::fromJson(file.readAll()).object()["entries"].toArray();
+    for (const QJsonValue &value : entries)
+    {
+        const QJsonObject entry = value.toObject();
+        const QString name = entry["name"].toString();
+        if (entry["mark"].toBool())
+        {
+            stages["@" + name] = entry["start_ms"].toDouble();
+        }
+        else
+        {
+            stages[name] += entry["duration_ms"].toDouble();
+        }
+    }
+    return stages;
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    QStringList args = app.arguments().mid(1);
+    QString jsonPath;
+    const int jsonIndex = args.indexOf("--json");
+    if (jsonIndex >= 0 && jsonIndex + 1 < args.size())
+    {
+        jsonPath = args[jsonIndex + 1];
+        args.erase(args.begin() + jsonIndex, args.begin() + jsonIndex + 2);
+    }
+    const int runs = args.size() > 0 ? std::max(1, args[0].toInt()) : 20;
+    const QString appPath = args.size() > 1 ? args[1] : QString(DESKTOPPET_APP_PATH);
+    if (appPath.isEmpty() || !QFile::exists(appPath))
+    {
+        std::fprintf(stderr, "找不到主程序: %s\n", qPrintable(appPath));
+        return 1;
+    }
+
+    QTemporaryDir dir;
+    if (!dir.isValid())
+    {
+        return 1;
+    }
+    const QString dataDir = dir.filePath("data");
+    QDir().mkpath(dataDir);
+
+    // 预热：第一次运行没有存档，只用来生成存档
+    double wallMs = 0;
+    if (runOnce(appPath, dataDir, dir.filePath("warmup.json"), wallMs).isEmpty())
+    {
+        return 1;
+    }
+
+    Samples samples;
+    for (int i = 0; i < runs; ++i)
+    {
+        const QMap<QString, double> stages = runOnce(appPath, dataDir, dir.filePath(QString("run%1.json").arg(i)), wallMs);
+        if (stages.isEmpty())
+        {
+            return 1;
+        }
+        for (auto it = stages.constBegin(); it != stages.constEnd(); ++it)
+        {
+            samples[it.key()].push_back(it.value());
+        }
+        samples["process"].push_back(wallMs);
+    }
+
+    // @开头的是时间点（距 main() 开始），其余是区间耗时
+    std::printf("%d 次运行（offscreen）\n", runs);
+    std::printf("%-40s %6s %10s %10s\n", "阶段", "次数", "中位数ms", "p95 ms");
+    QJsonArray summary;
+    for (auto it = samples.constBegin(); it != samples.constEnd(); ++it)
+    {
+        const double median = percentile(it.value(), 0.5);
+        const double p95 = percentile(it.value(), 0.95);
+        std::printf("%-40s %6zu %10.2f %10.2f\n", qPrintable(it.key()), it.value().size(), median, p95);
+
+        QJsonObject stage;
+        stage["name"] = it.key();
+        stage["runs"] = int(it.value().size());
+        stage["median_ms"] = median;
+        stage["p95_ms"] = p95;
+        summary.append(stage);
+    }
+
+    if (!jsonPath.isEmpty())
+    {
+        QFile file(jsonPath);
+        if (!file.open(QIODevice::WriteOnly) || file.write(QJsonDocument(summary).toJson()) < 0)
+        {
+            std::fprintf(stderr, "写入汇总结果失败: %s\n", qPrintable(jsonPath));
+            return 1;
+        }
+    }
+    return 0;
+}
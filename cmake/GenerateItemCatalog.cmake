@@ -0,0 +1,169 @@
+# 根据 collection_items.csv 生成编译期物品表 ItemCatalogData.h
+# 用法：cmake -DINPUT=<collection_items.csv> -DOUTPUT=<ItemCatalogData.h> -P GenerateItemCatalog.cmake
+#
+# CSV 每行：id,name,description,category,rarity,iconPath,detailImagePath,isHidden[,key]
+# 以 # 开头的行和空行忽略，id 不是数字的行视为标题行
+# 填写了 key 的物品额外生成强类型常量 Items::<key>
+# 字段数不对、id 重复、key 重复或 category/rarity 越界时直接报错，不生成半截的表
+
+cmake_minimum_required(VERSION 3.14)
+
+if(NOT INPUT OR NOT OUTPUT)
+    message(FATAL_ERROR "GenerateItemCatalog: 需要 -DINPUT=<csv> -DOUTPUT=<header>")
+endif()
+
+set(CATEGORY_NAMES Material Item Skin Achievement)
+set(RARITY_NAMES Common Rare Epic Legendary)
+
+# C 字符串字面量转义
+function(item_catalog_escape out text)
+    string(REPLACE "\\" "\\\\" text "${text}")
+    string(REPLACE "\"" "\\\"" text "${text}")
+    set(${out} "\"${text}\"" PARENT_SCOPE)
+endfunction()
+
+file(STRINGS "${INPUT}" LINES ENCODING UTF-8)
+
+set(ITEM_ROWS "")
+set(KEY_ROWS "")
+set(IDS "")
+set(KEYS "")
+set(MAX_ID 0)
+set(COUNT 0)
+set(LINE_NO 0)
+
+foreach(LINE IN LISTS LINES)
+    math(EXPR LINE_NO "${LINE_NO} + 1")
+    string(STRIP "${LINE}" LINE)
+    if(LINE STREQUAL "" OR LINE MATCHES "^#")
+        continue()
+    endif()
+
+    string(REPLACE "," ";" FIELDS "${LINE}")
+    list(LENGTH FIELDS FIELD_COUNT)
+    list(GET FIELDS 0 ID)
+    string(STRIP "${ID}" ID)
+    if(NOT ID MATCHES "^[0-9]+$")
+        continue()
+    endif()
+    if(FIELD_COUNT LESS 8 OR FIELD_COUNT GREATER 9)
+        message(FATAL_ERROR "${INPUT}:${LINE_NO}: 需要8或9个字段，实际 ${FIELD_COUNT} 个")
+    endif()
+    if(ID IN_LIST IDS)
+        message(FATAL_ERROR "${INPUT}:${LINE_NO}: 物品ID ${ID} 重复")
+    endif()
+    if(ID GREATER 32767)
+        message(FATAL_ERROR "${INPUT}:${LINE_NO}: 物品ID ${ID} 超出索引范围")
+    endif()
+    list(APPEND IDS ${ID})
+
+    list(GET FIELDS 1 NAME)
+    list(GET FIELDS 2 DESCRIPTION)
+    list(GET FIELDS 3 CATEGORY)
+    list(GET FIELDS 4 RARITY)
+    list(GET FIELDS 5 ICON)
+    list(GET FIELDS 6 DETAIL)
+    list(GET FIELDS 7 HIDDEN)
+    foreach(FIELD NAME DESCRIPTION CATEGORY RARITY ICON DETAIL HIDDEN)
+        string(STRIP "${${FIELD}}" ${FIELD})
+    endforeach()
+
+    if(NOT CATEGORY MATCHES "^[0-3]$" OR NOT RARITY MATCHES "^[0-3]$")
+        message(FATAL_ERROR "${INPUT}:${LINE_NO}: category/rarity 必须是0-3")
+    endif()
+    list(GET CATEGORY_NAMES ${CATEGORY} CATEGORY)
+    list(GET RARITY_NAMES ${RARITY} RARITY)
+    string(TOLOWER "${HIDDEN}" HIDDEN)
+    if(NOT HIDDEN STREQUAL "true")
+        set(HIDDEN false)
+    endif()
+
+    item_catalog_escape(NAME "${NAME}")
+    item_catalog_escape(DESCRIPTION "${DESCRIPTION}")
+    item_catalog_escape(ICON "${ICON}")
+    item_catalog_escape(DETAIL "${DETAIL}")
+    string(APPEND ITEM_ROWS
+        "    {ItemId(${ID}), ${NAME}, ${DESCRIPTION}, CollectionCategory::${CATEGORY}, CollectionRarity::${RARITY},\n"
+        "     ${ICON}, ${DETAIL}, ${HIDDEN}},\n")
+
+    if(FIELD_COUNT EQUAL 9)
+        list(GET FIELDS 8 KEY)
+        string(STRIP "${KEY}" KEY)
+        if(NOT KEY STREQUAL "")
+            if(NOT KEY MATCHES "^[A-Z][A-Z0-9_]*$")
+                message(FATAL_ERROR "${INPUT}:${LINE_NO}: key '${KEY}' 必须是大写的C++标识符")
+            endif()
+            if(KEY IN_LIST KEYS)
+                message(FATAL_ERROR "${INPUT}:${LINE_NO}: key ${KEY} 重复")
+            endif()
+            list(APPEND KEYS ${KEY})
+            string(APPEND KEY_ROWS "inline constexpr ItemId ${KEY}{${ID}};\n")
+        endif()
+    endif()
+
+    set(INDEX_OF_${ID} ${COUNT})
+    math(EXPR COUNT "${COUNT} + 1")
+    if(ID GREATER MAX_ID)
+        set(MAX_ID ${ID})
+    endif()
+endforeach()
+
+if(COUNT EQUAL 0)
+    message(FATAL_ERROR "${INPUT}: 没有任何物品")
+endif()
+
+# ID -> ITEMS 下标，-1 表示不存在；每行16个
+set(INDEX_ROWS "")
+set(ROW "   ")
+foreach(ID RANGE 0 ${MAX_ID})
+    if(DEFINED INDEX_OF_${ID})
+        string(APPEND ROW " ${INDEX_OF_${ID}},")
+    else()
+        string(APPEND ROW " -1,")
+    endif()
+    math(EXPR COLUMN "${ID} % 16")
+    if(COLUMN EQUAL 15)
+        string(APPEND INDEX_ROWS "${ROW}\n")
+        set(ROW "   ")
+    endif()
+endforeach()
+if(NOT ROW STREQUAL "   ")
+    string(APPEND INDEX_ROWS "${ROW}\n")
+endif()
+
+set(CONTENT "// 由 cmake/GenerateItemCatalog.cmake 根据 resources/csv/collection_items.csv 生成，请勿手动修改
+// 只能通过 common/ItemCatalog.h 包含
+#ifndef __ITEM_CATALOG_DATA_H__
+#define __ITEM_CATALOG_DATA_H__
+
+namespace item_catalog
+{
+
+inline constexpr ItemMeta ITEMS[] = {
+${ITEM_ROWS}};
+
+inline constexpr int COUNT = ${COUNT};
+inline constexpr int MAX_ID = ${MAX_ID};
+
+inline constexpr int16_t INDEX[MAX_ID + 1] = {
+${INDEX_ROWS}};
+
+} // namespace item_catalog
+
+namespace Items
+{
+
+${KEY_ROWS}
+} // namespace Items
+
+#endif
+")
+
+# 内容不变时不改写文件，避免触发全量重新编译
+if(EXISTS "${OUTPUT}")
+    file(READ "${OUTPUT}" OLD_CONTENT)
+    if(OLD_CONTENT STREQUAL CONTENT)
+        return()
+    endif()
+endif()
+file(WRITE "${OUTPUT}" "${CONTENT}")
@@ -1,6 +1,11 @@
 #include "PetApp.h"
 #include "../common/PropertyIds.h"
 #include "../view/ForgePanel.h"
+#include "../view/ImageLoader.h"
+#include "../view/AnimationCache.h"
+#include "../common/StartupProfiler.h"
+#include "../common/ItemCatalog.h"
+#include "../common/RandomService.h"
 #include <QObject>
 #include <QDebug>
 #include <QMetaObject>
@@ -27,6 +32,8 @@ PetApp::PetApp()
 
 bool PetApp::initialize()
 {
+    StartupProfiler::Scope profile("initialize");
+
     // Binding
     m_sp_pet_viewmodel->set_pet_model(m_sp_pet_model);
 
@@ -34,6 +41,7 @@ bool PetApp::initialize()
     m_main_wnd.set_position(m_sp_pet_viewmodel->get_position());
     m_main_wnd.set_animation(m_sp_pet_viewmodel->get_current_animation());
     m_main_wnd.set_size(m_sp_pet_viewmodel->get_size());
+    m_main_wnd.set_position_channel(m_sp_pet_viewmodel->get_position_channel());
 
     // Notification - 注册主窗口的通知回调
     m_sp_pet_viewmodel->get_trigger().add(m_main_wnd.get_notification(), &m_main_wnd);
@@ -41,18 +49,99 @@ bool PetApp::initialize()
     // Notification - 注册应用级别的通知回调
     m_sp_pet_viewmodel->get_trigger().add(&PetApp::app_notification_cb, this);
 
-    // 加载持久化数据
-    m_sp_pet_viewmodel->load_pet_data();
-
-    // Initialize model with default values if no saved data
+    // 先用默认形象显示宠物，存档在后台解析，各模型加载完成后通过通知刷新界面
     m_sp_pet_model->change_animation(":/resources/gif/spider.gif");
 
+    // 启动加载流水线（图鉴配置、存档、配方表并发解析，之后按依赖顺序恢复各模型）
+    m_sp_pet_viewmodel->start_loading();
+
+    // 宠物数据加载后恢复默认形象；仍在打工时之后的打工阶段会切换到工作形态
+    m_sp_pet_viewmodel->when_ready(PetViewModel::STAGE_PET, [this]() {
+        m_sp_pet_model->change_animation(":/resources/gif/spider.gif");
+    });
+
     // Update UI
     m_main_wnd.update_ui();
 
     return true;
 }
 
+void PetApp::show_swarm(int count)
+{
+    if (count <= 0)
+    {
+        return;
+    }
+
+    if (!m_swarm)
+    {
+        // 与主宠物共用同一份屏幕信息和宠物大小
+        m_swarm = std::make_unique<PetSwarm>(RandomService::GetInstance().stream(RandomStream::Movement).next());
+        m_swarm->setPetSize(*m_sp_pet_viewmodel->get_size());
+        sync_swarm_screens();
+
+        QVector<QRect> icons;
+        for (const DesktopIconInfo &icon : createDefaultObstacleProvider()->enumerate())
+        {
+            icons.append(icon.isVisible ? icon.rect : QRect());
+        }
+        m_swarm->setObstacles(icons);
+
+        m_swarm_wnd = std::make_unique<PetSwarmWindow>(*m_swarm);
+        m_swarm_wnd->set_animations(":/resources/gif/spider.gif", ":/resources/gif/kicking.gif");
+
+        // 屏幕增删或分辨率变化后，宠物回到仍然存在的屏幕上，覆盖层重新覆盖整个桌面
+        QObject::connect(m_sp_pet_viewmodel->getAutoMovementModel(), &AutoMovementModel::screenTopologyChanged,
+                         m_swarm_wnd.get(), [this]()
+                         { sync_swarm_screens(); });
+    }
+
+    m_swarm->spawnRandom(count);
+    m_swarm_wnd->start();
+    qDebug() << "Swarm started with" << m_swarm->size() << "pets";
+}
+
+void PetApp::sync_swarm_screens()
+{
+    if (!m_swarm)
+    {
+        return;
+    }
+
+    QVector<ScreenInfo> screens;
+    const ScreenTopology &topology = m_sp_pet_viewmodel->getAutoMovementModel()->getScreenTopology();
+    for (int i = 0; i < topology.count(); ++i)
+    {
+        screens.append(topology.screen(i));
+    }
+    m_swarm->setScreens(screens);
+    if (m_swarm_wnd)
+    {
+        m_swarm_wnd->update_screens();
+    }
+}
+
+void PetApp::shutdown()
+{
+    if (m_shut_down || !m_sp_pet_viewmodel)
+    {
+        return;
+    }
+    m_shut_down = true;
+
+    if (m_swarm_wnd)
+    {
+        m_swarm_wnd->stop();
+    }
+
+    StartupProfiler::Scope profile("shutdown");
+    m_sp_pet_viewmodel->stop_autosave();
+
+    // 停止后台解码，缓存的 QPixmap 要在 QApplication 析构之前释放
+    ImageLoader::GetInstance().shutdown();
+    AnimationCache::GetInstance().clear();
+}
+
 void PetApp::app_notification_cb(uint32_t id, void *p)
 {
     PetApp *pThis = static_cast<PetApp *>(p);
@@ -60,22 +149,22 @@ void PetApp::app_notification_cb(uint32_t id, void *p)
     switch (id)
     {
     case PROP_ID_SHOW_STATS_PANEL:
-        pThis->show_stats_panel();
+        pThis->m_sp_pet_viewmodel->when_ready(PetViewModel::STAGE_PET, [pThis]() { pThis->show_stats_panel(); });
         break;
     case PROP_ID_SHOW_BACKPACK_PANEL:
-        pThis->show_backpack_panel();
+        pThis->m_sp_pet_viewmodel->when_ready(PetViewModel::STAGE_BACKPACK, [pThis]() { pThis->show_backpack_panel(); });
         break;
     case PROP_ID_SHOW_COLLECTION_PANEL:
-        pThis->show_collection_panel();
+        pThis->m_sp_pet_viewmodel->when_ready(PetViewModel::STAGE_COLLECTION, [pThis]() { pThis->show_collection_panel(); });
         break;
     case PROP_ID_SHOW_WORK_PANEL:
-        pThis->show_work_panel();
+        pThis->m_sp_pet_viewmodel->when_ready(PetViewModel::STAGE_WORK, [pThis]() { pThis->show_work_panel(); });
         break;
     case PROP_ID_SHOW_FORGE_PANEL:
-        pThis->show_forge_panel();
+        pThis->m_sp_pet_viewmodel->when_ready(PetViewModel::STAGE_FORGE, [pThis]() { pThis->show_forge_panel(); });
         break;
     case PROP_ID_SHOW_WORK_UPGRADE_PANEL:  // 添加工作升级面板处理
-        pThis->show_work_upgrade_panel();
+        pThis->m_sp_pet_viewmodel->when_ready(PetViewModel::STAGE_WORK, [pThis]() { pThis->show_work_upgrade_panel(); });
         break;
     case PROP_ID_BACKPACK_UPDATE:
         // 当背包数据更新时，更新背包面板数据
@@ -117,18 +206,7 @@ void PetApp::app_notification_cb(uint32_t id, void *p)
         // 如果数值面板存在，更新其数据
         if (pThis->m_stats_panel)
         {
-            pThis->m_stats_panel->set_level(pThis->m_sp_pet_viewmodel->get_level());
-            pThis->m_stats_panel->set_experience(pThis->m_sp_pet_viewmodel->get_experience());
-            pThis->m_stats_panel->set_experience_to_next_level(pThis->m_sp_pet_viewmodel->get_experience_to_next_level());
-            pThis->m_stats_panel->set_money(pThis->m_sp_pet_viewmodel->get_money());
-
-            const QString *name = pThis->m_sp_pet_viewmodel->get_name();
-            if (name)
-            {
-                pThis->m_stats_panel->set_name(*name);
-            }
-
-            pThis->m_stats_panel->update_display();
+            pThis->update_stats_panel();
         }
         break;
     default:
@@ -136,6 +214,23 @@ void PetApp::app_notification_cb(uint32_t id, void *p)
     }
 }
 
+void PetApp::update_stats_panel()
+{
+    // 同一个快照中的等级、经验和金钱互相一致
+    const PetInfoSnapshot info = m_sp_pet_viewmodel->get_pet_snapshot();
+    if (!info)
+    {
+        return;
+    }
+
+    m_stats_panel->set_level(info->level);
+    m_stats_panel->set_experience(info->experience);
+    m_stats_panel->set_experience_to_next_level(info->experienceToNextLevel);
+    m_stats_panel->set_money(info->money);
+    m_stats_panel->set_name(info->name);
+    m_stats_panel->update_display();
+}
+
 void PetApp::show_stats_panel()
 {
     // 如果面板已经存在，直接显示
@@ -151,19 +246,7 @@ void PetApp::show_stats_panel()
     m_stats_panel = new PetStatsPanel(m_sp_pet_viewmodel->get_command_manager());
 
     // 设置面板的初始数据
-    m_stats_panel->set_level(m_sp_pet_viewmodel->get_level());
-    m_stats_panel->set_experience(m_sp_pet_viewmodel->get_experience());
-    m_stats_panel->set_experience_to_next_level(m_sp_pet_viewmodel->get_experience_to_next_level());
-    m_stats_panel->set_money(m_sp_pet_viewmodel->get_money());
-
-    const QString *name = m_sp_pet_viewmodel->get_name();
-    if (name)
-    {
-        m_stats_panel->set_name(*name);
-    }
-
-    // 更新显示
-    m_stats_panel->update_display();
+    update_stats_panel();
 
     // 重要：为数值面板注册通知回调（改进：避免重复注册）
     uintptr_t cookie = m_sp_pet_viewmodel->get_trigger().add(m_stats_panel->get_notification(), m_stats_panel);
@@ -370,7 +453,7 @@ PetApp* PetApp::getInstance()
 
 void PetApp::showWorkUpgradePanel()
 {
-    show_work_upgrade_panel();
+    m_sp_pet_viewmodel->when_ready(PetViewModel::STAGE_WORK, [this]() { show_work_upgrade_panel(); });
 }
 
 void PetApp::updateBackpackPanelData()
@@ -386,63 +469,39 @@ void PetApp::updateBackpackPanelData()
     // 更新背包面板的数据（不立即刷新显示）
     m_backpack_panel->updateBackpackData(backpackItems);
 
-    // 批量更新物品显示信息
+    // 批量更新物品显示信息：配置中的物品直接读编译期物品表，运行时新增的物品才查图鉴模型
     auto collectionModel = m_sp_pet_viewmodel->get_collection_model();
-    if (collectionModel)
+    for (const auto &item : backpackItems)
     {
-        for (const auto &item : backpackItems)
+        ItemDisplayInfo displayInfo;
+        if (const ItemMeta *meta = item_catalog::find(item.itemId))
+        {
+            displayInfo.name = QString::fromUtf8(meta->name);
+            displayInfo.iconPath = QString::fromUtf8(meta->iconPath);
+            displayInfo.description = QString::fromUtf8(meta->description);
+            displayInfo.category = QString::fromUtf8(item_catalog::categoryName(meta->category));
+            displayInfo.rarity = QString::fromUtf8(item_catalog::rarityName(meta->rarity));
+        }
+        else if (collectionModel)
         {
             CollectionItemInfo itemInfo = collectionModel->getItemInfo(item.itemId);
-            if (itemInfo.id != 0)
+            if (itemInfo.id == 0)
             {
-                ItemDisplayInfo displayInfo;
-                displayInfo.name = itemInfo.name;
-                displayInfo.iconPath = itemInfo.iconPath;
-                displayInfo.description = itemInfo.description;
-
-                // 转换类别和稀有度为中文
-                switch (static_cast<CollectionCategory>(itemInfo.category))
-                {
-                case CollectionCategory::Material:
-                    displayInfo.category = "材料";
-                    break;
-                case CollectionCategory::Item:
-                    displayInfo.category = "物品";
-                    break;
-                case CollectionCategory::Skin:
-                    displayInfo.category = "皮肤";
-                    break;
-                case CollectionCategory::Achievement:
-                    displayInfo.category = "成就";
-                    break;
-                default:
-                    displayInfo.category = "未知";
-                    break;
-                }
-
-                switch (static_cast<CollectionRarity>(itemInfo.rarity))
-                {
-                case CollectionRarity::Common:
-                    displayInfo.rarity = "普通";
-                    break;
-                case CollectionRarity::Rare:
-                    displayInfo.rarity = "稀有";
-                    break;
-                case CollectionRarity::Epic:
-                    displayInfo.rarity = "史诗";
-                    break;
-                case CollectionRarity::Legendary:
-                    displayInfo.rarity = "传说";
-                    break;
-                default:
-                    displayInfo.rarity = "未知";
-                    break;
-                }
-
-                // 只更新数据，不立即刷新显示
-                m_backpack_panel->updateItemDisplayInfo(item.itemId, displayInfo);
+                continue;
             }
+            displayInfo.name = itemInfo.name;
+            displayInfo.iconPath = itemInfo.iconPath;
+            displayInfo.description = itemInfo.description;
+            displayInfo.category = QString::fromUtf8(item_catalog::categoryName(itemInfo.category));
+            displayInfo.rarity = QString::fromUtf8(item_catalog::rarityName(itemInfo.rarity));
+        }
+        else
+        {
+            continue;
         }
+
+        // 只更新数据，不立即刷新显示
+        m_backpack_panel->updateItemDisplayInfo(item.itemId, displayInfo);
     }
 
     // 所有数据更新完毕后，统一刷新显示
@@ -506,13 +565,13 @@ void PetApp::updateWorkPanelData()
     // 更新工作面板的工作类型数据
     m_work_panel->updateWorkTypes(workTypes);
 
-    // 获取当前工作状态
+    // 获取当前工作状态（进度由面板根据截止时间自行刷新）
     WorkStatus status = m_sp_pet_viewmodel->get_current_work_status();
     WorkType currentType = m_sp_pet_viewmodel->get_current_work_type();
-    int remainingTime = m_sp_pet_viewmodel->get_work_remaining_time();
+    QDeadlineTimer deadline = m_sp_pet_viewmodel->get_work_deadline();
 
     // 构建工作状态信息
-    WorkStatusInfo statusInfo(status, currentType, remainingTime, "");
+    WorkStatusInfo statusInfo(status, currentType, deadline, "");
     
     // 更新工作面板的状态信息
     m_work_panel->updateWorkStatus(statusInfo);
@@ -635,47 +694,20 @@ void PetApp::updateForgePanelData()
         auto backpackModel = m_sp_pet_viewmodel->get_backpack_model();
         qDebug() << "PetApp::updateForgePanelData: 获取到背包模型";
         
-        // 获取材料物品的数量和名称
-        // 阳光材料 (ID 6-10)
-        QStringList sunshineNames = {"微光阳光", "温暖阳光", "炽热阳光", "灿烂阳光", "神圣阳光"};
-        for (int i = 0; i < 5; ++i)
-        {
-            int itemId = 6 + i;
-            int count = backpackModel->getItemCount(itemId);
-            QString name = backpackModel->getItemName(itemId);
-            
-            info.materialCounts[itemId] = count;
-            info.materialNames[itemId] = name.isEmpty() ? sunshineNames[i] : name;
-            
-            qDebug() << "PetApp::updateForgePanelData: 阳光材料" << itemId << "名称:" << info.materialNames[itemId] << "数量:" << count;
-        }
-        
-        // 矿石材料 (ID 11-15)
-        QStringList mineralNames = {"粗糙矿石", "普通矿石", "优质矿石", "稀有矿石", "传说矿石"};
-        for (int i = 0; i < 5; ++i)
-        {
-            int itemId = 11 + i;
-            int count = backpackModel->getItemCount(itemId);
-            QString name = backpackModel->getItemName(itemId);
-            
-            info.materialCounts[itemId] = count;
-            info.materialNames[itemId] = name.isEmpty() ? mineralNames[i] : name;
-            
-            qDebug() << "PetApp::updateForgePanelData: 矿石材料" << itemId << "名称:" << info.materialNames[itemId] << "数量:" << count;
-        }
-        
-        // 木材材料 (ID 16-20)
-        QStringList woodNames = {"枯木", "普通木材", "优质木材", "稀有木材", "神木"};
-        for (int i = 0; i < 5; ++i)
+        // 获取材料物品的数量和名称：阳光(6-10)、矿石(11-15)、木材(16-20)，名称来自编译期物品表
+        static constexpr ItemId FORGE_MATERIALS[] = {
+            Items::SUNSHINE_WEAK, Items::SUNSHINE_WARM, Items::SUNSHINE_HOT, Items::SUNSHINE_BRILLIANT, Items::SUNSHINE_SACRED,
+            Items::MINERAL_ROUGH, Items::MINERAL_COMMON, Items::MINERAL_FINE, Items::MINERAL_RARE, Items::MINERAL_LEGENDARY,
+            Items::WOOD_DEAD, Items::WOOD_COMMON, Items::WOOD_FINE, Items::WOOD_RARE, Items::WOOD_DIVINE,
+        };
+        for (ItemId itemId : FORGE_MATERIALS)
         {
-            int itemId = 16 + i;
             int count = backpackModel->getItemCount(itemId);
-            QString name = backpackModel->getItemName(itemId);
-            
+
             info.materialCounts[itemId] = count;
-            info.materialNames[itemId] = name.isEmpty() ? woodNames[i] : name;
-            
-            qDebug() << "PetApp::updateForgePanelData: 木材材料" << itemId << "名称:" << info.materialNames[itemId] << "数量:" << count;
+            info.materialNames[itemId] = QString::fromUtf8(item_catalog::find(itemId)->name);
+
+            qDebug() << "PetApp::updateForgePanelData: 材料" << int(itemId) << "名称:" << info.materialNames[itemId] << "数量:" << count;
         }
         
         qDebug() << "PetApp::updateForgePanelData: 总共准备了" << info.materialCounts.size() << "种材料数据";
@@ -9,6 +9,9 @@
 #include "../view/WorkPanel.h"
 #include "../view/ForgePanel.h"
 #include "../view/WorkUpgradePanel.h" // 添加工作升级面板
+#include "../view/PetSwarmWindow.h"
+#include "../model/PetSwarm.h"
+#include <functional>
 #include <memory>
 
 class PetApp
@@ -18,32 +21,42 @@ public:
     PetApp(const PetApp &) = delete;
     ~PetApp() noexcept
     {
-        // 在应用程序关闭时保存数据 - 通过ViewModel保存
-        if (m_sp_pet_viewmodel)
-        {
-            m_sp_pet_viewmodel->save_pet_data();
-            // 通过ViewModel保存其他数据
-            auto backpackModel = m_sp_pet_viewmodel->get_backpack_model();
-            if (backpackModel)
-            {
-                backpackModel->saveToFile("backpack_data.json");
-            }
-            auto collectionModel = m_sp_pet_viewmodel->get_collection_model();
-            if (collectionModel)
-            {
-                collectionModel->saveToFile("collection_data.json");
-            }
-        }
+        shutdown();
     }
 
     PetApp &operator=(const PetApp &) = delete;
 
     bool initialize();
 
+    // 保存剩余的修改并停止自动存档，只执行一次（析构时也会调用）
+    void shutdown();
+
+    // 启动流水线全部完成后调用 callback
+    void when_loaded(std::function<void()> callback)
+    {
+        m_sp_pet_viewmodel->when_ready(PetViewModel::STAGE_AUTOSAVE, std::move(callback));
+    }
+
     void show_main_window()
     {
         m_main_wnd.show();
     }
+
+    // 压力/演示模式：在主宠物之外再显示 count 只自动走动的宠物，共用一个模拟帧节拍
+    void show_swarm(int count);
+
+    // 调试用：JSON存档导出/导入（需在 initialize() 之后调用，会等待数据加载完成）
+    bool export_save_json(const QString &path)
+    {
+        m_sp_pet_viewmodel->wait_until_loaded();
+        return m_sp_pet_viewmodel->export_save_json(path);
+    }
+
+    bool import_save_json(const QString &path)
+    {
+        m_sp_pet_viewmodel->wait_until_loaded();
+        return m_sp_pet_viewmodel->import_save_json(path);
+    }
     
     // 静态方法用于获取实例和显示面板
     static PetApp* getInstance();
@@ -54,11 +67,13 @@ private:
     static void app_notification_cb(uint32_t id, void *p);
 
     void show_stats_panel();
+    void update_stats_panel(); // 用宠物快照刷新数值面板
     void show_backpack_panel();
     void show_collection_panel();
     void show_work_panel();
     void show_forge_panel();
     void show_work_upgrade_panel();  // 添加显示工作升级面板方法
+    void sync_swarm_screens(); // 群体宠物和覆盖层跟随自动移动维护的屏幕信息
     
     // 数据更新方法 - 用于向解耦的View层传递数据
     void updateBackpackPanelData();
@@ -77,6 +92,9 @@ private:
     WorkPanel *m_work_panel;
     ForgePanel *m_forge_panel; // 添加锻造面板成员
     WorkUpgradePanel *m_work_upgrade_panel; // 添加工作升级面板成员
+    std::unique_ptr<PetSwarm> m_swarm;                // 额外的宠物（按需创建）
+    std::unique_ptr<PetSwarmWindow> m_swarm_wnd;
+    bool m_shut_down = false;
 };
 
 #endif
@@ -1,22 +1,72 @@
 #include "PetApp.h"
+#include "../common/StartupProfiler.h"
 #include <QApplication>
+#include <QCommandLineParser>
 #include <QDebug>
 #include <QImageReader>
-#include <io.h>
+#include <QTimer>
 #include <fcntl.h>
 #include <iostream>
 
 #ifdef _WIN32
+#include <io.h>
 #include <Windows.h>
 #endif
 
 // 声明外部静态变量
 extern PetApp* s_appInstance;
 
+// 剖析模式：首帧已显示且数据加载完成后退出
+static void quit_when_started(QApplication &app)
+{
+    if (!StartupProfiler::instance().hasMark("first_frame"))
+    {
+        QTimer::singleShot(10, &app, [&app]() { quit_when_started(app); });
+        return;
+    }
+    app.quit();
+}
+
 int main(int argc, char *argv[])
 {
+    // 剖析时间从这里开始计算；DESKTOPPET_PROFILE 在整个会话结束时写出剖析结果
+    StartupProfiler &profiler = StartupProfiler::instance();
+    QString profilePath = qEnvironmentVariable("DESKTOPPET_PROFILE");
+    if (!profilePath.isEmpty())
+    {
+        profiler.enable();
+    }
+
+    double stageStart = profiler.elapsedMs();
     QApplication app(argc, argv);
+    profiler.record("qapplication", stageStart, profiler.elapsedMs() - stageStart);
+
+    // 调试用的存档导入/导出：--export-save 导出后直接退出，--import-save 导入后正常启动
+    // --profile：启动完成（首帧显示且数据加载完成）后立即退出，把启动和退出各阶段耗时写成JSON
+    // --pets N / --stress：额外显示 N 只（压力模式为100只）自动走动的宠物，日志中定期输出模拟耗时
+    QCommandLineParser parser;
+    QCommandLineOption exportOption("export-save", "把当前存档导出为JSON快照", "path");
+    QCommandLineOption importOption("import-save", "从JSON快照导入存档", "path");
+    QCommandLineOption profileOption("profile", "剖析启动和退出耗时，启动完成后退出并写出JSON", "path");
+    parser.addOption(exportOption);
+    parser.addOption(importOption);
+    QCommandLineOption petsOption("pets", "额外显示N只自动走动的宠物", "count");
+    QCommandLineOption stressOption("stress", "压力模式：额外显示100只宠物");
+    parser.addOption(profileOption);
+    parser.addOption(petsOption);
+    parser.addOption(stressOption);
+    parser.process(app);
+
+    const bool profileStartup = parser.isSet(profileOption);
+    if (profileStartup)
+    {
+        profilePath = parser.value(profileOption);
+        profiler.enable();
+    }
+
+    stageStart = profiler.elapsedMs();
     PetApp petApp;
+    profiler.record("construct", stageStart, profiler.elapsedMs() - stageStart);
     
     // 设置全局实例指针
     s_appInstance = &petApp;
@@ -26,12 +76,41 @@ int main(int argc, char *argv[])
         return 1;
     }
 
+    if (parser.isSet(importOption) && !petApp.import_save_json(parser.value(importOption)))
+    {
+        qWarning() << "导入存档失败:" << parser.value(importOption);
+    }
+    if (parser.isSet(exportOption))
+    {
+        s_appInstance = nullptr;
+        return petApp.export_save_json(parser.value(exportOption)) ? 0 : 1;
+    }
+
     petApp.show_main_window();
 
+    const int swarmSize = parser.isSet(stressOption) ? 100 : parser.value(petsOption).toInt();
+    if (swarmSize > 0)
+    {
+        petApp.show_swarm(swarmSize);
+    }
+
+    if (profileStartup)
+    {
+        petApp.when_loaded([&app]() { quit_when_started(app); });
+    }
+
     int result = app.exec();
+
+    // 在剖析结果中包含退出时的保存
+    petApp.shutdown();
+    profiler.mark("exit");
+    if (profiler.isEnabled() && !profiler.writeJson(profilePath))
+    {
+        qWarning() << "写入剖析结果失败:" << profilePath;
+    }
     
     // 清理全局实例指针
     s_appInstance = nullptr;
     
     return result;
-}
\ No newline at end of file
+}
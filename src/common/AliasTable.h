@@ -0,0 +1,143 @@
+#ifndef __ALIAS_TABLE_H__
+#define __ALIAS_TABLE_H__
+
+#include "RandomEngine.h"
+#include <cstdint>
+#include <vector>
+
+// Walker/Vose 别名表：O(n) 构建，O(1) 按权重抽样
+// 每次抽样只消耗一个64位随机数：高32位选槽位，低32位决定取本槽还是别名
+class AliasTable
+{
+public:
+    AliasTable() = default;
+
+    explicit AliasTable(const std::vector<double> &weights)
+    {
+        build(weights);
+    }
+
+    // 按权重构建，负数权重视为0；总权重为0时表为空
+    void build(const std::vector<double> &weights)
+    {
+        const size_t n = weights.size();
+        m_threshold.assign(n, 0);
+        m_alias.assign(n, 0);
+
+        double total = 0.0;
+        for (double w : weights)
+        {
+            total += w > 0.0 ? w : 0.0;
+        }
+        if (n == 0 || total <= 0.0)
+        {
+            m_threshold.clear();
+            m_alias.clear();
+            return;
+        }
+
+        // 把权重缩放到平均值为1，拆分为小于1和不小于1两组
+        std::vector<double> scaled(n);
+        std::vector<uint32_t> small;
+        std::vector<uint32_t> large;
+        small.reserve(n);
+        large.reserve(n);
+        for (size_t i = 0; i < n; ++i)
+        {
+            scaled[i] = (weights[i] > 0.0 ? weights[i] : 0.0) * double(n) / total;
+            (scaled[i] < 1.0 ? small : large).push_back(uint32_t(i));
+        }
+
+        while (!small.empty() && !large.empty())
+        {
+            const uint32_t s = small.back();
+            small.pop_back();
+            const uint32_t l = large.back();
+
+            m_threshold[s] = toThreshold(scaled[s]);
+            m_alias[s] = l;
+
+            scaled[l] = (scaled[l] + scaled[s]) - 1.0;
+            if (scaled[l] < 1.0)
+            {
+                large.pop_back();
+                small.push_back(l);
+            }
+        }
+
+        // 剩余槽位由浮点误差造成，概率视为1
+        for (uint32_t i : large)
+        {
+            m_threshold[i] = FULL;
+            m_alias[i] = i;
+        }
+        for (uint32_t i : small)
+        {
+            m_threshold[i] = FULL;
+            m_alias[i] = i;
+        }
+    }
+
+    bool isEmpty() const noexcept
+    {
+        return m_threshold.empty();
+    }
+
+    size_t size() const noexcept
+    {
+        return m_threshold.size();
+    }
+
+    // 抽取一个下标，表为空时返回0
+    uint32_t sample(RandomEngine &rng) const noexcept
+    {
+        if (m_threshold.empty())
+        {
+            return 0;
+        }
+        const uint64_t r = rng.next();
+        const uint32_t slot = uint32_t(((r >> 32) * uint64_t(m_threshold.size())) >> 32);
+        const uint32_t coin = uint32_t(r);
+        return coin < m_threshold[slot] ? slot : m_alias[slot];
+    }
+
+    // 槽位i被直接选中的概率（用于测试和调试）
+    double probability(uint32_t index) const noexcept
+    {
+        const size_t n = m_threshold.size();
+        if (index >= n)
+        {
+            return 0.0;
+        }
+        double p = double(m_threshold[index]) / double(FULL);
+        for (size_t i = 0; i < n; ++i)
+        {
+            if (m_alias[i] == index && i != index)
+            {
+                p += 1.0 - double(m_threshold[i]) / double(FULL);
+            }
+        }
+        return p / double(n);
+    }
+
+private:
+    static constexpr uint64_t FULL = uint64_t(1) << 32;
+
+    static uint64_t toThreshold(double p) noexcept
+    {
+        if (p <= 0.0)
+        {
+            return 0;
+        }
+        if (p >= 1.0)
+        {
+            return FULL;
+        }
+        return uint64_t(p * double(FULL));
+    }
+
+    std::vector<uint64_t> m_threshold; // 命中本槽位的阈值，按2^32缩放
+    std::vector<uint32_t> m_alias;     // 未命中时取的别名下标
+};
+
+#endif
@@ -0,0 +1,158 @@
+#include "AutoSaver.h"
+#include "SaveGame.h"
+#include "StartupProfiler.h"
+#include <QDebug>
+
+AutoSaver::~AutoSaver()
+{
+    // 析构时模型可能已经销毁，不再采集，只把已提交的快照写完
+    stopThread();
+}
+
+void AutoSaver::start(const QString &path, Collector collector, int intervalMs)
+{
+    if (isRunning())
+    {
+        return;
+    }
+
+    m_path = path;
+    m_collector = std::move(collector);
+    m_stopping = false;
+
+    // 先完整采集一次，之后只替换有修改的分区；启动时写一次，旧存档随之迁移到当前格式
+    submit(m_collector(false));
+    m_thread = std::thread(&AutoSaver::run, this);
+
+    m_timer.setInterval(intervalMs);
+    QObject::connect(&m_timer, &QTimer::timeout, [this]() { tick(); });
+    m_timer.start();
+
+    qDebug() << "自动存档已启动，间隔" << intervalMs << "毫秒:" << m_path;
+}
+
+void AutoSaver::stop()
+{
+    if (!isRunning())
+    {
+        return;
+    }
+
+    m_timer.stop();
+    QObject::disconnect(&m_timer, nullptr, nullptr, nullptr);
+    tick();
+    stopThread();
+    qDebug() << "自动存档已停止，共写入" << m_writeCount.load() << "次";
+}
+
+void AutoSaver::setInterval(int intervalMs)
+{
+    m_timer.setInterval(intervalMs);
+}
+
+void AutoSaver::saveNow()
+{
+    if (isRunning())
+    {
+        submit(m_collector(false));
+    }
+}
+
+void AutoSaver::flush()
+{
+    if (!isRunning())
+    {
+        return;
+    }
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_idle.wait(lock, [this]() { return !m_pending && !m_writing; });
+}
+
+int AutoSaver::intervalFromEnvironment()
+{
+    bool ok = false;
+    const int seconds = qEnvironmentVariableIntValue("DESKTOPPET_AUTOSAVE_INTERVAL", &ok);
+    return ok && seconds > 0 ? seconds * 1000 : DEFAULT_INTERVAL_MS;
+}
+
+void AutoSaver::tick()
+{
+    Sections sections = m_collector(true);
+    if (!sections.empty())
+    {
+        submit(std::move(sections));
+    }
+}
+
+void AutoSaver::submit(Sections sections)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (auto &section : sections)
+        {
+            m_sections[section.first] = std::move(section.second);
+        }
+        m_pending = true;
+        ++m_submittedGeneration;
+    }
+    m_wake.notify_one();
+}
+
+void AutoSaver::run()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true)
+    {
+        m_wake.wait(lock, [this]() { return m_pending || m_stopping; });
+        if (!m_pending)
+        {
+            break;
+        }
+
+        // 复制写入函数只复制快照的引用，编码和写盘都在锁外进行
+        const Sections sections = m_sections;
+        const quint64 generation = m_submittedGeneration;
+        m_pending = false;
+        m_writing = true;
+        lock.unlock();
+
+        StartupProfiler::Scope profile("save:autosave");
+        BinaryWriter out;
+        for (const auto &section : sections)
+        {
+            out.beginMessage(section.first);
+            section.second(out);
+            out.endMessage();
+        }
+        const std::string data = out.finish(SaveGame::CURRENT_VERSION);
+        if (!SaveGame::writeFileAtomically(m_path, QByteArray(data.data(), static_cast<int>(data.size()))))
+        {
+            qWarning() << "自动存档写入失败:" << m_path;
+        }
+        else
+        {
+            ++m_writeCount;
+            m_writtenGeneration = generation;
+        }
+
+        lock.lock();
+        m_writing = false;
+        m_idle.notify_all();
+    }
+    m_idle.notify_all();
+}
+
+void AutoSaver::stopThread()
+{
+    if (!m_thread.joinable())
+    {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_wake.notify_one();
+    m_thread.join();
+}
@@ -0,0 +1,104 @@
+#ifndef __AUTO_SAVER_H__
+#define __AUTO_SAVER_H__
+
+#include "BinaryCodec.h"
+#include <QString>
+#include <QTimer>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <thread>
+
+// 后台自动存档
+// GUI线程：定时检查各模型的脏标记，只为有修改的分区采集快照（Qt容器写时复制，采集只增加引用计数）
+// 存档线程：把每个分区最近一次的快照编码成二进制存档并原子写入
+// 写入期间到来的多次提交只保留最新的一份，连续的修改合并成一次写盘
+class AutoSaver
+{
+public:
+    // 把一个分区写入存档的函数，按值持有该分区的快照，会在存档线程中调用
+    using SectionWriter = std::function<void(BinaryWriter &)>;
+
+    // 分区字段号 -> 写入函数
+    using Sections = std::map<uint32_t, SectionWriter>;
+
+    // 在GUI线程采集分区快照；dirtyOnly 为 true 时只采集有修改的分区
+    using Collector = std::function<Sections(bool dirtyOnly)>;
+
+    static constexpr int DEFAULT_INTERVAL_MS = 30000;
+
+    AutoSaver() = default;
+    AutoSaver(const AutoSaver &) = delete;
+    ~AutoSaver();
+
+    AutoSaver &operator=(const AutoSaver &) = delete;
+
+    // 采集全部分区并启动存档线程，之后每隔 intervalMs 检查一次修改
+    void start(const QString &path, Collector collector, int intervalMs = intervalFromEnvironment());
+
+    // 保存剩余的修改，等待写盘完成后结束存档线程
+    void stop();
+
+    bool isRunning() const noexcept
+    {
+        return m_thread.joinable();
+    }
+
+    void setInterval(int intervalMs);
+    int interval() const noexcept
+    {
+        return m_timer.interval();
+    }
+
+    // 立即采集全部分区并交给存档线程，不等待写盘
+    void saveNow();
+
+    // 等待已提交的快照全部写盘
+    void flush();
+
+    // 成功写盘的次数
+    quint64 writeCount() const noexcept
+    {
+        return m_writeCount.load();
+    }
+
+    // 每次提交快照得到一个递增的代号；已写盘的代号之前提交的快照都已落盘
+    quint64 submittedGeneration() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_submittedGeneration;
+    }
+    quint64 writtenGeneration() const noexcept
+    {
+        return m_writtenGeneration.load();
+    }
+
+    // 存档间隔：DESKTOPPET_AUTOSAVE_INTERVAL 环境变量（秒），未设置时使用默认值
+    static int intervalFromEnvironment();
+
+private:
+    void tick();
+    void submit(Sections sections);
+    void run();
+    void stopThread();
+
+    QString m_path;
+    Collector m_collector;
+    QTimer m_timer;
+
+    std::thread m_thread;
+    mutable std::mutex m_mutex;
+    std::condition_variable m_wake; // 通知存档线程有新的快照
+    std::condition_variable m_idle; // 通知 flush() 写盘完成
+    Sections m_sections;            // 每个分区最近一次的快照
+    bool m_pending = false;         // 有尚未写盘的快照
+    bool m_writing = false;
+    bool m_stopping = false;
+    quint64 m_submittedGeneration = 0;
+    std::atomic<quint64> m_writeCount{0};
+    std::atomic<quint64> m_writtenGeneration{0};
+};
+
+#endif
@@ -0,0 +1,532 @@
+#ifndef __BINARY_CODEC_H__
+#define __BINARY_CODEC_H__
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// 紧凑二进制存档编码
+//
+// 文件布局：
+//   "DPSB" | varint 编码版本 | varint 数据结构版本 | varint 字符串数 | (varint 长度, UTF-8)... | 消息体
+//
+// 消息体是一串字段，每个字段以 varint(字段号 << 3 | 线型) 开头：
+//   Varint    无符号/zigzag整数、布尔、枚举
+//   Fixed64   8字节小端（double、64位随机数状态）
+//   Bytes     varint 长度 + 内容（嵌套消息、打包的varint数组）
+//   StringRef 字符串表下标，同一字符串只存一次
+// 读取时不认识的字段按线型整体跳过，缺少的字段保持默认值，因此新旧版本可以互相读取
+namespace binary
+{
+
+enum WireType : uint8_t
+{
+    Varint = 0,
+    Fixed64 = 1,
+    Bytes = 2,
+    StringRef = 3
+};
+
+constexpr char MAGIC[4] = {'D', 'P', 'S', 'B'};
+constexpr uint32_t CODEC_VERSION = 1;
+
+inline uint64_t zigzagEncode(int64_t v) noexcept
+{
+    return (uint64_t(v) << 1) ^ uint64_t(v >> 63);
+}
+
+inline int64_t zigzagDecode(uint64_t v) noexcept
+{
+    return int64_t(v >> 1) ^ -int64_t(v & 1);
+}
+
+inline void appendVarint(std::string &out, uint64_t v)
+{
+    while (v >= 0x80)
+    {
+        out.push_back(char(uint8_t(v) | 0x80));
+        v >>= 7;
+    }
+    out.push_back(char(uint8_t(v)));
+}
+
+// 从 [pos, end) 解码一个varint，成功时移动pos
+inline bool decodeVarint(const uint8_t *&pos, const uint8_t *end, uint64_t &value) noexcept
+{
+    value = 0;
+    for (int shift = 0; shift < 64 && pos < end; shift += 7)
+    {
+        const uint8_t byte = *pos++;
+        value |= uint64_t(byte & 0x7f) << shift;
+        if ((byte & 0x80) == 0)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace binary
+
+class BinaryWriter
+{
+public:
+    BinaryWriter()
+        : m_buffers(1)
+    {
+    }
+
+    void writeUInt(uint32_t field, uint64_t value)
+    {
+        writeKey(field, binary::Varint);
+        binary::appendVarint(top(), value);
+    }
+
+    void writeInt(uint32_t field, int64_t value)
+    {
+        writeUInt(field, binary::zigzagEncode(value));
+    }
+
+    void writeBool(uint32_t field, bool value)
+    {
+        writeUInt(field, value ? 1 : 0);
+    }
+
+    void writeFixed64(uint32_t field, uint64_t value)
+    {
+        writeKey(field, binary::Fixed64);
+        for (int i = 0; i < 8; ++i)
+        {
+            top().push_back(char(uint8_t(value >> (8 * i))));
+        }
+    }
+
+    void writeDouble(uint32_t field, double value)
+    {
+        uint64_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        writeFixed64(field, bits);
+    }
+
+    void writeString(uint32_t field, const std::string &value)
+    {
+        writeKey(field, binary::StringRef);
+        binary::appendVarint(top(), intern(value));
+    }
+
+    // 打包的无符号varint数组
+    void writePackedUInts(uint32_t field, const std::vector<uint64_t> &values)
+    {
+        std::string packed;
+        packed.reserve(values.size() * 2);
+        for (uint64_t v : values)
+        {
+            binary::appendVarint(packed, v);
+        }
+        writeBytes(field, packed);
+    }
+
+    // 打包的有符号数组（zigzag）
+    void writePackedInts(uint32_t field, const std::vector<int64_t> &values)
+    {
+        std::string packed;
+        packed.reserve(values.size() * 2);
+        for (int64_t v : values)
+        {
+            binary::appendVarint(packed, binary::zigzagEncode(v));
+        }
+        writeBytes(field, packed);
+    }
+
+    void writeBytes(uint32_t field, const std::string &bytes)
+    {
+        writeKey(field, binary::Bytes);
+        binary::appendVarint(top(), bytes.size());
+        top().append(bytes);
+    }
+
+    // 嵌套消息：begin/end 之间写入的字段属于该消息
+    void beginMessage(uint32_t field)
+    {
+        m_fields.push_back(field);
+        m_buffers.emplace_back();
+    }
+
+    void endMessage()
+    {
+        if (m_buffers.size() <= 1)
+        {
+            return;
+        }
+        std::string content = std::move(m_buffers.back());
+        m_buffers.pop_back();
+        const uint32_t field = m_fields.back();
+        m_fields.pop_back();
+        writeBytes(field, content);
+    }
+
+    // 只取消息体，不带文件头和字符串表；用于不含字符串的小记录（如存档日志）
+    const std::string &body() const
+    {
+        return m_buffers.front();
+    }
+
+    bool hasStrings() const noexcept
+    {
+        return !m_strings.empty();
+    }
+
+    // 生成完整文件内容：文件头 + 字符串表 + 消息体
+    std::string finish(uint32_t schemaVersion) const
+    {
+        std::string out(binary::MAGIC, sizeof(binary::MAGIC));
+        binary::appendVarint(out, binary::CODEC_VERSION);
+        binary::appendVarint(out, schemaVersion);
+        binary::appendVarint(out, m_strings.size());
+        for (const std::string &s : m_strings)
+        {
+            binary::appendVarint(out, s.size());
+            out.append(s);
+        }
+        out.append(m_buffers.front());
+        return out;
+    }
+
+private:
+    std::string &top()
+    {
+        return m_buffers.back();
+    }
+
+    void writeKey(uint32_t field, binary::WireType type)
+    {
+        binary::appendVarint(top(), (uint64_t(field) << 3) | type);
+    }
+
+    uint64_t intern(const std::string &value)
+    {
+        auto it = m_stringIndex.find(value);
+        if (it != m_stringIndex.end())
+        {
+            return it->second;
+        }
+        const uint64_t index = m_strings.size();
+        m_strings.push_back(value);
+        m_stringIndex.emplace(value, index);
+        return index;
+    }
+
+    std::vector<std::string> m_buffers; // 嵌套消息的缓冲栈，第0个是消息体
+    std::vector<uint32_t> m_fields;
+    std::vector<std::string> m_strings;
+    std::unordered_map<std::string, uint64_t> m_stringIndex;
+};
+
+// 按字段顺序读取一条消息：
+//   while (in.next()) { switch (in.field()) { case 1: x = in.readUInt(); break; default: break; } }
+// 未读取的字段在下一次 next() 时自动跳过；线型与读取方式不符时返回默认值
+class BinaryReader
+{
+public:
+    BinaryReader() = default;
+
+    // 解析文件头和字符串表，之后即可读取顶层消息
+    bool open(const char *data, size_t size)
+    {
+        m_pos = reinterpret_cast<const uint8_t *>(data);
+        m_end = m_pos + size;
+        m_error = false;
+        m_pending = false;
+        m_strings = std::make_shared<std::vector<std::string>>();
+
+        if (size < sizeof(binary::MAGIC) || std::memcmp(data, binary::MAGIC, sizeof(binary::MAGIC)) != 0)
+        {
+            return fail();
+        }
+        m_pos += sizeof(binary::MAGIC);
+
+        uint64_t codecVersion = 0;
+        uint64_t schemaVersion = 0;
+        uint64_t stringCount = 0;
+        if (!readVarint(codecVersion) || codecVersion != binary::CODEC_VERSION || !readVarint(schemaVersion) ||
+            !readVarint(stringCount) || stringCount > uint64_t(m_end - m_pos))
+        {
+            return fail();
+        }
+        m_schemaVersion = uint32_t(schemaVersion);
+
+        m_strings->reserve(size_t(stringCount));
+        for (uint64_t i = 0; i < stringCount; ++i)
+        {
+            uint64_t length = 0;
+            if (!readVarint(length) || length > uint64_t(m_end - m_pos))
+            {
+                return fail();
+            }
+            m_strings->emplace_back(reinterpret_cast<const char *>(m_pos), size_t(length));
+            m_pos += length;
+        }
+        return true;
+    }
+
+    // 直接读取没有文件头的消息体（见 BinaryWriter::body()）
+    void openBody(const char *data, size_t size)
+    {
+        m_pos = reinterpret_cast<const uint8_t *>(data);
+        m_end = m_pos + size;
+        m_error = false;
+        m_pending = false;
+    }
+
+    uint32_t schemaVersion() const noexcept
+    {
+        return m_schemaVersion;
+    }
+
+    bool isValid() const noexcept
+    {
+        return !m_error;
+    }
+
+    // 前进到下一个字段，消息结束或数据损坏时返回false
+    bool next()
+    {
+        if (m_pending)
+        {
+            skip();
+        }
+        if (m_error || m_pos >= m_end)
+        {
+            return false;
+        }
+
+        uint64_t key = 0;
+        if (!readVarint(key) || (key & 7) > binary::StringRef)
+        {
+            return fail();
+        }
+        m_field = uint32_t(key >> 3);
+        m_wireType = binary::WireType(key & 7);
+        m_pending = true;
+        return true;
+    }
+
+    uint32_t field() const noexcept
+    {
+        return m_field;
+    }
+
+    binary::WireType wireType() const noexcept
+    {
+        return m_wireType;
+    }
+
+    uint64_t readUInt()
+    {
+        uint64_t value = 0;
+        if (!expect(binary::Varint) || !readVarint(value))
+        {
+            return 0;
+        }
+        m_pending = false;
+        return value;
+    }
+
+    int64_t readInt()
+    {
+        return binary::zigzagDecode(readUInt());
+    }
+
+    bool readBool()
+    {
+        return readUInt() != 0;
+    }
+
+    uint64_t readFixed64()
+    {
+        if (!expect(binary::Fixed64) || m_end - m_pos < 8)
+        {
+            return 0;
+        }
+        uint64_t value = 0;
+        for (int i = 0; i < 8; ++i)
+        {
+            value |= uint64_t(m_pos[i]) << (8 * i);
+        }
+        m_pos += 8;
+        m_pending = false;
+        return value;
+    }
+
+    double readDouble()
+    {
+        const uint64_t bits = readFixed64();
+        double value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+    std::string readString()
+    {
+        uint64_t index = 0;
+        if (!expect(binary::StringRef) || !readVarint(index))
+        {
+            return std::string();
+        }
+        m_pending = false;
+        if (index >= m_strings->size())
+        {
+            fail();
+            return std::string();
+        }
+        return (*m_strings)[size_t(index)];
+    }
+
+    void readPackedUInts(std::vector<uint64_t> &values)
+    {
+        values.clear();
+        BinaryReader body;
+        if (!readBytes(body))
+        {
+            return;
+        }
+        uint64_t v = 0;
+        while (body.m_pos < body.m_end && body.readVarint(v))
+        {
+            values.push_back(v);
+        }
+        m_error = m_error || body.m_error;
+    }
+
+    void readPackedInts(std::vector<int64_t> &values)
+    {
+        std::vector<uint64_t> raw;
+        readPackedUInts(raw);
+        values.resize(raw.size());
+        for (size_t i = 0; i < raw.size(); ++i)
+        {
+            values[i] = binary::zigzagDecode(raw[i]);
+        }
+    }
+
+    // 读取嵌套消息，返回的读取器与本读取器共用字符串表
+    BinaryReader readMessage()
+    {
+        BinaryReader message;
+        if (!readBytes(message))
+        {
+            message.m_error = true;
+        }
+        return message;
+    }
+
+    // 跳过当前字段
+    void skip()
+    {
+        if (!m_pending)
+        {
+            return;
+        }
+        m_pending = false;
+        uint64_t value = 0;
+        switch (m_wireType)
+        {
+        case binary::Varint:
+        case binary::StringRef:
+            readVarint(value);
+            break;
+        case binary::Fixed64:
+            if (m_end - m_pos < 8)
+            {
+                fail();
+            }
+            else
+            {
+                m_pos += 8;
+            }
+            break;
+        case binary::Bytes:
+            if (!readVarint(value) || value > uint64_t(m_end - m_pos))
+            {
+                fail();
+            }
+            else
+            {
+                m_pos += value;
+            }
+            break;
+        }
+    }
+
+private:
+    bool fail() noexcept
+    {
+        m_error = true;
+        m_pending = false;
+        m_pos = m_end;
+        return false;
+    }
+
+    bool expect(binary::WireType type)
+    {
+        if (!m_pending || m_wireType != type)
+        {
+            skip();
+            return false;
+        }
+        return true;
+    }
+
+    bool readVarint(uint64_t &value) noexcept
+    {
+        value = 0;
+        for (int shift = 0; shift < 64; shift += 7)
+        {
+            if (m_pos >= m_end)
+            {
+                return fail();
+            }
+            const uint8_t byte = *m_pos++;
+            value |= uint64_t(byte & 0x7f) << shift;
+            if ((byte & 0x80) == 0)
+            {
+                return true;
+            }
+        }
+        return fail();
+    }
+
+    bool readBytes(BinaryReader &body)
+    {
+        uint64_t length = 0;
+        if (!expect(binary::Bytes) || !readVarint(length) || length > uint64_t(m_end - m_pos))
+        {
+            if (!m_error && m_pending)
+            {
+                fail();
+            }
+            return false;
+        }
+        body.m_pos = m_pos;
+        body.m_end = m_pos + length;
+        body.m_strings = m_strings;
+        body.m_schemaVersion = m_schemaVersion;
+        m_pos += length;
+        m_pending = false;
+        return true;
+    }
+
+    const uint8_t *m_pos = nullptr;
+    const uint8_t *m_end = nullptr;
+    std::shared_ptr<std::vector<std::string>> m_strings = std::make_shared<std::vector<std::string>>();
+    uint32_t m_schemaVersion = 0;
+    uint32_t m_field = 0;
+    binary::WireType m_wireType = binary::Varint;
+    bool m_pending = false;
+    bool m_error = false;
+};
+
+#endif
@@ -2,6 +2,7 @@
 #define __EVENT_DEFINE_H__
 
 #include <iostream>
+#include <vector>
 
 struct TestEvent
 {
@@ -21,4 +22,25 @@ struct AddItemEvent
     int count;
 };
 
+// 批量添加物品事件（离线结算等一次发放多种物品，背包只刷新一次）
+struct AddItemBatchEvent
+{
+    std::vector<AddItemEvent> items;
+};
+
+// 群体宠物开始相撞（包围盒从不相交变为相交时发送一次），pet/other 为 PetSwarm 中的下标
+struct PetBumpEvent
+{
+    int pet;
+    int other;
+};
+
+// 群体宠物碰到鼠标，开始跟随鼠标
+struct PetFollowCursorEvent
+{
+    int pet;
+    int cursorX;
+    int cursorY;
+};
+
 #endif
\ No newline at end of file
@@ -0,0 +1,23 @@
+#ifndef __FRAME_CLOCK_H__
+#define __FRAME_CLOCK_H__
+
+#include <QScreen>
+#include <QtGlobal>
+
+// 按屏幕刷新率计算帧定时器的间隔（毫秒）：60Hz→16，120Hz→8，144Hz→6
+// 向下取整，宁可偶尔一帧内触发两次也不漏帧；取不到刷新率时按60Hz
+inline int frameIntervalMs(qreal rate)
+{
+    if (rate < 1.0)
+    {
+        return 16;
+    }
+    return qBound(4, static_cast<int>(1000.0 / rate), 50);
+}
+
+inline int frameIntervalMs(const QScreen *screen)
+{
+    return frameIntervalMs(screen ? screen->refreshRate() : 0.0);
+}
+
+#endif
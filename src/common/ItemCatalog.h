@@ -0,0 +1,88 @@
+#ifndef __ITEM_CATALOG_H__
+#define __ITEM_CATALOG_H__
+
+#include "base/CollectionInfo.h"
+#include <cstdint>
+
+// 编译期物品表：构建时由 cmake/GenerateItemCatalog.cmake 从 resources/csv/collection_items.csv 生成
+// 物品ID、名称、类别、稀有度都是常量，热路径直接按ID查静态数组，不经过 CollectionModel 的 QMap 也不构造字符串
+// CSV 中填写了 key 的物品生成强类型常量 Items::<key>，代码里用它代替魔法数字
+//
+// 运行时的 CollectionModel 仍然从同一个CSV加载，负责收集状态和存档；这里只保存不会变化的配置
+
+// 强类型物品ID：不能从 int 隐式构造，可以隐式转换为 int 传给现有接口
+struct ItemId
+{
+    int value;
+
+    constexpr explicit ItemId(int id) noexcept : value(id) {}
+    constexpr operator int() const noexcept { return value; }
+};
+
+struct ItemMeta
+{
+    ItemId id;
+    const char *name; // UTF-8
+    const char *description;
+    CollectionCategory category;
+    CollectionRarity rarity;
+    const char *iconPath;
+    const char *detailImagePath;
+    bool hidden;
+};
+
+#include "ItemCatalogData.h"
+
+namespace item_catalog
+{
+
+// 不在表中时返回 nullptr
+constexpr const ItemMeta *find(int id) noexcept
+{
+    if (id < 0 || id > MAX_ID || INDEX[id] < 0)
+    {
+        return nullptr;
+    }
+    return &ITEMS[INDEX[id]];
+}
+
+constexpr bool contains(int id) noexcept
+{
+    return find(id) != nullptr;
+}
+
+constexpr const char *categoryName(CollectionCategory category) noexcept
+{
+    switch (category)
+    {
+    case CollectionCategory::Material:
+        return "材料";
+    case CollectionCategory::Item:
+        return "物品";
+    case CollectionCategory::Skin:
+        return "皮肤";
+    case CollectionCategory::Achievement:
+        return "成就";
+    }
+    return "未知";
+}
+
+constexpr const char *rarityName(CollectionRarity rarity) noexcept
+{
+    switch (rarity)
+    {
+    case CollectionRarity::Common:
+        return "普通";
+    case CollectionRarity::Rare:
+        return "稀有";
+    case CollectionRarity::Epic:
+        return "史诗";
+    case CollectionRarity::Legendary:
+        return "传说";
+    }
+    return "未知";
+}
+
+} // namespace item_catalog
+
+#endif
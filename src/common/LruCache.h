@@ -0,0 +1,100 @@
+#ifndef __LRU_CACHE_H__
+#define __LRU_CACHE_H__
+
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <unordered_map>
+#include <utility>
+
+// 按字节预算淘汰的 LRU 缓存：每个条目带一个开销（字节数），总开销超过预算时从最久未用的条目开始淘汰
+// 刚插入的条目即使单独超过预算也会保留，保证调用方拿到的结果至少能用到下一次插入
+// 值通常是 shared_ptr：被淘汰的条目只是从缓存里移除，正在使用它的地方不受影响
+template <typename Key, typename Value, typename Hash = std::hash<Key>>
+class LruCache
+{
+public:
+    explicit LruCache(int64_t budget = 0) : m_budget(budget) {}
+
+    // 命中时把条目移到最前并返回指针，未命中返回nullptr
+    const Value *find(const Key &key)
+    {
+        auto it = m_index.find(key);
+        if (it == m_index.end())
+        {
+            ++m_misses;
+            return nullptr;
+        }
+        ++m_hits;
+        m_entries.splice(m_entries.begin(), m_entries, it->second);
+        return &it->second->value;
+    }
+
+    // 插入或替换，随后按预算淘汰
+    void insert(const Key &key, Value value, int64_t cost)
+    {
+        auto it = m_index.find(key);
+        if (it != m_index.end())
+        {
+            m_used -= it->second->cost;
+            m_entries.erase(it->second);
+            m_index.erase(it);
+        }
+        m_entries.push_front({key, std::move(value), cost});
+        m_index.emplace(key, m_entries.begin());
+        m_used += cost;
+        trim();
+    }
+
+    void setBudget(int64_t budget)
+    {
+        m_budget = budget;
+        trim();
+    }
+
+    void clear()
+    {
+        m_entries.clear();
+        m_index.clear();
+        m_used = 0;
+    }
+
+    int64_t budget() const noexcept { return m_budget; }
+    int64_t usedBytes() const noexcept { return m_used; }
+    int size() const noexcept { return static_cast<int>(m_entries.size()); }
+    int64_t hits() const noexcept { return m_hits; }
+    int64_t misses() const noexcept { return m_misses; }
+    int64_t evictions() const noexcept { return m_evictions; }
+
+private:
+    struct Entry
+    {
+        Key key;
+        Value value;
+        int64_t cost;
+    };
+
+    // 最前面的条目（最近使用）不淘汰
+    void trim()
+    {
+        while (m_used > m_budget && m_entries.size() > 1)
+        {
+            const Entry &last = m_entries.back();
+            m_used -= last.cost;
+            m_index.erase(last.key);
+            m_entries.pop_back();
+            ++m_evictions;
+        }
+    }
+
+private:
+    std::list<Entry> m_entries; // 按最近使用排序，最前面最新
+    std::unordered_map<Key, typename std::list<Entry>::iterator, Hash> m_index;
+    int64_t m_budget;
+    int64_t m_used = 0;
+    int64_t m_hits = 0;
+    int64_t m_misses = 0;
+    int64_t m_evictions = 0;
+};
+
+#endif
@@ -0,0 +1,70 @@
+#ifndef __POSITION_CHANNEL_H__
+#define __POSITION_CHANNEL_H__
+
+#include <QPoint>
+#include <atomic>
+#include <cstdint>
+
+// 高频位置通道：写入方只更新一个原子坐标并置脏标记，读取方在自己的帧定时器里取样
+// 不经过 PropertyTrigger 的通知链，适合自动移动这种每几十毫秒更新一次、只需要最新值的数据
+// 坐标打包成一个64位整数，读写都是无锁的单次原子操作
+class PositionChannel
+{
+public:
+    PositionChannel() noexcept
+    {
+    }
+    PositionChannel(const PositionChannel &) = delete;
+    PositionChannel &operator=(const PositionChannel &) = delete;
+
+    void publish(const QPoint &position) noexcept
+    {
+        m_packed.store(pack(position), std::memory_order_relaxed);
+        m_dirty.store(true, std::memory_order_release);
+    }
+
+    // 自上次取样以来有新位置时返回true并取出；多次写入只取最后一次
+    bool take(QPoint &position) noexcept
+    {
+        if (!m_dirty.load(std::memory_order_relaxed) || !m_dirty.exchange(false, std::memory_order_acquire))
+        {
+            return false;
+        }
+        position = unpack(m_packed.load(std::memory_order_relaxed));
+        return true;
+    }
+
+    QPoint load() const noexcept
+    {
+        return unpack(m_packed.load(std::memory_order_acquire));
+    }
+
+    // 写入方正在连续移动时为true；停下（暂停、交互、停止自动移动）后读取方可以停掉取样定时器
+    void setMoving(bool moving) noexcept
+    {
+        m_moving.store(moving, std::memory_order_release);
+    }
+
+    bool isMoving() const noexcept
+    {
+        return m_moving.load(std::memory_order_acquire);
+    }
+
+private:
+    static uint64_t pack(const QPoint &position) noexcept
+    {
+        return (uint64_t(uint32_t(position.x())) << 32) | uint32_t(position.y());
+    }
+
+    static QPoint unpack(uint64_t packed) noexcept
+    {
+        return QPoint(int32_t(uint32_t(packed >> 32)), int32_t(uint32_t(packed)));
+    }
+
+private:
+    std::atomic<uint64_t> m_packed{0};
+    std::atomic<bool> m_dirty{false};
+    std::atomic<bool> m_moving{false};
+};
+
+#endif
@@ -24,7 +24,8 @@ enum {
     PROP_ID_SHOW_FORGE_PANEL,
     PROP_ID_FORGE_COMPLETED,
     PROP_ID_FORGE_UPDATE,  // 添加锻造更新属性ID
-    PROP_ID_SHOW_WORK_UPGRADE_PANEL  // 添加显示工作升级面板的属性ID
+    PROP_ID_SHOW_WORK_UPGRADE_PANEL,  // 添加显示工作升级面板的属性ID
+    PROP_ID_PET_MOVING  // 位置通道开始或停止连续移动
 };
 
 #endif
@@ -0,0 +1,186 @@
+#ifndef __RANDOM_ENGINE_H__
+#define __RANDOM_ENGINE_H__
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+// 快速、可复现的伪随机数引擎 (xoshiro256**)
+// - 非线程安全、无锁：每个子系统/线程持有自己的流
+// - 相同种子在任何平台上产生完全一致的序列，可用于回放奖励和测试
+// - 接口与 QRandomGenerator 保持一致（bounded 为左闭右开区间），方便替换
+class RandomEngine
+{
+public:
+    using result_type = uint64_t;
+    using State = std::array<uint64_t, 4>;
+
+    explicit RandomEngine(uint64_t seed = 0) noexcept
+    {
+        this->seed(seed);
+    }
+
+    // 使用splitmix64把64位种子扩展为256位状态
+    void seed(uint64_t seed) noexcept
+    {
+        uint64_t x = seed;
+        for (uint64_t &s : m_state)
+        {
+            s = splitmix64(x);
+        }
+    }
+
+    const State &state() const noexcept
+    {
+        return m_state;
+    }
+
+    void setState(const State &state) noexcept
+    {
+        m_state = state;
+        // 全零状态是xoshiro的不动点，退化为默认种子
+        if ((m_state[0] | m_state[1] | m_state[2] | m_state[3]) == 0)
+        {
+            seed(0);
+        }
+    }
+
+    // 生成下一个64位随机数
+    uint64_t next() noexcept
+    {
+        const uint64_t result = rotl(m_state[1] * 5, 7) * 9;
+        const uint64_t t = m_state[1] << 17;
+
+        m_state[2] ^= m_state[0];
+        m_state[3] ^= m_state[1];
+        m_state[1] ^= m_state[2];
+        m_state[0] ^= m_state[3];
+        m_state[2] ^= t;
+        m_state[3] = rotl(m_state[3], 45);
+
+        return result;
+    }
+
+    // 满足 UniformRandomBitGenerator，可直接用于 <random> 的分布
+    static constexpr result_type min() noexcept { return 0; }
+    static constexpr result_type max() noexcept { return UINT64_MAX; }
+    result_type operator()() noexcept { return next(); }
+
+    // [0, bound) 均匀整数，无偏（Lemire乘法 + 拒绝采样）
+    uint32_t bounded(uint32_t bound) noexcept
+    {
+        if (bound == 0)
+        {
+            return 0;
+        }
+        uint64_t m = uint64_t(uint32_t(next() >> 32)) * bound;
+        uint32_t low = uint32_t(m);
+        if (low < bound)
+        {
+            const uint32_t threshold = uint32_t(-bound) % bound;
+            while (low < threshold)
+            {
+                m = uint64_t(uint32_t(next() >> 32)) * bound;
+                low = uint32_t(m);
+            }
+        }
+        return uint32_t(m >> 32);
+    }
+
+    // [0, highest) 均匀整数
+    int bounded(int highest) noexcept
+    {
+        return highest <= 0 ? 0 : int(bounded(uint32_t(highest)));
+    }
+
+    // [lowest, highest) 均匀整数，与 QRandomGenerator::bounded(int, int) 语义相同
+    int bounded(int lowest, int highest) noexcept
+    {
+        if (highest <= lowest)
+        {
+            return lowest;
+        }
+        return lowest + int(bounded(uint32_t(int64_t(highest) - lowest)));
+    }
+
+    // [0, 1) 均匀浮点数，取高53位
+    double generateDouble() noexcept
+    {
+        return double(next() >> 11) * 0x1.0p-53;
+    }
+
+    // 批量生成：一次填满数组，用于大量奖励/模拟计算
+    void fillDouble(double *out, size_t count) noexcept
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            out[i] = double(next() >> 11) * 0x1.0p-53;
+        }
+    }
+
+    void fillFloat(float *out, size_t count) noexcept
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            out[i] = float(next() >> 40) * 0x1.0p-24f;
+        }
+    }
+
+    void fillBounded(uint32_t *out, size_t count, uint32_t bound) noexcept
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            out[i] = bounded(bound);
+        }
+    }
+
+    // 跳过 2^128 次调用，得到互不重叠的子流
+    void jump() noexcept
+    {
+        static const uint64_t JUMP[] = {0x180ec6d33cfd0abaULL, 0xd5a61266f0c9392cULL,
+                                        0xa9582618e03fc9aaULL, 0x39abdc4529b1661cULL};
+
+        State s = {0, 0, 0, 0};
+        for (uint64_t word : JUMP)
+        {
+            for (int b = 0; b < 64; ++b)
+            {
+                if (word & (uint64_t(1) << b))
+                {
+                    s[0] ^= m_state[0];
+                    s[1] ^= m_state[1];
+                    s[2] ^= m_state[2];
+                    s[3] ^= m_state[3];
+                }
+                next();
+            }
+        }
+        m_state = s;
+    }
+
+    // 从当前引擎派生一个独立子流（当前引擎前进到下一个子流）
+    RandomEngine split() noexcept
+    {
+        RandomEngine child(*this);
+        jump();
+        return child;
+    }
+
+    static uint64_t splitmix64(uint64_t &x) noexcept
+    {
+        uint64_t z = (x += 0x9e3779b97f4a7c15ULL);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        return z ^ (z >> 31);
+    }
+
+private:
+    static uint64_t rotl(uint64_t x, int k) noexcept
+    {
+        return (x << k) | (x >> (64 - k));
+    }
+
+    State m_state;
+};
+
+#endif
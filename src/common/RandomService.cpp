@@ -0,0 +1,214 @@
+#include "RandomService.h"
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QFile>
+#include <QDir>
+#include <QStandardPaths>
+#include <QDateTime>
+#include <QDebug>
+#include <random>
+
+RandomService::RandomService() noexcept
+    : m_masterSeed(0)
+{
+    // 允许通过环境变量固定种子，便于复现问题
+    bool ok = false;
+    const uint64_t envSeed = qEnvironmentVariable("DESKTOPPET_SEED").toULongLong(&ok);
+    reseed(ok ? envSeed : makeRandomSeed());
+}
+
+void RandomService::reseed(uint64_t masterSeed) noexcept
+{
+    m_masterSeed = masterSeed;
+
+    RandomEngine master(masterSeed);
+    for (RandomEngine &engine : m_streams)
+    {
+        engine = master.split();
+    }
+}
+
+uint64_t RandomService::makeRandomSeed() noexcept
+{
+    uint64_t seed = static_cast<uint64_t>(QDateTime::currentMSecsSinceEpoch());
+    try
+    {
+        std::random_device device;
+        seed ^= (uint64_t(device()) << 32) | device();
+    }
+    catch (...)
+    {
+        // random_device不可用时仅使用时间
+    }
+    return RandomEngine::splitmix64(seed);
+}
+
+bool RandomService::isSeedPinned() noexcept
+{
+    return qEnvironmentVariableIsSet("DESKTOPPET_SEED");
+}
+
+QJsonObject RandomService::toJson() const
+{
+    QJsonObject json;
+    // 64位整数超出JSON double精度，统一保存为十六进制字符串
+    json["masterSeed"] = QString::number(m_masterSeed, 16);
+
+    QJsonArray streamsJson;
+    for (const RandomEngine &engine : m_streams)
+    {
+        QJsonArray stateJson;
+        for (uint64_t word : engine.state())
+        {
+            stateJson.append(QString::number(word, 16));
+        }
+        streamsJson.append(stateJson);
+    }
+    json["streams"] = streamsJson;
+    return json;
+}
+
+bool RandomService::fromJson(const QJsonObject &json)
+{
+    bool ok = false;
+    const uint64_t seed = json["masterSeed"].toString().toULongLong(&ok, 16);
+    if (!ok)
+    {
+        return false;
+    }
+
+    // 先按主种子派生，旧存档缺少的流也能得到确定的状态
+    reseed(seed);
+
+    const QJsonArray streamsJson = json["streams"].toArray();
+    const int count = qMin(streamsJson.size(), static_cast<int>(RandomStream::Count));
+    for (int i = 0; i < count; ++i)
+    {
+        const QJsonArray stateJson = streamsJson[i].toArray();
+        if (stateJson.size() != 4)
+        {
+            continue;
+        }
+
+        RandomEngine::State state;
+        bool valid = true;
+        for (int w = 0; w < 4 && valid; ++w)
+        {
+            state[w] = stateJson[w].toString().toULongLong(&valid, 16);
+        }
+        if (valid)
+        {
+            m_streams[i].setState(state);
+        }
+    }
+    return true;
+}
+
+RandomService::SaveSnapshot RandomService::saveSnapshot() const noexcept
+{
+    SaveSnapshot snapshot;
+    snapshot.masterSeed = m_masterSeed;
+    for (size_t i = 0; i < snapshot.states.size(); ++i)
+    {
+        snapshot.states[i] = m_streams[i].state();
+    }
+    return snapshot;
+}
+
+// 二进制存档字段：1 主种子 2 各随机流状态（每个流4个字，依次排列）
+void RandomService::writeBinary(const SaveSnapshot &snapshot, BinaryWriter &out)
+{
+    out.writeFixed64(1, snapshot.masterSeed);
+    for (const RandomEngine::State &state : snapshot.states)
+    {
+        for (uint64_t word : state)
+        {
+            out.writeFixed64(2, word);
+        }
+    }
+}
+
+bool RandomService::readBinary(BinaryReader &in)
+{
+    bool hasSeed = false;
+    uint64_t seed = 0;
+    std::vector<uint64_t> words;
+    while (in.next())
+    {
+        switch (in.field())
+        {
+        case 1:
+            seed = in.readFixed64();
+            hasSeed = true;
+            break;
+        case 2:
+            words.push_back(in.readFixed64());
+            break;
+        default:
+            break;
+        }
+    }
+    if (!hasSeed || !in.isValid())
+    {
+        return false;
+    }
+
+    // 先按主种子派生，缺少的流也能得到确定的状态
+    reseed(seed);
+    const size_t count = qMin(words.size() / 4, static_cast<size_t>(RandomStream::Count));
+    for (size_t i = 0; i < count; ++i)
+    {
+        RandomEngine::State state;
+        for (size_t w = 0; w < 4; ++w)
+        {
+            state[w] = words[i * 4 + w];
+        }
+        m_streams[i].setState(state);
+    }
+    return true;
+}
+
+void RandomService::saveToFile(const QString &filename) const
+{
+    QString appDataPath = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
+    QDir dir(appDataPath);
+    if (!dir.exists())
+    {
+        dir.mkpath(appDataPath);
+    }
+
+    QFile file(appDataPath + "/" + filename);
+    if (file.open(QIODevice::WriteOnly))
+    {
+        file.write(QJsonDocument(toJson()).toJson());
+        file.close();
+    }
+    else
+    {
+        qDebug() << "无法保存随机数状态:" << file.fileName();
+    }
+}
+
+void RandomService::loadFromFile(const QString &filename)
+{
+    // 通过环境变量固定种子时以环境变量为准
+    if (isSeedPinned())
+    {
+        return;
+    }
+
+    QString appDataPath = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
+    QFile file(appDataPath + "/" + filename);
+    if (!file.open(QIODevice::ReadOnly))
+    {
+        return; // 文件不存在，保留随机种子
+    }
+
+    QJsonDocument doc = QJsonDocument::fromJson(file.readAll());
+    file.close();
+
+    if (!doc.isObject() || !fromJson(doc.object()))
+    {
+        qDebug() << "随机数状态文件格式错误，使用新的随机种子";
+    }
+}
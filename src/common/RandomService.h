@@ -0,0 +1,76 @@
+#ifndef __RANDOM_SERVICE_H__
+#define __RANDOM_SERVICE_H__
+
+#include "BinaryCodec.h"
+#include "RandomEngine.h"
+#include "Singleton.h"
+#include <QJsonObject>
+#include <QString>
+#include <array>
+
+// 各子系统独立的随机流，互不干扰，新增子系统时在Count之前追加
+enum class RandomStream
+{
+    Work = 0,   // 打工奖励
+    Forge,      // 锻造成功率
+    Movement,   // 自动移动
+    Simulation, // 离线结算/模拟
+    Count
+};
+
+// 随机数服务：持有主种子以及由其派生的各子系统随机流
+// 所有流都运行在GUI线程；需要在其它线程使用时请 split() 出独立引擎
+class RandomService : public Singleton<RandomService>
+{
+    friend class Singleton<RandomService>;
+
+public:
+    // 获取某个子系统的随机流
+    RandomEngine &stream(RandomStream which) noexcept
+    {
+        return m_streams[static_cast<int>(which)];
+    }
+
+    // 使用主种子重新派生所有子系统流（第i个流 = 主引擎跳跃i次）
+    void reseed(uint64_t masterSeed) noexcept;
+
+    uint64_t masterSeed() const noexcept
+    {
+        return m_masterSeed;
+    }
+
+    // 种子/流状态的存档，读档后可逐位复现后续所有随机结果
+    QJsonObject toJson() const;
+    bool fromJson(const QJsonObject &json);
+    bool readBinary(BinaryReader &in);
+
+    // 存档快照：主种子和各流状态的拷贝，可以交给后台线程序列化
+    struct SaveSnapshot
+    {
+        uint64_t masterSeed;
+        std::array<RandomEngine::State, static_cast<size_t>(RandomStream::Count)> states;
+    };
+    SaveSnapshot saveSnapshot() const noexcept;
+    static void writeBinary(const SaveSnapshot &snapshot, BinaryWriter &out);
+    void writeBinary(BinaryWriter &out) const
+    {
+        writeBinary(saveSnapshot(), out);
+    }
+
+    void saveToFile(const QString &filename) const;
+    void loadFromFile(const QString &filename);
+
+    // 生成一个不可预测的主种子
+    static uint64_t makeRandomSeed() noexcept;
+
+    // 是否通过 DESKTOPPET_SEED 环境变量固定了种子（此时忽略存档中的随机状态）
+    static bool isSeedPinned() noexcept;
+
+private:
+    RandomService() noexcept;
+
+    uint64_t m_masterSeed;
+    RandomEngine m_streams[static_cast<int>(RandomStream::Count)];
+};
+
+#endif
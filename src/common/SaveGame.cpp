@@ -0,0 +1,240 @@
+#include "SaveGame.h"
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QJsonDocument>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <QDebug>
+
+bool SaveGame::load()
+{
+    const QString binaryPath = fullPath(DEFAULT_FILENAME);
+    if (QFile::exists(binaryPath) && loadFile(binaryPath))
+    {
+        return true;
+    }
+
+    // 旧版本只写了JSON快照
+    const QString jsonPath = fullPath(JSON_FILENAME);
+    if (QFile::exists(jsonPath) && loadFile(jsonPath))
+    {
+        return true;
+    }
+
+    qDebug() << "存档快照不存在，使用旧存档";
+    return false;
+}
+
+bool SaveGame::loadFile(const QString &path)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly))
+    {
+        qDebug() << "无法打开存档快照:" << path;
+        return false;
+    }
+
+    const QByteArray data = file.readAll();
+    file.close();
+
+    if (!deserialize(data))
+    {
+        qWarning() << "存档快照损坏:" << path;
+        return false;
+    }
+
+    qDebug() << "存档快照加载完成，版本" << m_version << ":" << path;
+    return true;
+}
+
+bool SaveGame::save(const BinaryWriter &writer, const QString &filename)
+{
+    const std::string encoded = writer.finish(CURRENT_VERSION);
+    const QByteArray data(encoded.data(), static_cast<int>(encoded.size()));
+    const QString path = fullPath(filename);
+    if (!writeFileAtomically(path, data))
+    {
+        qWarning() << "保存存档快照失败:" << path;
+        return false;
+    }
+
+    // 之后读取分区时以刚写入的快照为准
+    deserializeBinary(data);
+    qDebug() << "存档快照已保存到:" << path << "大小" << data.size() << "字节";
+    return true;
+}
+
+bool SaveGame::saveJson(const QString &path)
+{
+    if (!writeFileAtomically(path, serialize()))
+    {
+        qWarning() << "导出JSON存档失败:" << path;
+        return false;
+    }
+
+    qDebug() << "JSON存档已导出到:" << path;
+    return true;
+}
+
+bool SaveGame::hasBinarySection(const QString &key) const noexcept
+{
+    const uint32_t field = sectionField(key);
+    return field != 0 && (m_binarySections & (1u << field)) != 0;
+}
+
+BinaryReader SaveGame::binarySection(const QString &key) const
+{
+    const uint32_t field = sectionField(key);
+    if (field == 0 || !hasBinarySection(key))
+    {
+        return BinaryReader();
+    }
+
+    BinaryReader root;
+    root.open(m_binary.constData(), static_cast<size_t>(m_binary.size()));
+    while (root.next())
+    {
+        if (root.field() == field)
+        {
+            return root.readMessage();
+        }
+    }
+    return BinaryReader();
+}
+
+QByteArray SaveGame::serialize() const
+{
+    QJsonObject root;
+    root["version"] = CURRENT_VERSION;
+    root["savedAt"] = QDateTime::currentDateTimeUtc().toString(Qt::ISODate);
+    root["sections"] = m_sections;
+    return QJsonDocument(root).toJson(QJsonDocument::Compact);
+}
+
+bool SaveGame::deserialize(const QByteArray &data)
+{
+    if (data.startsWith(QByteArray(binary::MAGIC, sizeof(binary::MAGIC))))
+    {
+        return deserializeBinary(data);
+    }
+
+    QJsonParseError error;
+    const QJsonDocument doc = QJsonDocument::fromJson(data, &error);
+    if (error.error != QJsonParseError::NoError || !doc.isObject())
+    {
+        return false;
+    }
+
+    const QJsonObject root = doc.object();
+    if (!root.contains("version") || !root["sections"].isObject())
+    {
+        return false;
+    }
+
+    m_version = root["version"].toInt();
+    m_sections = root["sections"].toObject();
+    m_binary.clear();
+    m_binarySections = 0;
+    if (m_version > CURRENT_VERSION)
+    {
+        // 新版本程序写的存档：尽量读取认识的分区
+        qWarning() << "存档快照版本" << m_version << "高于当前支持的版本" << CURRENT_VERSION;
+    }
+    else if (m_version < CURRENT_VERSION)
+    {
+        migrate(m_sections, m_version);
+    }
+
+    m_loaded = true;
+    return true;
+}
+
+bool SaveGame::deserializeBinary(const QByteArray &data)
+{
+    // 先完整走一遍顶层消息，截断或损坏的快照整体拒绝
+    BinaryReader root;
+    if (!root.open(data.constData(), static_cast<size_t>(data.size())))
+    {
+        return false;
+    }
+
+    uint32_t sections = 0;
+    while (root.next())
+    {
+        if (root.wireType() == binary::Bytes && root.field() < 32)
+        {
+            sections |= 1u << root.field();
+        }
+    }
+    if (!root.isValid())
+    {
+        return false;
+    }
+
+    m_version = static_cast<int>(root.schemaVersion());
+    if (m_version > CURRENT_VERSION)
+    {
+        // 不认识的字段会被跳过，尽量读取认识的部分
+        qWarning() << "存档快照版本" << m_version << "高于当前支持的版本" << CURRENT_VERSION;
+    }
+
+    m_binary = data;
+    m_binarySections = sections;
+    m_sections = QJsonObject();
+    m_loaded = true;
+    return true;
+}
+
+uint32_t SaveGame::sectionField(const QString &key)
+{
+    // 字段号一经使用不能修改或复用
+    static const char *const keys[] = {SECTION_PET,  SECTION_BACKPACK, SECTION_COLLECTION, SECTION_WORK,
+                                       SECTION_FORGE, SECTION_RANDOM,  SECTION_JOURNAL};
+    for (uint32_t i = 0; i < sizeof(keys) / sizeof(keys[0]); ++i)
+    {
+        if (key == QLatin1String(keys[i]))
+        {
+            return i + 1;
+        }
+    }
+    return 0;
+}
+
+QString SaveGame::fullPath(const QString &filename)
+{
+    QString appDataPath = qEnvironmentVariable("DESKTOPPET_DATA_DIR");
+    if (appDataPath.isEmpty())
+    {
+        appDataPath = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
+    }
+    QDir dir(appDataPath);
+    if (!dir.exists())
+    {
+        dir.mkpath(appDataPath);
+    }
+    return appDataPath + "/" + filename;
+}
+
+bool SaveGame::writeFileAtomically(const QString &path, const QByteArray &data)
+{
+    // QSaveFile 写入同目录下的临时文件，commit() 时刷盘并重命名覆盖目标文件
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly))
+    {
+        return false;
+    }
+    if (file.write(data) != data.size())
+    {
+        file.cancelWriting();
+        return false;
+    }
+    return file.commit();
+}
+
+void SaveGame::migrate(QJsonObject &sections, int fromVersion)
+{
+    // 目前只有版本1
+    Q_UNUSED(sections);
+    Q_UNUSED(fromVersion);
+}
@@ -0,0 +1,105 @@
+#ifndef __SAVE_GAME_H__
+#define __SAVE_GAME_H__
+
+#include "BinaryCodec.h"
+#include <QByteArray>
+#include <QJsonObject>
+#include <QJsonValue>
+#include <QString>
+
+// 统一存档：所有模型的数据写入同一个带版本号的快照文件
+// 写入走 临时文件 -> fsync -> rename，崩溃时磁盘上要么是旧快照要么是新快照，各模型之间始终一致
+//
+// 快照有两种格式：
+//   二进制（save_data.dps，主存档）：顶层消息的字段号对应分区，见 sectionField()，内容由各模型的 writeBinary 写入
+//   JSON  （save_data.json）：旧版本的快照格式，同时作为调试用的导入/导出格式
+class SaveGame
+{
+public:
+    // 快照格式版本，格式不兼容地变化时递增并在 migrate() 中补迁移
+    static constexpr int CURRENT_VERSION = 1;
+    static constexpr const char *DEFAULT_FILENAME = "save_data.dps";
+    static constexpr const char *JSON_FILENAME = "save_data.json";
+
+    // 各模型在快照中的分区名
+    static constexpr const char *SECTION_PET = "pet";
+    static constexpr const char *SECTION_BACKPACK = "backpack";
+    static constexpr const char *SECTION_COLLECTION = "collection";
+    static constexpr const char *SECTION_WORK = "work";
+    static constexpr const char *SECTION_FORGE = "forge";
+    static constexpr const char *SECTION_RANDOM = "random";
+    static constexpr const char *SECTION_JOURNAL = "journal"; // 快照包含的最后一条存档日志序号
+
+    // 读取存档目录下的快照：先读二进制快照，没有时读JSON快照
+    // 都不存在或损坏时返回false，调用方回退到旧的分文件存档
+    bool load();
+
+    // 读取指定路径的快照文件，按文件头自动识别格式
+    bool loadFile(const QString &path);
+
+    // 原子写入二进制快照，writer 中每个分区是一条嵌套消息
+    bool save(const BinaryWriter &writer, const QString &filename = DEFAULT_FILENAME);
+
+    // 原子写入JSON快照（调试导出）
+    bool saveJson(const QString &path);
+
+    bool isLoaded() const noexcept
+    {
+        return m_loaded;
+    }
+
+    int version() const noexcept
+    {
+        return m_version;
+    }
+
+    bool hasSection(const QString &key) const noexcept
+    {
+        return hasBinarySection(key) || m_sections.contains(key);
+    }
+
+    // 二进制快照中是否有该分区
+    bool hasBinarySection(const QString &key) const noexcept;
+
+    // 二进制分区的读取器；分区不存在时返回的读取器没有任何字段
+    BinaryReader binarySection(const QString &key) const;
+
+    // JSON快照中的分区
+    QJsonValue section(const QString &key) const
+    {
+        return m_sections.value(key);
+    }
+
+    void setSection(const QString &key, const QJsonValue &value)
+    {
+        m_sections[key] = value;
+    }
+
+    // JSON快照 <-> 字节流；deserialize 同时接受二进制快照
+    QByteArray serialize() const;
+    bool deserialize(const QByteArray &data);
+
+    // 分区在二进制快照顶层消息中的字段号，未知分区返回0
+    static uint32_t sectionField(const QString &key);
+
+    // 存档目录下的完整路径；DESKTOPPET_DATA_DIR 环境变量可以指定存档目录（基准测试用）
+    static QString fullPath(const QString &filename);
+
+    // 原子替换文件内容：失败时原文件保持不变
+    static bool writeFileAtomically(const QString &path, const QByteArray &data);
+
+private:
+    // 旧版本快照升级到当前版本
+    static void migrate(QJsonObject &sections, int fromVersion);
+
+    bool deserializeBinary(const QByteArray &data);
+
+    // 二进制快照原始内容，分区读取器直接引用其中的数据
+    QByteArray m_binary;
+    uint32_t m_binarySections = 0; // 已有分区的字段号位图
+    QJsonObject m_sections;
+    int m_version = CURRENT_VERSION;
+    bool m_loaded = false;
+};
+
+#endif
@@ -0,0 +1,185 @@
+#include "SaveJournal.h"
+#include "SaveGame.h"
+#include <QDebug>
+
+namespace
+{
+
+uint32_t fnv1a(const char *data, size_t size) noexcept
+{
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < size; ++i)
+    {
+        hash ^= uint8_t(data[i]);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+} // namespace
+
+bool SaveJournal::open(const QString &path)
+{
+    close();
+    m_path = path;
+    m_file.setFileName(path);
+    if (!m_file.open(QIODevice::ReadWrite))
+    {
+        qWarning() << "无法打开存档日志:" << path;
+        return false;
+    }
+
+    const QByteArray data = m_file.readAll();
+    const size_t valid = parse(data, [this](const Record &record) { advanceTo(record.seq); });
+    if (valid < size_t(data.size()))
+    {
+        qWarning() << "存档日志末尾有" << data.size() - qint64(valid) << "字节不完整，已丢弃";
+        m_file.resize(qint64(valid));
+    }
+    m_file.seek(m_file.size());
+    return true;
+}
+
+void SaveJournal::close()
+{
+    if (m_file.isOpen())
+    {
+        m_file.close();
+    }
+}
+
+bool SaveJournal::append(RecordType type, const BinaryWriter &record)
+{
+    if (!m_file.isOpen() || record.hasStrings())
+    {
+        return false;
+    }
+
+    const std::string &payload = record.body();
+    std::string bytes;
+    bytes.reserve(payload.size() + 16);
+    binary::appendVarint(bytes, m_lastSeq + 1);
+    binary::appendVarint(bytes, type);
+    binary::appendVarint(bytes, payload.size());
+    bytes.append(payload);
+    const uint32_t checksum = fnv1a(bytes.data(), bytes.size());
+    for (int i = 0; i < 4; ++i)
+    {
+        bytes.push_back(char(uint8_t(checksum >> (8 * i))));
+    }
+
+    if (m_file.write(bytes.data(), qint64(bytes.size())) != qint64(bytes.size()) || !m_file.flush())
+    {
+        qWarning() << "写入存档日志失败:" << m_path;
+        return false;
+    }
+    ++m_lastSeq;
+    return true;
+}
+
+int SaveJournal::replay(uint64_t afterSeq, const std::function<void(RecordType, BinaryReader &)> &apply) const
+{
+    QFile file(m_path);
+    if (!file.open(QIODevice::ReadOnly))
+    {
+        return 0;
+    }
+
+    const QByteArray data = file.readAll();
+    int count = 0;
+    parse(data, [&](const Record &record) {
+        if (record.seq <= afterSeq)
+        {
+            return;
+        }
+        BinaryReader in;
+        in.openBody(record.payload, record.size);
+        apply(RecordType(record.type), in);
+        ++count;
+    });
+    return count;
+}
+
+bool SaveJournal::truncateThrough(uint64_t seq)
+{
+    if (!m_file.isOpen())
+    {
+        return false;
+    }
+
+    m_file.seek(0);
+    const QByteArray data = m_file.readAll();
+    QByteArray kept;
+    parse(data, [&](const Record &record) {
+        if (record.seq > seq)
+        {
+            kept.append(record.begin, int(record.end - record.begin));
+        }
+    });
+
+    // 通常快照之后没有新记录，直接清空即可
+    bool ok = true;
+    if (kept.isEmpty())
+    {
+        ok = m_file.resize(0);
+    }
+    else
+    {
+        m_file.close();
+        ok = SaveGame::writeFileAtomically(m_path, kept);
+        m_file.open(QIODevice::ReadWrite);
+    }
+    m_file.seek(m_file.size());
+
+    if (!ok)
+    {
+        qWarning() << "压缩存档日志失败:" << m_path;
+    }
+    return ok;
+}
+
+size_t SaveJournal::parse(const QByteArray &data, const std::function<void(const Record &)> &visit)
+{
+    const char *base = data.constData();
+    const uint8_t *pos = reinterpret_cast<const uint8_t *>(base);
+    const uint8_t *end = pos + data.size();
+    size_t valid = 0;
+
+    while (pos < end)
+    {
+        const uint8_t *begin = pos;
+        uint64_t seq = 0;
+        uint64_t type = 0;
+        uint64_t size = 0;
+        if (!binary::decodeVarint(pos, end, seq) || !binary::decodeVarint(pos, end, type) ||
+            !binary::decodeVarint(pos, end, size) || size > uint64_t(end - pos) || uint64_t(end - pos) - size < 4)
+        {
+            // 先比较再相减：损坏的长度可能接近 2^64，size + 4 会回绕成很小的数
+            break;
+        }
+
+        const uint8_t *payload = pos;
+        pos += size;
+        uint32_t checksum = 0;
+        for (int i = 0; i < 4; ++i)
+        {
+            checksum |= uint32_t(pos[i]) << (8 * i);
+        }
+        if (checksum != fnv1a(reinterpret_cast<const char *>(begin), size_t(pos - begin)))
+        {
+            break;
+        }
+        pos += 4;
+
+        Record record;
+        record.seq = seq;
+        record.type = uint32_t(type);
+        record.payload = reinterpret_cast<const char *>(payload);
+        record.size = size_t(size);
+        record.begin = reinterpret_cast<const char *>(begin);
+        record.end = reinterpret_cast<const char *>(pos);
+        visit(record);
+        valid = size_t(pos - reinterpret_cast<const uint8_t *>(base));
+    }
+    return valid;
+}
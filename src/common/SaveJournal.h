@@ -0,0 +1,92 @@
+#ifndef __SAVE_JOURNAL_H__
+#define __SAVE_JOURNAL_H__
+
+#include "BinaryCodec.h"
+#include <QFile>
+#include <QString>
+#include <functional>
+
+// 存档日志（预写日志）：两次快照之间的背包、图鉴、宠物成长和锻造修改以小记录追加到日志文件
+//
+// 记录格式：varint 序号 | varint 类型 | varint 长度 | 内容 | 4字节校验（FNV-1a，覆盖前面所有字节）
+// 内容是不带字符串表的二进制消息，记录的都是修改后的值而不是增量，重放多次结果相同（锻造历史除外，由序号保证只重放一次）
+//
+// 启动时先读快照，再重放序号大于快照中记录序号的日志；快照写盘后丢弃已经包含在快照中的记录
+// 追加只写入几十字节并刷新到系统缓冲区，进程崩溃不会丢失已追加的记录
+class SaveJournal
+{
+public:
+    enum RecordType : uint32_t
+    {
+        BackpackItem = 1, // 背包某物品的数量
+        BackpackClear,    // 清空背包
+        CollectionItem,   // 图鉴某物品的状态
+        PetProgress,      // 当前宠物类型及其等级、经验、金钱
+        ForgeHistoryItem, // 一条锻造历史及锻造统计
+        ForgeLevel        // 工作系统等级
+    };
+
+    static constexpr const char *DEFAULT_FILENAME = "save_data.journal";
+
+    SaveJournal() = default;
+    SaveJournal(const SaveJournal &) = delete;
+    SaveJournal &operator=(const SaveJournal &) = delete;
+
+    // 打开（或创建）日志文件；末尾不完整或校验失败的记录视为崩溃时未写完，直接截掉
+    bool open(const QString &path);
+    void close();
+
+    bool isOpen() const noexcept
+    {
+        return m_file.isOpen();
+    }
+
+    // 最后一条记录的序号
+    uint64_t lastSeq() const noexcept
+    {
+        return m_lastSeq;
+    }
+
+    // 保证之后的序号大于 seq（快照中记录的序号可能大于日志中剩下的记录）
+    void advanceTo(uint64_t seq) noexcept
+    {
+        if (seq > m_lastSeq)
+        {
+            m_lastSeq = seq;
+        }
+    }
+
+    // 追加一条记录，record 中不能写入字符串
+    bool append(RecordType type, const BinaryWriter &record);
+
+    // 按顺序重放序号大于 afterSeq 的记录，返回重放的条数
+    int replay(uint64_t afterSeq, const std::function<void(RecordType, BinaryReader &)> &apply) const;
+
+    // 丢弃序号不大于 seq 的记录（这些修改已经写进快照）
+    bool truncateThrough(uint64_t seq);
+
+    qint64 size() const
+    {
+        return m_file.size();
+    }
+
+private:
+    struct Record
+    {
+        uint64_t seq;
+        uint32_t type;
+        const char *payload;
+        size_t size;
+        const char *begin; // 整条记录（含校验）的起止位置
+        const char *end;
+    };
+
+    // 解析日志内容，返回完整记录的总字节数
+    static size_t parse(const QByteArray &data, const std::function<void(const Record &)> &visit);
+
+    QString m_path;
+    QFile m_file;
+    uint64_t m_lastSeq = 0;
+};
+
+#endif
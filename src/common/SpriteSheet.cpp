@@ -0,0 +1,81 @@
+#include "SpriteSheet.h"
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QDebug>
+
+bool SpriteSheet::isSpriteSheetPath(const QString &path)
+{
+    return path.endsWith(".json", Qt::CaseInsensitive);
+}
+
+bool SpriteSheet::parse(const QByteArray &json, const QString &baseDir, SpriteSheet &sheet)
+{
+    const QJsonDocument doc = QJsonDocument::fromJson(json);
+    if (!doc.isObject())
+    {
+        qDebug() << "精灵图集帧表JSON格式错误";
+        return false;
+    }
+    const QJsonObject root = doc.object();
+    const QString image = root["image"].toString();
+    const QJsonArray frames = root["frames"].toArray();
+    if (image.isEmpty() || frames.isEmpty())
+    {
+        qDebug() << "精灵图集缺少图集文件或帧表";
+        return false;
+    }
+
+    SpriteSheet result;
+    result.imagePath = QFileInfo(image).isAbsolute() || baseDir.isEmpty() ? image : baseDir + "/" + image;
+    result.loopCount = root["loop"].toInt(-1);
+    result.frames.reserve(frames.size());
+    for (const QJsonValue &value : frames)
+    {
+        const QJsonObject frame = value.toObject();
+        const QRect rect(frame["x"].toInt(), frame["y"].toInt(), frame["w"].toInt(), frame["h"].toInt());
+        if (rect.isEmpty() || rect.x() < 0 || rect.y() < 0)
+        {
+            qDebug() << "精灵图集第" << result.frames.size() << "帧的位置非法";
+            return false;
+        }
+        result.frames.append({rect, qMax(1, frame["duration"].toInt(DEFAULT_DURATION))});
+    }
+
+    sheet = result;
+    return true;
+}
+
+bool SpriteSheet::load(const QString &jsonPath, SpriteSheet &sheet)
+{
+    QFile file(jsonPath);
+    if (!file.open(QIODevice::ReadOnly))
+    {
+        qDebug() << "无法打开精灵图集帧表" << jsonPath;
+        return false;
+    }
+    return parse(file.readAll(), QFileInfo(jsonPath).path(), sheet);
+}
+
+QByteArray SpriteSheet::toJson(const QString &imageName) const
+{
+    QJsonArray array;
+    for (const SpriteFrame &frame : frames)
+    {
+        QJsonObject object;
+        object["x"] = frame.rect.x();
+        object["y"] = frame.rect.y();
+        object["w"] = frame.rect.width();
+        object["h"] = frame.rect.height();
+        object["duration"] = frame.duration;
+        array.append(object);
+    }
+
+    QJsonObject root;
+    root["image"] = imageName;
+    root["loop"] = loopCount;
+    root["frames"] = array;
+    return QJsonDocument(root).toJson(QJsonDocument::Compact);
+}
@@ -0,0 +1,44 @@
+#ifndef __SPRITE_SHEET_H__
+#define __SPRITE_SHEET_H__
+
+#include <QByteArray>
+#include <QRect>
+#include <QString>
+#include <QVector>
+
+// 精灵图集动画：一张图集 PNG 加一个 JSON 帧表，所有帧一次读入，不需要 GIF 解码器逐帧解码
+//
+// {
+//   "image": "spider.png",   // 图集文件，相对于 JSON 文件所在目录
+//   "loop": -1,              // 可选，与 QMovie 一致：-1 无限循环，n 表示首轮之后再重复 n 次
+//   "frames": [
+//     {"x": 0, "y": 0, "w": 400, "h": 97, "duration": 100},   // duration 为毫秒，缺省 100
+//     ...
+//   ]
+// }
+struct SpriteFrame
+{
+    QRect rect;   // 在图集中的位置
+    int duration; // 毫秒
+};
+
+struct SpriteSheet
+{
+    static constexpr int DEFAULT_DURATION = 100;
+
+    QString imagePath; // 已拼接好目录的图集路径
+    QVector<SpriteFrame> frames;
+    int loopCount = -1;
+
+    // 以 .json 结尾的动画路径按精灵图集读取
+    static bool isSpriteSheetPath(const QString &path);
+
+    // baseDir 用来拼接相对的图集路径；帧表为空或有非法的帧时返回false
+    static bool parse(const QByteArray &json, const QString &baseDir, SpriteSheet &sheet);
+    static bool load(const QString &jsonPath, SpriteSheet &sheet);
+
+    // 生成帧表，imageName 写入 "image" 字段
+    QByteArray toJson(const QString &imageName) const;
+};
+
+#endif
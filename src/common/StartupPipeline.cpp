@@ -0,0 +1,202 @@
+#include "StartupPipeline.h"
+#include "StartupProfiler.h"
+#include <QDebug>
+#include <QMetaObject>
+#include <QThreadPool>
+
+StartupPipeline::StartupPipeline() = default;
+
+StartupPipeline::~StartupPipeline()
+{
+    // 后台阶段持有调用方的数据，必须等它们结束
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_backgroundDone.wait(lock, [this]() { return m_backgroundRunning == 0; });
+}
+
+StartupPipeline::StageId StartupPipeline::addBackground(const QString &name, Task task)
+{
+    auto stage = std::make_unique<Stage>();
+    stage->name = name;
+    stage->task = std::move(task);
+    stage->background = true;
+    m_stages.push_back(std::move(stage));
+    return StageId(m_stages.size() - 1);
+}
+
+StartupPipeline::StageId StartupPipeline::addStage(const QString &name, const std::vector<StageId> &after, Task task)
+{
+    auto stage = std::make_unique<Stage>();
+    stage->name = name;
+    stage->task = std::move(task);
+    stage->after = after;
+    m_foreground.push_back(stage.get());
+    m_stages.push_back(std::move(stage));
+    return StageId(m_stages.size() - 1);
+}
+
+void StartupPipeline::start()
+{
+    if (m_started)
+    {
+        return;
+    }
+    m_started = true;
+    m_clock.start();
+
+    for (const auto &stage : m_stages)
+    {
+        if (!stage->background)
+        {
+            continue;
+        }
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            ++m_backgroundRunning;
+        }
+        Stage *background = stage.get();
+        QThreadPool::globalInstance()->start([this, background]() { runBackground(*background); });
+    }
+
+    // 没有依赖后台阶段的前台阶段不必等待
+    QMetaObject::invokeMethod(&m_context, [this]() { advance(); }, Qt::QueuedConnection);
+}
+
+bool StartupPipeline::waitForFinished()
+{
+    if (!m_started)
+    {
+        return true;
+    }
+
+    // 在前台阶段或其回调里调用时不能重入推进，直接返回，由外层的推进继续执行剩余阶段
+    while (!isFinished() && !m_advancing)
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_backgroundDone.wait(lock, [this]() { return dependenciesDone(*m_foreground[m_next]); });
+        }
+        advance();
+    }
+    return isFinished();
+}
+
+bool StartupPipeline::isReady(const QString &name) const
+{
+    const Stage *stage = find(name);
+    return !stage || stage->done.load();
+}
+
+void StartupPipeline::whenReady(const QString &name, Task callback)
+{
+    Stage *stage = find(name);
+    if (!stage || stage->done.load())
+    {
+        callback();
+        return;
+    }
+    stage->callbacks.push_back(std::move(callback));
+}
+
+QString StartupPipeline::report() const
+{
+    QString text = QString("启动流水线共 %1 ms\n").arg(m_foreground.empty() ? 0.0 : m_foreground.back()->endMs, 0, 'f', 1);
+    for (const auto &stage : m_stages)
+    {
+        text += QString("  %1 %2 开始 %3 ms 耗时 %4 ms\n")
+                    .arg(stage->name, -12)
+                    .arg(stage->background ? QStringLiteral("后台") : QStringLiteral("GUI "))
+                    .arg(stage->startMs, 7, 'f', 1)
+                    .arg(stage->endMs - stage->startMs, 7, 'f', 1);
+    }
+    return text;
+}
+
+double StartupPipeline::elapsedMs() const
+{
+    return m_clock.nsecsElapsed() / 1e6;
+}
+
+bool StartupPipeline::dependenciesDone(const Stage &stage) const
+{
+    for (StageId id : stage.after)
+    {
+        if (!m_stages[size_t(id)]->done.load())
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void StartupPipeline::runBackground(Stage &stage)
+{
+    stage.startMs = elapsedMs();
+    {
+        StartupProfiler::Scope profile("load:" + stage.name);
+        stage.task();
+    }
+    stage.endMs = elapsedMs();
+    stage.done = true;
+
+    // 先投递再通知；计数减到0之后析构函数随时可能返回，所以必须在持锁期间通知，
+    // 否则析构函数可能在 notify_all() 之前看到0并销毁条件变量
+    QMetaObject::invokeMethod(&m_context, [this]() { advance(); }, Qt::QueuedConnection);
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        --m_backgroundRunning;
+        m_backgroundDone.notify_all();
+    }
+}
+
+void StartupPipeline::advance()
+{
+    // 阶段或回调里可能再次调用 waitForFinished，不重入
+    if (m_advancing || isFinished())
+    {
+        return;
+    }
+    m_advancing = true;
+    while (m_next < m_foreground.size() && dependenciesDone(*m_foreground[m_next]))
+    {
+        runForeground(*m_foreground[m_next]);
+        ++m_next;
+    }
+    m_advancing = false;
+
+    if (isFinished())
+    {
+        StartupProfiler::instance().mark("loaded");
+        qDebug().noquote() << report();
+    }
+}
+
+void StartupPipeline::runForeground(Stage &stage)
+{
+    stage.startMs = elapsedMs();
+    {
+        StartupProfiler::Scope profile("load:" + stage.name);
+        stage.task();
+    }
+    stage.endMs = elapsedMs();
+    stage.done = true;
+
+    // 回调可能再登记回调，先取出来
+    std::vector<Task> callbacks;
+    callbacks.swap(stage.callbacks);
+    for (const Task &callback : callbacks)
+    {
+        callback();
+    }
+}
+
+StartupPipeline::Stage *StartupPipeline::find(const QString &name) const
+{
+    for (const auto &stage : m_stages)
+    {
+        if (stage->name == name)
+        {
+            return stage.get();
+        }
+    }
+    return nullptr;
+}
@@ -0,0 +1,93 @@
+#ifndef __STARTUP_PIPELINE_H__
+#define __STARTUP_PIPELINE_H__
+
+#include <QElapsedTimer>
+#include <QObject>
+#include <QString>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// 启动流水线
+// 后台阶段：互不依赖的耗时工作（解析配置、读取存档、构建配方表），start() 后提交到线程池并发执行，不能访问模型
+// 前台阶段：在GUI线程按添加顺序执行，等到依赖的后台阶段完成才运行，运行完即视为就绪
+// 后台阶段完成时向GUI线程投递一次推进，GUI线程在两次推进之间照常处理绘制和输入
+class StartupPipeline
+{
+public:
+    using Task = std::function<void()>;
+    using StageId = int;
+
+    StartupPipeline();
+    StartupPipeline(const StartupPipeline &) = delete;
+    StartupPipeline &operator=(const StartupPipeline &) = delete;
+
+    // 等待仍在运行的后台阶段，未执行的前台阶段直接放弃
+    ~StartupPipeline();
+
+    // 需在 start() 之前添加
+    StageId addBackground(const QString &name, Task task);
+    StageId addStage(const QString &name, const std::vector<StageId> &after, Task task);
+
+    void start();
+
+    // 阻塞等待全部阶段完成，剩余的前台阶段在调用线程（GUI线程）执行；未启动时直接返回true
+    // 在前台阶段或其回调中调用时不会等待，立即返回false（剩余阶段由外层推进执行）
+    bool waitForFinished();
+
+    bool isStarted() const noexcept
+    {
+        return m_started;
+    }
+    bool isFinished() const noexcept
+    {
+        return m_started && m_next == m_foreground.size();
+    }
+
+    // 阶段是否已完成；没有这个阶段时视为已完成
+    bool isReady(const QString &name) const;
+
+    // 阶段完成后在GUI线程调用 callback，已完成则立即调用
+    void whenReady(const QString &name, Task callback);
+
+    // 各阶段开始时间和耗时（毫秒，从 start() 算起）
+    QString report() const;
+
+private:
+    struct Stage
+    {
+        QString name;
+        Task task;
+        std::vector<StageId> after;
+        bool background = false;
+        std::atomic<bool> done{false};
+        double startMs = 0;
+        double endMs = 0;
+        std::vector<Task> callbacks;
+    };
+
+    double elapsedMs() const;
+    bool dependenciesDone(const Stage &stage) const;
+    void runBackground(Stage &stage);
+    void advance();
+    void runForeground(Stage &stage);
+    Stage *find(const QString &name) const;
+
+    std::vector<std::unique_ptr<Stage>> m_stages;
+    std::vector<Stage *> m_foreground;
+    size_t m_next = 0; // 下一个要执行的前台阶段
+    bool m_started = false;
+    bool m_advancing = false;
+    QElapsedTimer m_clock;
+
+    std::mutex m_mutex;
+    std::condition_variable m_backgroundDone;
+    int m_backgroundRunning = 0;
+
+    QObject m_context; // 投递到GUI线程的推进以它为目标，流水线析构后不会再执行
+};
+
+#endif
@@ -0,0 +1,111 @@
+#include "StartupProfiler.h"
+#include "SaveGame.h"
+#include <QCoreApplication>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QThread>
+
+namespace
+{
+
+// 没有 QCoreApplication 时（测试、工具）都算GUI线程
+bool isGuiThread()
+{
+    const QCoreApplication *app = QCoreApplication::instance();
+    return !app || QThread::currentThread() == app->thread();
+}
+
+} // namespace
+
+StartupProfiler &StartupProfiler::instance()
+{
+    static StartupProfiler profiler;
+    return profiler;
+}
+
+StartupProfiler::StartupProfiler()
+{
+    m_clock.start();
+}
+
+double StartupProfiler::elapsedMs() const
+{
+    return m_clock.nsecsElapsed() / 1e6;
+}
+
+void StartupProfiler::record(const QString &name, double startMs, double durationMs)
+{
+    if (isEnabled())
+    {
+        append(name, startMs, durationMs, false);
+    }
+}
+
+void StartupProfiler::mark(const QString &name)
+{
+    if (!isEnabled())
+    {
+        return;
+    }
+
+    // 检查和追加在同一把锁内完成，多个线程同时标记同一个名字时只记录第一个
+    const double now = elapsedMs();
+    const bool gui = isGuiThread();
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!containsMark(name))
+    {
+        m_entries.push_back(Entry{name, now, 0, gui, true});
+    }
+}
+
+bool StartupProfiler::hasMark(const QString &name) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return containsMark(name);
+}
+
+bool StartupProfiler::containsMark(const QString &name) const
+{
+    for (const Entry &entry : m_entries)
+    {
+        if (entry.mark && entry.name == name)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+void StartupProfiler::append(const QString &name, double startMs, double durationMs, bool mark)
+{
+    const bool gui = isGuiThread();
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_entries.push_back(Entry{name, startMs, durationMs, gui, mark});
+}
+
+std::vector<StartupProfiler::Entry> StartupProfiler::entries() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_entries;
+}
+
+bool StartupProfiler::writeJson(const QString &path) const
+{
+    QJsonArray array;
+    for (const Entry &entry : entries())
+    {
+        QJsonObject object;
+        object["name"] = entry.name;
+        object["start_ms"] = entry.startMs;
+        object["duration_ms"] = entry.durationMs;
+        object["thread"] = entry.gui ? "gui" : "worker";
+        object["mark"] = entry.mark;
+        array.append(object);
+    }
+
+    QJsonObject root;
+    root["version"] = 1;
+    root["entries"] = array;
+    return SaveGame::writeFileAtomically(path, QJsonDocument(root).toJson(QJsonDocument::Indented));
+}
@@ -0,0 +1,92 @@
+#ifndef __STARTUP_PROFILER_H__
+#define __STARTUP_PROFILER_H__
+
+#include <QElapsedTimer>
+#include <QString>
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+// 启动/退出剖析：记录各阶段（模型加载、CSV解析、资源解码、存档）的开始时间和耗时，输出JSON
+// 默认关闭，--profile <path> 或 DESKTOPPET_PROFILE=<path> 时启用；关闭时计时只做一次原子读
+// 时间都从 main() 开始计算，可以在任意线程记录
+class StartupProfiler
+{
+public:
+    struct Entry
+    {
+        QString name;
+        double startMs;
+        double durationMs;
+        bool gui;  // 是否在GUI线程
+        bool mark; // 时间点而不是区间
+    };
+
+    static StartupProfiler &instance();
+
+    void enable() noexcept
+    {
+        m_enabled = true;
+    }
+    bool isEnabled() const noexcept
+    {
+        return m_enabled.load(std::memory_order_relaxed);
+    }
+
+    double elapsedMs() const;
+
+    void record(const QString &name, double startMs, double durationMs);
+
+    // 记录一个时间点（如首帧显示），同名标记只记第一次
+    void mark(const QString &name);
+    bool hasMark(const QString &name) const;
+
+    std::vector<Entry> entries() const;
+
+    // {"version":1,"entries":[{"name","start_ms","duration_ms","thread":"gui|worker","mark"}...]}
+    bool writeJson(const QString &path) const;
+
+    // 作用域计时
+    class Scope
+    {
+    public:
+        explicit Scope(const QString &name)
+        {
+            if (StartupProfiler::instance().isEnabled())
+            {
+                m_name = name;
+                m_startMs = StartupProfiler::instance().elapsedMs();
+                m_active = true;
+            }
+        }
+        ~Scope()
+        {
+            if (m_active)
+            {
+                StartupProfiler &profiler = StartupProfiler::instance();
+                profiler.record(m_name, m_startMs, profiler.elapsedMs() - m_startMs);
+            }
+        }
+
+        Scope(const Scope &) = delete;
+        Scope &operator=(const Scope &) = delete;
+
+    private:
+        QString m_name;
+        double m_startMs = 0;
+        bool m_active = false;
+    };
+
+private:
+    StartupProfiler();
+
+    void append(const QString &name, double startMs, double durationMs, bool mark);
+    bool containsMark(const QString &name) const; // 调用方持有 m_mutex
+
+    QElapsedTimer m_clock;
+    std::atomic<bool> m_enabled{false};
+    mutable std::mutex m_mutex;
+    std::vector<Entry> m_entries;
+};
+
+#endif
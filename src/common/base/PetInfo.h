@@ -4,6 +4,7 @@
 #include <QPoint>
 #include <QString>
 #include <QSize>
+#include <memory>
 #include "../../common/Types.h"
 
 enum class PetState {
@@ -30,6 +31,11 @@ struct PetInfo
     int experience{0};               // 当前经验值
     int experienceToNextLevel{100};  // 升级所需经验值
     int money{0};                    // 金钱
+
+    quint64 version{0};              // 快照版本，PetModel 每次发布递增
 };
 
+// 发布后不再修改的 PetInfo 快照，可以在任意线程持有和读取
+using PetInfoSnapshot = std::shared_ptr<const PetInfo>;
+
 #endif
@@ -1,16 +1,14 @@
 #include "AutoMovementModel.h"
 #include "PetModel.h"
 #include "../common/PropertyIds.h"
+#include "../common/FrameClock.h"
 #include <QApplication>
+#include <QGuiApplication>
 #include <QScreen>
 #include <QCursor>
-#include <QRandomGenerator>
 #include <QDebug>
-#include <QtMath>
 #include <cmath>
-#include <Windows.h>
-#include <CommCtrl.h>
-#include <shellapi.h>
+#include <algorithm>
 
 #ifndef M_PI
 #define M_PI 3.14159265358979323846
@@ -25,12 +23,19 @@ AutoMovementModel::AutoMovementModel(QObject *parent)
     , m_cornerStayTimer(new QTimer(this))
     , m_interactionTimer(new QTimer(this))
     , m_iconRefreshTimer(new QTimer(this))
+    , m_followSystemScreens(true)
     , m_petSize(DEFAULT_PET_WIDTH, DEFAULT_PET_HEIGHT)
+    , m_pathIndex(0)
+    , m_pathRevision(0)
+    , m_interactedCount(0)
     , m_isInteracting(false)
+    , m_iconsLoaded(false)
     , m_iconRefreshInterval(5000)  // 5秒刷新一次图标信息
+    , m_rng(&RandomService::GetInstance().stream(RandomStream::Movement))
 {
     // 初始化定时器
     m_updateTimer->setSingleShot(false);
+    m_updateTimer->setTimerType(Qt::PreciseTimer);
     m_pauseTimer->setSingleShot(true);
     m_cornerStayTimer->setSingleShot(true);
     m_interactionTimer->setSingleShot(true);
@@ -47,8 +52,8 @@ AutoMovementModel::AutoMovementModel(QObject *parent)
     
     // 设置默认配置
     m_config.mode = AutoMovementMode::RandomMovement;
-    m_config.speed = 10;
-    m_config.updateInterval = 50;
+    m_config.maxSpeed = 200.0;
+    m_config.acceleration = 800.0;
     m_config.enableRandomPause = false;
     m_config.pauseProbability = 0;
     m_config.pauseDuration = 0;
@@ -58,11 +63,9 @@ AutoMovementModel::AutoMovementModel(QObject *parent)
     m_config.interactionAnimation = ":/resources/gif/kicking.gif";
     m_config.interactionDuration = 1500;
     
-    qDebug() << "AutoMovementModel initialized with screen rect:" << m_screenRect;
+    qDebug() << "AutoMovementModel initialized with" << m_screens.count() << "screens, bounds:" << m_screens.bounds();
     
-    // 初始化桌面图标信息（只在构造时做一次）
-    refreshDesktopIcons();
-    qDebug() << "Loaded" << m_desktopIcons.size() << "desktop icons for interaction";
+    // 桌面图标枚举较慢，推迟到第一次启动自动移动时进行，不占用启动时间
 }
 
 AutoMovementModel::~AutoMovementModel()
@@ -72,17 +75,20 @@ AutoMovementModel::~AutoMovementModel()
 
 void AutoMovementModel::setConfig(const AutoMovementConfig& config)
 {
+    const bool radiusChanged = config.iconDetectionRadius != m_config.iconDetectionRadius;
     m_config = config;
     
-    // 更新定时器间隔
-    if (m_config.updateInterval > 0) {
-        m_updateTimer->setInterval(m_config.updateInterval);
+    // 网格格子边长等于检测半径，半径变化后需要重建
+    if (radiusChanged && m_iconsLoaded) {
+        rebuildIconGrid();
     }
     
+    m_motion.setLimits(m_config.maxSpeed, m_config.acceleration);
+    
     qDebug() << "AutoMovement config updated:"
              << "mode=" << static_cast<int>(m_config.mode)
-             << "speed=" << m_config.speed
-             << "interval=" << m_config.updateInterval;
+             << "maxSpeed=" << m_config.maxSpeed
+             << "acceleration=" << m_config.acceleration;
 }
 
 void AutoMovementModel::startAutoMovement()
@@ -102,25 +108,32 @@ void AutoMovementModel::startAutoMovement()
     if (m_petModel) {
         m_lastPosition = m_petModel->get_info()->position;
         m_petSize = m_petModel->get_info()->size;
+        m_screens.setPetSize(m_petSize);
         m_originalAnimation = m_petModel->get_info()->currentAnimation;
         qDebug() << "Pet current position:" << m_lastPosition << "size:" << m_petSize;
     }
     
-    // 设置初始随机目标
-    m_currentTarget = getRandomScreenPoint();
+    // 从当前位置静止起步，设置初始随机目标
+    m_motion.setLimits(m_config.maxSpeed, m_config.acceleration);
+    m_motion.reset(QPointF(m_lastPosition));
+    planPathTo(getRandomScreenPoint());
     qDebug() << "RandomMovement mode - initial target:" << m_currentTarget;
     
-    // 启动定时器
-    m_updateTimer->start(m_config.updateInterval);
+    // 启动帧节拍
+    startFrameTicks();
     
     // 启动图标刷新定时器（低频率）
     if (m_config.enableIconInteraction) {
+        if (!m_iconsLoaded) {
+            refreshDesktopIcons();
+            qDebug() << "Loaded" << m_desktopIcons.size() << "desktop icons for interaction";
+        }
         m_iconRefreshTimer->start(m_iconRefreshInterval);
         qDebug() << "Icon refresh timer started with interval:" << m_iconRefreshInterval << "ms";
     }
     
     qDebug() << "AutoMovement started successfully with mode:" << static_cast<int>(m_config.mode)
-             << "update interval:" << m_config.updateInterval
+             << "frame interval:" << m_updateTimer->interval()
              << "initial target:" << m_currentTarget;
 }
 
@@ -134,11 +147,16 @@ void AutoMovementModel::stopAutoMovement()
     m_isPaused = false;
     
     // 停止所有定时器
-    m_updateTimer->stop();
+    stopFrameTicks();
     m_pauseTimer->stop();
     m_cornerStayTimer->stop();
     m_iconRefreshTimer->stop();
     
+    // 提交快速通道更新的最终位置，通知其他观察者
+    if (m_petModel) {
+        m_petModel->commit_position();
+    }
+    
     qDebug() << "AutoMovement stopped";
 }
 
@@ -147,38 +165,143 @@ void AutoMovementModel::setPetModel(std::shared_ptr<PetModel> petModel)
     m_petModel = petModel;
     if (m_petModel) {
         m_petSize = m_petModel->get_info()->size;
+        m_screens.setPetSize(m_petSize);
         m_lastPosition = m_petModel->get_info()->position;
     }
 }
 
 void AutoMovementModel::setScreenRect(const QRect& screenRect)
 {
-    m_screenRect = screenRect;
-    qDebug() << "Screen rect set to:" << m_screenRect;
+    m_followSystemScreens = false;
+    ScreenInfo info;
+    info.name = QStringLiteral("custom");
+    info.geometry = screenRect;
+    info.availableGeometry = screenRect;
+    m_screens.setScreens({info});
+    applyScreenTopology();
+    qDebug() << "Screen rect set to:" << screenRect;
 }
 
 void AutoMovementModel::initializeScreenInfo()
 {
-    // 获取主屏幕信息
-    QScreen* primaryScreen = QApplication::primaryScreen();
-    if (primaryScreen) {
-        m_screenRect = primaryScreen->geometry();
-    } else {
+    m_screens.setPetSize(m_petSize);
+    
+    // 屏幕增删、分辨率/DPI/刷新率变化时重建缓存，每帧只读缓存，不再查询 QScreen
+    if (auto* app = qobject_cast<QGuiApplication*>(QCoreApplication::instance())) {
+        connect(app, &QGuiApplication::screenAdded, this, [this](QScreen* screen) {
+            watchScreen(screen);
+            refreshScreenTopology();
+        });
+        connect(app, &QGuiApplication::screenRemoved, this, &AutoMovementModel::refreshScreenTopology);
+        connect(app, &QGuiApplication::primaryScreenChanged, this, &AutoMovementModel::refreshScreenTopology);
+        for (QScreen* screen : QGuiApplication::screens()) {
+            watchScreen(screen);
+        }
+    }
+    refreshScreenTopology();
+}
+
+void AutoMovementModel::watchScreen(QScreen* screen)
+{
+    connect(screen, &QScreen::geometryChanged, this, &AutoMovementModel::refreshScreenTopology);
+    connect(screen, &QScreen::availableGeometryChanged, this, &AutoMovementModel::refreshScreenTopology);
+    connect(screen, &QScreen::logicalDotsPerInchChanged, this, &AutoMovementModel::refreshScreenTopology);
+    connect(screen, &QScreen::refreshRateChanged, this, &AutoMovementModel::refreshScreenTopology);
+}
+
+void AutoMovementModel::refreshScreenTopology()
+{
+    if (!m_followSystemScreens) {
+        return;
+    }
+    
+    QVector<ScreenInfo> screens;
+    for (QScreen* screen : QGuiApplication::screens()) {
+        ScreenInfo info;
+        info.name = screen->name();
+        info.geometry = screen->geometry();
+        info.availableGeometry = screen->availableGeometry();
+        info.devicePixelRatio = screen->devicePixelRatio();
+        info.logicalDpi = screen->logicalDotsPerInch();
+        info.refreshRate = screen->refreshRate();
+        screens.append(info);
+    }
+    if (screens.isEmpty()) {
         // 默认屏幕大小
-        m_screenRect = QRect(0, 0, 1920, 1080);
+        ScreenInfo info;
+        info.geometry = QRect(0, 0, 1920, 1080);
+        screens.append(info);
+    }
+    m_screens.setScreens(screens);
+    applyScreenTopology();
+    qDebug() << "Screen topology updated:" << m_screens.count() << "screens, bounds:" << m_screens.bounds();
+}
+
+void AutoMovementModel::applyScreenTopology()
+{
+    resetNavGrid();
+    emit screenTopologyChanged();
+    if (!m_isActive || !m_petModel) {
+        return;
+    }
+    
+    // 宠物所在的屏幕被移除或缩小时拉回可活动区域，从新位置重新选择目标
+    const QPoint constrainedPos = constrainToScreen(m_lastPosition);
+    if (constrainedPos != m_lastPosition) {
+        m_lastPosition = constrainedPos;
+        m_petModel->stream_position(constrainedPos);
+    }
+    m_motion.reset(QPointF(m_lastPosition));
+    if (m_updateTimer->isActive()) {
+        startFrameTicks();
+    }
+}
+
+void AutoMovementModel::resetNavGrid()
+{
+    m_navGrid.reset(m_screens.bounds());
+    m_navGrid.setObstacles(navObstacleRects());
+    m_path.clear();
+}
+
+void AutoMovementModel::startFrameTicks()
+{
+    // 帧间隔跟随宠物所在屏幕的刷新率（取自屏幕缓存）
+    const int screen = m_screens.screenAt(m_lastPosition + petCenterOffset());
+    m_updateTimer->start(frameIntervalMs(screen >= 0 ? m_screens.screen(screen).refreshRate : 0.0));
+    m_frameClock.start();
+    // 窗口的取样定时器跟随帧节拍启停
+    if (m_petModel) {
+        m_petModel->set_moving(true);
+    }
+}
+
+void AutoMovementModel::stopFrameTicks()
+{
+    m_updateTimer->stop();
+    m_frameClock.invalidate();
+    if (m_petModel) {
+        m_petModel->set_moving(false);
     }
 }
 
 void AutoMovementModel::updateMovement()
 {
     if (!m_isActive || !m_petModel || m_isPaused || m_isInteracting) {
+        stopFrameTicks();
         return;
     }
     
+    // 按实际经过的时间推进，定时器抖动和刷新率不影响移动速度
+    const double dt = m_frameClock.isValid() ? m_frameClock.restart() / 1000.0 : 0.0;
+    if (!m_frameClock.isValid()) {
+        m_frameClock.start();
+    }
+    
     // 根据模式处理移动
     switch (m_config.mode) {
     case AutoMovementMode::RandomMovement:
-        processRandomMovement();
+        processRandomMovement(dt);
         // 如果启用了图标交互功能，检测并与图标交互
         if (m_config.enableIconInteraction) {
             detectAndInteractWithIcons();
@@ -192,6 +315,9 @@ void AutoMovementModel::updateMovement()
 void AutoMovementModel::onPauseTimeout()
 {
     m_isPaused = false;
+    if (m_isActive && !m_isInteracting) {
+        startFrameTicks();
+    }
     qDebug() << "Resume movement after pause";
 }
 
@@ -199,6 +325,9 @@ void AutoMovementModel::onInteractionComplete()
 {
     m_isInteracting = false;
     restoreOriginalAnimation();
+    if (m_isActive && !m_isPaused) {
+        startFrameTicks();
+    }
     qDebug() << "Interaction animation completed, resuming movement";
 }
 
@@ -206,117 +335,164 @@ void AutoMovementModel::refreshDesktopIconsSlot()
 {
     if (m_config.enableIconInteraction) {
         refreshDesktopIcons();
-        qDebug() << "Desktop icons refreshed periodically";
     }
 }
 
-void AutoMovementModel::processRandomMovement()
+void AutoMovementModel::processRandomMovement(double dt)
 {
-    QPoint currentPos = m_petModel->get_info()->position;
-    
-    // 每隔一定时间或到达目标时，随机选择新的移动方向
-    QPoint diff = m_currentTarget - currentPos;
-    int distance = qSqrt(diff.x() * diff.x() + diff.y() * diff.y());
+    // 位置被其他途径改动过（例如拖动后恢复），从新位置静止起步并重新规划
+    const QPoint currentPos = m_petModel->get_info()->position;
+    if (currentPos != m_lastPosition) {
+        m_motion.reset(QPointF(currentPos));
+        m_lastPosition = currentPos;
+        m_path.clear();
+    }
     
-    // 如果接近目标或距离太小，立即选择新的随机目标
-    if (distance < m_config.speed * 2) {
-        // 生成随机的移动方向
-        int angle = getRandomInt(0, 359); // 0-359度
-        double radian = angle * M_PI / 180.0;
-        
-        // 计算移动距离（在屏幕范围内的随机距离）
-        int moveDistance = getRandomInt(100, 300);
-        
-        // 计算新目标位置
-        int newX = currentPos.x() + static_cast<int>(moveDistance * cos(radian));
-        int newY = currentPos.y() + static_cast<int>(moveDistance * sin(radian));
-        
-        m_currentTarget = QPoint(newX, newY);
-        
-        // 确保目标在屏幕范围内
-        m_currentTarget = constrainToScreen(m_currentTarget);
-        
-        qDebug() << "New random target:" << m_currentTarget << "angle:" << angle;
-        return;
+    // 障碍物变化后检查剩余路径，被挡住时重新规划到同一个目标
+    if (!m_path.isEmpty() && m_pathRevision != m_navGrid.revision()) {
+        repairPath();
     }
     
-    // 计算下一步位置
-    QPoint nextPos = currentPos;
-    if (distance > 0) {
-        double ratio = static_cast<double>(m_config.speed) / distance;
-        nextPos.setX(currentPos.x() + static_cast<int>(diff.x() * ratio));
-        nextPos.setY(currentPos.y() + static_cast<int>(diff.y() * ratio));
+    // 沿路点前进：中间路点接近时直接转向下一个，不减速停下；到达终点后选择新的目标
+    const QPoint petCenter = currentPos + petCenterOffset();
+    if (m_pathIndex + 1 < m_path.size()) {
+        const QPoint toWaypoint = m_path[m_pathIndex] - petCenter;
+        // 限制在屏幕内后可能到不了路点附近，停下时同样前往下一个
+        if (QPoint::dotProduct(toWaypoint, toWaypoint) <= m_navGrid.cellSize() * m_navGrid.cellSize() ||
+            m_motion.hasArrived()) {
+            ++m_pathIndex;
+            m_motion.setTarget(QPointF(constrainToScreen(m_path[m_pathIndex] - petCenterOffset())));
+        }
+    } else if (m_path.isEmpty() || m_motion.hasArrived()) {
+        chooseNextTarget(currentPos);
     }
     
-    // 约束到屏幕范围
-    nextPos = constrainToScreen(nextPos);
+    QPoint nextPos = m_motion.step(dt).toPoint();
     
-    // 如果碰到屏幕边缘，立即改变方向
-    if (nextPos.x() <= 0 || nextPos.x() >= m_screenRect.width() - m_petSize.width() ||
-        nextPos.y() <= 0 || nextPos.y() >= m_screenRect.height() - m_petSize.height()) {
-        
-        // 反向移动或随机新方向
-        int angle = getRandomInt(0, 359);
-        double radian = angle * M_PI / 180.0;
-        int moveDistance = getRandomInt(100, 200);
-        
-        int newX = currentPos.x() + static_cast<int>(moveDistance * cos(radian));
-        int newY = currentPos.y() + static_cast<int>(moveDistance * sin(radian));
-        
-        m_currentTarget = constrainToScreen(QPoint(newX, newY));
+    // 约束到屏幕范围；碰到屏幕边缘时停下并换一个方向
+    const QPoint constrainedPos = constrainToScreen(nextPos);
+    if (constrainedPos != nextPos) {
+        nextPos = constrainedPos;
+        m_motion.reset(QPointF(nextPos));
+        planPathTo(randomTargetFrom(nextPos, 100, 200));
         qDebug() << "Hit boundary, new direction:" << m_currentTarget;
     }
     
-    // 更新宠物位置
-    if (nextPos != currentPos) {
-        m_petModel->change_position(nextPos);
+    // 更新宠物位置：走位置快速通道，窗口按自己的帧节奏取样，不经过通知链
+    if (nextPos != m_lastPosition) {
+        m_petModel->stream_position(nextPos);
         m_lastPosition = nextPos;
     }
 }
 
+void AutoMovementModel::chooseNextTarget(const QPoint& from)
+{
+    // 大部分时间随机走动，偶尔去找还没交互过的图标、走到屏幕角落或者跑向鼠标
+    const int roll = getRandomInt(0, 99);
+    if (roll < 20 && m_config.enableIconInteraction && m_interactedCount < m_desktopIcons.size()) {
+        const int start = getRandomInt(0, m_desktopIcons.size() - 1);
+        for (int k = 0; k < m_desktopIcons.size(); ++k) {
+            const int i = (start + k) % m_desktopIcons.size();
+            if (m_desktopIcons[i].isVisible && !m_interactedMask[i]) {
+                planPathTo(m_desktopIcons[i].rect.center() - petCenterOffset());
+                qDebug() << "Heading to desktop icon:" << m_desktopIcons[i].text;
+                return;
+            }
+        }
+    }
+    if (roll >= 20 && roll < 30) {
+        // 宠物所在屏幕的四个角
+        const QRect area = m_screens.walkableRect(std::max(0, m_screens.screenAt(from + petCenterOffset())));
+        const QPoint corners[4] = {area.topLeft(), area.topRight(),
+                                   area.bottomLeft(), area.bottomRight()};
+        planPathTo(corners[getRandomInt(0, 3)]);
+        qDebug() << "Heading to screen corner:" << m_currentTarget;
+        return;
+    }
+    if (roll >= 30 && roll < 35) {
+        planPathTo(QCursor::pos() - petCenterOffset());
+        qDebug() << "Heading to cursor:" << m_currentTarget;
+        return;
+    }
+    planPathTo(randomTargetFrom(from, 100, 300));
+}
+
+void AutoMovementModel::planPathTo(const QPoint& target)
+{
+    // 目标限制在屏幕内，在宠物中心点的坐标系里寻路
+    m_currentTarget = constrainToScreen(target);
+    const QPoint start = m_lastPosition + petCenterOffset();
+    const QPoint goal = m_currentTarget + petCenterOffset();
+    if (!m_navGrid.findPath(start, goal, m_path)) {
+        // 被障碍物隔开或超出导航范围时直接走直线
+        m_path = {goal};
+    }
+    m_pathIndex = 0;
+    m_pathRevision = m_navGrid.revision();
+    m_motion.setTarget(QPointF(constrainToScreen(m_path.front() - petCenterOffset())));
+}
+
+void AutoMovementModel::repairPath()
+{
+    m_pathRevision = m_navGrid.revision();
+    QPoint from = m_lastPosition + petCenterOffset();
+    for (int i = m_pathIndex; i < m_path.size(); ++i) {
+        // 与寻路时的规则一致：起点或终点（例如走向图标）本身在障碍物里时，进出这片障碍物的线段不算被挡住
+        const bool blockedGoal = i == m_path.size() - 1 && m_navGrid.isBlocked(m_path[i]);
+        if (!blockedGoal && !m_navGrid.isBlocked(from) && !m_navGrid.isSegmentClear(from, m_path[i])) {
+            qDebug() << "Path blocked by changed obstacles, replanning to" << m_currentTarget;
+            planPathTo(m_currentTarget);
+            return;
+        }
+        from = m_path[i];
+    }
+}
+
+QPoint AutoMovementModel::randomTargetFrom(const QPoint& from, int minDistance, int maxDistance)
+{
+    int angle = getRandomInt(0, 359); // 0-359度
+    double radian = angle * M_PI / 180.0;
+    int moveDistance = getRandomInt(minDistance, maxDistance);
+    
+    int newX = from.x() + static_cast<int>(moveDistance * cos(radian));
+    int newY = from.y() + static_cast<int>(moveDistance * sin(radian));
+    return QPoint(newX, newY);
+}
+
 QPoint AutoMovementModel::getRandomScreenPoint()
 {
+    if (m_screens.isEmpty()) {
+        return m_lastPosition;
+    }
+    
+    // 随机选一块屏幕，在它的可活动范围内取点
+    const QRect area = m_screens.walkableRect(getRandomInt(0, m_screens.count() - 1));
     int margin = 50; // 距离边缘的安全距离
-    int x = getRandomInt(margin, m_screenRect.width() - margin - m_petSize.width());
-    int y = getRandomInt(margin, m_screenRect.height() - margin - m_petSize.height());
+    int x = getRandomInt(area.left() + margin, area.right() - margin);
+    int y = getRandomInt(area.top() + margin, area.bottom() - margin);
     return QPoint(x, y);
 }
 
 bool AutoMovementModel::isPositionValid(const QPoint& pos)
 {
-    return m_screenRect.contains(pos) && 
-           m_screenRect.contains(QPoint(pos.x() + m_petSize.width(), pos.y() + m_petSize.height()));
+    return m_screens.constrain(pos) == pos;
 }
 
 QPoint AutoMovementModel::constrainToScreen(const QPoint& pos)
 {
-    QPoint constrainedPos = pos;
-    
-    // 限制到屏幕范围内
-    if (constrainedPos.x() < m_screenRect.left()) {
-        constrainedPos.setX(m_screenRect.left());
-    } else if (constrainedPos.x() + m_petSize.width() > m_screenRect.right()) {
-        constrainedPos.setX(m_screenRect.right() - m_petSize.width());
-    }
-    
-    if (constrainedPos.y() < m_screenRect.top()) {
-        constrainedPos.setY(m_screenRect.top());
-    } else if (constrainedPos.y() + m_petSize.height() > m_screenRect.bottom()) {
-        constrainedPos.setY(m_screenRect.bottom() - m_petSize.height());
-    }
-    
-    return constrainedPos;
+    // 限制到宠物所在屏幕（或最近的屏幕）的可活动范围内，相邻屏幕之间可以直接走过去
+    return m_screens.constrain(pos);
 }
 
 int AutoMovementModel::getRandomInt(int min, int max)
 {
     if (min >= max) return min;
-    return QRandomGenerator::global()->bounded(min, max + 1);
+    return m_rng->bounded(min, max + 1);
 }
 
 bool AutoMovementModel::shouldPause()
 {
-    return QRandomGenerator::global()->bounded(100) < m_config.pauseProbability;
+    return m_rng->bounded(100) < m_config.pauseProbability;
 }
 
 void AutoMovementModel::detectAndInteractWithIcons()
@@ -327,33 +503,81 @@ void AutoMovementModel::detectAndInteractWithIcons()
     QPoint petCenter = QPoint(currentPos.x() + m_petSize.width() / 2,
                              currentPos.y() + m_petSize.height() / 2);
     
-    // 不再每次都刷新桌面图标位置，而是使用缓存的图标信息
-    // refreshDesktopIcons(); // 删除这行，改为定时刷新
+    // 只检查网格中附近格子里的图标，耗时与图标总数无关
+    // 候选按下标排序后再掷骰子，保持与逐个遍历图标时相同的顺序和随机数消耗
+    m_iconCandidates.clear();
+    m_iconGrid.query(petCenter, m_config.iconDetectionRadius, [this](int index) {
+        if (!m_interactedMask[index]) {
+            m_iconCandidates.append(index);
+        }
+    });
+    std::sort(m_iconCandidates.begin(), m_iconCandidates.end());
     
-    // 检测是否接近任何图标
-    for (int i = 0; i < m_desktopIcons.size(); ++i) {
+    for (int i : m_iconCandidates) {
         const DesktopIconInfo& icon = m_desktopIcons[i];
-        if (!icon.isVisible) continue;
         
-        // 检查是否已经与此图标交互过
-        if (m_interactedIcons.contains(i)) continue;
-        
-        if (isNearIcon(petCenter, icon)) {
-            // 随机决定是否与图标交互
-            if (getRandomInt(0, 100) < m_config.iconInteractionProbability) {
-                playInteractionAnimation();
-                m_interactedIcons.append(i);
-                qDebug() << "Interacting with desktop icon:" << icon.text 
-                         << "at position:" << icon.rect.center();
-                break; // 一次只与一个图标交互
-            }
+        // 随机决定是否与图标交互
+        if (getRandomInt(0, 100) < m_config.iconInteractionProbability) {
+            playInteractionAnimation();
+            m_interactedMask[i] = true;
+            ++m_interactedCount;
+            qDebug() << "Interacting with desktop icon:" << icon.text 
+                     << "at position:" << icon.rect.center();
+            break; // 一次只与一个图标交互
         }
     }
 }
 
+void AutoMovementModel::setObstacleProvider(std::unique_ptr<IDesktopObstacleProvider> provider)
+{
+    m_obstacleProvider = std::move(provider);
+    if (m_iconsLoaded) {
+        refreshDesktopIcons();
+    }
+}
+
 void AutoMovementModel::refreshDesktopIcons()
 {
-    m_desktopIcons = getDesktopIcons();
+    if (!m_obstacleProvider) {
+        m_obstacleProvider = createDefaultObstacleProvider();
+        qDebug() << "Using desktop obstacle provider:" << m_obstacleProvider->name();
+    }
+    
+    // 增量刷新：只有障碍物真的变化时才改写列表并重建网格
+    const ObstacleDiff diff = mergeObstacles(m_desktopIcons, m_interactedMask, m_obstacleProvider->enumerate());
+    const bool firstLoad = !m_iconsLoaded;
+    m_iconsLoaded = true;
+    if (!diff.changed() && !firstLoad) {
+        return;
+    }
+    
+    m_interactedCount = static_cast<int>(std::count(m_interactedMask.begin(), m_interactedMask.end(), true));
+    rebuildIconGrid();
+    m_navGrid.setObstacles(navObstacleRects());
+    qDebug() << "Desktop obstacles changed: added" << diff.added << "removed" << diff.removed
+             << "updated" << diff.updated << "total" << m_desktopIcons.size();
+}
+
+QVector<QRect> AutoMovementModel::visibleObstacleRects() const
+{
+    // 不可见的障碍物用空区域占位，保持下标与 m_desktopIcons 一致
+    QVector<QRect> rects;
+    rects.reserve(m_desktopIcons.size());
+    for (const DesktopIconInfo& icon : m_desktopIcons) {
+        rects.append(icon.isVisible ? icon.rect : QRect());
+    }
+    return rects;
+}
+
+QVector<QRect> AutoMovementModel::navObstacleRects() const
+{
+    // 屏幕之间的空隙放在最后，刷新图标时前面的下标不变，导航网格可以逐项比较
+    return visibleObstacleRects() + m_screens.deadZones();
+}
+
+void AutoMovementModel::rebuildIconGrid()
+{
+    m_iconGrid.build(visibleObstacleRects(), m_config.iconDetectionRadius);
 }
 
 void AutoMovementModel::playInteractionAnimation()
@@ -362,6 +586,10 @@ void AutoMovementModel::playInteractionAnimation()
     
     m_isInteracting = true;
     
+    // 交互期间宠物不动，停掉帧节拍，不再唤醒
+    stopFrameTicks();
+    m_motion.reset(QPointF(m_lastPosition));
+    
     // 播放交互动画
     m_petModel->change_animation(m_config.interactionAnimation);
     
@@ -381,91 +609,3 @@ void AutoMovementModel::restoreOriginalAnimation()
     
     qDebug() << "Restored original animation:" << m_originalAnimation;
 }
-
-QVector<DesktopIconInfo> AutoMovementModel::getDesktopIcons()
-{
-    QVector<DesktopIconInfo> icons;
-    
-    // 暂时禁用Windows API调用，只使用模拟图标来避免系统卡死
-    // 如果无法获取真实图标，创建一些模拟的桌面图标位置用于测试
-    QVector<QPoint> iconPositions = {
-        QPoint(50, 50),    // 左上角
-        QPoint(50, 150),   // 左侧
-        QPoint(50, 250),   // 左侧
-        QPoint(150, 50),   // 上方
-        QPoint(150, 150),  // 中间偏左
-        QPoint(250, 50),   // 上方
-        QPoint(250, 150),  // 中间
-    };
-    
-    for (int i = 0; i < iconPositions.size(); ++i) {
-        DesktopIconInfo iconInfo;
-        iconInfo.rect = QRect(iconPositions[i].x(), iconPositions[i].y(), 48, 48); // 标准图标大小
-        iconInfo.hwnd = nullptr;
-        iconInfo.index = i;
-        iconInfo.isVisible = true;
-        iconInfo.text = QString("Test_Icon_%1").arg(i + 1);
-        
-        icons.append(iconInfo);
-    }
-    qDebug() << "Using" << icons.size() << "simulated desktop icons for testing";
-    
-    /*
-    // Windows API实现（暂时注释掉以避免系统卡死）
-    // 找到桌面窗口
-    HWND hDesktop = FindWindow(L"Progman", NULL);
-    if (!hDesktop) {
-        hDesktop = FindWindow(L"WorkerW", NULL);
-    }
-    
-    if (hDesktop) {
-        // 找到桌面图标列表视图
-        HWND hDefView = FindWindowEx(hDesktop, NULL, L"SHELLDLL_DefView", NULL);
-        if (hDefView) {
-            HWND hListView = FindWindowEx(hDefView, NULL, L"SysListView32", NULL);
-            if (hListView) {
-                // 获取图标数量
-                int iconCount = ListView_GetItemCount(hListView);
-                qDebug() << "Found" << iconCount << "desktop icons";
-                
-                for (int i = 0; i < iconCount; ++i) {
-                    RECT iconRect;
-                    if (ListView_GetItemRect(hListView, i, &iconRect, LVIR_BOUNDS)) {
-                        DesktopIconInfo iconInfo;
-                        iconInfo.rect = QRect(iconRect.left, iconRect.top, 
-                                            iconRect.right - iconRect.left, 
-                                            iconRect.bottom - iconRect.top);
-                        iconInfo.hwnd = hListView;
-                        iconInfo.index = i;
-                        iconInfo.isVisible = true;
-                        
-                        // 获取图标文本
-                        wchar_t buffer[256];
-                        ListView_GetItemText(hListView, i, 0, buffer, sizeof(buffer) / sizeof(wchar_t));
-                        iconInfo.text = QString::fromWCharArray(buffer);
-                        
-                        icons.append(iconInfo);
-                    }
-                }
-            } else {
-                qDebug() << "Could not find SysListView32 window";
-            }
-        } else {
-            qDebug() << "Could not find SHELLDLL_DefView window";
-        }
-    } else {
-        qDebug() << "Could not find desktop window";
-    }
-    */
-    
-    return icons;
-}
-
-bool AutoMovementModel::isNearIcon(const QPoint& pos, const DesktopIconInfo& icon)
-{
-    QPoint iconCenter = icon.rect.center();
-    int distance = qSqrt(qPow(pos.x() - iconCenter.x(), 2) + qPow(pos.y() - iconCenter.y(), 2));
-    return distance <= m_config.iconDetectionRadius;
-}
-
-
@@ -3,6 +3,13 @@
 
 #include "../common/PropertyTrigger.h"
 #include "../common/Types.h"
+#include "../common/RandomService.h"
+#include "IconSpatialGrid.h"
+#include "DesktopObstacleProvider.h"
+#include "MotionIntegrator.h"
+#include "NavGrid.h"
+#include "ScreenTopology.h"
+#include <QElapsedTimer>
 #include <QTimer>
 #include <QPoint>
 #include <QSize>
@@ -10,32 +17,17 @@
 #include <QScreen>
 #include <memory>
 #include <QVector>
-#include <Windows.h>
-#include <CommCtrl.h>
+#include <vector>
 
 class PetModel;
 
-/**
- * 桌面图标信息结构
- */
-struct DesktopIconInfo {
-    QRect rect;          // 图标的位置和大小
-    QString text;        // 图标的文本
-    HWND hwnd;           // 图标所在的窗口句柄
-    int index;           // 图标在列表中的索引
-    bool isVisible;      // 图标是否可见
-    
-    DesktopIconInfo() : hwnd(nullptr), index(-1), isVisible(true) {}
-};
-
-
 /**
  * 自动移动配置结构
  */
 struct AutoMovementConfig {
     AutoMovementMode mode = AutoMovementMode::Disabled;
-    int speed = 10;                    // 移动速度（像素/帧）
-    int updateInterval = 50;          // 更新间隔（毫秒）
+    double maxSpeed = 200.0;          // 最大移动速度（像素/秒）
+    double acceleration = 800.0;      // 加速度（像素/秒²），起步、转向和到达时平滑过渡
     bool enableRandomPause = false;   // 是否启用随机暂停（已禁用）
     int pauseProbability = 0;         // 暂停概率（百分比）
     int pauseDuration = 0;            // 暂停持续时间（毫秒）
@@ -74,8 +66,9 @@ public:
     // 设置关联的宠物模型
     void setPetModel(std::shared_ptr<PetModel> petModel);
 
-    // 设置屏幕区域（可选，默认使用主屏幕）
+    // 设置屏幕区域（可选，默认使用系统的所有屏幕并跟随屏幕变化；设置后固定为这一块区域）
     void setScreenRect(const QRect& screenRect);
+    const ScreenTopology& getScreenTopology() const { return m_screens; }
 
     // 获取当前状态
     AutoMovementMode getCurrentMode() const { return m_config.mode; }
@@ -85,28 +78,56 @@ public:
     PropertyTrigger& getTrigger() { return m_trigger; }
     
     // 桌面图标管理
+    // 替换障碍物来源（测试和基准使用合成障碍物）；传入空指针时在下次刷新时重新按平台选择
+    void setObstacleProvider(std::unique_ptr<IDesktopObstacleProvider> provider);
     void refreshDesktopIcons();
-    int getInteractedIconCount() const { return m_interactedIcons.size(); }
+    int getInteractedIconCount() const { return m_interactedCount; }
+
+    // 注入随机数引擎（默认使用RandomService的移动流）
+    void setRandomEngine(RandomEngine* engine)
+    {
+        m_rng = engine ? engine : &RandomService::GetInstance().stream(RandomStream::Movement);
+    }
+
+signals:
+    // 屏幕增删或几何变化后发出，此时 getScreenTopology() 已经是新的屏幕信息
+    void screenTopologyChanged();
 
 private slots:
     void updateMovement();
     void onPauseTimeout();
     void onInteractionComplete();
     void refreshDesktopIconsSlot();
+    void refreshScreenTopology();
 
 private:
     // 初始化
     void initializeScreenInfo();
+    void watchScreen(QScreen* screen);
+    void applyScreenTopology();
     
     // 移动处理方法
-    void processRandomMovement();
+    void processRandomMovement(double dt);
+    QPoint randomTargetFrom(const QPoint& from, int minDistance, int maxDistance);
+    
+    // 导航：选择目标（随机方向、图标、屏幕角落或鼠标），在导航网格上寻路，障碍物变化时修补路径
+    void chooseNextTarget(const QPoint& from);
+    void planPathTo(const QPoint& target);
+    void repairPath();
+    void resetNavGrid();
+    QPoint petCenterOffset() const { return QPoint(m_petSize.width() / 2, m_petSize.height() / 2); }
+    
+    // 帧节拍：按显示器刷新率运行，暂停或交互期间完全停止
+    void startFrameTicks();
+    void stopFrameTicks();
     
     // 桌面图标相关方法
     void detectAndInteractWithIcons();
     void playInteractionAnimation();
     void restoreOriginalAnimation();
-    QVector<DesktopIconInfo> getDesktopIcons();
-    bool isNearIcon(const QPoint& pos, const DesktopIconInfo& icon);
+    void rebuildIconGrid();
+    QVector<QRect> visibleObstacleRects() const;
+    QVector<QRect> navObstacleRects() const;
     
     // 碰撞检测和路径规划
     bool isPositionValid(const QPoint& pos);
@@ -133,20 +154,35 @@ private:
     QTimer* m_interactionTimer;
     
     // 屏幕信息
-    QRect m_screenRect;
+    ScreenTopology m_screens;        // 所有屏幕的几何信息缓存，屏幕变化时重建
+    bool m_followSystemScreens;      // 是否跟随系统屏幕变化（调用 setScreenRect 后不再跟随）
     QSize m_petSize;
     
     // 移动状态
     QPoint m_currentTarget;
-    QPoint m_lastPosition;
+    QPoint m_lastPosition;           // 上一次写入模型的位置
+    MotionIntegrator m_motion;       // 浮点位置/速度积分
+    QElapsedTimer m_frameClock;      // 测量两帧之间实际经过的时间
+    
+    // 导航
+    NavGrid m_navGrid;               // 屏幕范围的占用网格，障碍物刷新时增量更新
+    QVector<QPoint> m_path;          // 当前路径的路点（宠物中心点坐标）
+    int m_pathIndex;                 // 正在前往的路点
+    quint64 m_pathRevision;          // 规划路径时导航网格的版本
     
     // 桌面图标管理
+    std::unique_ptr<IDesktopObstacleProvider> m_obstacleProvider; // 障碍物来源，第一次刷新时创建
     QVector<DesktopIconInfo> m_desktopIcons;
-    QVector<int> m_interactedIcons;  // 已交互的图标索引列表
+    IconSpatialGrid m_iconGrid;      // 图标中心点的网格索引，刷新图标或检测半径变化时重建
+    std::vector<bool> m_interactedMask; // 按图标下标记录是否已交互过
+    int m_interactedCount;           // 已交互的图标数
+    QVector<int> m_iconCandidates;   // 每帧复用的附近图标缓冲区
     bool m_isInteracting;            // 是否正在进行交互
+    bool m_iconsLoaded;              // 是否已枚举过桌面图标
     QString m_originalAnimation;     // 原始动画路径
     QTimer* m_iconRefreshTimer;      // 图标刷新定时器
     int m_iconRefreshInterval;       // 图标刷新间隔（毫秒）
+    RandomEngine* m_rng;             // 移动随机数引擎（不持有）
     
     // 通知系统
     PropertyTrigger m_trigger;
@@ -1,7 +1,9 @@
 #include "BackpackModel.h"
 #include "../common/PropertyIds.h"
 #include "../common/CollectionManager.h"
+#include "../common/ItemCatalog.h"
 #include <QDebug>
+#include <algorithm>
 
 BackpackModel::BackpackModel(QObject *parent) noexcept
     : QObject(parent)
@@ -30,8 +32,7 @@ void BackpackModel::addItem(int itemId, int count) noexcept
     if (count <= 0) return;
     
     // 检查物品是否在图鉴系统中存在
-    CollectionItemInfo itemInfo;
-    if (!getItemInfo(itemId, itemInfo)) {
+    if (!itemExists(itemId)) {
         qWarning() << "尝试添加不存在的物品:" << itemId;
         return;
     }
@@ -46,13 +47,14 @@ void BackpackModel::addItem(int itemId, int count) noexcept
         // 新物品，添加到背包
         m_items.append(BackpackItemInfo(itemId, count));
     }
+    journalItem(itemId);
     
     // 自动解锁和收集图鉴物品
     CollectionManager& collectionMgr = CollectionManager::getInstance();
     collectionMgr.unlockItem(itemId);
     collectionMgr.collectItem(itemId, count);
     
-    qDebug() << "添加物品到背包:" << itemInfo.name << "(" << itemId << ") 数量:" << count << "并自动解锁图鉴";
+    qDebug() << "添加物品到背包:" << getItemName(itemId) << "(" << itemId << ") 数量:" << count << "并自动解锁图鉴";
     
     // 发射信号
     emit itemAdded(itemId, count);
@@ -62,6 +64,44 @@ void BackpackModel::addItem(int itemId, int count) noexcept
     fireBackpackUpdate();
 }
 
+void BackpackModel::addItems(const QVector<BackpackItemInfo>& items) noexcept
+{
+    CollectionManager& collectionMgr = CollectionManager::getInstance();
+    bool changed = false;
+
+    for (const BackpackItemInfo& item : items) {
+        if (item.count <= 0) continue;
+
+        if (!itemExists(item.itemId)) {
+            qWarning() << "尝试添加不存在的物品:" << item.itemId;
+            continue;
+        }
+
+        int index = findItemIndex(item.itemId);
+        int oldCount = 0;
+        if (index != -1) {
+            oldCount = m_items[index].count;
+            m_items[index].count += item.count;
+        } else {
+            m_items.append(BackpackItemInfo(item.itemId, item.count));
+        }
+        journalItem(item.itemId);
+
+        collectionMgr.unlockItem(item.itemId);
+        collectionMgr.collectItem(item.itemId, item.count);
+
+        emit itemAdded(item.itemId, item.count);
+        emit itemChanged(item.itemId, oldCount, oldCount + item.count);
+        changed = true;
+    }
+
+    if (changed) {
+        qDebug() << "批量添加物品到背包，共" << items.size() << "种";
+        emit backpackUpdated();
+        fireBackpackUpdate();
+    }
+}
+
 void BackpackModel::removeItem(int itemId, int count) noexcept
 {
     if (count <= 0) return;
@@ -79,6 +119,7 @@ void BackpackModel::removeItem(int itemId, int count) noexcept
         // 减少数量
         m_items[index].count -= count;
     }
+    journalItem(itemId);
     
     // 发射信号
     emit itemRemoved(itemId, actualRemoved);
@@ -103,6 +144,7 @@ void BackpackModel::setItemCount(int itemId, int newCount) noexcept
         // 添加新物品
         m_items.append(BackpackItemInfo(itemId, newCount));
     }
+    journalItem(itemId);
     
     fireBackpackUpdate();
 }
@@ -122,11 +164,64 @@ void BackpackModel::clear() noexcept
 {
     if (!m_items.isEmpty()) {
         m_items.clear();
+        if (m_journal) {
+            m_journal->append(SaveJournal::BackpackClear, BinaryWriter());
+        }
         fireBackpackUpdate();
     }
 }
 
-void BackpackModel::saveToFile(const QString &filename) const
+// 日志记录：1 物品ID 2 修改后的数量（0表示已移除）
+void BackpackModel::journalItem(int itemId)
+{
+    if (!m_journal) {
+        return;
+    }
+    BinaryWriter record;
+    record.writeUInt(1, static_cast<uint64_t>(itemId));
+    record.writeUInt(2, static_cast<uint64_t>(getItemCount(itemId)));
+    m_journal->append(SaveJournal::BackpackItem, record);
+}
+
+void BackpackModel::applyJournalRecord(SaveJournal::RecordType type, BinaryReader &in)
+{
+    if (type == SaveJournal::BackpackClear) {
+        m_items.clear();
+        fireBackpackUpdate();
+        return;
+    }
+    if (type != SaveJournal::BackpackItem) {
+        return;
+    }
+
+    int itemId = 0;
+    int count = 0;
+    while (in.next()) {
+        switch (in.field()) {
+        case 1: itemId = static_cast<int>(in.readUInt()); break;
+        case 2: count = static_cast<int>(in.readUInt()); break;
+        default: break;
+        }
+    }
+    if (!in.isValid() || itemId <= 0) {
+        return;
+    }
+
+    // 直接写入数量，不再联动图鉴（图鉴有自己的日志记录）
+    int index = findItemIndex(itemId);
+    if (count <= 0) {
+        if (index != -1) {
+            m_items.remove(index);
+        }
+    } else if (index != -1) {
+        m_items[index].count = count;
+    } else {
+        m_items.append(BackpackItemInfo(itemId, count));
+    }
+    fireBackpackUpdate();
+}
+
+QJsonArray BackpackModel::toJson() const
 {
     QJsonArray jsonArray;
     for (const auto &item : m_items) {
@@ -135,8 +230,81 @@ void BackpackModel::saveToFile(const QString &filename) const
         itemObj["count"] = item.count;
         jsonArray.append(itemObj);
     }
+    return jsonArray;
+}
+
+void BackpackModel::fromJson(const QJsonArray &jsonArray)
+{
+    QVector<BackpackItemInfo> newItems;
+    newItems.reserve(jsonArray.size());
+    for (const QJsonValue &value : jsonArray) {
+        if (value.isObject()) {
+            QJsonObject obj = value.toObject();
+            int itemId = obj["itemId"].toInt();
+            int count = obj["count"].toInt();
+            if (itemId > 0 && count > 0) {
+                newItems.append(BackpackItemInfo(itemId, count));
+            }
+        }
+    }
     
-    QJsonDocument doc(jsonArray);
+    // 更新数据
+    if (!newItems.isEmpty() || !m_items.isEmpty()) {
+        m_items = newItems;
+        fireBackpackUpdate();
+    }
+}
+
+// 二进制存档字段：1 物品ID数组 2 数量数组（按背包顺序一一对应）
+void BackpackModel::writeBinary(const SaveSnapshot &items, BinaryWriter &out)
+{
+    std::vector<uint64_t> ids;
+    std::vector<uint64_t> counts;
+    ids.reserve(items.size());
+    counts.reserve(items.size());
+    for (const auto &item : items) {
+        ids.push_back(static_cast<uint64_t>(item.itemId));
+        counts.push_back(static_cast<uint64_t>(item.count));
+    }
+    out.writePackedUInts(1, ids);
+    out.writePackedUInts(2, counts);
+}
+
+void BackpackModel::readBinary(BinaryReader &in)
+{
+    std::vector<uint64_t> ids;
+    std::vector<uint64_t> counts;
+    while (in.next()) {
+        switch (in.field()) {
+        case 1: in.readPackedUInts(ids); break;
+        case 2: in.readPackedUInts(counts); break;
+        default: break;
+        }
+    }
+    if (!in.isValid()) {
+        return;
+    }
+    
+    QVector<BackpackItemInfo> newItems;
+    const size_t n = std::min(ids.size(), counts.size());
+    newItems.reserve(static_cast<int>(n));
+    for (size_t i = 0; i < n; ++i) {
+        int itemId = static_cast<int>(ids[i]);
+        int count = static_cast<int>(counts[i]);
+        if (itemId > 0 && count > 0) {
+            newItems.append(BackpackItemInfo(itemId, count));
+        }
+    }
+    
+    if (!newItems.isEmpty() || !m_items.isEmpty()) {
+        m_items = newItems;
+        fireBackpackUpdate();
+    }
+}
+
+void BackpackModel::saveToFile(const QString &filename) const
+{
+    QJsonDocument doc(toJson());
     
     // 获取应用数据存储路径
     QString appDataPath = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
@@ -171,24 +339,7 @@ void BackpackModel::loadFromFile(const QString &filename)
         return; // JSON格式错误，使用默认值
     }
     
-    QJsonArray jsonArray = doc.array();
-    QVector<BackpackItemInfo> newItems;
-    for (const QJsonValue &value : jsonArray) {
-        if (value.isObject()) {
-            QJsonObject obj = value.toObject();
-            int itemId = obj["itemId"].toInt();
-            int count = obj["count"].toInt();
-            if (itemId > 0 && count > 0) {
-                newItems.append(BackpackItemInfo(itemId, count));
-            }
-        }
-    }
-    
-    // 更新数据
-    if (!newItems.isEmpty() || !m_items.isEmpty()) {
-        m_items = newItems;
-        fireBackpackUpdate();
-    }
+    fromJson(doc.array());
 }
 
 void BackpackModel::initializeFromCollection() noexcept
@@ -249,8 +400,20 @@ bool BackpackModel::getItemInfo(int itemId, CollectionItemInfo& outInfo) const n
     return (outInfo.id == itemId);
 }
 
+bool BackpackModel::itemExists(int itemId) const noexcept
+{
+    if (item_catalog::contains(itemId)) {
+        return true;
+    }
+    CollectionItemInfo itemInfo;
+    return getItemInfo(itemId, itemInfo);
+}
+
 QString BackpackModel::getItemName(int itemId) const noexcept
 {
+    if (const ItemMeta *meta = item_catalog::find(itemId)) {
+        return QString::fromUtf8(meta->name);
+    }
     CollectionItemInfo itemInfo;
     if (getItemInfo(itemId, itemInfo)) {
         return itemInfo.name;
@@ -260,6 +423,9 @@ QString BackpackModel::getItemName(int itemId) const noexcept
 
 QString BackpackModel::getItemDescription(int itemId) const noexcept
 {
+    if (const ItemMeta *meta = item_catalog::find(itemId)) {
+        return QString::fromUtf8(meta->description);
+    }
     CollectionItemInfo itemInfo;
     if (getItemInfo(itemId, itemInfo)) {
         return itemInfo.description;
@@ -269,6 +435,9 @@ QString BackpackModel::getItemDescription(int itemId) const noexcept
 
 QString BackpackModel::getItemIcon(int itemId) const noexcept
 {
+    if (const ItemMeta *meta = item_catalog::find(itemId)) {
+        return QString::fromUtf8(meta->iconPath);
+    }
     CollectionItemInfo itemInfo;
     if (getItemInfo(itemId, itemInfo)) {
         return itemInfo.iconPath;
@@ -278,6 +447,9 @@ QString BackpackModel::getItemIcon(int itemId) const noexcept
 
 CollectionCategory BackpackModel::getItemCategory(int itemId) const noexcept
 {
+    if (const ItemMeta *meta = item_catalog::find(itemId)) {
+        return meta->category;
+    }
     CollectionItemInfo itemInfo;
     if (getItemInfo(itemId, itemInfo)) {
         return itemInfo.category;
@@ -287,6 +459,9 @@ CollectionCategory BackpackModel::getItemCategory(int itemId) const noexcept
 
 CollectionRarity BackpackModel::getItemRarity(int itemId) const noexcept
 {
+    if (const ItemMeta *meta = item_catalog::find(itemId)) {
+        return meta->rarity;
+    }
     CollectionItemInfo itemInfo;
     if (getItemInfo(itemId, itemInfo)) {
         return itemInfo.rarity;
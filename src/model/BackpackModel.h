@@ -3,6 +3,8 @@
 
 #include "../common/PropertyTrigger.h"
 #include "../common/PropertyIds.h"
+#include "../common/BinaryCodec.h"
+#include "../common/SaveJournal.h"
 #include "../common/base/BackpackItemInfo.h"
 #include "../common/base/CollectionInfo.h"
 #include <QObject>
@@ -38,6 +40,7 @@ public:
 
     // 物品操作方法
     void addItem(int itemId, int count = 1) noexcept;
+    void addItems(const QVector<BackpackItemInfo>& items) noexcept; // 批量添加，只通知一次
     void removeItem(int itemId, int count = 1) noexcept;
     void setItemCount(int itemId, int newCount) noexcept;
     int getItemCount(int itemId) const noexcept;
@@ -58,6 +61,33 @@ public:
     // 持久化方法
     void saveToFile(const QString &filename) const;
     void loadFromFile(const QString &filename);
+    QJsonArray toJson() const;
+    void fromJson(const QJsonArray &jsonArray);
+    void readBinary(BinaryReader &in);
+
+    // 存档快照：QVector 隐式共享，复制只增加引用计数，可以交给后台线程序列化
+    using SaveSnapshot = QVector<BackpackItemInfo>;
+    SaveSnapshot saveSnapshot() const {
+        return m_items;
+    }
+    static void writeBinary(const SaveSnapshot &items, BinaryWriter &out);
+    void writeBinary(BinaryWriter &out) const {
+        writeBinary(m_items, out);
+    }
+
+    // 存档日志：设置后每次修改追加一条记录；启动时用 applyJournalRecord 重放
+    void setJournal(SaveJournal *journal) noexcept {
+        m_journal = journal;
+    }
+    void applyJournalRecord(SaveJournal::RecordType type, BinaryReader &in);
+
+    // 自上次存档以来背包是否被修改
+    bool isDirty() const noexcept {
+        return m_dirty;
+    }
+    void clearDirty() noexcept {
+        m_dirty = false;
+    }
 
 signals:
     void itemChanged(int itemId, int oldCount, int newCount);
@@ -69,15 +99,24 @@ private:
 private:
     // 查找物品索引
     int findItemIndex(int itemId) const noexcept;
+
+    // 物品是否存在：先查编译期物品表，表中没有的再查图鉴系统
+    bool itemExists(int itemId) const noexcept;
     
+    // 把物品当前数量追加到存档日志
+    void journalItem(int itemId);
+
     // 触发背包更新通知
     void fireBackpackUpdate() {
+        m_dirty = true;
         m_trigger.fire(PROP_ID_BACKPACK_UPDATE);
     }
 
 private:
     QVector<BackpackItemInfo> m_items;  // 背包物品列表
     PropertyTrigger m_trigger;           // 属性触发器
+    bool m_dirty = false;                // 有未保存的修改
+    SaveJournal *m_journal = nullptr;    // 存档日志（不持有）
 };
 
 #endif // BACKPACKMODEL_H
\ No newline at end of file
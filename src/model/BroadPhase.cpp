@@ -0,0 +1,164 @@
+#include "BroadPhase.h"
+#include <algorithm>
+
+int SweepAndPrune::add(const QRect& rect, CollisionLayer layer)
+{
+    m_proxies.push_back({0, -1, 0, -1, layer});
+    const int proxy = size() - 1;
+    update(proxy, rect);
+    m_order.push_back(proxy);
+    m_needsFullSort = true;
+    return proxy;
+}
+
+void SweepAndPrune::update(int proxy, const QRect& rect)
+{
+    Proxy& p = m_proxies[proxy];
+    if (rect.isEmpty()) {
+        // 空包围盒：maxX < minX，扫描时跳过
+        p.minX = 0;
+        p.maxX = -1;
+        p.minY = 0;
+        p.maxY = -1;
+        return;
+    }
+    p.minX = rect.left();
+    p.maxX = rect.right();
+    p.minY = rect.top();
+    p.maxY = rect.bottom();
+}
+
+void SweepAndPrune::clear()
+{
+    m_proxies.clear();
+    m_order.clear();
+    m_sorted.clear();
+    m_pairs.clear();
+    m_needsFullSort = false;
+}
+
+void SweepAndPrune::sortOrder()
+{
+    auto minX = [this](int proxy) { return m_proxies[proxy].minX; };
+    if (m_needsFullSort) {
+        std::sort(m_order.begin(), m_order.end(), [&](int a, int b) { return minX(a) < minX(b); });
+        m_needsFullSort = false;
+        return;
+    }
+
+    // 插入排序：移动量小时每个元素只需要和相邻的几个比较
+    for (size_t i = 1; i < m_order.size(); ++i) {
+        const int proxy = m_order[i];
+        const int key = minX(proxy);
+        size_t j = i;
+        while (j > 0 && minX(m_order[j - 1]) > key) {
+            m_order[j] = m_order[j - 1];
+            --j;
+        }
+        m_order[j] = proxy;
+    }
+}
+
+int SweepAndPrune::bandOf(int y) const
+{
+    return (y - m_bandOrigin) / m_bandHeight;
+}
+
+const std::vector<CollisionPair>& SweepAndPrune::findPairs()
+{
+    m_pairs.clear();
+    m_testCount = 0;
+    sortOrder();
+
+    // 带高取平均高度的两倍：大部分碰撞体只落在一两条带里
+    long long totalHeight = 0;
+    int active = 0;
+    int minY = 0;
+    int maxY = 0;
+    for (const Proxy& p : m_proxies) {
+        if (p.maxX < p.minX) {
+            continue;
+        }
+        totalHeight += p.maxY - p.minY + 1;
+        minY = active == 0 ? p.minY : std::min(minY, p.minY);
+        maxY = active == 0 ? p.maxY : std::max(maxY, p.maxY);
+        ++active;
+    }
+    if (active < 2) {
+        return m_pairs;
+    }
+    m_bandOrigin = minY;
+    m_bandHeight = static_cast<int>(std::max<long long>(MIN_BAND_HEIGHT, 2 * totalHeight / active));
+    const int bands = bandOf(maxY) + 1;
+
+    // 按带分桶（计数排序），沿 m_order 遍历，所以每条带内仍按 minX 有序
+    m_bandStart.assign(bands + 1, 0);
+    for (int proxy : m_order) {
+        const Proxy& p = m_proxies[proxy];
+        if (p.maxX < p.minX) {
+            continue;
+        }
+        for (int band = bandOf(p.minY); band <= bandOf(p.maxY); ++band) {
+            ++m_bandStart[band + 1];
+        }
+    }
+    for (int band = 1; band <= bands; ++band) {
+        m_bandStart[band] += m_bandStart[band - 1];
+    }
+    m_bandFill.assign(m_bandStart.begin(), m_bandStart.end() - 1);
+    m_sorted.resize(m_bandStart[bands]);
+    m_sortedIds.resize(m_bandStart[bands]);
+    for (int proxy : m_order) {
+        const Proxy& p = m_proxies[proxy];
+        if (p.maxX < p.minX) {
+            continue;
+        }
+        for (int band = bandOf(p.minY); band <= bandOf(p.maxY); ++band) {
+            const int slot = m_bandFill[band]++;
+            m_sorted[slot] = p;
+            m_sortedIds[slot] = proxy;
+        }
+    }
+
+    // 每条带内扫描；跨多条带的一对只在 max(minY) 所在的带里报告一次
+    for (int band = 0; band < bands; ++band) {
+        const int end = m_bandStart[band + 1];
+        for (int i = m_bandStart[band]; i < end; ++i) {
+            const Proxy& a = m_sorted[i];
+            // 后面的碰撞体左边界已超过 a 的右边界时，它们在 x 方向都不与 a 相交
+            for (int j = i + 1; j < end && m_sorted[j].minX <= a.maxX; ++j) {
+                const Proxy& b = m_sorted[j];
+                if (!shouldTest(a.layer, b.layer)) {
+                    continue;
+                }
+                ++m_testCount;
+                if (a.minY <= b.maxY && b.minY <= a.maxY && bandOf(std::max(a.minY, b.minY)) == band) {
+                    const int first = m_sortedIds[i];
+                    const int second = m_sortedIds[j];
+                    m_pairs.push_back(first < second ? CollisionPair{first, second} : CollisionPair{second, first});
+                }
+            }
+        }
+    }
+
+    // 按 first 计数排序（线性），每个 first 下的少量结果再按 second 排序
+    m_bucketStart.assign(m_proxies.size() + 1, 0);
+    for (const CollisionPair& pair : m_pairs) {
+        ++m_bucketStart[pair.first + 1];
+    }
+    for (size_t i = 1; i < m_bucketStart.size(); ++i) {
+        m_bucketStart[i] += m_bucketStart[i - 1];
+    }
+    m_bucketFill.assign(m_bucketStart.begin(), m_bucketStart.end() - 1);
+    m_scratch.resize(m_pairs.size());
+    for (const CollisionPair& pair : m_pairs) {
+        m_scratch[m_bucketFill[pair.first]++] = pair;
+    }
+    for (size_t i = 0; i + 1 < m_bucketStart.size(); ++i) {
+        if (m_bucketStart[i + 1] - m_bucketStart[i] > 1) {
+            std::sort(m_scratch.begin() + m_bucketStart[i], m_scratch.begin() + m_bucketStart[i + 1]);
+        }
+    }
+    m_pairs.swap(m_scratch);
+    return m_pairs;
+}
@@ -0,0 +1,98 @@
+#ifndef __BROAD_PHASE_H__
+#define __BROAD_PHASE_H__
+
+#include <QRect>
+#include <cstdint>
+#include <vector>
+
+/**
+ * 碰撞体所属的层，决定哪些组合需要检测
+ * 障碍物之间、鼠标与障碍物之间不检测
+ */
+enum class CollisionLayer : uint8_t {
+    Pet,
+    Cursor,
+    Obstacle,
+};
+
+/**
+ * 一对包围盒相交的碰撞体（first < second）
+ */
+struct CollisionPair {
+    int first;
+    int second;
+
+    bool operator==(const CollisionPair& other) const { return first == other.first && second == other.second; }
+    bool operator<(const CollisionPair& other) const
+    {
+        return first != other.first ? first < other.first : second < other.second;
+    }
+};
+
+/**
+ * 宽阶段碰撞检测（排序扫描，sort and sweep）
+ * 碰撞体按包围盒左边界排序，从左到右扫描，只和左边界落在自己 x 范围内的后续碰撞体比较 y 范围
+ * 只沿一个轴扫描时，宽屏上同一列的碰撞体都要互相比较，比较次数按 n^1.5 增长；
+ * 因此先按 y 把碰撞体分到若干水平带（带高为平均高度的两倍），每条带各自扫描，比较次数与实际相交的对数成正比
+ * 宠物每帧只移动几个像素，上一帧的顺序几乎有序，用插入排序维护；分带和结果排序都是计数排序，整体接近线性
+ */
+class SweepAndPrune
+{
+public:
+    // 添加碰撞体，返回编号（从 0 开始连续分配）；空的包围盒不参与检测
+    int add(const QRect& rect, CollisionLayer layer);
+    void update(int proxy, const QRect& rect);
+    void clear();
+
+    int size() const { return static_cast<int>(m_proxies.size()); }
+    CollisionLayer layer(int proxy) const { return m_proxies[proxy].layer; }
+
+    // 当前所有相交的碰撞体对，按 (first, second) 排序
+    const std::vector<CollisionPair>& findPairs();
+
+    // 上一次 findPairs() 做了多少次 y 方向的比较（用于基准和测试）
+    long long lastTestCount() const { return m_testCount; }
+
+    static bool shouldTest(CollisionLayer a, CollisionLayer b)
+    {
+        if (a == CollisionLayer::Obstacle || b == CollisionLayer::Obstacle) {
+            return a == CollisionLayer::Pet || b == CollisionLayer::Pet;
+        }
+        return a != CollisionLayer::Cursor || b != CollisionLayer::Cursor;
+    }
+
+private:
+    struct Proxy {
+        int minX;
+        int maxX;
+        int minY;
+        int maxY;
+        CollisionLayer layer;
+    };
+
+    void sortOrder();
+    int bandOf(int y) const;
+
+    static const int MIN_BAND_HEIGHT = 16;
+
+private:
+    std::vector<Proxy> m_proxies;
+    std::vector<int> m_order;        // 按 minX 排序的碰撞体编号
+    bool m_needsFullSort = false;    // 新增碰撞体后整体排序一次
+
+    // 扫描用的连续数组：按带排列，带内按 minX 有序；跨带的碰撞体在每条带里各有一份
+    std::vector<Proxy> m_sorted;
+    std::vector<int> m_sortedIds;
+    std::vector<int> m_bandStart;
+    std::vector<int> m_bandFill;
+    int m_bandOrigin = 0;
+    int m_bandHeight = MIN_BAND_HEIGHT;
+
+    std::vector<CollisionPair> m_pairs;
+    std::vector<CollisionPair> m_scratch;  // 排序用的临时数组
+    std::vector<int> m_bucketStart;  // 结果按 first 计数排序
+    std::vector<int> m_bucketFill;
+    long long m_testCount = 0;
+};
+
+#endif // __BROAD_PHASE_H__
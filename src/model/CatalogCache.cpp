@@ -0,0 +1,264 @@
+#include "CatalogCache.h"
+#include "CollectionModel.h"
+#include "../common/SaveGame.h"
+#include "../common/StartupProfiler.h"
+#include <QDebug>
+#include <QFile>
+#include <QHash>
+#include <QResource>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace
+{
+
+constexpr uint32_t MAGIC = 0x43435044; // "DPCC"，字节序不同时读出来不相等
+constexpr uint32_t VERSION = 1;
+
+struct Header
+{
+    uint32_t magic;
+    uint32_t version;
+    uint64_t sourceHash;
+    uint32_t count;
+    uint32_t recordsOffset;
+    uint32_t poolOffset;
+    uint32_t poolSize; // UTF-16 码元个数
+};
+
+// 字符串池中的位置，单位是 UTF-16 码元
+struct StringRef
+{
+    uint32_t offset;
+    uint32_t length;
+};
+
+struct Record
+{
+    int32_t id;
+    uint8_t category;
+    uint8_t rarity;
+    uint8_t hidden;
+    uint8_t reserved;
+    StringRef name;
+    StringRef description;
+    StringRef iconPath;
+    StringRef detailImagePath;
+};
+
+static_assert(sizeof(Header) == 32, "缓存文件头大小变化需要提升 VERSION");
+static_assert(sizeof(Record) == 40, "缓存记录大小变化需要提升 VERSION");
+
+// 缓存文件的映射在进程结束前保持有效，从缓存得到的 QString 直接引用映射内存
+// 按路径记录已建立的映射：再次读取内容相同（sourceHash 一致）的缓存时复用原有映射，不重复映射同一个文件
+// 只有缓存在运行期间被重建成不同内容时才会为同一路径新增映射，旧映射仍被之前返回的字符串引用
+struct Mapping
+{
+    std::unique_ptr<QFile> file;
+    const uchar *data = nullptr;
+    qint64 size = 0;
+};
+
+std::mutex s_mappingMutex;
+QHash<QString, std::vector<Mapping>> s_mappings;
+
+bool validEnums(const Record &record)
+{
+    return record.category <= uint8_t(CollectionCategory::Achievement) &&
+           record.rarity <= uint8_t(CollectionRarity::Legendary) && record.hidden <= 1;
+}
+
+// 校验并解析一份已映射的缓存，任何字段越界都视为损坏
+bool parse(const uchar *data, qint64 size, uint64_t sourceHash, QMap<int, CollectionItemInfo> &items)
+{
+    Header header;
+    std::memcpy(&header, data, sizeof(header));
+    if (header.magic != MAGIC || header.version != VERSION || header.sourceHash != sourceHash ||
+        header.recordsOffset % alignof(Record) != 0 || header.poolOffset % alignof(char16_t) != 0 ||
+        quint64(header.recordsOffset) + quint64(header.count) * sizeof(Record) > quint64(size) ||
+        quint64(header.poolOffset) + quint64(header.poolSize) * sizeof(char16_t) > quint64(size))
+    {
+        return false;
+    }
+
+    const Record *records = reinterpret_cast<const Record *>(data + header.recordsOffset);
+    const QChar *pool = reinterpret_cast<const QChar *>(data + header.poolOffset);
+    auto text = [&](const StringRef &ref, QString &out) {
+        if (quint64(ref.offset) + ref.length > header.poolSize)
+        {
+            return false;
+        }
+        out = QString::fromRawData(pool + ref.offset, qsizetype(ref.length));
+        return true;
+    };
+
+    QMap<int, CollectionItemInfo> loaded;
+    for (uint32_t i = 0; i < header.count; ++i)
+    {
+        const Record &record = records[i];
+        if (!validEnums(record))
+        {
+            return false;
+        }
+        CollectionItemInfo info;
+        info.id = record.id;
+        info.category = static_cast<CollectionCategory>(record.category);
+        info.rarity = static_cast<CollectionRarity>(record.rarity);
+        info.isHidden = record.hidden != 0;
+        if (!text(record.name, info.name) || !text(record.description, info.description) ||
+            !text(record.iconPath, info.iconPath) || !text(record.detailImagePath, info.detailImagePath))
+        {
+            return false;
+        }
+        loaded.insert(info.id, info);
+    }
+    items = std::move(loaded);
+    return true;
+}
+
+QByteArray readSource(const QString &path)
+{
+    // 资源文件可能是压缩存储的，uncompressedData() 在未压缩时不复制
+    if (path.startsWith(':'))
+    {
+        QResource resource(path);
+        return resource.isValid() ? resource.uncompressedData() : QByteArray();
+    }
+
+    QFile file(path);
+    return file.open(QIODevice::ReadOnly) ? file.readAll() : QByteArray();
+}
+
+// 相同的字符串（如多个物品共用的图标）在池中只存一份
+class StringPool
+{
+public:
+    StringRef add(const QString &text)
+    {
+        auto it = m_offsets.constFind(text);
+        if (it != m_offsets.constEnd())
+        {
+            return StringRef{it.value(), uint32_t(text.size())};
+        }
+        const uint32_t offset = uint32_t(m_chars.size());
+        m_chars.insert(m_chars.end(), text.utf16(), text.utf16() + text.size());
+        m_offsets.insert(text, offset);
+        return StringRef{offset, uint32_t(text.size())};
+    }
+
+    const std::vector<char16_t> &chars() const noexcept
+    {
+        return m_chars;
+    }
+
+private:
+    std::vector<char16_t> m_chars;
+    QHash<QString, uint32_t> m_offsets;
+};
+
+} // namespace
+
+QMap<int, CollectionItemInfo> CatalogCache::load(const QString &csvPath, const QString &cachePath)
+{
+    StartupProfiler::Scope profile("catalog:load");
+
+    const QByteArray source = readSource(csvPath);
+    if (source.isEmpty())
+    {
+        return CollectionModel::parseItemsCSV(csvPath);
+    }
+
+    const uint64_t sourceHash = hash(source);
+    QMap<int, CollectionItemInfo> items;
+    if (read(cachePath, sourceHash, items))
+    {
+        qDebug() << "从缓存加载图鉴物品配置，共" << items.size() << "个物品";
+        return items;
+    }
+
+    qDebug() << "图鉴缓存不存在或已过期，重新解析:" << csvPath;
+    items = CollectionModel::parseItemsCSV(csvPath);
+    if (!items.isEmpty() && !write(items, sourceHash, cachePath))
+    {
+        qWarning() << "写入图鉴缓存失败:" << cachePath;
+    }
+    return items;
+}
+
+bool CatalogCache::read(const QString &cachePath, uint64_t sourceHash, QMap<int, CollectionItemInfo> &items)
+{
+    std::lock_guard<std::mutex> lock(s_mappingMutex);
+    std::vector<Mapping> &mappings = s_mappings[cachePath];
+    for (const Mapping &mapping : mappings)
+    {
+        if (parse(mapping.data, mapping.size, sourceHash, items))
+        {
+            return true;
+        }
+    }
+
+    auto file = std::make_unique<QFile>(cachePath);
+    if (!file->open(QIODevice::ReadOnly) || file->size() < qint64(sizeof(Header)))
+    {
+        return false;
+    }
+
+    const qint64 size = file->size();
+    const uchar *data = file->map(0, size);
+    if (!data || !parse(data, size, sourceHash, items))
+    {
+        return false;
+    }
+
+    mappings.push_back(Mapping{std::move(file), data, size});
+    return true;
+}
+
+bool CatalogCache::write(const QMap<int, CollectionItemInfo> &items, uint64_t sourceHash, const QString &cachePath)
+{
+    StringPool pool;
+    std::vector<Record> records;
+    records.reserve(size_t(items.size()));
+    for (const CollectionItemInfo &info : items)
+    {
+        Record record{};
+        record.id = info.id;
+        record.category = uint8_t(info.category);
+        record.rarity = uint8_t(info.rarity);
+        record.hidden = info.isHidden ? 1 : 0;
+        record.name = pool.add(info.name);
+        record.description = pool.add(info.description);
+        record.iconPath = pool.add(info.iconPath);
+        record.detailImagePath = pool.add(info.detailImagePath);
+        records.push_back(record);
+    }
+
+    Header header{};
+    header.magic = MAGIC;
+    header.version = VERSION;
+    header.sourceHash = sourceHash;
+    header.count = uint32_t(records.size());
+    header.recordsOffset = sizeof(Header);
+    header.poolOffset = uint32_t(sizeof(Header) + records.size() * sizeof(Record));
+    header.poolSize = uint32_t(pool.chars().size());
+
+    QByteArray data;
+    data.reserve(int(header.poolOffset + header.poolSize * sizeof(char16_t)));
+    data.append(reinterpret_cast<const char *>(&header), sizeof(header));
+    data.append(reinterpret_cast<const char *>(records.data()), int(records.size() * sizeof(Record)));
+    data.append(reinterpret_cast<const char *>(pool.chars().data()), int(pool.chars().size() * sizeof(char16_t)));
+    return SaveGame::writeFileAtomically(cachePath, data);
+}
+
+uint64_t CatalogCache::hash(const QByteArray &data) noexcept
+{
+    uint64_t value = 14695981039346656037ull;
+    for (char c : data)
+    {
+        value ^= uint8_t(c);
+        value *= 1099511628211ull;
+    }
+    return value;
+}
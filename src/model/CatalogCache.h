@@ -0,0 +1,33 @@
+#ifndef __CATALOG_CACHE_H__
+#define __CATALOG_CACHE_H__
+
+#include "../common/base/CollectionInfo.h"
+#include <QByteArray>
+#include <QMap>
+#include <QString>
+#include <cstdint>
+
+// 图鉴目录缓存：把解析好的 collection_items.csv 编译成二进制文件，启动时映射整个文件直接读取
+//
+// 文件格式（本机字节序）：文件头 | 定长记录数组 | 字符串池
+// 文件头记录CSV内容的哈希，CSV修改（哈希不一致）、文件损坏或格式版本变化时重新解析CSV并重建缓存
+// 字符串池保存UTF-16文本，记录中的字符串是池内的偏移和长度；读取时 QString 直接引用映射内存，不复制也不解码
+// 映射一旦建立在进程结束前不解除，因此从缓存得到的字符串可以随意复制和长期保存；重复读取内容相同的缓存时复用已有映射
+// 记录中的枚举值超出范围时与校验失败同样处理，重新解析CSV
+class CatalogCache
+{
+public:
+    static constexpr const char *DEFAULT_FILENAME = "collection_items.cache";
+
+    // 优先从缓存读取；缓存不可用时解析CSV并写入缓存
+    static QMap<int, CollectionItemInfo> load(const QString &csvPath, const QString &cachePath);
+
+    // sourceHash 与缓存中的不一致时返回false
+    static bool read(const QString &cachePath, uint64_t sourceHash, QMap<int, CollectionItemInfo> &items);
+    static bool write(const QMap<int, CollectionItemInfo> &items, uint64_t sourceHash, const QString &cachePath);
+
+    // CSV内容的哈希（FNV-1a 64位）
+    static uint64_t hash(const QByteArray &data) noexcept;
+};
+
+#endif
@@ -1,4 +1,5 @@
 #include "CollectionModel.h"
+#include "../common/StartupProfiler.h"
 
 CollectionModel::CollectionModel(QObject *parent)
     : QObject(parent)
@@ -26,8 +27,11 @@ void CollectionModel::loadFromFile(const QString &filename)
         return;
     }
     
-    QJsonObject rootJson = doc.object();
-    
+    fromJson(doc.object());
+}
+
+void CollectionModel::fromJson(const QJsonObject &rootJson)
+{
     if (rootJson.contains("collections")) {
         QJsonObject collectionsJson = rootJson["collections"].toObject();
         
@@ -60,7 +64,7 @@ void CollectionModel::loadFromFile(const QString &filename)
     qDebug() << "图鉴数据加载完成，总物品数:" << m_items.size();
 }
 
-void CollectionModel::saveToFile(const QString &filename) const
+QJsonObject CollectionModel::toJson() const
 {
     QJsonObject rootJson;
     rootJson["version"] = "1.0";
@@ -89,7 +93,136 @@ void CollectionModel::saveToFile(const QString &filename) const
     statsJson["completionRate"] = getCompletionRate();
     rootJson["statistics"] = statsJson;
     
-    QJsonDocument doc(rootJson);
+    return rootJson;
+}
+
+// 二进制存档字段（只保存已发现或已收集的物品，按ID升序）：
+//   1 ID差分数组 2 状态数组 3 获得数量数组 4 首次获得时间（秒，0表示无）差分数组
+// 统计信息可由物品状态算出，不再保存
+void CollectionModel::writeBinary(const SaveSnapshot &items, BinaryWriter &out)
+{
+    std::vector<uint64_t> idDeltas;
+    std::vector<uint64_t> statuses;
+    std::vector<uint64_t> totals;
+    std::vector<int64_t> timeDeltas;
+
+    int lastId = 0;
+    qint64 lastTime = 0;
+    for (auto it = items.constBegin(); it != items.constEnd(); ++it) {
+        const CollectionItemInfo &info = it.value();
+        if (info.status == CollectionStatus::Unknown) {
+            continue;
+        }
+        const qint64 time = info.firstObtainedTime.isValid() ? info.firstObtainedTime.toSecsSinceEpoch() : 0;
+        idDeltas.push_back(static_cast<uint64_t>(info.id - lastId));
+        statuses.push_back(static_cast<uint64_t>(info.status));
+        totals.push_back(static_cast<uint64_t>(qMax(0, info.totalObtained)));
+        timeDeltas.push_back(time - lastTime);
+        lastId = info.id;
+        lastTime = time;
+    }
+
+    out.writePackedUInts(1, idDeltas);
+    out.writePackedUInts(2, statuses);
+    out.writePackedUInts(3, totals);
+    out.writePackedInts(4, timeDeltas);
+}
+
+void CollectionModel::readBinary(BinaryReader &in)
+{
+    std::vector<uint64_t> idDeltas;
+    std::vector<uint64_t> statuses;
+    std::vector<uint64_t> totals;
+    std::vector<int64_t> timeDeltas;
+    while (in.next()) {
+        switch (in.field()) {
+        case 1: in.readPackedUInts(idDeltas); break;
+        case 2: in.readPackedUInts(statuses); break;
+        case 3: in.readPackedUInts(totals); break;
+        case 4: in.readPackedInts(timeDeltas); break;
+        default: break;
+        }
+    }
+    if (!in.isValid()) {
+        qDebug() << "图鉴二进制数据损坏";
+        return;
+    }
+
+    int itemId = 0;
+    qint64 time = 0;
+    for (size_t i = 0; i < idDeltas.size(); ++i) {
+        itemId += static_cast<int>(idDeltas[i]);
+        time += i < timeDeltas.size() ? timeDeltas[i] : 0;
+
+        auto it = m_items.find(itemId);
+        if (it == m_items.end()) {
+            continue;
+        }
+        if (i < statuses.size()) {
+            it->status = static_cast<CollectionStatus>(statuses[i]);
+        }
+        if (i < totals.size()) {
+            it->totalObtained = static_cast<int>(totals[i]);
+        }
+        if (time > 0) {
+            it->firstObtainedTime = QDateTime::fromSecsSinceEpoch(time);
+        }
+    }
+
+    qDebug() << "图鉴数据加载完成，总物品数:" << m_items.size();
+}
+
+// 日志记录：1 物品ID 2 状态 3 累计获得数量 4 首次获得时间（秒，0表示无）
+void CollectionModel::journalItem(int itemId)
+{
+    if (!m_journal) {
+        return;
+    }
+    const CollectionItemInfo &info = m_items[itemId];
+    BinaryWriter record;
+    record.writeUInt(1, static_cast<uint64_t>(itemId));
+    record.writeUInt(2, static_cast<uint64_t>(info.status));
+    record.writeUInt(3, static_cast<uint64_t>(qMax(0, info.totalObtained)));
+    record.writeInt(4, info.firstObtainedTime.isValid() ? info.firstObtainedTime.toSecsSinceEpoch() : 0);
+    m_journal->append(SaveJournal::CollectionItem, record);
+}
+
+void CollectionModel::applyJournalRecord(SaveJournal::RecordType type, BinaryReader &in)
+{
+    if (type != SaveJournal::CollectionItem) {
+        return;
+    }
+
+    int itemId = 0;
+    CollectionStatus status = CollectionStatus::Unknown;
+    int total = 0;
+    qint64 time = 0;
+    while (in.next()) {
+        switch (in.field()) {
+        case 1: itemId = static_cast<int>(in.readUInt()); break;
+        case 2: status = static_cast<CollectionStatus>(in.readUInt()); break;
+        case 3: total = static_cast<int>(in.readUInt()); break;
+        case 4: time = in.readInt(); break;
+        default: break;
+        }
+    }
+
+    // 与 readBinary 相同，只恢复物品配置中存在的物品
+    auto it = m_items.find(itemId);
+    if (!in.isValid() || it == m_items.end()) {
+        return;
+    }
+    it->status = status;
+    it->totalObtained = total;
+    if (time > 0) {
+        it->firstObtainedTime = QDateTime::fromSecsSinceEpoch(time);
+    }
+    fireCollectionUpdate();
+}
+
+void CollectionModel::saveToFile(const QString &filename) const
+{
+    QJsonDocument doc(toJson());
     
     QString appDataPath = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
     QDir dir(appDataPath);
@@ -110,17 +243,23 @@ void CollectionModel::saveToFile(const QString &filename) const
 
 void CollectionModel::loadItemsFromCSV(const QString &csvPath)
 {
+    setItemCatalog(parseItemsCSV(csvPath));
+}
+
+QMap<int, CollectionItemInfo> CollectionModel::parseItemsCSV(const QString &csvPath)
+{
+    StartupProfiler::Scope profile("csv:collection_items");
     qDebug() << "开始加载图鉴物品配置:" << csvPath;
     
+    QMap<int, CollectionItemInfo> items;
     QFile file(csvPath);
     if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
         qWarning() << "无法打开图鉴配置文件:" << csvPath;
-        return;
+        return items;
     }
     
     QTextStream in(&file);
     bool firstLine = true;
-    int loadedCount = 0;
     
     while (!in.atEnd()) {
         QString line = in.readLine().trimmed();
@@ -156,13 +295,23 @@ void CollectionModel::loadItemsFromCSV(const QString &csvPath)
         QString detailPath = parts[6].trimmed();
         bool isHidden = (parts.size() > 7) ? (parts[7].trimmed().toLower() == "true") : false;
         
-        CollectionItemInfo info(id, name, description, category, rarity, iconPath, detailPath, isHidden);
-        m_items[id] = info;
-        loadedCount++;
+        items[id] = CollectionItemInfo(id, name, description, category, rarity, iconPath, detailPath, isHidden);
     }
     
     file.close();
-    qDebug() << "图鉴物品配置加载完成，共加载" << loadedCount << "个物品";
+    qDebug() << "图鉴物品配置加载完成，共加载" << items.size() << "个物品";
+    return items;
+}
+
+void CollectionModel::setItemCatalog(const QMap<int, CollectionItemInfo> &items)
+{
+    if (m_items.isEmpty()) {
+        m_items = items;
+        return;
+    }
+    for (auto it = items.constBegin(); it != items.constEnd(); ++it) {
+        m_items[it.key()] = it.value();
+    }
 }
 
 bool CollectionModel::unlockItem(int itemId)
@@ -175,6 +324,7 @@ bool CollectionModel::unlockItem(int itemId)
         qDebug() << "解锁图鉴物品:" << itemId << "(" << info.name << ")";
         
         emit itemUnlocked(itemId);
+        journalItem(itemId);
         fireCollectionUpdate();
         return true;
     }
@@ -201,6 +351,7 @@ bool CollectionModel::collectItem(int itemId, int count)
     qDebug() << "收集图鉴物品:" << itemId << "数量:" << count << "总计:" << info.totalObtained;
     
     emit itemCollected(itemId, count);
+    journalItem(itemId);
     fireCollectionUpdate();
     return true;
 }
@@ -348,6 +499,7 @@ void CollectionModel::printStatistics() const
 
 void CollectionModel::fireCollectionUpdate()
 {
+    m_dirty = true;
     emit collectionUpdated();
 }
 
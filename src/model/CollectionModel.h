@@ -13,6 +13,8 @@
 #include <QDebug>
 #include "../common/base/CollectionInfo.h"
 #include "../common/PropertyTrigger.h"
+#include "../common/BinaryCodec.h"
+#include "../common/SaveJournal.h"
 
 class CollectionModel : public QObject
 {
@@ -24,7 +26,38 @@ public:
     // 文件操作
     void loadFromFile(const QString &filename = "collection_data.json");
     void saveToFile(const QString &filename = "collection_data.json") const;
+    QJsonObject toJson() const;
+    void fromJson(const QJsonObject &rootJson);
+    void readBinary(BinaryReader &in);
+
+    // 存档快照：QMap 隐式共享，复制只增加引用计数，可以交给后台线程序列化
+    using SaveSnapshot = QMap<int, CollectionItemInfo>;
+    SaveSnapshot saveSnapshot() const {
+        return m_items;
+    }
+    static void writeBinary(const SaveSnapshot &items, BinaryWriter &out);
+    void writeBinary(BinaryWriter &out) const {
+        writeBinary(m_items, out);
+    }
+
+    // 存档日志：设置后每次解锁/收集追加一条记录；启动时用 applyJournalRecord 重放
+    void setJournal(SaveJournal *journal) noexcept {
+        m_journal = journal;
+    }
+    void applyJournalRecord(SaveJournal::RecordType type, BinaryReader &in);
+
+    // 自上次存档以来图鉴是否被修改
+    bool isDirty() const noexcept {
+        return m_dirty;
+    }
+    void clearDirty() noexcept {
+        m_dirty = false;
+    }
     void loadItemsFromCSV(const QString &csvPath);
+
+    // 只解析配置不修改模型，可以在后台线程调用；setItemCatalog 在GUI线程写入模型
+    static QMap<int, CollectionItemInfo> parseItemsCSV(const QString &csvPath);
+    void setItemCatalog(const QMap<int, CollectionItemInfo> &items);
     
     // 解锁和收集
     bool unlockItem(int itemId);
@@ -65,8 +98,11 @@ signals:
 private:
     QMap<int, CollectionItemInfo> m_items;
     PropertyTrigger m_trigger;
+    bool m_dirty = false; // 有未保存的修改
+    SaveJournal *m_journal = nullptr; // 存档日志（不持有）
     
     void fireCollectionUpdate();
+    void journalItem(int itemId);
     void ensureItemExists(int itemId);
 };
 
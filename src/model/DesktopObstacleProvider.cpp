@@ -0,0 +1,119 @@
+#include "DesktopObstacleProvider.h"
+#include "X11DesktopObstacleProvider.h"
+#include <QDebug>
+#include <QHash>
+
+namespace {
+
+bool sameObstacle(const DesktopIconInfo& a, const DesktopIconInfo& b)
+{
+    return a.rect == b.rect && a.isVisible == b.isVisible && a.text == b.text;
+}
+
+} // namespace
+
+SyntheticObstacleProvider::SyntheticObstacleProvider()
+{
+    // 标准图标大小 48x48
+    const QVector<QPoint> iconPositions = {
+        QPoint(50, 50),    // 左上角
+        QPoint(50, 150),   // 左侧
+        QPoint(50, 250),   // 左侧
+        QPoint(150, 50),   // 上方
+        QPoint(150, 150),  // 中间偏左
+        QPoint(250, 50),   // 上方
+        QPoint(250, 150),  // 中间
+    };
+    for (const QPoint& pos : iconPositions) {
+        m_rects.append(QRect(pos.x(), pos.y(), 48, 48));
+    }
+}
+
+SyntheticObstacleProvider::SyntheticObstacleProvider(const QVector<QRect>& rects)
+    : m_rects(rects)
+{
+}
+
+QVector<DesktopIconInfo> SyntheticObstacleProvider::enumerate()
+{
+    QVector<DesktopIconInfo> icons;
+    icons.reserve(m_rects.size());
+    for (int i = 0; i < m_rects.size(); ++i) {
+        DesktopIconInfo iconInfo;
+        iconInfo.rect = m_rects[i];
+        iconInfo.id = static_cast<quint64>(i) + 1;
+        iconInfo.index = i;
+        iconInfo.isVisible = true;
+        iconInfo.text = QString("Test_Icon_%1").arg(i + 1);
+        icons.append(iconInfo);
+    }
+    return icons;
+}
+
+std::unique_ptr<IDesktopObstacleProvider> createDefaultObstacleProvider()
+{
+    if (qEnvironmentVariable("DESKTOPPET_OBSTACLES") != QLatin1String("synthetic")) {
+#ifdef DESKTOPPET_HAVE_X11
+        if (auto provider = createX11ObstacleProvider()) {
+            return provider;
+        }
+        qDebug() << "Could not connect to X11 display, falling back to synthetic obstacles";
+#endif
+        // Windows 下通过 SysListView32 枚举桌面图标需要跨进程读内存，之前直接调用会卡住系统，
+        // 在有可靠实现之前同样使用合成障碍物
+    }
+    return std::make_unique<SyntheticObstacleProvider>();
+}
+
+ObstacleDiff mergeObstacles(QVector<DesktopIconInfo>& current, std::vector<bool>& interacted,
+                            const QVector<DesktopIconInfo>& fresh)
+{
+    ObstacleDiff diff;
+    interacted.resize(current.size(), false);
+
+    // 快速路径：id 和顺序都没变，只改写变化的条目，下标和已交互标记不动
+    bool sameOrder = current.size() == fresh.size();
+    for (int i = 0; sameOrder && i < fresh.size(); ++i) {
+        sameOrder = current[i].id == fresh[i].id;
+    }
+    if (sameOrder) {
+        for (int i = 0; i < fresh.size(); ++i) {
+            if (!sameObstacle(current[i], fresh[i])) {
+                current[i] = fresh[i];
+                current[i].index = i;
+                ++diff.updated;
+            }
+        }
+        return diff;
+    }
+
+    // 有增删或顺序变化：按 id 对应新旧条目，已交互标记跟随 id
+    QHash<quint64, int> oldIndex;
+    oldIndex.reserve(current.size());
+    for (int i = 0; i < current.size(); ++i) {
+        oldIndex.insert(current[i].id, i);
+    }
+
+    std::vector<bool> freshInteracted(fresh.size(), false);
+    for (int i = 0; i < fresh.size(); ++i) {
+        auto it = oldIndex.find(fresh[i].id);
+        if (it == oldIndex.end()) {
+            ++diff.added;
+            continue;
+        }
+        freshInteracted[i] = interacted[it.value()];
+        if (!sameObstacle(current[it.value()], fresh[i])) {
+            ++diff.updated;
+        }
+        oldIndex.erase(it);
+    }
+    diff.removed = oldIndex.size();
+    diff.reindexed = true;
+
+    current = fresh;
+    for (int i = 0; i < current.size(); ++i) {
+        current[i].index = i;
+    }
+    interacted.swap(freshInteracted);
+    return diff;
+}
@@ -0,0 +1,81 @@
+#ifndef __DESKTOP_OBSTACLE_PROVIDER_H__
+#define __DESKTOP_OBSTACLE_PROVIDER_H__
+
+#include <QRect>
+#include <QString>
+#include <QVector>
+#include <QtGlobal>
+#include <memory>
+#include <vector>
+
+/**
+ * 桌面障碍物信息（桌面图标或顶层窗口）
+ */
+struct DesktopIconInfo {
+    QRect rect;          // 障碍物的位置和大小
+    QString text;        // 图标文本或窗口标题
+    quint64 id;          // 稳定标识（X11窗口ID、合成障碍物的序号），刷新时按它做增量比较
+    int index;           // 在列表中的索引
+    bool isVisible;      // 是否可见
+
+    DesktopIconInfo() : id(0), index(-1), isVisible(true) {}
+};
+
+/**
+ * 桌面障碍物来源接口
+ * AutoMovementModel 只通过它获取障碍物，不直接依赖平台API
+ */
+class IDesktopObstacleProvider
+{
+public:
+    virtual ~IDesktopObstacleProvider() = default;
+
+    virtual const char* name() const = 0;
+
+    // 枚举当前的障碍物，每次调用返回完整列表
+    virtual QVector<DesktopIconInfo> enumerate() = 0;
+};
+
+/**
+ * 合成障碍物：固定的区域列表，用于测试、基准和没有可用平台实现的环境
+ */
+class SyntheticObstacleProvider : public IDesktopObstacleProvider
+{
+public:
+    // 默认为左上角的7个模拟图标
+    SyntheticObstacleProvider();
+    explicit SyntheticObstacleProvider(const QVector<QRect>& rects);
+
+    const char* name() const override { return "synthetic"; }
+    QVector<DesktopIconInfo> enumerate() override;
+
+    // 替换区域列表，rects[i] 的 id 固定为 i+1，用于模拟图标移动/增删
+    void setRects(const QVector<QRect>& rects) { m_rects = rects; }
+
+private:
+    QVector<QRect> m_rects;
+};
+
+// 按平台选择障碍物来源：
+// 环境变量 DESKTOPPET_OBSTACLES=synthetic 时强制使用合成障碍物；
+// Linux 下编译了 X11 支持且能连接显示服务器时枚举顶层窗口；其余情况使用合成障碍物
+std::unique_ptr<IDesktopObstacleProvider> createDefaultObstacleProvider();
+
+/**
+ * 一次刷新的增量结果
+ */
+struct ObstacleDiff {
+    int added = 0;        // 新出现的障碍物
+    int removed = 0;      // 消失的障碍物
+    int updated = 0;      // 区域、可见性或文本变化的障碍物
+    bool reindexed = false; // 下标发生了变化（有增删或顺序变化）
+
+    bool changed() const { return added || removed || updated || reindexed; }
+};
+
+// 用新枚举结果增量更新 current：id 和顺序不变时只改写变化的条目，
+// 否则按 id 重新排列，interacted（按下标的已交互标记）跟随 id 保留
+ObstacleDiff mergeObstacles(QVector<DesktopIconInfo>& current, std::vector<bool>& interacted,
+                            const QVector<DesktopIconInfo>& fresh);
+
+#endif // __DESKTOP_OBSTACLE_PROVIDER_H__
@@ -3,21 +3,25 @@
 #include "CollectionModel.h"
 #include "WorkModel.h"
 #include "../common/PropertyIds.h"
+#include "../common/RandomService.h"
 #include <QJsonDocument>
 #include <QFile>
 #include <QTextStream>
-#include <QRandomGenerator>
 #include <QDebug>
 #include <QDateTime>
 
-ForgeModel::ForgeModel(QObject *parent)
-    : QObject(parent), m_totalForgeCount(0), m_successfulForgeCount(0)
+ForgeModel::ForgeModel(QObject *parent, TableInit tables)
+    : QObject(parent), m_totalForgeCount(0), m_successfulForgeCount(0),
+      m_rng(&RandomService::GetInstance().stream(RandomStream::Forge))
 {
     // 初始化工作系统等级
     m_workSystemLevels[WorkType::Photosynthesis] = WorkSystemLevel::Basic;
 
-    // 初始化默认配方和升级路径
-    initialize();
+    // 初始化默认配方和升级路径（DeferTables 时由调用方稍后通过 setTables 设置）
+    if (tables == BuildTables)
+    {
+        initialize();
+    }
 }
 
 ForgeModel::~ForgeModel()
@@ -26,13 +30,26 @@ ForgeModel::~ForgeModel()
 
 void ForgeModel::initialize()
 {
-    initializeDefaultRecipes();
-    initializeWorkUpgrades();
+    setTables(buildTables());
+}
+
+ForgeModel::Tables ForgeModel::buildTables()
+{
+    Tables tables;
+    tables.recipes = buildDefaultRecipes();
+    tables.upgrades = buildWorkUpgrades();
+    return tables;
+}
+
+void ForgeModel::setTables(Tables tables)
+{
+    m_recipes = std::move(tables.recipes);
+    m_workUpgrades = std::move(tables.upgrades);
 }
 
-void ForgeModel::initializeDefaultRecipes()
+QVector<ForgeRecipe> ForgeModel::buildDefaultRecipes()
 {
-    m_recipes.clear();
+    QVector<ForgeRecipe> recipes;
 
     // ========== 阳光合成配方 ========= =
     // 阳光合成不需要其他物品，直接升级
@@ -51,7 +68,7 @@ void ForgeModel::initializeDefaultRecipes()
     };
     sunlightUpgrade1.unlockLevel = 1;
     sunlightUpgrade1.requiresCatalyst = false;
-    m_recipes.append(sunlightUpgrade1);
+    recipes.append(sunlightUpgrade1);
 
     // 配方2: 5个温暖阳光 -> 1个炽热阳光
     ForgeRecipe sunlightUpgrade2;
@@ -67,7 +84,7 @@ void ForgeModel::initializeDefaultRecipes()
     };
     sunlightUpgrade2.unlockLevel = 1;
     sunlightUpgrade2.requiresCatalyst = false;
-    m_recipes.append(sunlightUpgrade2);
+    recipes.append(sunlightUpgrade2);
 
     // 配方3: 5个炽热阳光 -> 1个灿烂阳光
     ForgeRecipe sunlightUpgrade3;
@@ -83,7 +100,7 @@ void ForgeModel::initializeDefaultRecipes()
     };
     sunlightUpgrade3.unlockLevel = 1;
     sunlightUpgrade3.requiresCatalyst = false;
-    m_recipes.append(sunlightUpgrade3);
+    recipes.append(sunlightUpgrade3);
 
     // 配方4: 5个灿烂阳光 -> 1个神圣阳光
     ForgeRecipe sunlightUpgrade4;
@@ -99,7 +116,7 @@ void ForgeModel::initializeDefaultRecipes()
     };
     sunlightUpgrade4.unlockLevel = 1;
     sunlightUpgrade4.requiresCatalyst = false;
-    m_recipes.append(sunlightUpgrade4);
+    recipes.append(sunlightUpgrade4);
 
     // ========== 矿石合成配方 ========= =
     // 5个低品质矿石 + 对应品质阳光 -> 1个高品质矿石
@@ -111,15 +128,15 @@ void ForgeModel::initializeDefaultRecipes()
     mineralUpgrade1.description = "5个粗糙矿石 + 1个温暖阳光合成1个普通矿石";
     mineralUpgrade1.type = ForgeRecipeType::Special;
     mineralUpgrade1.materials = {
-        ForgeMaterial(11, 5, false),             // 5个粗糙矿石
-        ForgeMaterial(SUNSHINE_WARM_ID, 1, true) // 1个温暖阳光作为催化剂
+        ForgeMaterial(Items::MINERAL_ROUGH, 5, false), // 5个粗糙矿石
+        ForgeMaterial(SUNSHINE_WARM_ID, 1, true)       // 1个温暖阳光作为催化剂
     };
     mineralUpgrade1.outputs = {
-        ForgeOutput(12, 1, 1.0f) // 1个普通矿石
+        ForgeOutput(Items::MINERAL_COMMON, 1, 1.0f) // 1个普通矿石
     };
     mineralUpgrade1.unlockLevel = 1;
     mineralUpgrade1.requiresCatalyst = true;
-    m_recipes.append(mineralUpgrade1);
+    recipes.append(mineralUpgrade1);
 
     // 配方6: 5个普通矿石 + 1个炽热阳光 -> 1个优质矿石
     ForgeRecipe mineralUpgrade2;
@@ -128,15 +145,15 @@ void ForgeModel::initializeDefaultRecipes()
     mineralUpgrade2.description = "5个普通矿石 + 1个炽热阳光合成1个优质矿石";
     mineralUpgrade2.type = ForgeRecipeType::Special;
     mineralUpgrade2.materials = {
-        ForgeMaterial(12, 5, false),            // 5个普通矿石
-        ForgeMaterial(SUNSHINE_HOT_ID, 1, true) // 1个炽热阳光作为催化剂
+        ForgeMaterial(Items::MINERAL_COMMON, 5, false), // 5个普通矿石
+        ForgeMaterial(SUNSHINE_HOT_ID, 1, true)         // 1个炽热阳光作为催化剂
     };
     mineralUpgrade2.outputs = {
-        ForgeOutput(13, 1, 1.0f) // 1个优质矿石
+        ForgeOutput(Items::MINERAL_FINE, 1, 1.0f) // 1个优质矿石
     };
     mineralUpgrade2.unlockLevel = 1;
     mineralUpgrade2.requiresCatalyst = true;
-    m_recipes.append(mineralUpgrade2);
+    recipes.append(mineralUpgrade2);
 
     // 配方7: 5个优质矿石 + 1个灿烂阳光 -> 1个稀有矿石
     ForgeRecipe mineralUpgrade3;
@@ -145,15 +162,15 @@ void ForgeModel::initializeDefaultRecipes()
     mineralUpgrade3.description = "5个优质矿石 + 1个灿烂阳光合成1个稀有矿石";
     mineralUpgrade3.type = ForgeRecipeType::Special;
     mineralUpgrade3.materials = {
-        ForgeMaterial(13, 5, false),                  // 5个优质矿石
+        ForgeMaterial(Items::MINERAL_FINE, 5, false), // 5个优质矿石
         ForgeMaterial(SUNSHINE_BRILLIANT_ID, 1, true) // 1个灿烂阳光作为催化剂
     };
     mineralUpgrade3.outputs = {
-        ForgeOutput(14, 1, 1.0f) // 1个稀有矿石
+        ForgeOutput(Items::MINERAL_RARE, 1, 1.0f) // 1个稀有矿石
     };
     mineralUpgrade3.unlockLevel = 1;
     mineralUpgrade3.requiresCatalyst = true;
-    m_recipes.append(mineralUpgrade3);
+    recipes.append(mineralUpgrade3);
 
     // 配方8: 5个稀有矿石 + 1个神圣阳光 -> 1个传说矿石
     ForgeRecipe mineralUpgrade4;
@@ -162,15 +179,15 @@ void ForgeModel::initializeDefaultRecipes()
     mineralUpgrade4.description = "5个稀有矿石 + 1个神圣阳光合成1个传说矿石";
     mineralUpgrade4.type = ForgeRecipeType::Special;
     mineralUpgrade4.materials = {
-        ForgeMaterial(14, 5, false),               // 5个稀有矿石
-        ForgeMaterial(SUNSHINE_SACRED_ID, 1, true) // 1个神圣阳光作为催化剂
+        ForgeMaterial(Items::MINERAL_RARE, 5, false), // 5个稀有矿石
+        ForgeMaterial(SUNSHINE_SACRED_ID, 1, true)    // 1个神圣阳光作为催化剂
     };
     mineralUpgrade4.outputs = {
-        ForgeOutput(15, 1, 1.0f) // 1个传说矿石
+        ForgeOutput(Items::MINERAL_LEGENDARY, 1, 1.0f) // 1个传说矿石
     };
     mineralUpgrade4.unlockLevel = 1;
     mineralUpgrade4.requiresCatalyst = true;
-    m_recipes.append(mineralUpgrade4);
+    recipes.append(mineralUpgrade4);
 
     // ========== 木材合成配方 ========= =
     // 5个低品质木材 + 对应品质阳光 -> 1个高品质木材
@@ -182,15 +199,15 @@ void ForgeModel::initializeDefaultRecipes()
     woodUpgrade1.description = "5个枯木 + 1个温暖阳光合成1个普通木材";
     woodUpgrade1.type = ForgeRecipeType::Special;
     woodUpgrade1.materials = {
-        ForgeMaterial(16, 5, false),             // 5个枯木
-        ForgeMaterial(SUNSHINE_WARM_ID, 1, true) // 1个温暖阳光作为催化剂
+        ForgeMaterial(Items::WOOD_DEAD, 5, false), // 5个枯木
+        ForgeMaterial(SUNSHINE_WARM_ID, 1, true)   // 1个温暖阳光作为催化剂
     };
     woodUpgrade1.outputs = {
-        ForgeOutput(17, 1, 1.0f) // 1个普通木材
+        ForgeOutput(Items::WOOD_COMMON, 1, 1.0f) // 1个普通木材
     };
     woodUpgrade1.unlockLevel = 1;
     woodUpgrade1.requiresCatalyst = true;
-    m_recipes.append(woodUpgrade1);
+    recipes.append(woodUpgrade1);
 
     // 配方10: 5个普通木材 + 1个炽热阳光 -> 1个优质木材
     ForgeRecipe woodUpgrade2;
@@ -199,15 +216,15 @@ void ForgeModel::initializeDefaultRecipes()
     woodUpgrade2.description = "5个普通木材 + 1个炽热阳光合成1个优质木材";
     woodUpgrade2.type = ForgeRecipeType::Special;
     woodUpgrade2.materials = {
-        ForgeMaterial(17, 5, false),            // 5个普通木材
-        ForgeMaterial(SUNSHINE_HOT_ID, 1, true) // 1个炽热阳光作为催化剂
+        ForgeMaterial(Items::WOOD_COMMON, 5, false), // 5个普通木材
+        ForgeMaterial(SUNSHINE_HOT_ID, 1, true)      // 1个炽热阳光作为催化剂
     };
     woodUpgrade2.outputs = {
-        ForgeOutput(18, 1, 1.0f) // 1个优质木材
+        ForgeOutput(Items::WOOD_FINE, 1, 1.0f) // 1个优质木材
     };
     woodUpgrade2.unlockLevel = 1;
     woodUpgrade2.requiresCatalyst = true;
-    m_recipes.append(woodUpgrade2);
+    recipes.append(woodUpgrade2);
 
     // 配方11: 5个优质木材 + 1个灿烂阳光 -> 1个稀有木材
     ForgeRecipe woodUpgrade3;
@@ -216,15 +233,15 @@ void ForgeModel::initializeDefaultRecipes()
     woodUpgrade3.description = "5个优质木材 + 1个灿烂阳光合成1个稀有木材";
     woodUpgrade3.type = ForgeRecipeType::Special;
     woodUpgrade3.materials = {
-        ForgeMaterial(18, 5, false),                  // 5个优质木材
+        ForgeMaterial(Items::WOOD_FINE, 5, false),    // 5个优质木材
         ForgeMaterial(SUNSHINE_BRILLIANT_ID, 1, true) // 1个灿烂阳光作为催化剂
     };
     woodUpgrade3.outputs = {
-        ForgeOutput(19, 1, 1.0f) // 1个稀有木材
+        ForgeOutput(Items::WOOD_RARE, 1, 1.0f) // 1个稀有木材
     };
     woodUpgrade3.unlockLevel = 1;
     woodUpgrade3.requiresCatalyst = true;
-    m_recipes.append(woodUpgrade3);
+    recipes.append(woodUpgrade3);
 
     // 配方12: 5个稀有木材 + 1个神圣阳光 -> 1个神木
     ForgeRecipe woodUpgrade4;
@@ -233,22 +250,23 @@ void ForgeModel::initializeDefaultRecipes()
     woodUpgrade4.description = "5个稀有木材 + 1个神圣阳光合成1个神木";
     woodUpgrade4.type = ForgeRecipeType::Special;
     woodUpgrade4.materials = {
-        ForgeMaterial(19, 5, false),               // 5个稀有木材
+        ForgeMaterial(Items::WOOD_RARE, 5, false), // 5个稀有木材
         ForgeMaterial(SUNSHINE_SACRED_ID, 1, true) // 1个神圣阳光作为催化剂
     };
     woodUpgrade4.outputs = {
-        ForgeOutput(20, 1, 1.0f) // 1个神木
+        ForgeOutput(Items::WOOD_DIVINE, 1, 1.0f) // 1个神木
     };
     woodUpgrade4.unlockLevel = 1;
     woodUpgrade4.requiresCatalyst = true;
-    m_recipes.append(woodUpgrade4);
+    recipes.append(woodUpgrade4);
 
-    qDebug() << "ForgeModel: Initialized" << m_recipes.size() << "synthesis recipes";
+    qDebug() << "ForgeModel: Initialized" << recipes.size() << "synthesis recipes";
+    return recipes;
 }
 
-void ForgeModel::initializeWorkUpgrades()
+QVector<WorkSystemUpgrade> ForgeModel::buildWorkUpgrades()
 {
-    m_workUpgrades.clear();
+    QVector<WorkSystemUpgrade> upgrades;
 
     // ========== 光合作用工作系统升级 ==========
     // 基础 → 进阶
@@ -259,12 +277,12 @@ void ForgeModel::initializeWorkUpgrades()
     photoUpgrade1.upgradeMaterials = {
         ForgeMaterial(SUNSHINE_WARM_ID, 10, false), // 10个温暖阳光
         ForgeMaterial(SUNSHINE_HOT_ID, 5, false),   // 5个炽热阳光
-        ForgeMaterial(16, 5, false)                 // 5个枯木作为辅助材料
+        ForgeMaterial(Items::WOOD_DEAD, 5, false)   // 5个枯木作为辅助材料
     };
     photoUpgrade1.dropRateMultiplier = 1.5f;
     photoUpgrade1.qualityBonus = 0.2f;
     photoUpgrade1.unlockedItems = {201, 202};
-    m_workUpgrades.append(photoUpgrade1);
+    upgrades.append(photoUpgrade1);
 
     // 进阶 → 专家
     WorkSystemUpgrade photoUpgrade2;
@@ -274,13 +292,13 @@ void ForgeModel::initializeWorkUpgrades()
     photoUpgrade2.upgradeMaterials = {
         ForgeMaterial(SUNSHINE_HOT_ID, 15, false),      // 15个炽热阳光
         ForgeMaterial(SUNSHINE_BRILLIANT_ID, 8, false), // 8个灿烂阳光
-        ForgeMaterial(17, 8, false),                    // 8个普通木材
-        ForgeMaterial(11, 10, false)                    // 10个粗糙矿石
+        ForgeMaterial(Items::WOOD_COMMON, 8, false),    // 8个普通木材
+        ForgeMaterial(Items::MINERAL_ROUGH, 10, false)  // 10个粗糙矿石
     };
     photoUpgrade2.dropRateMultiplier = 2.0f;
     photoUpgrade2.qualityBonus = 0.4f;
     photoUpgrade2.unlockedItems = {203, 204, 205};
-    m_workUpgrades.append(photoUpgrade2);
+    upgrades.append(photoUpgrade2);
 
     // 专家 → 大师
     WorkSystemUpgrade photoUpgrade3;
@@ -290,13 +308,13 @@ void ForgeModel::initializeWorkUpgrades()
     photoUpgrade3.upgradeMaterials = {
         ForgeMaterial(SUNSHINE_BRILLIANT_ID, 20, false), // 20个灿烂阳光
         ForgeMaterial(SUNSHINE_SACRED_ID, 10, false),    // 10个神圣阳光
-        ForgeMaterial(18, 5, false),                     // 5个优质木材
-        ForgeMaterial(13, 5, false)                      // 5个优质矿石
+        ForgeMaterial(Items::WOOD_FINE, 5, false),       // 5个优质木材
+        ForgeMaterial(Items::MINERAL_FINE, 5, false)     // 5个优质矿石
     };
     photoUpgrade3.dropRateMultiplier = 3.0f;
     photoUpgrade3.qualityBonus = 0.6f;
     photoUpgrade3.unlockedItems = {206, 207, 208, 209};
-    m_workUpgrades.append(photoUpgrade3);
+    upgrades.append(photoUpgrade3);
 
     // ========== 挖矿工作系统升级 ==========
     // 基础 → 进阶
@@ -305,14 +323,14 @@ void ForgeModel::initializeWorkUpgrades()
     miningUpgrade1.currentLevel = WorkSystemLevel::Basic;
     miningUpgrade1.targetLevel = WorkSystemLevel::Advanced;
     miningUpgrade1.upgradeMaterials = {
-        ForgeMaterial(11, 15, false),             // 15个粗糙矿石
-        ForgeMaterial(12, 8, false),              // 8个普通矿石
-        ForgeMaterial(SUNSHINE_WARM_ID, 5, false) // 5个温暖阳光
+        ForgeMaterial(Items::MINERAL_ROUGH, 15, false), // 15个粗糙矿石
+        ForgeMaterial(Items::MINERAL_COMMON, 8, false), // 8个普通矿石
+        ForgeMaterial(SUNSHINE_WARM_ID, 5, false)       // 5个温暖阳光
     };
     miningUpgrade1.dropRateMultiplier = 1.5f;
     miningUpgrade1.qualityBonus = 0.2f;
     miningUpgrade1.unlockedItems = {211, 212};
-    m_workUpgrades.append(miningUpgrade1);
+    upgrades.append(miningUpgrade1);
 
     // 进阶 → 专家
     WorkSystemUpgrade miningUpgrade2;
@@ -320,15 +338,15 @@ void ForgeModel::initializeWorkUpgrades()
     miningUpgrade2.currentLevel = WorkSystemLevel::Advanced;
     miningUpgrade2.targetLevel = WorkSystemLevel::Expert;
     miningUpgrade2.upgradeMaterials = {
-        ForgeMaterial(12, 20, false),             // 20个普通矿石
-        ForgeMaterial(13, 12, false),             // 12个优质矿石
-        ForgeMaterial(SUNSHINE_HOT_ID, 8, false), // 8个炽热阳光
-        ForgeMaterial(17, 10, false)              // 10个普通木材
+        ForgeMaterial(Items::MINERAL_COMMON, 20, false), // 20个普通矿石
+        ForgeMaterial(Items::MINERAL_FINE, 12, false),   // 12个优质矿石
+        ForgeMaterial(SUNSHINE_HOT_ID, 8, false),        // 8个炽热阳光
+        ForgeMaterial(Items::WOOD_COMMON, 10, false)     // 10个普通木材
     };
     miningUpgrade2.dropRateMultiplier = 2.0f;
     miningUpgrade2.qualityBonus = 0.4f;
     miningUpgrade2.unlockedItems = {213, 214, 215};
-    m_workUpgrades.append(miningUpgrade2);
+    upgrades.append(miningUpgrade2);
 
     // 专家 → 大师
     WorkSystemUpgrade miningUpgrade3;
@@ -336,15 +354,15 @@ void ForgeModel::initializeWorkUpgrades()
     miningUpgrade3.currentLevel = WorkSystemLevel::Expert;
     miningUpgrade3.targetLevel = WorkSystemLevel::Master;
     miningUpgrade3.upgradeMaterials = {
-        ForgeMaterial(13, 25, false),                   // 25个优质矿石
-        ForgeMaterial(14, 15, false),                   // 15个稀有矿石
-        ForgeMaterial(15, 3, false),                    // 3个传说矿石
-        ForgeMaterial(SUNSHINE_BRILLIANT_ID, 10, false) // 10个灿烂阳光
+        ForgeMaterial(Items::MINERAL_FINE, 25, false),     // 25个优质矿石
+        ForgeMaterial(Items::MINERAL_RARE, 15, false),     // 15个稀有矿石
+        ForgeMaterial(Items::MINERAL_LEGENDARY, 3, false), // 3个传说矿石
+        ForgeMaterial(SUNSHINE_BRILLIANT_ID, 10, false)    // 10个灿烂阳光
     };
     miningUpgrade3.dropRateMultiplier = 3.0f;
     miningUpgrade3.qualityBonus = 0.6f;
     miningUpgrade3.unlockedItems = {216, 217, 218, 219};
-    m_workUpgrades.append(miningUpgrade3);
+    upgrades.append(miningUpgrade3);
 
     // ========== 冒险工作系统升级 ==========
     // 基础 → 进阶
@@ -353,14 +371,14 @@ void ForgeModel::initializeWorkUpgrades()
     adventureUpgrade1.currentLevel = WorkSystemLevel::Basic;
     adventureUpgrade1.targetLevel = WorkSystemLevel::Advanced;
     adventureUpgrade1.upgradeMaterials = {
-        ForgeMaterial(16, 15, false), // 15个枯木
-        ForgeMaterial(17, 8, false),  // 8个普通木材
-        ForgeMaterial(11, 5, false)   // 5个粗糙矿石
+        ForgeMaterial(Items::WOOD_DEAD, 15, false),   // 15个枯木
+        ForgeMaterial(Items::WOOD_COMMON, 8, false),  // 8个普通木材
+        ForgeMaterial(Items::MINERAL_ROUGH, 5, false) // 5个粗糙矿石
     };
     adventureUpgrade1.dropRateMultiplier = 1.5f;
     adventureUpgrade1.qualityBonus = 0.2f;
     adventureUpgrade1.unlockedItems = {221, 222};
-    m_workUpgrades.append(adventureUpgrade1);
+    upgrades.append(adventureUpgrade1);
 
     // 进阶 → 专家
     WorkSystemUpgrade adventureUpgrade2;
@@ -368,15 +386,15 @@ void ForgeModel::initializeWorkUpgrades()
     adventureUpgrade2.currentLevel = WorkSystemLevel::Advanced;
     adventureUpgrade2.targetLevel = WorkSystemLevel::Expert;
     adventureUpgrade2.upgradeMaterials = {
-        ForgeMaterial(17, 20, false),            // 20个普通木材
-        ForgeMaterial(18, 12, false),            // 12个优质木材
-        ForgeMaterial(12, 8, false),             // 8个普通矿石
-        ForgeMaterial(SUNSHINE_HOT_ID, 5, false) // 5个炽热阳光
+        ForgeMaterial(Items::WOOD_COMMON, 20, false),   // 20个普通木材
+        ForgeMaterial(Items::WOOD_FINE, 12, false),     // 12个优质木材
+        ForgeMaterial(Items::MINERAL_COMMON, 8, false), // 8个普通矿石
+        ForgeMaterial(SUNSHINE_HOT_ID, 5, false)        // 5个炽热阳光
     };
     adventureUpgrade2.dropRateMultiplier = 2.0f;
     adventureUpgrade2.qualityBonus = 0.4f;
     adventureUpgrade2.unlockedItems = {223, 224, 225};
-    m_workUpgrades.append(adventureUpgrade2);
+    upgrades.append(adventureUpgrade2);
 
     // 专家 → 大师
     WorkSystemUpgrade adventureUpgrade3;
@@ -384,17 +402,18 @@ void ForgeModel::initializeWorkUpgrades()
     adventureUpgrade3.currentLevel = WorkSystemLevel::Expert;
     adventureUpgrade3.targetLevel = WorkSystemLevel::Master;
     adventureUpgrade3.upgradeMaterials = {
-        ForgeMaterial(18, 25, false),               // 25个优质木材
-        ForgeMaterial(19, 15, false),               // 15个稀有木材
-        ForgeMaterial(20, 3, false),                // 3个神木
-        ForgeMaterial(SUNSHINE_SACRED_ID, 5, false) // 5个神圣阳光
+        ForgeMaterial(Items::WOOD_FINE, 25, false),  // 25个优质木材
+        ForgeMaterial(Items::WOOD_RARE, 15, false),  // 15个稀有木材
+        ForgeMaterial(Items::WOOD_DIVINE, 3, false), // 3个神木
+        ForgeMaterial(SUNSHINE_SACRED_ID, 5, false)  // 5个神圣阳光
     };
     adventureUpgrade3.dropRateMultiplier = 3.0f;
     adventureUpgrade3.qualityBonus = 0.6f;
     adventureUpgrade3.unlockedItems = {226, 227, 228, 229};
-    m_workUpgrades.append(adventureUpgrade3);
+    upgrades.append(adventureUpgrade3);
 
-    qDebug() << "ForgeModel: Initialized" << m_workUpgrades.size() << "work upgrades for all work types";
+    qDebug() << "ForgeModel: Initialized" << upgrades.size() << "work upgrades for all work types";
+    return upgrades;
 }
 
 bool ForgeModel::canForge(int recipeId) const
@@ -584,7 +603,7 @@ bool ForgeModel::consumeMaterials(const QVector<ForgeMaterial> &materials)
 
 bool ForgeModel::rollForgeSuccess(float successRate) const
 {
-    float randomValue = QRandomGenerator::global()->generateDouble();
+    float randomValue = m_rng->generateDouble();
     return randomValue <= successRate;
 }
 
@@ -629,6 +648,8 @@ bool ForgeModel::isRecipeUnlocked(int recipeId) const
 void ForgeModel::addForgeHistory(const ForgeHistory &history)
 {
     m_forgeHistory.append(history);
+    m_dirty = true;
+    journalHistory(history);
 
     // 限制历史记录数量
     if (m_forgeHistory.size() > 1000)
@@ -682,6 +703,14 @@ bool ForgeModel::upgradeWorkSystem(WorkType workType, WorkSystemLevel targetLeve
 
             // 升级工作系统
             m_workSystemLevels[workType] = targetLevel;
+            m_dirty = true;
+            if (m_journal)
+            {
+                BinaryWriter record;
+                record.writeUInt(1, static_cast<uint64_t>(workType));
+                record.writeUInt(2, static_cast<uint64_t>(targetLevel));
+                m_journal->append(SaveJournal::ForgeLevel, record);
+            }
 
             // 更新工作系统效果
             updateWorkSystemBenefits(workType, targetLevel);
@@ -970,6 +999,266 @@ void ForgeModel::fromJson(const QJsonObject &json)
     }
 }
 
+ForgeModel::SaveSnapshot ForgeModel::saveSnapshot() const
+{
+    return SaveSnapshot{m_totalForgeCount, m_successfulForgeCount, m_workSystemLevels, m_forgeHistory};
+}
+
+// 二进制存档字段：
+//   1 总锻造次数 2 成功次数 3 工作类型数组 4 对应等级数组
+//   锻造历史按列存放：5 配方ID 6 时间（秒）差分 7 是否成功
+//   8 每条记录的材料数 9 材料ID 10 材料数量 11 是否催化剂
+//   12 每条记录的产物数 13 产物ID
+void ForgeModel::writeBinary(const SaveSnapshot &snapshot, BinaryWriter &out)
+{
+    out.writeInt(1, snapshot.totalForgeCount);
+    out.writeInt(2, snapshot.successfulForgeCount);
+
+    std::vector<uint64_t> workTypes;
+    std::vector<uint64_t> workLevels;
+    for (auto it = snapshot.workSystemLevels.constBegin(); it != snapshot.workSystemLevels.constEnd(); ++it)
+    {
+        workTypes.push_back(static_cast<uint64_t>(it.key()));
+        workLevels.push_back(static_cast<uint64_t>(it.value()));
+    }
+    out.writePackedUInts(3, workTypes);
+    out.writePackedUInts(4, workLevels);
+
+    std::vector<uint64_t> recipeIds, successes, materialCounts, materialIds, materialAmounts, catalysts;
+    std::vector<uint64_t> productCounts, productIds;
+    std::vector<int64_t> timeDeltas;
+    recipeIds.reserve(snapshot.forgeHistory.size());
+    timeDeltas.reserve(snapshot.forgeHistory.size());
+
+    qint64 lastTime = 0;
+    for (const auto &history : snapshot.forgeHistory)
+    {
+        const qint64 time = history.forgeTime.isValid() ? history.forgeTime.toSecsSinceEpoch() : 0;
+        recipeIds.push_back(static_cast<uint64_t>(history.recipeId));
+        timeDeltas.push_back(time - lastTime);
+        successes.push_back(history.success ? 1 : 0);
+        lastTime = time;
+
+        materialCounts.push_back(static_cast<uint64_t>(history.materialsCost.size()));
+        for (const auto &material : history.materialsCost)
+        {
+            materialIds.push_back(static_cast<uint64_t>(material.itemId));
+            materialAmounts.push_back(static_cast<uint64_t>(material.requiredCount));
+            catalysts.push_back(material.isCatalyst ? 1 : 0);
+        }
+
+        productCounts.push_back(static_cast<uint64_t>(history.productsGained.size()));
+        for (int itemId : history.productsGained)
+        {
+            productIds.push_back(static_cast<uint64_t>(itemId));
+        }
+    }
+
+    out.writePackedUInts(5, recipeIds);
+    out.writePackedInts(6, timeDeltas);
+    out.writePackedUInts(7, successes);
+    out.writePackedUInts(8, materialCounts);
+    out.writePackedUInts(9, materialIds);
+    out.writePackedUInts(10, materialAmounts);
+    out.writePackedUInts(11, catalysts);
+    out.writePackedUInts(12, productCounts);
+    out.writePackedUInts(13, productIds);
+}
+
+void ForgeModel::readBinary(BinaryReader &in)
+{
+    int totalForgeCount = 0;
+    int successfulForgeCount = 0;
+    std::vector<uint64_t> workTypes, workLevels;
+    std::vector<uint64_t> recipeIds, successes, materialCounts, materialIds, materialAmounts, catalysts;
+    std::vector<uint64_t> productCounts, productIds;
+    std::vector<int64_t> timeDeltas;
+
+    while (in.next())
+    {
+        switch (in.field())
+        {
+        case 1: totalForgeCount = static_cast<int>(in.readInt()); break;
+        case 2: successfulForgeCount = static_cast<int>(in.readInt()); break;
+        case 3: in.readPackedUInts(workTypes); break;
+        case 4: in.readPackedUInts(workLevels); break;
+        case 5: in.readPackedUInts(recipeIds); break;
+        case 6: in.readPackedInts(timeDeltas); break;
+        case 7: in.readPackedUInts(successes); break;
+        case 8: in.readPackedUInts(materialCounts); break;
+        case 9: in.readPackedUInts(materialIds); break;
+        case 10: in.readPackedUInts(materialAmounts); break;
+        case 11: in.readPackedUInts(catalysts); break;
+        case 12: in.readPackedUInts(productCounts); break;
+        case 13: in.readPackedUInts(productIds); break;
+        default: break;
+        }
+    }
+    if (!in.isValid())
+    {
+        qDebug() << "ForgeModel: 二进制数据损坏";
+        return;
+    }
+
+    m_totalForgeCount = totalForgeCount;
+    m_successfulForgeCount = successfulForgeCount;
+
+    for (size_t i = 0; i < workTypes.size() && i < workLevels.size(); ++i)
+    {
+        m_workSystemLevels[static_cast<WorkType>(workTypes[i])] = static_cast<WorkSystemLevel>(workLevels[i]);
+    }
+
+    m_forgeHistory.clear();
+    m_forgeHistory.reserve(static_cast<int>(recipeIds.size()));
+    size_t materialPos = 0;
+    size_t productPos = 0;
+    qint64 time = 0;
+    for (size_t i = 0; i < recipeIds.size(); ++i)
+    {
+        ForgeHistory history;
+        history.recipeId = static_cast<int>(recipeIds[i]);
+        time += i < timeDeltas.size() ? timeDeltas[i] : 0;
+        if (time > 0)
+        {
+            history.forgeTime = QDateTime::fromSecsSinceEpoch(time);
+        }
+        history.success = i < successes.size() && successes[i] != 0;
+
+        const size_t materials = i < materialCounts.size() ? static_cast<size_t>(materialCounts[i]) : 0;
+        for (size_t m = 0; m < materials && materialPos < materialIds.size(); ++m, ++materialPos)
+        {
+            ForgeMaterial material;
+            material.itemId = static_cast<int>(materialIds[materialPos]);
+            material.requiredCount = materialPos < materialAmounts.size() ? static_cast<int>(materialAmounts[materialPos]) : 0;
+            material.isCatalyst = materialPos < catalysts.size() && catalysts[materialPos] != 0;
+            history.materialsCost.append(material);
+        }
+
+        const size_t products = i < productCounts.size() ? static_cast<size_t>(productCounts[i]) : 0;
+        for (size_t p = 0; p < products && productPos < productIds.size(); ++p, ++productPos)
+        {
+            history.productsGained.append(static_cast<int>(productIds[productPos]));
+        }
+
+        m_forgeHistory.append(history);
+    }
+}
+
+// 锻造历史日志记录：1 配方ID 2 时间（秒） 3 是否成功 4 材料ID 5 材料数量 6 是否催化剂 7 产物ID
+//                   8 总锻造次数 9 成功次数
+// 工作系统等级日志记录：1 工作类型 2 等级
+void ForgeModel::journalHistory(const ForgeHistory &history)
+{
+    if (!m_journal)
+    {
+        return;
+    }
+
+    std::vector<uint64_t> materialIds, materialAmounts, catalysts, productIds;
+    for (const auto &material : history.materialsCost)
+    {
+        materialIds.push_back(static_cast<uint64_t>(material.itemId));
+        materialAmounts.push_back(static_cast<uint64_t>(material.requiredCount));
+        catalysts.push_back(material.isCatalyst ? 1 : 0);
+    }
+    for (int itemId : history.productsGained)
+    {
+        productIds.push_back(static_cast<uint64_t>(itemId));
+    }
+
+    BinaryWriter record;
+    record.writeUInt(1, static_cast<uint64_t>(history.recipeId));
+    record.writeInt(2, history.forgeTime.isValid() ? history.forgeTime.toSecsSinceEpoch() : 0);
+    record.writeBool(3, history.success);
+    record.writePackedUInts(4, materialIds);
+    record.writePackedUInts(5, materialAmounts);
+    record.writePackedUInts(6, catalysts);
+    record.writePackedUInts(7, productIds);
+    record.writeInt(8, m_totalForgeCount);
+    record.writeInt(9, m_successfulForgeCount);
+    m_journal->append(SaveJournal::ForgeHistoryItem, record);
+}
+
+void ForgeModel::applyJournalRecord(SaveJournal::RecordType type, BinaryReader &in)
+{
+    if (type == SaveJournal::ForgeLevel)
+    {
+        int workType = -1;
+        int level = -1;
+        while (in.next())
+        {
+            switch (in.field())
+            {
+            case 1: workType = static_cast<int>(in.readUInt()); break;
+            case 2: level = static_cast<int>(in.readUInt()); break;
+            default: break;
+            }
+        }
+        if (in.isValid() && workType >= 0 && level >= static_cast<int>(WorkSystemLevel::Basic) &&
+            level <= static_cast<int>(WorkSystemLevel::Master))
+        {
+            m_workSystemLevels[static_cast<WorkType>(workType)] = static_cast<WorkSystemLevel>(level);
+            updateWorkSystemBenefits(static_cast<WorkType>(workType), static_cast<WorkSystemLevel>(level));
+            m_dirty = true;
+        }
+        return;
+    }
+    if (type != SaveJournal::ForgeHistoryItem)
+    {
+        return;
+    }
+
+    ForgeHistory history;
+    qint64 time = 0;
+    int totalForgeCount = m_totalForgeCount;
+    int successfulForgeCount = m_successfulForgeCount;
+    std::vector<uint64_t> materialIds, materialAmounts, catalysts, productIds;
+    while (in.next())
+    {
+        switch (in.field())
+        {
+        case 1: history.recipeId = static_cast<int>(in.readUInt()); break;
+        case 2: time = in.readInt(); break;
+        case 3: history.success = in.readBool(); break;
+        case 4: in.readPackedUInts(materialIds); break;
+        case 5: in.readPackedUInts(materialAmounts); break;
+        case 6: in.readPackedUInts(catalysts); break;
+        case 7: in.readPackedUInts(productIds); break;
+        case 8: totalForgeCount = static_cast<int>(in.readInt()); break;
+        case 9: successfulForgeCount = static_cast<int>(in.readInt()); break;
+        default: break;
+        }
+    }
+    if (!in.isValid())
+    {
+        return;
+    }
+
+    if (time > 0)
+    {
+        history.forgeTime = QDateTime::fromSecsSinceEpoch(time);
+    }
+    for (size_t i = 0; i < materialIds.size(); ++i)
+    {
+        history.materialsCost.append(ForgeMaterial(static_cast<int>(materialIds[i]),
+                                                   i < materialAmounts.size() ? static_cast<int>(materialAmounts[i]) : 0,
+                                                   i < catalysts.size() && catalysts[i] != 0));
+    }
+    for (uint64_t itemId : productIds)
+    {
+        history.productsGained.append(static_cast<int>(itemId));
+    }
+
+    m_totalForgeCount = totalForgeCount;
+    m_successfulForgeCount = successfulForgeCount;
+    m_forgeHistory.append(history);
+    if (m_forgeHistory.size() > 1000)
+    {
+        m_forgeHistory.removeFirst();
+    }
+    m_dirty = true;
+}
+
 void ForgeModel::updateWorkSystemBenefits(WorkType workType, WorkSystemLevel newLevel)
 {
     // 更新工作系统的收益效果
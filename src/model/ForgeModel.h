@@ -2,8 +2,12 @@
 #define __FORGE_MODEL_H__
 
 #include "../common/PropertyTrigger.h"
+#include "../common/BinaryCodec.h"
+#include "../common/SaveJournal.h"
 #include "../common/ForgeTypes.h"
+#include "../common/ItemCatalog.h"
 #include "../common/Types.h"
+#include "../common/RandomService.h"
 #include <QObject>
 #include <QVector>
 #include <QMap>
@@ -20,11 +24,26 @@ class ForgeModel : public QObject
     Q_OBJECT
 
 public:
-    explicit ForgeModel(QObject *parent = nullptr);
+    // 配方表和工作系统升级表：不依赖任何模型状态，可以在后台线程构建
+    struct Tables
+    {
+        QVector<ForgeRecipe> recipes;
+        QVector<WorkSystemUpgrade> upgrades;
+    };
+
+    enum TableInit
+    {
+        BuildTables, // 构造时构建默认配方表
+        DeferTables  // 由调用方稍后通过 setTables 设置
+    };
+
+    explicit ForgeModel(QObject *parent = nullptr, TableInit tables = BuildTables);
     ~ForgeModel();
 
     // 初始化和配置
     void initialize();
+    static Tables buildTables();
+    void setTables(Tables tables);
     void loadRecipesFromFile(const QString& filePath);
     void loadRecipesFromCSV(const QString& csvPath);
     
@@ -33,11 +52,18 @@ public:
     void setCollectionModel(std::shared_ptr<CollectionModel> collectionModel);
     void setWorkModel(std::shared_ptr<WorkModel> workModel);
 
+    // 注入随机数引擎（默认使用RandomService的锻造流）
+    void setRandomEngine(RandomEngine* engine)
+    {
+        m_rng = engine ? engine : &RandomService::GetInstance().stream(RandomStream::Forge);
+    }
+
     // 配方管理
     QVector<ForgeRecipe> getAvailableRecipes() const;
     QVector<ForgeRecipe> getRecipesByType(ForgeRecipeType type) const;
     ForgeRecipe getRecipeById(int recipeId) const;
     bool isRecipeUnlocked(int recipeId) const;
+    const QVector<ForgeRecipe>& getAllRecipes() const { return m_recipes; }
 
     // 锻造操作
     bool canForge(int recipeId) const;
@@ -57,6 +83,7 @@ public:
     WorkSystemLevel getWorkSystemLevel(WorkType workType) const;
     QVector<WorkSystemUpgrade> getAvailableWorkUpgrades() const;
     bool canUpgradeWorkSystem(WorkType workType) const;
+    const QVector<WorkSystemUpgrade>& getAllWorkUpgrades() const { return m_workUpgrades; }
     
     // 统计和历史
     QVector<ForgeHistory> getForgeHistory() const;
@@ -69,6 +96,39 @@ public:
     void loadFromFile(const QString& filename);
     QJsonObject toJson() const;
     void fromJson(const QJsonObject& json);
+    void readBinary(BinaryReader& in);
+
+    // 存档快照：Qt容器隐式共享，复制只增加引用计数，可以交给后台线程序列化
+    struct SaveSnapshot
+    {
+        int totalForgeCount;
+        int successfulForgeCount;
+        QMap<WorkType, WorkSystemLevel> workSystemLevels;
+        QVector<ForgeHistory> forgeHistory;
+    };
+    SaveSnapshot saveSnapshot() const;
+    static void writeBinary(const SaveSnapshot& snapshot, BinaryWriter& out);
+    void writeBinary(BinaryWriter& out) const
+    {
+        writeBinary(saveSnapshot(), out);
+    }
+
+    // 存档日志：设置后每次锻造和工作系统升级追加一条记录；启动时用 applyJournalRecord 重放
+    void setJournal(SaveJournal* journal) noexcept
+    {
+        m_journal = journal;
+    }
+    void applyJournalRecord(SaveJournal::RecordType type, BinaryReader& in);
+
+    // 自上次存档以来锻造数据是否被修改
+    bool isDirty() const noexcept
+    {
+        return m_dirty;
+    }
+    void clearDirty() noexcept
+    {
+        m_dirty = false;
+    }
 
     // 属性触发器
     PropertyTrigger& get_trigger() { return m_trigger; }
@@ -87,13 +147,14 @@ private slots:
 
 private:
     // 内部方法
-    void initializeDefaultRecipes();
-    void initializeWorkUpgrades();
+    static QVector<ForgeRecipe> buildDefaultRecipes();
+    static QVector<WorkSystemUpgrade> buildWorkUpgrades();
     bool consumeMaterials(const QVector<ForgeMaterial>& materials);
     void produceItems(const QVector<ForgeOutput>& outputs);
     void updateWorkSystemBenefits(WorkType workType, WorkSystemLevel newLevel);
     bool rollForgeSuccess(float successRate) const;
     void addForgeHistory(const ForgeHistory& history);
+    void journalHistory(const ForgeHistory& history);
     void checkAndUnlockRecipes();
 
 private:
@@ -111,16 +172,21 @@ private:
     // 统计数据
     int m_totalForgeCount;
     int m_successfulForgeCount;
+    bool m_dirty = false; // 有未保存的修改
+    SaveJournal* m_journal = nullptr; // 存档日志（不持有）
+
+    // 锻造随机数引擎（不持有）
+    RandomEngine* m_rng;
     
     // 属性触发器
     PropertyTrigger m_trigger;
     
-    // 常量定义
-    static constexpr int SUNSHINE_WEAK_ID = 6;        // 微光阳光ID
-    static constexpr int SUNSHINE_WARM_ID = 7;        // 温暖阳光ID
-    static constexpr int SUNSHINE_HOT_ID = 8;         // 炽热阳光ID
-    static constexpr int SUNSHINE_BRILLIANT_ID = 9;   // 灿烂阳光ID
-    static constexpr int SUNSHINE_SACRED_ID = 10;     // 神圣阳光ID
+    // 常量定义（来自编译期物品表）
+    static constexpr ItemId SUNSHINE_WEAK_ID = Items::SUNSHINE_WEAK;           // 微光阳光ID
+    static constexpr ItemId SUNSHINE_WARM_ID = Items::SUNSHINE_WARM;           // 温暖阳光ID
+    static constexpr ItemId SUNSHINE_HOT_ID = Items::SUNSHINE_HOT;             // 炽热阳光ID
+    static constexpr ItemId SUNSHINE_BRILLIANT_ID = Items::SUNSHINE_BRILLIANT; // 灿烂阳光ID
+    static constexpr ItemId SUNSHINE_SACRED_ID = Items::SUNSHINE_SACRED;       // 神圣阳光ID
 };
 
 #endif // __FORGE_MODEL_H__
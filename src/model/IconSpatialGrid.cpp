@@ -0,0 +1,71 @@
+#include "IconSpatialGrid.h"
+#include <algorithm>
+
+void IconSpatialGrid::build(const QVector<QRect>& rects, int cellSize)
+{
+    clear();
+    m_cellSize = std::max(1, cellSize);
+    m_centers.resize(rects.size());
+
+    // 先求有效图标中心点的包围盒，网格只覆盖这个范围
+    bool hasValid = false;
+    int minX = 0, minY = 0, maxX = 0, maxY = 0;
+    for (int i = 0; i < rects.size(); ++i) {
+        if (!rects[i].isValid()) {
+            continue;
+        }
+        const QPoint center = rects[i].center();
+        m_centers[i] = center;
+        if (!hasValid) {
+            minX = maxX = center.x();
+            minY = maxY = center.y();
+            hasValid = true;
+        } else {
+            minX = std::min(minX, center.x());
+            maxX = std::max(maxX, center.x());
+            minY = std::min(minY, center.y());
+            maxY = std::max(maxY, center.y());
+        }
+    }
+    if (!hasValid) {
+        return;
+    }
+
+    m_origin = QPoint(minX, minY);
+    m_cols = (maxX - minX) / m_cellSize + 1;
+    m_rows = (maxY - minY) / m_cellSize + 1;
+
+    // 计数排序：先统计每个格子的图标数，再按前缀和放入 m_items
+    std::vector<int> cellOf(rects.size(), -1);
+    m_cellStart.assign(static_cast<size_t>(m_cols) * m_rows + 1, 0);
+    for (int i = 0; i < rects.size(); ++i) {
+        if (!rects[i].isValid()) {
+            continue;
+        }
+        const int col = (m_centers[i].x() - minX) / m_cellSize;
+        const int row = (m_centers[i].y() - minY) / m_cellSize;
+        cellOf[i] = row * m_cols + col;
+        ++m_cellStart[cellOf[i] + 1];
+    }
+    for (size_t c = 1; c < m_cellStart.size(); ++c) {
+        m_cellStart[c] += m_cellStart[c - 1];
+    }
+
+    m_items.resize(m_cellStart.back());
+    std::vector<int> fill(m_cellStart.begin(), m_cellStart.end() - 1);
+    for (int i = 0; i < rects.size(); ++i) {
+        if (cellOf[i] >= 0) {
+            m_items[fill[cellOf[i]]++] = i;
+        }
+    }
+}
+
+void IconSpatialGrid::clear()
+{
+    m_cols = 0;
+    m_rows = 0;
+    m_origin = QPoint();
+    m_centers.clear();
+    m_cellStart.clear();
+    m_items.clear();
+}
@@ -0,0 +1,86 @@
+#ifndef __ICON_SPATIAL_GRID_H__
+#define __ICON_SPATIAL_GRID_H__
+
+#include <QPoint>
+#include <QRect>
+#include <QVector>
+#include <vector>
+
+/**
+ * 桌面图标的均匀网格索引
+ * 按图标中心点分桶，格子边长不小于检测半径时，一次查询最多检查 3x3 个格子，
+ * 耗时只和附近的图标数有关，与图标总数无关
+ * 存储为压缩行格式（每个格子在 m_items 中的起止下标），查询时不分配内存
+ */
+class IconSpatialGrid
+{
+public:
+    // rects[i] 为第 i 个图标的区域，invalid 的区域（不可见图标）不加入索引
+    void build(const QVector<QRect>& rects, int cellSize);
+    void clear();
+
+    int size() const { return m_centers.size(); }
+
+    // 对中心点与 center 距离不超过 radius 的每个图标调用 visit(index)，不保证顺序
+    template <typename Visit>
+    void query(const QPoint& center, int radius, Visit&& visit) const
+    {
+        if (m_items.empty() || radius < 0) {
+            return;
+        }
+
+        // 查询范围（相对网格原点）与网格不相交时直接返回
+        const long long left = static_cast<long long>(center.x()) - radius - m_origin.x();
+        const long long right = static_cast<long long>(center.x()) + radius - m_origin.x();
+        const long long top = static_cast<long long>(center.y()) - radius - m_origin.y();
+        const long long bottom = static_cast<long long>(center.y()) + radius - m_origin.y();
+        if (right < 0 || bottom < 0 ||
+            left >= static_cast<long long>(m_cols) * m_cellSize ||
+            top >= static_cast<long long>(m_rows) * m_cellSize) {
+            return;
+        }
+
+        const int minCol = clampCell(left, m_cols);
+        const int maxCol = clampCell(right, m_cols);
+        const int minRow = clampCell(top, m_rows);
+        const int maxRow = clampCell(bottom, m_rows);
+
+        const long long radiusSquared = static_cast<long long>(radius) * radius;
+        for (int row = minRow; row <= maxRow; ++row) {
+            for (int col = minCol; col <= maxCol; ++col) {
+                const int cell = row * m_cols + col;
+                for (int k = m_cellStart[cell]; k < m_cellStart[cell + 1]; ++k) {
+                    const int index = m_items[k];
+                    const QPoint& iconCenter = m_centers[index];
+                    const long long dx = iconCenter.x() - center.x();
+                    const long long dy = iconCenter.y() - center.y();
+                    if (dx * dx + dy * dy <= radiusSquared) {
+                        visit(index);
+                    }
+                }
+            }
+        }
+    }
+
+private:
+    // 相对原点的坐标所在的格子，限制在 [0, count) 内
+    int clampCell(long long offset, int count) const
+    {
+        if (offset < 0) {
+            return 0;
+        }
+        const long long cell = offset / m_cellSize;
+        return cell >= count ? count - 1 : static_cast<int>(cell);
+    }
+
+private:
+    int m_cellSize = 1;
+    int m_cols = 0;
+    int m_rows = 0;
+    QPoint m_origin;
+    QVector<QPoint> m_centers;    // 每个图标的中心点（按图标下标）
+    std::vector<int> m_cellStart; // 格子 c 的图标在 m_items[m_cellStart[c], m_cellStart[c+1]) 中
+    std::vector<int> m_items;     // 图标下标，按格子排列
+};
+
+#endif // __ICON_SPATIAL_GRID_H__
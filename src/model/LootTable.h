@@ -0,0 +1,167 @@
+#ifndef __LOOT_TABLE_H__
+#define __LOOT_TABLE_H__
+
+#include "../common/AliasTable.h"
+#include "../common/RandomEngine.h"
+#include <algorithm>
+#include <vector>
+
+// 掉落表配置条目（对应 loot_tables.csv 的一行）
+struct LootEntry
+{
+    int tier = 0;        // 品质档位，数值越大品质越高；品质加成按档位整体上移
+    int itemId = 0;      // 物品ID
+    double weight = 0.0; // 基础权重（百分比）
+    int minCount = 1;    // 最少数量
+    int maxCount = 1;    // 最多数量
+};
+
+// 一次掉落结果
+struct LootDrop
+{
+    int itemId = 0;
+    int count = 0;
+};
+
+// 编译后的掉落表：(物品, 数量) 的每种组合都是别名表中的一个结果
+// 因此一次掉落只需一次 O(1) 抽样，与表中物品数量无关
+class LootTable
+{
+public:
+    struct Outcome
+    {
+        int itemId;
+        int count;
+        double probability;
+    };
+
+    // 由基础条目编译：
+    // - qualityBonus 把累计分布向高品质平移（0.2 表示抽样值整体+20个百分点，溢出部分归入最高档位）
+    // - dropRateMultiplier 直接折算进数量，最少1个
+    static LootTable compile(std::vector<LootEntry> entries, double qualityBonus, double dropRateMultiplier)
+    {
+        LootTable table;
+
+        entries.erase(std::remove_if(entries.begin(), entries.end(),
+                                     [](const LootEntry &e) { return e.weight <= 0.0 || e.maxCount < e.minCount; }),
+                      entries.end());
+        if (entries.empty())
+        {
+            return table;
+        }
+
+        std::stable_sort(entries.begin(), entries.end(),
+                         [](const LootEntry &a, const LootEntry &b) { return a.tier < b.tier; });
+
+        double total = 0.0;
+        for (const LootEntry &e : entries)
+        {
+            total += e.weight;
+        }
+
+        const double shift = std::min(std::max(qualityBonus, 0.0), 1.0);
+        const int topTier = entries.back().tier;
+
+        std::vector<double> weights;
+        size_t begin = 0;
+        double cdf = 0.0;
+        while (begin < entries.size())
+        {
+            // 找出同一档位的所有条目
+            size_t end = begin;
+            double tierWeight = 0.0;
+            while (end < entries.size() && entries[end].tier == entries[begin].tier)
+            {
+                tierWeight += entries[end].weight;
+                ++end;
+            }
+
+            // 档位在累计分布上的区间 [low, high)，平移后只保留落在 [shift, 1) 的部分
+            const double low = cdf;
+            const double high = cdf + tierWeight / total;
+            cdf = high;
+            double tierMass = std::max(0.0, high - std::max(low, shift));
+            if (entries[begin].tier == topTier)
+            {
+                tierMass += shift;
+            }
+
+            for (size_t i = begin; i < end; ++i)
+            {
+                const LootEntry &e = entries[i];
+                const int span = e.maxCount - e.minCount + 1;
+                const double p = tierMass * (e.weight / tierWeight) / span;
+                for (int c = e.minCount; c <= e.maxCount; ++c)
+                {
+                    int count = static_cast<int>(c * dropRateMultiplier);
+                    if (count < 1)
+                    {
+                        count = 1;
+                    }
+                    table.m_outcomes.push_back({e.itemId, count, p});
+                    weights.push_back(p);
+                }
+            }
+            begin = end;
+        }
+
+        table.m_alias.build(weights);
+        return table;
+    }
+
+    bool isEmpty() const noexcept
+    {
+        return m_alias.isEmpty();
+    }
+
+    // O(1) 抽取一次掉落
+    LootDrop draw(RandomEngine &rng) const noexcept
+    {
+        if (m_alias.isEmpty())
+        {
+            return LootDrop();
+        }
+        const Outcome &o = m_outcomes[m_alias.sample(rng)];
+        return LootDrop{o.itemId, o.count};
+    }
+
+    // 批量抽样：抽取n次，只累计每个结果的命中次数（hits下标与outcomes()对应）
+    // 离线结算、模拟等大批量场景不需要逐次构造LootDrop
+    void drawCounts(RandomEngine &rng, uint64_t n, std::vector<uint64_t> &hits) const
+    {
+        hits.assign(m_outcomes.size(), 0);
+        if (m_alias.isEmpty())
+        {
+            return;
+        }
+        for (uint64_t i = 0; i < n; ++i)
+        {
+            ++hits[m_alias.sample(rng)];
+        }
+    }
+
+    const std::vector<Outcome> &outcomes() const noexcept
+    {
+        return m_outcomes;
+    }
+
+    // 某个物品的理论掉落概率（不区分数量）
+    double itemProbability(int itemId) const noexcept
+    {
+        double p = 0.0;
+        for (const Outcome &o : m_outcomes)
+        {
+            if (o.itemId == itemId)
+            {
+                p += o.probability;
+            }
+        }
+        return p;
+    }
+
+private:
+    std::vector<Outcome> m_outcomes;
+    AliasTable m_alias;
+};
+
+#endif
@@ -0,0 +1,69 @@
+#include "LootTableLoader.h"
+#include <QFile>
+#include <QTextStream>
+#include <QStringList>
+#include <QDebug>
+
+bool LootTableLoader::loadFromCSV(const QString &csvPath, LootTableRows &rows)
+{
+    QFile file(csvPath);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+    {
+        qWarning() << "无法打开掉落表配置文件:" << csvPath;
+        return false;
+    }
+
+    QTextStream in(&file);
+    bool firstLine = true;
+    int loadedCount = 0;
+
+    while (!in.atEnd())
+    {
+        QString line = in.readLine().trimmed();
+
+        if (line.isEmpty() || line.startsWith('#'))
+        {
+            continue;
+        }
+
+        // 跳过标题行
+        if (firstLine)
+        {
+            firstLine = false;
+            continue;
+        }
+
+        QStringList parts = line.split(',');
+        if (parts.size() < 7)
+        {
+            qWarning() << "无效的掉落表配置行:" << line;
+            continue;
+        }
+
+        bool typeOk, levelOk, tierOk, idOk, weightOk, minOk, maxOk;
+        int workType = parts[0].trimmed().toInt(&typeOk);
+        int level = parts[1].trimmed().toInt(&levelOk);
+
+        LootEntry entry;
+        entry.tier = parts[2].trimmed().toInt(&tierOk);
+        entry.itemId = parts[3].trimmed().toInt(&idOk);
+        entry.weight = parts[4].trimmed().toDouble(&weightOk);
+        entry.minCount = parts[5].trimmed().toInt(&minOk);
+        entry.maxCount = parts[6].trimmed().toInt(&maxOk);
+
+        if (!(typeOk && levelOk && tierOk && idOk && weightOk && minOk && maxOk) ||
+            workType < 0 || workType > static_cast<int>(WorkType::Adventure) || level < 0 || level > static_cast<int>(WorkSystemLevel::Master) ||
+            entry.weight <= 0.0 || entry.minCount < 1 || entry.maxCount < entry.minCount)
+        {
+            qWarning() << "无效的掉落表配置行:" << line;
+            continue;
+        }
+
+        rows[static_cast<WorkType>(workType)][level].push_back(entry);
+        loadedCount++;
+    }
+
+    file.close();
+    qDebug() << "掉落表配置加载完成，共加载" << loadedCount << "条";
+    return loadedCount > 0;
+}
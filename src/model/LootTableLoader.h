@@ -0,0 +1,20 @@
+#ifndef __LOOT_TABLE_LOADER_H__
+#define __LOOT_TABLE_LOADER_H__
+
+#include "LootTable.h"
+#include "../common/Types.h"
+#include <QMap>
+#include <QString>
+#include <vector>
+
+// 掉落表配置：工作类型 -> 等级(0为基础表) -> 条目
+using LootTableRows = QMap<WorkType, QMap<int, std::vector<LootEntry>>>;
+
+// 从CSV读取掉落表配置，格式见 resources/csv/loot_tables.csv
+class LootTableLoader
+{
+public:
+    static bool loadFromCSV(const QString &csvPath, LootTableRows &rows);
+};
+
+#endif
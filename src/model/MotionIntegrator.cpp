@@ -0,0 +1,73 @@
+#include "MotionIntegrator.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+const double ARRIVE_DISTANCE = 0.5; // 像素
+const double ARRIVE_SPEED = 1.0;    // 像素/秒
+
+double length(const QPointF& v)
+{
+    return std::hypot(v.x(), v.y());
+}
+
+} // namespace
+
+void MotionIntegrator::setLimits(double maxSpeed, double acceleration)
+{
+    m_maxSpeed = std::max(0.0, maxSpeed);
+    m_acceleration = std::max(1.0, acceleration);
+}
+
+void MotionIntegrator::reset(const QPointF& position)
+{
+    m_position = position;
+    m_target = position;
+    m_velocity = QPointF();
+}
+
+QPointF MotionIntegrator::step(double dt)
+{
+    dt = std::min(std::max(dt, 0.0), MAX_STEP);
+    if (dt <= 0.0) {
+        return m_position;
+    }
+
+    const QPointF toTarget = m_target - m_position;
+    const double distance = length(toTarget);
+
+    // 期望速度：朝向目标，大小不超过最大速度，也不超过在剩余距离内能刹住的速度
+    QPointF desired;
+    if (distance > ARRIVE_DISTANCE) {
+        const double desiredSpeed = std::min(m_maxSpeed, std::sqrt(2.0 * m_acceleration * distance));
+        desired = toTarget * (desiredSpeed / distance);
+    }
+
+    // 转向：速度向期望速度靠拢，每帧的变化量受加速度限制
+    QPointF steer = desired - m_velocity;
+    const double steerLength = length(steer);
+    const double maxDelta = m_acceleration * dt;
+    if (steerLength > maxDelta) {
+        steer *= maxDelta / steerLength;
+    }
+    const QPointF previousVelocity = m_velocity;
+    m_velocity += steer;
+
+    // 按这一步的平均速度推进（匀加速时是精确解），轨迹不随帧率变化
+    // 这一步朝着目标走并且会越过它时直接停在目标上；背离目标的一步（目标刚换到身后）照常推进，由转向慢慢掉头
+    const QPointF move = (previousVelocity + m_velocity) * (0.5 * dt);
+    const bool towardsTarget = QPointF::dotProduct(move, toTarget) > 0.0;
+    if (distance <= ARRIVE_DISTANCE || (towardsTarget && length(move) >= distance)) {
+        m_position = m_target;
+        m_velocity = QPointF();
+    } else {
+        m_position += move;
+    }
+    return m_position;
+}
+
+bool MotionIntegrator::hasArrived() const
+{
+    return length(m_target - m_position) <= ARRIVE_DISTANCE && length(m_velocity) <= ARRIVE_SPEED;
+}
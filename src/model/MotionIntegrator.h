@@ -0,0 +1,41 @@
+#ifndef __MOTION_INTEGRATOR_H__
+#define __MOTION_INTEGRATOR_H__
+
+#include <QPointF>
+
+/**
+ * 基于时间的运动积分器
+ * 位置和速度用浮点数保存，每帧按实际经过的时间推进，移动速度与帧率和定时器抖动无关
+ * 朝目标转向时速度变化受加速度限制（起步缓入），接近目标时按 v = sqrt(2·a·d) 减速（到达缓出），不会越过目标
+ */
+class MotionIntegrator
+{
+public:
+    // 单步最大时长（秒）：卡顿或系统休眠后不会一步跳出很远
+    static constexpr double MAX_STEP = 0.1;
+
+    void setLimits(double maxSpeed, double acceleration);
+
+    // 停在 position，速度清零
+    void reset(const QPointF& position);
+    void setTarget(const QPointF& target) { m_target = target; }
+
+    // 前进 dt 秒，返回新位置
+    QPointF step(double dt);
+
+    // 已停在目标上
+    bool hasArrived() const;
+
+    const QPointF& position() const { return m_position; }
+    const QPointF& velocity() const { return m_velocity; }
+    const QPointF& target() const { return m_target; }
+
+private:
+    QPointF m_position;
+    QPointF m_velocity;
+    QPointF m_target;
+    double m_maxSpeed = 200.0;      // 像素/秒
+    double m_acceleration = 800.0;  // 像素/秒²
+};
+
+#endif // __MOTION_INTEGRATOR_H__
@@ -0,0 +1,309 @@
+#include "NavGrid.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <functional>
+
+namespace {
+
+const float SQRT2 = 1.41421356f;
+const float TIE_BREAK = 1.001f;
+
+// 8 个方向：先上下左右，再对角
+const int DX[8] = {1, -1, 0, 0, 1, 1, -1, -1};
+const int DY[8] = {0, 0, 1, -1, 1, -1, 1, -1};
+
+} // namespace
+
+void NavGrid::reset(const QRect& bounds, int cellSize)
+{
+    m_bounds = bounds;
+    m_cellSize = std::max(1, cellSize);
+    m_cols = bounds.isValid() ? (bounds.width() + m_cellSize - 1) / m_cellSize : 0;
+    m_rows = bounds.isValid() ? (bounds.height() + m_cellSize - 1) / m_cellSize : 0;
+
+    const size_t cells = static_cast<size_t>(m_cols) * m_rows;
+    m_coverCount.assign(cells, 0);
+    m_cost.assign(cells, 0.0f);
+    m_parent.assign(cells, -1);
+    m_openedAt.assign(cells, 0);
+    m_closedAt.assign(cells, 0);
+    m_escapeAt.assign(cells, 0);
+    m_generation = 0;
+    m_obstacles.clear();
+    ++m_revision;
+}
+
+void NavGrid::setObstacles(const QVector<QRect>& rects)
+{
+    if (rects.size() == m_obstacles.size()) {
+        for (int i = 0; i < rects.size(); ++i) {
+            if (rects[i] != m_obstacles[i]) {
+                applyRect(m_obstacles[i], -1);
+                applyRect(rects[i], +1);
+            }
+        }
+    } else {
+        for (const QRect& rect : m_obstacles) {
+            applyRect(rect, -1);
+        }
+        for (const QRect& rect : rects) {
+            applyRect(rect, +1);
+        }
+    }
+    m_obstacles = rects;
+}
+
+void NavGrid::applyRect(const QRect& rect, int delta)
+{
+    const QRect clipped = rect.intersected(m_bounds);
+    if (clipped.isEmpty()) {
+        return;
+    }
+
+    const int col0 = (clipped.left() - m_bounds.left()) / m_cellSize;
+    const int col1 = (clipped.right() - m_bounds.left()) / m_cellSize;
+    const int row0 = (clipped.top() - m_bounds.top()) / m_cellSize;
+    const int row1 = (clipped.bottom() - m_bounds.top()) / m_cellSize;
+    bool changed = false;
+    for (int row = row0; row <= row1; ++row) {
+        for (int col = col0; col <= col1; ++col) {
+            uint16_t& count = m_coverCount[row * m_cols + col];
+            const bool wasBlocked = count > 0;
+            count = static_cast<uint16_t>(count + delta);
+            changed = changed || wasBlocked != (count > 0);
+        }
+    }
+    if (changed) {
+        ++m_revision;
+    }
+}
+
+int NavGrid::cellIndex(const QPoint& point) const
+{
+    if (!isValid() || !m_bounds.contains(point)) {
+        return -1;
+    }
+    const int col = (point.x() - m_bounds.left()) / m_cellSize;
+    const int row = (point.y() - m_bounds.top()) / m_cellSize;
+    return row * m_cols + col;
+}
+
+QPoint NavGrid::cellCenter(int index) const
+{
+    const int col = index % m_cols;
+    const int row = index / m_cols;
+    // 边缘的格子可能不完整，中心点限制在范围内
+    const int x = std::min(m_bounds.left() + col * m_cellSize + m_cellSize / 2, m_bounds.right());
+    const int y = std::min(m_bounds.top() + row * m_cellSize + m_cellSize / 2, m_bounds.bottom());
+    return QPoint(x, y);
+}
+
+bool NavGrid::isBlocked(const QPoint& point) const
+{
+    const int index = cellIndex(point);
+    return index >= 0 && m_coverCount[index] > 0;
+}
+
+bool NavGrid::isSegmentClear(const QPoint& from, const QPoint& to) const
+{
+    // 每半个格子取一个采样点
+    const int dx = to.x() - from.x();
+    const int dy = to.y() - from.y();
+    const int steps = std::max(std::abs(dx), std::abs(dy)) * 2 / m_cellSize + 1;
+    for (int i = 0; i <= steps; ++i) {
+        const QPoint sample(from.x() + dx * i / steps, from.y() + dy * i / steps);
+        if (isBlocked(sample)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void NavGrid::updateComponents()
+{
+    if (m_componentRevision == m_revision && m_component.size() == m_coverCount.size()) {
+        return;
+    }
+    m_componentRevision = m_revision;
+    m_component.assign(m_coverCount.size(), -1);
+
+    // 空闲格子按 8 邻接划分连通区域，障碍物格子标记为 -1；m_cells 暂作栈使用
+    int label = 0;
+    for (int seed = 0; seed < static_cast<int>(m_coverCount.size()); ++seed) {
+        if (m_coverCount[seed] > 0 || m_component[seed] >= 0) {
+            continue;
+        }
+        m_component[seed] = label;
+        m_cells.clear();
+        m_cells.push_back(seed);
+        while (!m_cells.empty()) {
+            const int current = m_cells.back();
+            m_cells.pop_back();
+            const int col = current % m_cols;
+            const int row = current / m_cols;
+            for (int dir = 0; dir < 8; ++dir) {
+                const int nextCol = col + DX[dir];
+                const int nextRow = row + DY[dir];
+                if (nextCol < 0 || nextCol >= m_cols || nextRow < 0 || nextRow >= m_rows) {
+                    continue;
+                }
+                const int next = nextRow * m_cols + nextCol;
+                if (m_coverCount[next] == 0 && m_component[next] < 0) {
+                    m_component[next] = label;
+                    m_cells.push_back(next);
+                }
+            }
+        }
+        ++label;
+    }
+}
+
+void NavGrid::markEscapeRegion(int cell)
+{
+    if (m_coverCount[cell] == 0 || m_escapeAt[cell] == m_generation) {
+        return;
+    }
+
+    // 8 邻接泛洪，m_cells 暂作栈使用
+    m_cells.clear();
+    m_cells.push_back(cell);
+    m_escapeAt[cell] = m_generation;
+    while (!m_cells.empty()) {
+        const int current = m_cells.back();
+        m_cells.pop_back();
+        const int col = current % m_cols;
+        const int row = current / m_cols;
+        for (int dir = 0; dir < 8; ++dir) {
+            const int nextCol = col + DX[dir];
+            const int nextRow = row + DY[dir];
+            if (nextCol < 0 || nextCol >= m_cols || nextRow < 0 || nextRow >= m_rows) {
+                continue;
+            }
+            const int next = nextRow * m_cols + nextCol;
+            if (m_coverCount[next] > 0 && m_escapeAt[next] != m_generation) {
+                m_escapeAt[next] = m_generation;
+                m_cells.push_back(next);
+            }
+        }
+    }
+}
+
+bool NavGrid::findPath(const QPoint& start, const QPoint& goal, QVector<QPoint>& path)
+{
+    path.clear();
+    const int startCell = cellIndex(start);
+    const int goalCell = cellIndex(goal);
+    if (startCell < 0 || goalCell < 0) {
+        return false;
+    }
+    if (startCell == goalCell) {
+        path.append(goal);
+        return true;
+    }
+
+    // 两端都在空闲格子上且不连通时，不用搜索整片区域就能判定不可达
+    updateComponents();
+    if (m_component[startCell] >= 0 && m_component[goalCell] >= 0 && m_component[startCell] != m_component[goalCell]) {
+        return false;
+    }
+
+    // 代数回绕时清空标记
+    if (++m_generation == 0) {
+        std::fill(m_openedAt.begin(), m_openedAt.end(), 0);
+        std::fill(m_closedAt.begin(), m_closedAt.end(), 0);
+        std::fill(m_escapeAt.begin(), m_escapeAt.end(), 0);
+        m_generation = 1;
+    }
+    markEscapeRegion(startCell);
+    markEscapeRegion(goalCell);
+
+    const int goalCol = goalCell % m_cols;
+    const int goalRow = goalCell / m_cols;
+    // 八方向距离（以格子为单位），每步代价至少为1，估价不会偏高
+    auto heuristic = [&](int col, int row) {
+        const int hx = std::abs(col - goalCol);
+        const int hy = std::abs(row - goalRow);
+        const float octile = static_cast<float>(hx + hy) + (SQRT2 - 2.0f) * static_cast<float>(std::min(hx, hy));
+        // 略微放大估价，f 相同时优先扩展离终点更近的格子，开阔区域不会成片展开
+        return octile * TIE_BREAK;
+    };
+
+    m_open.clear();
+    m_cost[startCell] = 0.0f;
+    m_parent[startCell] = -1;
+    m_openedAt[startCell] = m_generation;
+    m_open.emplace_back(heuristic(startCell % m_cols, startCell / m_cols), startCell);
+
+    const auto byPriority = std::greater<std::pair<float, int>>();
+    while (!m_open.empty()) {
+        std::pop_heap(m_open.begin(), m_open.end(), byPriority);
+        const int current = m_open.back().second;
+        m_open.pop_back();
+        if (m_closedAt[current] == m_generation) {
+            continue;
+        }
+        m_closedAt[current] = m_generation;
+        if (current == goalCell) {
+            break;
+        }
+
+        const int col = current % m_cols;
+        const int row = current / m_cols;
+        for (int dir = 0; dir < 8; ++dir) {
+            const int nextCol = col + DX[dir];
+            const int nextRow = row + DY[dir];
+            if (nextCol < 0 || nextCol >= m_cols || nextRow < 0 || nextRow >= m_rows) {
+                continue;
+            }
+            const int next = nextRow * m_cols + nextCol;
+            if (m_closedAt[next] == m_generation) {
+                continue;
+            }
+
+            if (m_coverCount[next] > 0 && m_escapeAt[next] != m_generation) {
+                continue;
+            }
+
+            const float cost = m_cost[current] + (dir < 4 ? 1.0f : SQRT2);
+            if (m_openedAt[next] != m_generation || cost < m_cost[next]) {
+                m_openedAt[next] = m_generation;
+                m_cost[next] = cost;
+                m_parent[next] = current;
+                m_open.emplace_back(cost + heuristic(nextCol, nextRow), next);
+                std::push_heap(m_open.begin(), m_open.end(), byPriority);
+            }
+        }
+    }
+    if (m_closedAt[goalCell] != m_generation) {
+        return false;
+    }
+
+    // 回溯得到起点到终点经过的格子，只保留方向改变的拐点和终点
+    m_cells.clear();
+    int lastStep = 0;
+    for (int cell = goalCell; cell != startCell; cell = m_parent[cell]) {
+        const int step = cell - m_parent[cell];
+        if (m_cells.empty() || step != lastStep) {
+            m_cells.push_back(cell);
+        }
+        lastStep = step;
+    }
+    std::reverse(m_cells.begin(), m_cells.end());
+
+    // 拉直：从当前锚点出发，沿拐点尽量往前找能直线到达的点
+    QPoint anchor = start;
+    const int count = static_cast<int>(m_cells.size());
+    auto waypoint = [&](int k) { return k == count - 1 ? goal : cellCenter(m_cells[k]); };
+    int k = 0;
+    while (k < count) {
+        int reach = k;
+        while (reach + 1 < count && isSegmentClear(anchor, waypoint(reach + 1))) {
+            ++reach;
+        }
+        anchor = waypoint(reach);
+        path.append(anchor);
+        k = reach + 1;
+    }
+    return true;
+}
@@ -0,0 +1,75 @@
+#ifndef __NAV_GRID_H__
+#define __NAV_GRID_H__
+
+#include <QPoint>
+#include <QRect>
+#include <QVector>
+#include <QtGlobal>
+#include <cstdint>
+#include <vector>
+
+/**
+ * 自动移动的导航网格
+ * 把屏幕区域划分成粗粒度的格子，记录每个格子被多少个障碍物覆盖，在格子上做 8 方向 A* 寻路
+ * 障碍物覆盖的格子不可通行；起点或终点落在障碍物里时（例如宠物停在窗口上、目标是图标），
+ * 与它相连的那片障碍物格子在本次寻路中视为可通行
+ * 寻路用的临时数组在多次调用之间复用，按代数标记访问状态，不需要每次清空
+ */
+class NavGrid
+{
+public:
+    static const int DEFAULT_CELL_SIZE = 64;
+
+    // 设置覆盖范围和格子大小，清空所有障碍物
+    void reset(const QRect& bounds, int cellSize = DEFAULT_CELL_SIZE);
+
+    // 用新的障碍物列表更新占用情况：与上一次列表逐项比较，只改写变化的障碍物覆盖的格子
+    void setObstacles(const QVector<QRect>& rects);
+
+    // 任意格子的通行状态变化时递增，用于判断缓存的路径是否需要检查
+    quint64 revision() const { return m_revision; }
+
+    bool isValid() const { return m_cols > 0 && m_rows > 0; }
+    bool isBlocked(const QPoint& point) const;
+    int cellSize() const { return m_cellSize; }
+    const QRect& bounds() const { return m_bounds; }
+
+    // 线段经过的格子都没有障碍物
+    bool isSegmentClear(const QPoint& from, const QPoint& to) const;
+
+    // 从 start 到 goal 寻路，path 为依次经过的路点（不含起点，最后一个是 goal 本身）
+    // 拐点之间能直线通过时会合并，路点数量通常只有几个；start/goal 超出范围或被障碍物隔开时返回 false
+    bool findPath(const QPoint& start, const QPoint& goal, QVector<QPoint>& path);
+
+private:
+    int cellIndex(const QPoint& point) const;
+    QPoint cellCenter(int index) const;
+    void applyRect(const QRect& rect, int delta);
+    void markEscapeRegion(int cell);
+    void updateComponents();
+
+private:
+    QRect m_bounds;
+    int m_cellSize = DEFAULT_CELL_SIZE;
+    int m_cols = 0;
+    int m_rows = 0;
+    std::vector<uint16_t> m_coverCount; // 每个格子被几个障碍物覆盖
+    QVector<QRect> m_obstacles;         // 上一次设置的障碍物，用于增量比较
+    quint64 m_revision = 0;
+
+    // A* 临时数据
+    std::vector<float> m_cost;
+    std::vector<int> m_parent;
+    std::vector<uint32_t> m_openedAt;   // 格子在第几代搜索中被访问过
+    std::vector<uint32_t> m_closedAt;
+    std::vector<uint32_t> m_escapeAt;   // 本次寻路中可以穿过的障碍物格子
+    uint32_t m_generation = 0;
+    std::vector<std::pair<float, int>> m_open;
+    std::vector<int> m_cells;
+
+    // 空闲格子的连通区域编号，网格版本变化后第一次寻路时重新计算
+    std::vector<int> m_component;
+    quint64 m_componentRevision = 0;
+};
+
+#endif // __NAV_GRID_H__
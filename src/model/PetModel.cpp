@@ -41,6 +41,7 @@ PetModel::PetModel() noexcept
 
     // 设置默认当前宠物为Spider
     m_current_info = m_pet_data[PetType::Spider];
+    publish();
 }
 
 void PetModel::OnEvent(TestEvent event)
@@ -49,6 +50,7 @@ void PetModel::OnEvent(TestEvent event)
     std::cout << "[TestEvent]:TestInt为" << event.TestInt << "，TestString为" << event.TestString << std::endl;
     m_current_info.money = event.TestInt;
     m_current_info.name.append(event.TestString);
+    publish();
 }
 
 void PetModel::OnEvent(AddExperienceEvent event)
@@ -84,20 +86,54 @@ void PetModel::change_position(const QPoint &position) noexcept
     if (abs(diff.x()) > 2 || abs(diff.y()) > 2)
     {
         m_current_info.position = position;
+        m_position_streaming = false;
+        publish();
 
-        // 同步更新当前宠物类型的数据
-        m_pet_data[m_current_info.petType].position = position;
-
+        m_dirty = true;
         m_trigger.fire(PROP_ID_PET_POSITION);
     }
 }
 
+void PetModel::stream_position(const QPoint &position) noexcept
+{
+    if (m_current_info.position == position)
+    {
+        return;
+    }
+    m_current_info.position = position;
+    m_position_channel.publish(position);
+    m_position_streaming = true;
+    m_dirty = true;
+}
+
+void PetModel::commit_position() noexcept
+{
+    if (!m_position_streaming)
+    {
+        return;
+    }
+    m_position_streaming = false;
+    publish();
+    m_trigger.fire(PROP_ID_PET_POSITION);
+}
+
+void PetModel::set_moving(bool moving) noexcept
+{
+    if (m_position_channel.isMoving() == moving)
+    {
+        return;
+    }
+    m_position_channel.setMoving(moving);
+    m_trigger.fire(PROP_ID_PET_MOVING);
+}
+
 void PetModel::change_state(PetState state) noexcept
 {
     if (m_current_info.state != state)
     {
         m_current_info.state = state;
-        m_pet_data[m_current_info.petType].state = state;
+        publish();
+        m_dirty = true;
         m_trigger.fire(PROP_ID_PET_STATE);
     }
 }
@@ -107,7 +143,8 @@ void PetModel::change_animation(const QString &animation) noexcept
     if (m_current_info.currentAnimation != animation)
     {
         m_current_info.currentAnimation = animation;
-        m_pet_data[m_current_info.petType].currentAnimation = animation;
+        publish();
+        m_dirty = true;
         m_trigger.fire(PROP_ID_PET_ANIMATION);
     }
 }
@@ -117,7 +154,8 @@ void PetModel::change_visibility(bool visible) noexcept
     if (m_current_info.isVisible != visible)
     {
         m_current_info.isVisible = visible;
-        m_pet_data[m_current_info.petType].isVisible = visible;
+        publish();
+        m_dirty = true;
         m_trigger.fire(PROP_ID_PET_VISIBLE);
     }
 }
@@ -127,7 +165,8 @@ void PetModel::change_size(const QSize &size) noexcept
     if (m_current_info.size != size)
     {
         m_current_info.size = size;
-        m_pet_data[m_current_info.petType].size = size;
+        publish();
+        m_dirty = true;
         m_trigger.fire(PROP_ID_PET_SIZE);
     }
 }
@@ -145,8 +184,16 @@ void PetModel::change_pet_type(PetType type) noexcept
         // 保存当前宠物的数据
         save_current_pet_data();
 
-        // 切换到新的宠物类型
+        // 切换到新的宠物类型；位置、大小等是所有宠物共享的全局设置（存档中也只保存一份），切换后保持不变
+        const QPoint position = m_current_info.position;
+        const QSize size = m_current_info.size;
+        const int speed = m_current_info.speed;
+        const bool isVisible = m_current_info.isVisible;
         load_pet_data_for_type(type);
+        m_current_info.position = position;
+        m_current_info.size = size;
+        m_current_info.speed = speed;
+        m_current_info.isVisible = isVisible;
 
         qDebug() << "切换宠物类型后:" << static_cast<int>(m_current_info.petType)
                  << "名称:" << m_current_info.name
@@ -155,14 +202,15 @@ void PetModel::change_pet_type(PetType type) noexcept
                  << "金钱:" << m_current_info.money;
 
         // 触发所有相关属性的更新通知
+        publish();
+        m_dirty = true;
         m_trigger.fire(PROP_ID_PET_TYPE);
         m_trigger.fire(PROP_ID_PET_LEVEL);
         m_trigger.fire(PROP_ID_PET_EXPERIENCE);
         m_trigger.fire(PROP_ID_PET_MONEY);
         m_trigger.fire(PROP_ID_PET_ANIMATION);
 
-        // 自动保存数据
-        save_to_file("pet_data.json");
+        journal_progress();
     }
     else
     {
@@ -177,11 +225,19 @@ void PetModel::add_experience(int exp) noexcept
         return;
 
     m_current_info.experience += exp;
-    m_pet_data[m_current_info.petType].experience = m_current_info.experience;
-    m_trigger.fire(PROP_ID_PET_EXPERIENCE);
 
-    // 检查是否升级
+    // 检查是否升级，升级后的数据和经验一起发布
+    const int oldLevel = m_current_info.level;
     check_level_up();
+    publish();
+
+    m_dirty = true;
+    m_trigger.fire(PROP_ID_PET_EXPERIENCE);
+    if (m_current_info.level != oldLevel)
+    {
+        m_trigger.fire(PROP_ID_PET_LEVEL);
+    }
+    journal_progress();
 }
 
 void PetModel::set_level(int level) noexcept
@@ -192,12 +248,11 @@ void PetModel::set_level(int level) noexcept
     {
         m_current_info.level = level;
         m_current_info.experienceToNextLevel = calculate_experience_needed(level);
+        publish();
 
-        // 同步到对应宠物类型数据
-        m_pet_data[m_current_info.petType].level = level;
-        m_pet_data[m_current_info.petType].experienceToNextLevel = m_current_info.experienceToNextLevel;
-
+        m_dirty = true;
         m_trigger.fire(PROP_ID_PET_LEVEL);
+        journal_progress();
     }
 }
 
@@ -207,8 +262,10 @@ void PetModel::add_money(int amount) noexcept
         return;
 
     m_current_info.money += amount;
-    m_pet_data[m_current_info.petType].money = m_current_info.money;
+    publish();
+    m_dirty = true;
     m_trigger.fire(PROP_ID_PET_MONEY);
+    journal_progress();
 }
 
 void PetModel::spend_money(int amount) noexcept
@@ -219,8 +276,10 @@ void PetModel::spend_money(int amount) noexcept
     if (m_current_info.money >= amount)
     {
         m_current_info.money -= amount;
-        m_pet_data[m_current_info.petType].money = m_current_info.money;
+        publish();
+        m_dirty = true;
         m_trigger.fire(PROP_ID_PET_MONEY);
+        journal_progress();
     }
 }
 
@@ -238,18 +297,11 @@ void PetModel::check_level_up() noexcept
         m_current_info.experience -= m_current_info.experienceToNextLevel;
         m_current_info.level++;
         m_current_info.experienceToNextLevel = calculate_experience_needed(m_current_info.level);
-
-        // 同步到对应宠物类型数据
-        m_pet_data[m_current_info.petType].experience = m_current_info.experience;
-        m_pet_data[m_current_info.petType].level = m_current_info.level;
-        m_pet_data[m_current_info.petType].experienceToNextLevel = m_current_info.experienceToNextLevel;
-
-        m_trigger.fire(PROP_ID_PET_LEVEL);
     }
 }
 
 // 持久化方法实现
-void PetModel::save_to_file(const QString &filename) const
+QJsonObject PetModel::to_json() const
 {
     QJsonObject rootJson;
 
@@ -257,8 +309,9 @@ void PetModel::save_to_file(const QString &filename) const
     rootJson["currentPetType"] = static_cast<int>(m_current_info.petType);
 
     // 保存所有宠物数据
+    const QMap<PetType, PetInfo> pets = all_pet_data();
     QJsonObject petsJson;
-    for (auto it = m_pet_data.constBegin(); it != m_pet_data.constEnd(); ++it)
+    for (auto it = pets.constBegin(); it != pets.constEnd(); ++it)
     {
         PetType type = it.key();
         const PetInfo &info = it.value();
@@ -286,7 +339,12 @@ void PetModel::save_to_file(const QString &filename) const
     globalJson["isVisible"] = m_current_info.isVisible;
     rootJson["globalSettings"] = globalJson;
 
-    QJsonDocument doc(rootJson);
+    return rootJson;
+}
+
+void PetModel::save_to_file(const QString &filename) const
+{
+    QJsonDocument doc(to_json());
 
     // 获取应用数据存储路径
     QString appDataPath = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
@@ -328,7 +386,13 @@ void PetModel::load_from_file(const QString &filename)
         return; // JSON格式错误，使用默认值
     }
 
-    QJsonObject rootJson = doc.object();
+    from_json(doc.object());
+}
+
+void PetModel::from_json(const QJsonObject &rootJson)
+{
+    // 当前宠物的数据先写回，作为加载的基础
+    m_pet_data[m_current_info.petType] = m_current_info;
 
     // 检查是否为新格式（包含pets字段）
     if (rootJson.contains("pets"))
@@ -477,6 +541,243 @@ void PetModel::load_from_file(const QString &filename)
         // 更新对应宠物类型的数据
         m_pet_data[m_current_info.petType] = m_current_info;
     }
+    publish();
+}
+
+// 二进制存档字段：
+//   1 当前宠物类型  2 宠物（重复，嵌套）  3 全局设置（嵌套）
+// 宠物：1 类型 2 名称 3 等级 4 经验 5 升级所需经验 6 金钱 7 当前动画 8 状态
+// 全局设置：1 x 2 y 3 宽 4 高 5 速度 6 是否可见
+PetModel::SaveSnapshot PetModel::save_snapshot() const
+{
+    // 不用已发布的快照：快速通道更新的位置可能还没有发布
+    return SaveSnapshot{m_current_info, all_pet_data()};
+}
+
+void PetModel::write_binary(const SaveSnapshot &snapshot, BinaryWriter &out)
+{
+    out.writeUInt(1, static_cast<uint64_t>(snapshot.current.petType));
+
+    for (auto it = snapshot.pets.constBegin(); it != snapshot.pets.constEnd(); ++it)
+    {
+        const PetInfo &info = it.value();
+        out.beginMessage(2);
+        out.writeUInt(1, static_cast<uint64_t>(it.key()));
+        out.writeString(2, info.name.toStdString());
+        out.writeInt(3, info.level);
+        out.writeInt(4, info.experience);
+        out.writeInt(5, info.experienceToNextLevel);
+        out.writeInt(6, info.money);
+        out.writeString(7, info.currentAnimation.toStdString());
+        out.writeUInt(8, static_cast<uint64_t>(info.state));
+        out.endMessage();
+    }
+
+    out.beginMessage(3);
+    out.writeInt(1, snapshot.current.position.x());
+    out.writeInt(2, snapshot.current.position.y());
+    out.writeInt(3, snapshot.current.size.width());
+    out.writeInt(4, snapshot.current.size.height());
+    out.writeInt(5, snapshot.current.speed);
+    out.writeBool(6, snapshot.current.isVisible);
+    out.endMessage();
+}
+
+void PetModel::read_binary(BinaryReader &in)
+{
+    m_pet_data[m_current_info.petType] = m_current_info;
+
+    PetType currentType = PetType::Spider;
+    bool hasGlobal = false;
+    QPoint position(100, 100);
+    QSize size(200, 200);
+    int speed = 50;
+    bool isVisible = true;
+
+    while (in.next())
+    {
+        switch (in.field())
+        {
+        case 1:
+            currentType = static_cast<PetType>(in.readUInt());
+            break;
+        case 2:
+        {
+            BinaryReader petIn = in.readMessage();
+            PetInfo info;
+            bool known = false;
+            while (petIn.next())
+            {
+                switch (petIn.field())
+                {
+                case 1:
+                {
+                    // 类型字段总是最先写入，以现有数据为基础覆盖
+                    const PetType type = static_cast<PetType>(petIn.readUInt());
+                    known = m_pet_data.contains(type);
+                    if (known)
+                    {
+                        info = m_pet_data[type];
+                    }
+                    break;
+                }
+                case 2:
+                    info.name = QString::fromStdString(petIn.readString());
+                    break;
+                case 3:
+                    info.level = static_cast<int>(petIn.readInt());
+                    break;
+                case 4:
+                    info.experience = static_cast<int>(petIn.readInt());
+                    break;
+                case 5:
+                    info.experienceToNextLevel = static_cast<int>(petIn.readInt());
+                    break;
+                case 6:
+                    info.money = static_cast<int>(petIn.readInt());
+                    break;
+                case 7:
+                    info.currentAnimation = QString::fromStdString(petIn.readString());
+                    break;
+                case 8:
+                    info.state = static_cast<PetState>(petIn.readUInt());
+                    break;
+                default:
+                    break;
+                }
+            }
+            if (known && petIn.isValid())
+            {
+                m_pet_data[info.petType] = info;
+            }
+            break;
+        }
+        case 3:
+        {
+            BinaryReader globalIn = in.readMessage();
+            hasGlobal = true;
+            while (globalIn.next())
+            {
+                switch (globalIn.field())
+                {
+                case 1:
+                    position.setX(static_cast<int>(globalIn.readInt()));
+                    break;
+                case 2:
+                    position.setY(static_cast<int>(globalIn.readInt()));
+                    break;
+                case 3:
+                    size.setWidth(static_cast<int>(globalIn.readInt()));
+                    break;
+                case 4:
+                    size.setHeight(static_cast<int>(globalIn.readInt()));
+                    break;
+                case 5:
+                    speed = static_cast<int>(globalIn.readInt());
+                    break;
+                case 6:
+                    isVisible = globalIn.readBool();
+                    break;
+                default:
+                    break;
+                }
+            }
+            break;
+        }
+        default:
+            break;
+        }
+    }
+
+    // 应用全局设置到所有宠物
+    if (hasGlobal)
+    {
+        for (auto &info : m_pet_data)
+        {
+            info.position = position;
+            info.size = size;
+            info.speed = speed;
+            info.isVisible = isVisible;
+        }
+    }
+
+    if (m_pet_data.contains(currentType))
+    {
+        m_current_info = m_pet_data[currentType];
+    }
+    publish();
+}
+
+// 日志记录：1 当前宠物类型 2 等级 3 经验 4 升级所需经验 5 金钱
+void PetModel::journal_progress()
+{
+    if (!m_journal)
+    {
+        return;
+    }
+    BinaryWriter record;
+    record.writeUInt(1, static_cast<uint64_t>(m_current_info.petType));
+    record.writeInt(2, m_current_info.level);
+    record.writeInt(3, m_current_info.experience);
+    record.writeInt(4, m_current_info.experienceToNextLevel);
+    record.writeInt(5, m_current_info.money);
+    m_journal->append(SaveJournal::PetProgress, record);
+}
+
+void PetModel::apply_journal_record(SaveJournal::RecordType type, BinaryReader &in)
+{
+    if (type != SaveJournal::PetProgress)
+    {
+        return;
+    }
+
+    PetType petType = m_current_info.petType;
+    PetInfo progress = m_current_info;
+    while (in.next())
+    {
+        switch (in.field())
+        {
+        case 1:
+            petType = static_cast<PetType>(in.readUInt());
+            break;
+        case 2:
+            progress.level = static_cast<int>(in.readInt());
+            break;
+        case 3:
+            progress.experience = static_cast<int>(in.readInt());
+            break;
+        case 4:
+            progress.experienceToNextLevel = static_cast<int>(in.readInt());
+            break;
+        case 5:
+            progress.money = static_cast<int>(in.readInt());
+            break;
+        default:
+            break;
+        }
+    }
+    if (!in.isValid())
+    {
+        return;
+    }
+
+    // 记录时的宠物就是当前宠物，必要时先切换过去
+    if (m_current_info.petType != petType)
+    {
+        save_current_pet_data();
+        load_pet_data_for_type(petType);
+    }
+    m_current_info.level = progress.level;
+    m_current_info.experience = progress.experience;
+    m_current_info.experienceToNextLevel = progress.experienceToNextLevel;
+    m_current_info.money = progress.money;
+    publish();
+
+    m_dirty = true;
+    m_trigger.fire(PROP_ID_PET_TYPE);
+    m_trigger.fire(PROP_ID_PET_LEVEL);
+    m_trigger.fire(PROP_ID_PET_EXPERIENCE);
+    m_trigger.fire(PROP_ID_PET_MONEY);
 }
 
 void PetModel::save_current_pet_data() noexcept
@@ -490,6 +791,26 @@ void PetModel::save_current_pet_data() noexcept
     m_pet_data[m_current_info.petType] = m_current_info;
 }
 
+QMap<PetType, PetInfo> PetModel::all_pet_data() const
+{
+    QMap<PetType, PetInfo> pets = m_pet_data;
+    pets[m_current_info.petType] = m_current_info;
+    return pets;
+}
+
+void PetModel::publish() noexcept
+{
+    auto info = std::make_shared<PetInfo>(m_current_info);
+    info->version = ++m_version;
+    std::atomic_store_explicit(&m_snapshot, PetInfoSnapshot(std::move(info)), std::memory_order_release);
+
+    // 加载存档、切换宠物等也可能改变位置，位置通道始终跟随当前位置
+    if (m_position_channel.load() != m_current_info.position)
+    {
+        m_position_channel.publish(m_current_info.position);
+    }
+}
+
 void PetModel::load_pet_data_for_type(PetType type) noexcept
 {
     // 从对应类型的数据中加载到当前宠物信息
@@ -2,10 +2,16 @@
 #define __PET_MODEL_H__
 
 #include "../common/PropertyTrigger.h"
+#include "../common/BinaryCodec.h"
+#include "../common/SaveJournal.h"
+#include "../common/PositionChannel.h"
 #include "../common/base/PetInfo.h"
 #include <iostream>
 #include <string>
 #include <QMap>
+#include <QJsonObject>
+#include <atomic>
+#include <memory>
 #include "../common/EventMgr.h"
 #include "../common/EventDefine.h"
 
@@ -23,18 +29,38 @@ public:
 
     PetModel &operator=(const PetModel &) = delete;
 
+    // 当前宠物的实时数据，只能在修改模型的线程（GUI线程）上使用，绑定到视图的指针在模型生命期内有效
     const PetInfo *get_info() const noexcept
     {
         return &m_current_info;
     }
 
+    // 当前宠物的不可变快照：每次修改后整体替换，读取方拿到的各字段互相一致，可以在任意线程调用
+    PetInfoSnapshot snapshot() const noexcept
+    {
+        return std::atomic_load_explicit(&m_snapshot, std::memory_order_acquire);
+    }
+
     PropertyTrigger &get_trigger() noexcept
     {
         return m_trigger;
     }
 
+    // 高频位置通道：自动移动期间窗口在自己的帧定时器上从这里取样
+    PositionChannel &get_position_channel() noexcept
+    {
+        return m_position_channel;
+    }
+
     // Methods
     void change_position(const QPoint &position) noexcept;
+
+    // 位置快速通道：只更新当前位置并写入位置通道，不发布快照也不触发通知
+    // 连续移动结束后调用 commit_position()，发布快照并补发一次 PROP_ID_PET_POSITION
+    void stream_position(const QPoint &position) noexcept;
+    void commit_position() noexcept;
+    // 标记位置通道是否处于连续移动中，状态变化时触发 PROP_ID_PET_MOVING
+    void set_moving(bool moving) noexcept;
     void change_state(PetState state) noexcept;
     void change_animation(const QString &animation) noexcept;
     void change_visibility(bool visible) noexcept;
@@ -50,6 +76,39 @@ public:
     // 持久化方法
     void save_to_file(const QString &filename) const;
     void load_from_file(const QString &filename);
+    QJsonObject to_json() const;
+    void from_json(const QJsonObject &rootJson);
+    void read_binary(BinaryReader &in);
+
+    // 存档快照：QMap/QString 隐式共享，复制只增加引用计数，可以交给后台线程序列化
+    struct SaveSnapshot
+    {
+        PetInfo current;
+        QMap<PetType, PetInfo> pets;
+    };
+    SaveSnapshot save_snapshot() const;
+    static void write_binary(const SaveSnapshot &snapshot, BinaryWriter &out);
+    void write_binary(BinaryWriter &out) const
+    {
+        write_binary(save_snapshot(), out);
+    }
+
+    // 存档日志：设置后经验、等级、金钱和宠物切换各追加一条记录；启动时用 apply_journal_record 重放
+    void set_journal(SaveJournal *journal) noexcept
+    {
+        m_journal = journal;
+    }
+    void apply_journal_record(SaveJournal::RecordType type, BinaryReader &in);
+
+    // 自上次存档以来数据是否被修改
+    bool is_dirty() const noexcept
+    {
+        return m_dirty;
+    }
+    void clear_dirty() noexcept
+    {
+        m_dirty = false;
+    }
 
 private:
     // 等级计算辅助方法
@@ -58,14 +117,29 @@ private:
     // 保存当前宠物数据到对应的类型数据中
     void save_current_pet_data() noexcept;
 
+    // 每个宠物类型的数据，当前宠物取 m_current_info（m_pet_data 中的那份只在切换宠物时更新）
+    QMap<PetType, PetInfo> all_pet_data() const;
+
+    // 修改 m_current_info 后发布新快照，要在 fire 通知之前调用
+    void publish() noexcept;
+
     // 从对应类型数据中加载到当前宠物数据
     void load_pet_data_for_type(PetType type) noexcept;
     void check_level_up() noexcept;
 
+    // 把当前宠物的成长数据追加到存档日志
+    void journal_progress();
+
 private:
     PetInfo m_current_info;            // 当前显示的宠物信息
-    QMap<PetType, PetInfo> m_pet_data; // 每个宠物类型的独立数据
+    QMap<PetType, PetInfo> m_pet_data; // 每个宠物类型的独立数据（当前宠物的在切换时才写回）
+    PetInfoSnapshot m_snapshot;        // 最近一次发布的快照，通过 std::atomic_load/atomic_store 访问
+    PositionChannel m_position_channel; // 当前位置（包括快速通道的更新）
+    bool m_position_streaming{false};  // 有经快速通道更新、尚未提交的位置
+    quint64 m_version{0};              // 快照版本
     PropertyTrigger m_trigger;
+    bool m_dirty{false};               // 有未保存的修改
+    SaveJournal *m_journal{nullptr};   // 存档日志（不持有）
 };
 
 #endif
\ No newline at end of file
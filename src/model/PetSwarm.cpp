@@ -0,0 +1,408 @@
+#include "PetSwarm.h"
+#include "../common/EventMgr.h"
+#include "../common/EventDefine.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+const float ARRIVE_DISTANCE = 0.5f; // 像素，与 MotionIntegrator 一致
+const int SCREEN_MARGIN = 50;       // 随机目标距离屏幕边缘的安全距离
+const float BOUNCE_DISTANCE = 150.0f; // 相撞后朝相反方向走开的距离
+
+} // namespace
+
+PetSwarm::PetSwarm(uint64_t seed)
+    : m_petSize(200, 200)
+    , m_rng(seed)
+{
+    m_screens.setPetSize(m_petSize);
+}
+
+void PetSwarm::setScreens(const QVector<ScreenInfo>& screens)
+{
+    m_screens.setScreens(screens);
+
+    // 屏幕被移除或缩小后，把不在可活动区域内的宠物拉回来，走动中的重新选择目标（旧目标可能已不在屏幕上）
+    for (int i = 0; i < size(); ++i) {
+        const QPoint current = position(i);
+        const QPoint constrained = m_screens.constrain(current);
+        if (constrained != current) {
+            m_posX[i] = static_cast<float>(constrained.x());
+            m_posY[i] = static_cast<float>(constrained.y());
+            m_velX[i] = 0.0f;
+            m_velY[i] = 0.0f;
+            m_broadPhaseDirty = true;
+        }
+        if (m_state[i] == static_cast<uint8_t>(SwarmPetState::Walking)) {
+            chooseTarget(i);
+        }
+    }
+}
+
+void PetSwarm::setPetSize(const QSize& size)
+{
+    m_petSize = size;
+    m_screens.setPetSize(size);
+}
+
+void PetSwarm::setObstacles(const QVector<QRect>& rects)
+{
+    m_obstacles = rects;
+    std::fill(m_lastIcon.begin(), m_lastIcon.end(), -1);
+    m_broadPhaseDirty = true;
+}
+
+void PetSwarm::setCursor(const QPoint& position)
+{
+    m_cursor = position;
+    const int radius = m_config.cursorRadius;
+    m_cursorRect = QRect(position.x() - radius, position.y() - radius, 2 * radius + 1, 2 * radius + 1);
+}
+
+void PetSwarm::clearCursor()
+{
+    m_cursorRect = QRect();
+}
+
+int PetSwarm::spawn(const QPoint& topLeft)
+{
+    const QPoint position = m_screens.constrain(topLeft);
+    m_posX.push_back(static_cast<float>(position.x()));
+    m_posY.push_back(static_cast<float>(position.y()));
+    m_velX.push_back(0.0f);
+    m_velY.push_back(0.0f);
+    m_targetX.push_back(m_posX.back());
+    m_targetY.push_back(m_posY.back());
+    m_state.push_back(static_cast<uint8_t>(SwarmPetState::Walking));
+    m_stateTime.push_back(0.0f);
+    m_lastIcon.push_back(-1);
+    m_broadPhaseDirty = true;
+
+    const int index = size() - 1;
+    chooseTarget(index);
+    return index;
+}
+
+void PetSwarm::spawnRandom(int count)
+{
+    if (m_screens.isEmpty()) {
+        return;
+    }
+    for (int i = 0; i < count; ++i) {
+        spawn(randomPointOnScreen(m_rng.bounded(m_screens.count())));
+    }
+}
+
+void PetSwarm::clear()
+{
+    m_posX.clear();
+    m_posY.clear();
+    m_velX.clear();
+    m_velY.clear();
+    m_targetX.clear();
+    m_targetY.clear();
+    m_state.clear();
+    m_stateTime.clear();
+    m_lastIcon.clear();
+    m_changed.clear();
+    m_lastPairs.clear();
+    m_broadPhaseDirty = true;
+}
+
+void PetSwarm::step(double dt)
+{
+    m_changed.clear();
+    dt = std::min(std::max(dt, 0.0), MAX_STEP);
+    if (dt <= 0.0) {
+        return;
+    }
+
+    const float seconds = static_cast<float>(dt);
+    updateTimers(seconds);
+    integrate(seconds);
+    detectContacts();
+    sendEvents();
+}
+
+void PetSwarm::updateTimers(float dt)
+{
+    // 停留和交互结束后重新出发
+    const int count = size();
+    for (int i = 0; i < count; ++i) {
+        if (m_state[i] == static_cast<uint8_t>(SwarmPetState::Walking)) {
+            continue;
+        }
+        m_stateTime[i] -= dt;
+        if (m_stateTime[i] <= 0.0f) {
+            setState(i, SwarmPetState::Walking, 0.0f);
+            chooseTarget(i);
+        }
+    }
+}
+
+void PetSwarm::integrate(float dt)
+{
+    const float maxSpeed = m_config.maxSpeed;
+    const float acceleration = std::max(1.0f, m_config.acceleration);
+    const float maxDelta = acceleration * dt;
+
+    // 跟随中的宠物以鼠标为目标（宠物中心对准鼠标）
+    const QPoint followTarget = m_screens.constrain(m_cursor - QPoint(m_petSize.width() / 2, m_petSize.height() / 2));
+
+    const int count = size();
+    for (int i = 0; i < count; ++i) {
+        const bool following = m_state[i] == static_cast<uint8_t>(SwarmPetState::Following);
+        if (m_state[i] != static_cast<uint8_t>(SwarmPetState::Walking) && !following) {
+            continue;
+        }
+        if (following) {
+            m_targetX[i] = static_cast<float>(followTarget.x());
+            m_targetY[i] = static_cast<float>(followTarget.y());
+        }
+
+        const float toX = m_targetX[i] - m_posX[i];
+        const float toY = m_targetY[i] - m_posY[i];
+        const float distance = std::sqrt(toX * toX + toY * toY);
+
+        // 期望速度：朝向目标，不超过最大速度和剩余距离内能刹住的速度
+        float desiredX = 0.0f;
+        float desiredY = 0.0f;
+        if (distance > ARRIVE_DISTANCE) {
+            const float desiredSpeed = std::min(maxSpeed, std::sqrt(2.0f * acceleration * distance));
+            desiredX = toX * (desiredSpeed / distance);
+            desiredY = toY * (desiredSpeed / distance);
+        }
+
+        // 速度变化量受加速度限制，按平均速度推进
+        float steerX = desiredX - m_velX[i];
+        float steerY = desiredY - m_velY[i];
+        const float steerLength = std::sqrt(steerX * steerX + steerY * steerY);
+        if (steerLength > maxDelta) {
+            steerX *= maxDelta / steerLength;
+            steerY *= maxDelta / steerLength;
+        }
+        const float moveX = (2.0f * m_velX[i] + steerX) * (0.5f * dt);
+        const float moveY = (2.0f * m_velY[i] + steerY) * (0.5f * dt);
+        m_velX[i] += steerX;
+        m_velY[i] += steerY;
+
+        // 只有朝着目标的一步越过目标才算到达，目标刚换到身后时不会瞬移过去
+        const bool towardsTarget = moveX * toX + moveY * toY > 0.0f;
+        if (distance <= ARRIVE_DISTANCE ||
+            (towardsTarget && moveX * moveX + moveY * moveY >= distance * distance)) {
+            // 到达目标：按概率停留一会儿，否则直接前往下一个目标；跟随中的宠物停在鼠标旁等它移动
+            m_posX[i] = m_targetX[i];
+            m_posY[i] = m_targetY[i];
+            m_velX[i] = 0.0f;
+            m_velY[i] = 0.0f;
+            if (following) {
+                continue;
+            }
+            if (static_cast<int>(m_rng.bounded(100)) < m_config.idleProbability) {
+                setState(i, SwarmPetState::Idle, randomSeconds(m_config.idleMinSeconds, m_config.idleMaxSeconds));
+            } else {
+                chooseTarget(i);
+            }
+        } else {
+            m_posX[i] += moveX;
+            m_posY[i] += moveY;
+        }
+    }
+}
+
+void PetSwarm::rebuildBroadPhase()
+{
+    // 新宠物追加在末尾，宠物之间已有的接触编号不变；鼠标和图标排在所有宠物之后，编号随宠物数量后移
+    // 上一帧的接触按新编号改写后保留，已经碰着鼠标的宠物不会被当成新接触重复发送事件
+    const int count = size();
+    const int shift = count - m_broadPhasePets;
+    if (shift != 0) {
+        for (CollisionPair& pair : m_lastPairs) {
+            if (pair.second >= m_broadPhasePets) {
+                pair.second += shift;
+            }
+        }
+        std::sort(m_lastPairs.begin(), m_lastPairs.end());
+    }
+
+    m_broadPhase.clear();
+    for (int i = 0; i < count; ++i) {
+        m_broadPhase.add(rect(i), CollisionLayer::Pet);
+    }
+    m_broadPhase.add(m_cursorRect, CollisionLayer::Cursor);
+    for (const QRect& obstacle : m_obstacles) {
+        m_broadPhase.add(obstacle, CollisionLayer::Obstacle);
+    }
+    m_broadPhasePets = count;
+    m_broadPhaseDirty = false;
+}
+
+void PetSwarm::detectContacts()
+{
+    const int count = size();
+    if (m_broadPhaseDirty) {
+        rebuildBroadPhase();
+    } else {
+        for (int i = 0; i < count; ++i) {
+            m_broadPhase.update(i, rect(i));
+        }
+        m_broadPhase.update(count, m_cursorRect);
+    }
+    const int cursorProxy = count;
+    const int firstObstacle = count + 1;
+
+    m_iconCandidate.assign(count, -1);
+    m_touchingLastIcon.assign(count, 0);
+    m_newBumps.clear();
+    m_newFollowers.clear();
+
+    // 成对结果按编号排序，与上一帧的结果二分比较得到新出现的接触
+    const std::vector<CollisionPair>& pairs = m_broadPhase.findPairs();
+    for (const CollisionPair& pair : pairs) {
+        const int pet = pair.first;   // 宠物编号最小，总在 first
+        const int other = pair.second;
+        if (other >= firstObstacle) {
+            const int icon = other - firstObstacle;
+            if (icon == m_lastIcon[pet]) {
+                m_touchingLastIcon[pet] = 1;
+            } else if (m_iconCandidate[pet] < 0) {
+                m_iconCandidate[pet] = icon;
+            }
+            continue;
+        }
+        if (std::binary_search(m_lastPairs.begin(), m_lastPairs.end(), pair)) {
+            continue;
+        }
+        if (other == cursorProxy) {
+            // 跟随中追上鼠标只延长跟随时间，不重复发送
+            if (m_state[pet] == static_cast<uint8_t>(SwarmPetState::Following)) {
+                m_stateTime[pet] = m_config.followSeconds;
+            } else if (m_state[pet] != static_cast<uint8_t>(SwarmPetState::Interacting)) {
+                setState(pet, SwarmPetState::Following, m_config.followSeconds);
+                m_newFollowers.push_back(pet);
+            }
+        } else {
+            m_newBumps.push_back(pair);
+            // 相撞后各自朝远离对方的方向走开（随机换目标会让宠物越挤越多）
+            const float dx = m_posX[pet] - m_posX[other];
+            const float dy = m_posY[pet] - m_posY[other];
+            bounceAway(pet, dx, dy);
+            bounceAway(other, -dx, -dy);
+        }
+    }
+    m_lastPairs.assign(pairs.begin(), pairs.end());
+
+    // 与图标接触时按概率交互，离开上一次交互的图标之前不再与它交互
+    for (int i = 0; i < count; ++i) {
+        if (!m_touchingLastIcon[i]) {
+            m_lastIcon[i] = -1;
+        }
+        if (m_state[i] != static_cast<uint8_t>(SwarmPetState::Walking) || m_iconCandidate[i] < 0) {
+            continue;
+        }
+        if (static_cast<int>(m_rng.bounded(100)) < m_config.interactionProbability) {
+            m_lastIcon[i] = m_iconCandidate[i];
+            m_velX[i] = 0.0f;
+            m_velY[i] = 0.0f;
+            setState(i, SwarmPetState::Interacting, m_config.interactionSeconds);
+            ++m_interactionCount;
+        }
+    }
+}
+
+void PetSwarm::sendEvents()
+{
+    m_bumpCount += static_cast<long long>(m_newBumps.size());
+    m_followCount += static_cast<long long>(m_newFollowers.size());
+    for (const CollisionPair& bump : m_newBumps) {
+        PetBumpEvent event;
+        event.pet = bump.first;
+        event.other = bump.second;
+        EventMgr::GetInstance().SendEvent(event);
+    }
+    for (int pet : m_newFollowers) {
+        PetFollowCursorEvent event;
+        event.pet = pet;
+        event.cursorX = m_cursor.x();
+        event.cursorY = m_cursor.y();
+        EventMgr::GetInstance().SendEvent(event);
+    }
+}
+
+void PetSwarm::chooseTarget(int index)
+{
+    // 在宠物所在的屏幕内走动，多屏时偶尔换到另一块屏幕
+    const QPoint center(static_cast<int>(m_posX[index]) + m_petSize.width() / 2,
+                        static_cast<int>(m_posY[index]) + m_petSize.height() / 2);
+    int screen = m_screens.screenAt(center);
+    if (screen < 0) {
+        return;
+    }
+    if (m_screens.count() > 1 && m_rng.bounded(100) < 5) {
+        screen = m_rng.bounded(m_screens.count());
+    }
+    const QPoint target = randomPointOnScreen(screen);
+    m_targetX[index] = static_cast<float>(target.x());
+    m_targetY[index] = static_cast<float>(target.y());
+}
+
+void PetSwarm::bounceAway(int index, float dx, float dy)
+{
+    if (m_state[index] != static_cast<uint8_t>(SwarmPetState::Walking)) {
+        return;
+    }
+    float length = std::sqrt(dx * dx + dy * dy);
+    if (length < 1.0f) {
+        // 完全重叠时随机选一个方向
+        const float angle = static_cast<float>(m_rng.generateDouble() * 2.0 * 3.14159265358979);
+        dx = std::cos(angle);
+        dy = std::sin(angle);
+        length = 1.0f;
+    }
+    const QPoint away(static_cast<int>(m_posX[index] + dx / length * BOUNCE_DISTANCE),
+                      static_cast<int>(m_posY[index] + dy / length * BOUNCE_DISTANCE));
+    const QPoint target = m_screens.constrain(away);
+    m_targetX[index] = static_cast<float>(target.x());
+    m_targetY[index] = static_cast<float>(target.y());
+    // 相撞时停下再掉头：保留原速度会沿弧线冲出新目标，可能越过屏幕边缘
+    m_velX[index] = 0.0f;
+    m_velY[index] = 0.0f;
+}
+
+void PetSwarm::setState(int index, SwarmPetState state, float seconds)
+{
+    m_stateTime[index] = seconds;
+    if (m_state[index] != static_cast<uint8_t>(state)) {
+        m_state[index] = static_cast<uint8_t>(state);
+        m_changed.push_back(index);
+    }
+}
+
+QPoint PetSwarm::randomPointOnScreen(int screen)
+{
+    const QRect area = m_screens.walkableRect(screen);
+    const int left = area.left() + SCREEN_MARGIN;
+    const int right = area.right() - SCREEN_MARGIN;
+    const int top = area.top() + SCREEN_MARGIN;
+    const int bottom = area.bottom() - SCREEN_MARGIN;
+    // 屏幕太小、留不出安全距离时取中心
+    const int x = left < right ? m_rng.bounded(left, right + 1) : area.center().x();
+    const int y = top < bottom ? m_rng.bounded(top, bottom + 1) : area.center().y();
+    return QPoint(x, y);
+}
+
+float PetSwarm::randomSeconds(float minSeconds, float maxSeconds)
+{
+    return minSeconds + static_cast<float>(m_rng.generateDouble()) * std::max(0.0f, maxSeconds - minSeconds);
+}
+
+QPoint PetSwarm::position(int index) const
+{
+    return QPoint(static_cast<int>(std::lround(m_posX[index])), static_cast<int>(std::lround(m_posY[index])));
+}
+
+QPoint PetSwarm::target(int index) const
+{
+    return QPoint(static_cast<int>(std::lround(m_targetX[index])), static_cast<int>(std::lround(m_targetY[index])));
+}
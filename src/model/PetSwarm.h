@@ -0,0 +1,141 @@
+#ifndef __PET_SWARM_H__
+#define __PET_SWARM_H__
+
+#include "../common/RandomEngine.h"
+#include "BroadPhase.h"
+#include "ScreenTopology.h"
+#include <QPoint>
+#include <QRect>
+#include <QSize>
+#include <QVector>
+#include <cstdint>
+#include <vector>
+
+/**
+ * 群体宠物的状态
+ */
+enum class SwarmPetState : uint8_t {
+    Walking,      // 朝目标移动
+    Idle,         // 到达目标后原地停留
+    Interacting,  // 正在与桌面图标交互
+    Following,    // 碰到鼠标后跟着鼠标走
+};
+
+/**
+ * 群体宠物配置（所有宠物共用）
+ */
+struct SwarmConfig {
+    float maxSpeed = 200.0f;          // 最大移动速度（像素/秒）
+    float acceleration = 800.0f;      // 加速度（像素/秒²）
+    int idleProbability = 30;         // 到达目标后停留的概率（百分比）
+    float idleMinSeconds = 0.5f;      // 停留时间范围
+    float idleMaxSeconds = 2.0f;
+    int interactionProbability = 2;   // 每帧与图标接触时交互的概率（百分比）
+    float interactionSeconds = 1.5f;  // 交互持续时间
+    int cursorRadius = 24;            // 鼠标的碰撞范围（像素）
+    float followSeconds = 3.0f;       // 碰到鼠标后跟随的时间
+};
+
+/**
+ * 多只宠物的批量模拟
+ * 宠物数据按列存放（位置、速度、目标、状态各占一个数组），每帧由一次 step() 依次推进：
+ * 状态计时 → 移动积分 → 碰撞检测，每一步都是对连续数组的顺序遍历，没有每只宠物各自的定时器
+ * 移动与 MotionIntegrator 相同（限加速度的 arrive），目标在宠物当前所在屏幕的可活动范围内随机选取
+ * 宠物、鼠标和图标的包围盒放在同一个宽阶段（SweepAndPrune）中检测，新出现的接触才会触发：
+ * 宠物相撞时各自换方向（PetBumpEvent），碰到鼠标时跟随鼠标（PetFollowCursorEvent），碰到图标时按概率交互
+ * 状态发生变化的宠物下标记录在 changed() 中，界面只需要为这些宠物切换动画
+ */
+class PetSwarm
+{
+public:
+    explicit PetSwarm(uint64_t seed = 0);
+
+    void setConfig(const SwarmConfig& config) { m_config = config; }
+    const SwarmConfig& config() const { return m_config; }
+
+    // 屏幕和宠物大小（所有宠物大小相同）；屏幕变化时已有的宠物会被拉回新的可活动区域
+    void setScreens(const QVector<ScreenInfo>& screens);
+    void setPetSize(const QSize& size);
+    const QSize& petSize() const { return m_petSize; }
+    const ScreenTopology& screens() const { return m_screens; }
+
+    // 可交互的障碍物（桌面图标），invalid 的区域忽略
+    void setObstacles(const QVector<QRect>& rects);
+
+    // 鼠标位置（每帧由界面更新）；清除后不再参与碰撞
+    void setCursor(const QPoint& position);
+    void clearCursor();
+
+    // 在 topLeft 处添加一只静止的宠物，返回下标
+    int spawn(const QPoint& topLeft);
+    // 在随机屏幕的随机位置添加 count 只宠物
+    void spawnRandom(int count);
+    void clear();
+    int size() const { return static_cast<int>(m_posX.size()); }
+
+    // 推进 dt 秒（超过 MAX_STEP 的部分丢弃，避免长时间卡顿后宠物瞬移）
+    void step(double dt);
+
+    QPoint position(int index) const;
+    QRect rect(int index) const { return QRect(position(index), m_petSize); }
+    SwarmPetState state(int index) const { return static_cast<SwarmPetState>(m_state[index]); }
+    QPoint target(int index) const;
+
+    // 上一次 step() 中状态发生变化的宠物
+    const std::vector<int>& changed() const { return m_changed; }
+    // 累计交互、相撞和开始跟随鼠标的次数
+    long long interactionCount() const { return m_interactionCount; }
+    long long bumpCount() const { return m_bumpCount; }
+    long long followCount() const { return m_followCount; }
+
+    static constexpr double MAX_STEP = 0.1;
+
+private:
+    void updateTimers(float dt);
+    void integrate(float dt);
+    void detectContacts();
+    void rebuildBroadPhase();
+    void sendEvents();
+    void chooseTarget(int index);
+    void bounceAway(int index, float dx, float dy);
+    void setState(int index, SwarmPetState state, float seconds);
+    QPoint randomPointOnScreen(int screen);
+    float randomSeconds(float minSeconds, float maxSeconds);
+
+private:
+    SwarmConfig m_config;
+    ScreenTopology m_screens;
+    QSize m_petSize;
+    QVector<QRect> m_obstacles;
+    QRect m_cursorRect;              // 空区域表示鼠标不参与碰撞
+    QPoint m_cursor;
+    RandomEngine m_rng;
+
+    // 每只宠物一列（左上角坐标）
+    std::vector<float> m_posX;
+    std::vector<float> m_posY;
+    std::vector<float> m_velX;
+    std::vector<float> m_velY;
+    std::vector<float> m_targetX;
+    std::vector<float> m_targetY;
+    std::vector<uint8_t> m_state;
+    std::vector<float> m_stateTime;  // 当前状态剩余时间（秒），移动中不使用
+    std::vector<int> m_lastIcon;     // 上一次交互的图标，离开之前不重复交互
+
+    // 宽阶段：碰撞体编号 [0, 宠物数) 为宠物，之后是鼠标，再之后是图标
+    SweepAndPrune m_broadPhase;
+    bool m_broadPhaseDirty = true;   // 宠物或图标增减后重建
+    int m_broadPhasePets = 0;        // 重建时的宠物数
+    std::vector<CollisionPair> m_lastPairs; // 上一帧的接触，用来判断哪些是新出现的
+    std::vector<int> m_iconCandidate;   // 每只宠物这一帧接触到的下标最小的图标
+    std::vector<uint8_t> m_touchingLastIcon;
+
+    std::vector<int> m_changed;
+    std::vector<CollisionPair> m_newBumps;  // 这一帧新发生的宠物相撞
+    std::vector<int> m_newFollowers;        // 这一帧开始跟随鼠标的宠物
+    long long m_interactionCount = 0;
+    long long m_bumpCount = 0;
+    long long m_followCount = 0;
+};
+
+#endif // __PET_SWARM_H__
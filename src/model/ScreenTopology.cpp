@@ -0,0 +1,199 @@
+#include "ScreenTopology.h"
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+
+namespace {
+
+// 屏幕边缘相差不超过这么多像素时视为相接（缩放取整可能带来 1~2 像素的误差）
+const int ADJACENT_TOLERANCE = 2;
+
+bool overlaps(int a0, int a1, int b0, int b1)
+{
+    return a0 <= b1 && b0 <= a1;
+}
+
+QPoint clampToRect(const QPoint& point, const QRect& rect)
+{
+    return QPoint(std::min(std::max(point.x(), rect.left()), rect.right()),
+                  std::min(std::max(point.y(), rect.top()), rect.bottom()));
+}
+
+long long squaredDistance(const QPoint& a, const QPoint& b)
+{
+    const long long dx = a.x() - b.x();
+    const long long dy = a.y() - b.y();
+    return dx * dx + dy * dy;
+}
+
+} // namespace
+
+void ScreenTopology::setScreens(const QVector<ScreenInfo>& screens)
+{
+    m_screens = screens;
+    m_bounds = QRect();
+    for (ScreenInfo& screen : m_screens) {
+        if (!screen.availableGeometry.isValid()) {
+            screen.availableGeometry = screen.geometry;
+        }
+        m_bounds = m_bounds.united(screen.geometry);
+    }
+    m_lastHit = 0;
+    rebuildWalkAreas();
+    rebuildDeadZones();
+}
+
+void ScreenTopology::setPetSize(const QSize& size)
+{
+    if (size == m_petSize) {
+        return;
+    }
+    m_petSize = size;
+    rebuildWalkAreas();
+}
+
+void ScreenTopology::rebuildWalkAreas()
+{
+    m_walkAreas.clear();
+    const int halfWidth = m_petSize.width() / 2;
+    const int halfHeight = m_petSize.height() / 2;
+
+    for (int i = 0; i < m_screens.size(); ++i) {
+        const QRect& geometry = m_screens[i].geometry;
+        const QRect& available = m_screens[i].availableGeometry;
+
+        // 哪几条边与其他屏幕相接
+        bool hasLeft = false, hasRight = false, hasTop = false, hasBottom = false;
+        for (int j = 0; j < m_screens.size(); ++j) {
+            if (j == i) {
+                continue;
+            }
+            const QRect& other = m_screens[j].geometry;
+            if (overlaps(geometry.top(), geometry.bottom(), other.top(), other.bottom())) {
+                hasRight = hasRight || std::abs(other.left() - (geometry.right() + 1)) <= ADJACENT_TOLERANCE;
+                hasLeft = hasLeft || std::abs(other.right() + 1 - geometry.left()) <= ADJACENT_TOLERANCE;
+            }
+            if (overlaps(geometry.left(), geometry.right(), other.left(), other.right())) {
+                hasBottom = hasBottom || std::abs(other.top() - (geometry.bottom() + 1)) <= ADJACENT_TOLERANCE;
+                hasTop = hasTop || std::abs(other.bottom() + 1 - geometry.top()) <= ADJACENT_TOLERANCE;
+            }
+        }
+
+        // 中心点范围：外侧边缘留出宠物的一半，相接的一侧可以走到边上
+        int left = available.left() + (hasLeft ? 0 : halfWidth);
+        int right = available.right() + 1 - (hasRight ? 0 : m_petSize.width() - halfWidth);
+        int top = available.top() + (hasTop ? 0 : halfHeight);
+        int bottom = available.bottom() + 1 - (hasBottom ? 0 : m_petSize.height() - halfHeight);
+        // 屏幕比宠物还小时只能停在屏幕中央
+        if (left > right) {
+            left = right = available.center().x();
+        }
+        if (top > bottom) {
+            top = bottom = available.center().y();
+        }
+        m_walkAreas.append(QRect(QPoint(left, top), QPoint(right, bottom)));
+    }
+}
+
+void ScreenTopology::rebuildDeadZones()
+{
+    m_deadZones.clear();
+    if (m_screens.isEmpty()) {
+        return;
+    }
+
+    // 按屏幕边界切分外接矩形，没有被任何屏幕覆盖的小块就是空隙；同一行中相邻的空隙合并
+    std::vector<int> xs = {m_bounds.left(), m_bounds.right() + 1};
+    std::vector<int> ys = {m_bounds.top(), m_bounds.bottom() + 1};
+    for (const ScreenInfo& screen : m_screens) {
+        xs.push_back(screen.geometry.left());
+        xs.push_back(screen.geometry.right() + 1);
+        ys.push_back(screen.geometry.top());
+        ys.push_back(screen.geometry.bottom() + 1);
+    }
+    std::sort(xs.begin(), xs.end());
+    xs.erase(std::unique(xs.begin(), xs.end()), xs.end());
+    std::sort(ys.begin(), ys.end());
+    ys.erase(std::unique(ys.begin(), ys.end()), ys.end());
+
+    for (size_t row = 0; row + 1 < ys.size(); ++row) {
+        int runStart = -1;
+        for (size_t col = 0; col + 1 <= xs.size(); ++col) {
+            bool covered = true;
+            if (col + 1 < xs.size()) {
+                const QPoint probe(xs[col], ys[row]);
+                covered = std::any_of(m_screens.begin(), m_screens.end(), [&](const ScreenInfo& screen) {
+                    return screen.geometry.contains(probe);
+                });
+            }
+            if (!covered && runStart < 0) {
+                runStart = xs[col];
+            } else if (covered && runStart >= 0) {
+                m_deadZones.append(QRect(QPoint(runStart, ys[row]), QPoint(xs[col] - 1, ys[row + 1] - 1)));
+                runStart = -1;
+            }
+        }
+    }
+}
+
+int ScreenTopology::screenAt(const QPoint& point) const
+{
+    if (m_screens.isEmpty()) {
+        return -1;
+    }
+    if (m_lastHit < m_screens.size() && m_screens[m_lastHit].geometry.contains(point)) {
+        return m_lastHit;
+    }
+
+    int nearest = 0;
+    long long nearestDistance = -1;
+    for (int i = 0; i < m_screens.size(); ++i) {
+        const QRect& geometry = m_screens[i].geometry;
+        if (geometry.contains(point)) {
+            m_lastHit = i;
+            return i;
+        }
+        const long long distance = squaredDistance(point, clampToRect(point, geometry));
+        if (nearestDistance < 0 || distance < nearestDistance) {
+            nearest = i;
+            nearestDistance = distance;
+        }
+    }
+    return nearest;
+}
+
+QPoint ScreenTopology::constrain(const QPoint& topLeft) const
+{
+    if (m_walkAreas.isEmpty()) {
+        return topLeft;
+    }
+
+    const QPoint half(m_petSize.width() / 2, m_petSize.height() / 2);
+    const QPoint center = topLeft + half;
+    if (m_lastHit < m_walkAreas.size() && m_walkAreas[m_lastHit].contains(center)) {
+        return topLeft;
+    }
+
+    // 不在任何区域内时投影到最近的区域
+    QPoint best = center;
+    long long bestDistance = -1;
+    for (int i = 0; i < m_walkAreas.size(); ++i) {
+        if (m_walkAreas[i].contains(center)) {
+            m_lastHit = i;
+            return topLeft;
+        }
+        const QPoint projected = clampToRect(center, m_walkAreas[i]);
+        const long long distance = squaredDistance(center, projected);
+        if (bestDistance < 0 || distance < bestDistance) {
+            best = projected;
+            bestDistance = distance;
+        }
+    }
+    return best - half;
+}
+
+QRect ScreenTopology::walkableRect(int index) const
+{
+    const QPoint half(m_petSize.width() / 2, m_petSize.height() / 2);
+    return m_walkAreas[index].translated(-half);
+}
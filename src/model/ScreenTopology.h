@@ -0,0 +1,69 @@
+#ifndef __SCREEN_TOPOLOGY_H__
+#define __SCREEN_TOPOLOGY_H__
+
+#include <QPoint>
+#include <QRect>
+#include <QSize>
+#include <QString>
+#include <QVector>
+
+/**
+ * 单个屏幕的几何信息（逻辑像素）
+ */
+struct ScreenInfo {
+    QString name;
+    QRect geometry;           // 屏幕区域
+    QRect availableGeometry;  // 去掉任务栏/停靠栏后的可用区域
+    qreal devicePixelRatio = 1.0;
+    qreal logicalDpi = 96.0;
+    qreal refreshRate = 60.0;
+};
+
+/**
+ * 虚拟桌面拓扑缓存
+ * 保存所有屏幕的几何信息，只在屏幕增删或几何变化时重建；每帧的查询只读缓存
+ * 宠物可以活动的范围按屏幕划分成若干区域（以宠物中心点计）：
+ * 屏幕外侧的边缘留出半个宠物大小，保证宠物完整显示；与相邻屏幕相接的一侧不留边，宠物可以跨屏移动
+ * 混合DPI时 Qt 已经把各屏幕换算到同一逻辑坐标系，屏幕之间的空隙通过投影到最近的区域处理
+ */
+class ScreenTopology
+{
+public:
+    void setScreens(const QVector<ScreenInfo>& screens);
+    // 宠物大小变化时重新计算可活动区域
+    void setPetSize(const QSize& size);
+
+    bool isEmpty() const { return m_screens.isEmpty(); }
+    int count() const { return m_screens.size(); }
+    const ScreenInfo& screen(int index) const { return m_screens[index]; }
+
+    // 所有屏幕的外接矩形
+    const QRect& bounds() const { return m_bounds; }
+
+    // 包含 point 的屏幕下标，不在任何屏幕上时返回离它最近的屏幕；没有屏幕时返回 -1
+    // 相邻两次查询通常落在同一块屏幕，先检查上一次命中的屏幕
+    int screenAt(const QPoint& point) const;
+
+    // 把宠物左上角位置限制到可活动区域内，已经在区域内时原样返回
+    QPoint constrain(const QPoint& topLeft) const;
+
+    // 宠物左上角在 index 号屏幕上可以到达的范围
+    QRect walkableRect(int index) const;
+
+    // 外接矩形内不属于任何屏幕的部分，给导航网格当作障碍物
+    const QVector<QRect>& deadZones() const { return m_deadZones; }
+
+private:
+    void rebuildWalkAreas();
+    void rebuildDeadZones();
+
+private:
+    QVector<ScreenInfo> m_screens;
+    QRect m_bounds;
+    QSize m_petSize;
+    QVector<QRect> m_walkAreas;   // 每个屏幕上宠物中心点可以到达的范围
+    QVector<QRect> m_deadZones;
+    mutable int m_lastHit = 0;
+};
+
+#endif // __SCREEN_TOPOLOGY_H__
@@ -1,11 +1,16 @@
 #include "WorkModel.h"
 #include "../common/EventMgr.h"
 #include "../common/EventDefine.h"
+#include "../common/RandomService.h"
+#include "../common/StartupProfiler.h"
 #include <QDebug>
-#include <QRandomGenerator>
+#include <QJsonDocument>
+#include <QDateTime>
+#include <limits>
 
 WorkModel::WorkModel() noexcept
-    : m_trigger(), m_currentStatus(WorkStatus::Idle), m_currentWorkType(WorkType::Photosynthesis), m_remainingTime(0), m_continuousMode(false), m_workTimer(nullptr)
+    : m_trigger(), m_currentStatus(WorkStatus::Idle), m_currentWorkType(WorkType::Photosynthesis), m_continuousMode(false), m_cycleStartTime(0), m_workTimer(nullptr),
+      m_rng(&RandomService::GetInstance().stream(RandomStream::Work))
 {
     initializeWorkTypes();
 
@@ -17,9 +22,12 @@ WorkModel::WorkModel() noexcept
     // 初始化工作系统加成效果
     initializeWorkSystemBonuses();
 
-    // 创建工作定时器
+    // 加载掉落表（依赖加成效果）
+    loadLootTablesFromCSV(":/resources/csv/loot_tables.csv");
+
+    // 创建周期完成定时器：只在截止时间唤醒一次，不再每秒轮询
     m_workTimer = new QTimer(this);
-    m_workTimer->setInterval(1000); // 设置1秒间隔
+    m_workTimer->setSingleShot(true);
     connect(m_workTimer, &QTimer::timeout, this, &WorkModel::onWorkTimer);
 }
 
@@ -92,15 +100,14 @@ void WorkModel::startWork(WorkType type) noexcept
     // 开始新的工作
     m_currentStatus = WorkStatus::Working;
     m_currentWorkType = type;
-    m_remainingTime = workInfo->workDuration;
     m_continuousMode = true; // 默认开启连续模式
+    startCycle(static_cast<qint64>(workInfo->workDuration) * 1000);
 
     qDebug() << "开始连续打工：" << workInfo->name << "，持续时间：" << workInfo->workDuration << "秒";
 
     // 发射工作开始信号
     emit workStarted(type);
 
-    m_workTimer->start();
     fireWorkStatusUpdate();
 }
 
@@ -113,9 +120,9 @@ void WorkModel::stopWork() noexcept
     }
 
     m_currentStatus = WorkStatus::Idle;
-    m_remainingTime = 0;
     m_continuousMode = false; // 停止连续模式
     m_workTimer->stop();
+    m_deadline = QDeadlineTimer();
 
     qDebug() << "停止打工和连续模式";
     fireWorkStatusUpdate();
@@ -133,259 +140,88 @@ const WorkInfo *WorkModel::getWorkInfo(WorkType type) const noexcept
     return nullptr;
 }
 
-void WorkModel::onWorkTimer()
+void WorkModel::startCycle(qint64 durationMs)
 {
-    if (m_currentStatus != WorkStatus::Working)
+    if (durationMs < 0)
     {
-        m_workTimer->stop();
-        return;
+        durationMs = 0;
     }
 
-    m_remainingTime--;
-
-    if (m_remainingTime <= 0)
-    {
-        // 工作完成
-        const WorkInfo *workInfo = getWorkInfo(m_currentWorkType);
-        QVector<int> rewards; // 记录奖励物品ID
-        
-        if (workInfo)
-        {
-            qDebug() << "工作完成！获得" << workInfo->experienceReward << "经验值";
-
-            // 触发经验值增加事件
-            AddExperienceEvent expEvent;
-            expEvent.experience = workInfo->experienceReward;
-            EventMgr::GetInstance().SendEvent(expEvent);
-
-            // 如果是光合作用，随机生成阳光
-            if (m_currentWorkType == WorkType::Photosynthesis)
-            {
-                rewards = generateSunshineRewards();
-            }
-            // 如果是挖矿，随机生成矿石
-            else if (m_currentWorkType == WorkType::Mining)
-            {
-                rewards = generateMineralRewards();
-            }
-            // 如果是冒险，随机生成木头
-            else if (m_currentWorkType == WorkType::Adventure)
-            {
-                rewards = generateWoodRewards();
-            }
-        }
-
-        // 发射工作完成信号
-        emit workCompleted(m_currentWorkType, rewards);
+    const WorkInfo *workInfo = getWorkInfo(m_currentWorkType);
+    const qint64 fullMs = workInfo ? static_cast<qint64>(workInfo->workDuration) * 1000 : durationMs;
 
-        if (m_continuousMode)
-        {
-            // 如果是连续模式，自动开始下一轮工作
-            qDebug() << "自动开始下一轮工作：" << workInfo->name;
-            m_remainingTime = workInfo->workDuration; // 重置剩余时间
-            fireWorkStatusUpdate();
-        }
-        else
-        {
-            // 停止工作
-            m_currentStatus = WorkStatus::Idle;
-            m_workTimer->stop();
-            emit workStopped();
-            fireWorkStatusUpdate();
-        }
-    }
-    else
-    {
-        // 更新剩余时间
-        fireWorkStatusUpdate();
-    }
+    m_deadline.setRemainingTime(durationMs);
+    // 记录墙钟上的周期开始时间，用于退出后的离线结算
+    m_cycleStartTime = QDateTime::currentMSecsSinceEpoch() - (fullMs - durationMs);
+    m_workTimer->start(static_cast<int>(durationMs));
 }
 
-void WorkModel::generateSunshine()
+void WorkModel::onWorkTimer()
 {
-    // 获取当前光合作用系统的加成效果
-    float dropRateMultiplier = getDropRateMultiplier(WorkType::Photosynthesis);
-    float qualityBonus = getQualityBonus(WorkType::Photosynthesis);
-
-    // 阳光物品ID范围：6-10 (微光阳光到神圣阳光)
-    // 基础概率：普通60%，稀有25%，史诗12%，传说3%
-    // 应用品质加成后调整概率
-
-    QRandomGenerator *rng = QRandomGenerator::global();
-    int random = rng->bounded(100); // 0-99
-
-    // 应用品质加成，提高高品质物品的概率
-    float adjustedRandom = random - (qualityBonus * 100);
-    if (adjustedRandom < 0)
-        adjustedRandom = 0;
-
-    int sunshineId;
-    int count = 1;
-
-    if (adjustedRandom < 60)
-    {
-        // 基础概率60%获得微光阳光 (ID=6, 普通)
-        sunshineId = 6;
-        count = rng->bounded(1, 4); // 1-3个
-    }
-    else if (adjustedRandom < 85)
-    {
-        // 25% 概率获得温暖阳光 (ID=7, 稀有)
-        sunshineId = 7;
-        count = rng->bounded(1, 3); // 1-2个
-    }
-    else if (adjustedRandom < 97)
-    {
-        // 12% 概率获得炽热阳光或灿烂阳光 (ID=8或9, 史诗)
-        sunshineId = rng->bounded(8, 10); // 8或9
-        count = 1;
-    }
-    else
+    if (m_currentStatus != WorkStatus::Working)
     {
-        // 3% 概率获得神圣阳光 (ID=10, 传说)
-        sunshineId = 10;
-        count = 1;
+        return;
     }
 
-    // 应用掉落率倍数
-    int finalCount = static_cast<int>(count * dropRateMultiplier);
-    if (finalCount < 1)
-        finalCount = 1;
-
-    // 触发添加物品事件
-    AddItemEvent itemEvent;
-    itemEvent.itemId = sunshineId;
-    itemEvent.count = finalCount;
-    EventMgr::GetInstance().SendEvent(itemEvent);
-
-    qDebug() << "光合作用产生阳光! 物品ID:" << sunshineId << "数量:" << finalCount
-             << "(等级加成: x" << dropRateMultiplier << ", 品质加成: +" << (qualityBonus * 100) << "%)";
-}
-
-void WorkModel::generateMinerals()
-{
-    // 获取当前挖矿系统的加成效果
-    float dropRateMultiplier = getDropRateMultiplier(WorkType::Mining);
-    float qualityBonus = getQualityBonus(WorkType::Mining);
-
-    // 矿石物品ID范围：11-15 (粗糙矿石到传说矿石)
-    // 基础概率：普通50%，稀有30%，史诗15%，传说5%
-    // 应用品质加成后调整概率
-
-    QRandomGenerator *rng = QRandomGenerator::global();
-    int random = rng->bounded(100); // 0-99
-
-    // 应用品质加成，提高高品质物品的概率
-    float adjustedRandom = random - (qualityBonus * 100);
-    if (adjustedRandom < 0)
-        adjustedRandom = 0;
-
-    int mineralId;
-    int count = 1;
-
-    if (adjustedRandom < 50)
-    {
-        // 50% 概率获得粗糙矿石 (ID=11, 普通)
-        mineralId = 11;
-        count = rng->bounded(2, 6); // 2-5个
-    }
-    else if (adjustedRandom < 80)
-    {
-        // 30% 概率获得普通矿石 (ID=12, 稀有)
-        mineralId = 12;
-        count = rng->bounded(1, 4); // 1-3个
-    }
-    else if (adjustedRandom < 95)
+    // 定时器可能略早于截止时间触发，未到期则补足剩余时间
+    if (!m_deadline.hasExpired())
     {
-        // 15% 概率获得优质矿石或稀有矿石 (ID=13或14, 史诗)
-        mineralId = rng->bounded(13, 15); // 13或14
-        count = 1;
-    }
-    else
-    {
-        // 5% 概率获得传说矿石 (ID=15, 传说)
-        mineralId = 15;
-        count = 1;
+        m_workTimer->start(static_cast<int>(m_deadline.remainingTime()));
+        return;
     }
 
-    // 应用掉落率倍数
-    int finalCount = static_cast<int>(count * dropRateMultiplier);
-    if (finalCount < 1)
-        finalCount = 1;
-
-    // 触发添加物品事件
-    AddItemEvent itemEvent;
-    itemEvent.itemId = mineralId;
-    itemEvent.count = finalCount;
-    EventMgr::GetInstance().SendEvent(itemEvent);
+    // 工作完成
+    const WorkInfo *workInfo = getWorkInfo(m_currentWorkType);
+    QVector<int> rewards; // 记录奖励物品ID
+    qint64 overdueMs = 0;
 
-    qDebug() << "挖矿产生矿石! 物品ID:" << mineralId << "数量:" << finalCount
-             << "(等级加成: x" << dropRateMultiplier << ", 品质加成: +" << (qualityBonus * 100) << "%)";
-}
-
-void WorkModel::generateWoods()
-{
-    // 获取当前冒险系统的加成效果
-    float dropRateMultiplier = getDropRateMultiplier(WorkType::Adventure);
-    float qualityBonus = getQualityBonus(WorkType::Adventure);
+    if (workInfo)
+    {
+        qDebug() << "工作完成！获得" << workInfo->experienceReward << "经验值";
 
-    // 木头物品ID范围：16-20 (枯木到神木)
-    // 基础概率：普通55%，稀有30%，史诗10%，传说5%
-    // 应用品质加成后调整概率
+        // 触发经验值增加事件
+        AddExperienceEvent expEvent;
+        expEvent.experience = workInfo->experienceReward;
+        EventMgr::GetInstance().SendEvent(expEvent);
 
-    QRandomGenerator *rng = QRandomGenerator::global();
-    int random = rng->bounded(100); // 0-99
+        // 按当前工作系统等级的掉落表生成奖励（阳光/矿石/木头）
+        rewards = generateRewards(m_currentWorkType);
 
-    // 应用品质加成，提高高品质物品的概率
-    float adjustedRandom = random - (qualityBonus * 100);
-    if (adjustedRandom < 0)
-        adjustedRandom = 0;
+        // remainingTime()到期后恒为0，超时量需用绝对时间计算
+        overdueMs = qMax<qint64>(0, QDeadlineTimer::current().deadline() - m_deadline.deadline());
+    }
 
-    int woodId;
-    int count = 1;
+    // 发射工作完成信号
+    emit workCompleted(m_currentWorkType, rewards);
 
-    if (adjustedRandom < 55)
-    {
-        // 55% 概率获得枯木 (ID=16, 普通)
-        woodId = 16;
-        count = rng->bounded(2, 5); // 2-4个
-    }
-    else if (adjustedRandom < 85)
+    if (m_continuousMode && workInfo)
     {
-        // 30% 概率获得普通木材 (ID=17, 稀有)
-        woodId = 17;
-        count = rng->bounded(1, 3); // 1-2个
-    }
-    else if (adjustedRandom < 95)
-    {
-        // 10% 概率获得优质木材或稀有木材 (ID=18或19, 史诗)
-        woodId = rng->bounded(18, 20); // 18或19
-        count = 1;
+        // 连续模式：下一周期从上一个截止时间接着算，避免误差累积
+        // 如果系统休眠等原因错过了多个周期，一次性补发
+        const qint64 durationMs = static_cast<qint64>(workInfo->workDuration) * 1000;
+        if (durationMs > 0 && overdueMs >= durationMs)
+        {
+            grantBatchRewards(m_currentWorkType, overdueMs / durationMs);
+            overdueMs %= durationMs;
+        }
+
+        qDebug() << "自动开始下一轮工作：" << workInfo->name;
+        startCycle(durationMs - overdueMs);
     }
     else
     {
-        // 5% 概率获得神木 (ID=20, 传说)
-        woodId = 20;
-        count = 1;
+        // 停止工作
+        m_currentStatus = WorkStatus::Idle;
+        m_deadline = QDeadlineTimer();
+        emit workStopped();
     }
 
-    // 应用掉落率倍数
-    int finalCount = static_cast<int>(count * dropRateMultiplier);
-    if (finalCount < 1)
-        finalCount = 1;
-
-    // 触发添加物品事件
-    AddItemEvent itemEvent;
-    itemEvent.itemId = woodId;
-    itemEvent.count = finalCount;
-    EventMgr::GetInstance().SendEvent(itemEvent);
-
-    qDebug() << "冒险产生木头! 物品ID:" << woodId << "数量:" << finalCount
-             << "(等级加成: x" << dropRateMultiplier << ", 品质加成: +" << (qualityBonus * 100) << "%)";
+    fireWorkStatusUpdate();
 }
 
 void WorkModel::fireWorkStatusUpdate()
 {
+    m_dirty = true;
     m_trigger.fire(PROP_ID_WORK_STATUS_UPDATE);
 }
 
@@ -417,6 +253,7 @@ void WorkModel::setWorkSystemLevel(WorkType workType, WorkSystemLevel level) noe
     if (m_workSystemLevels[workType] != level)
     {
         m_workSystemLevels[workType] = level;
+        m_dirty = true;
         emit workSystemLevelChanged(workType, level);
         qDebug() << "工作系统等级已更新：" << static_cast<int>(workType) << "-> 等级" << static_cast<int>(level);
     }
@@ -430,13 +267,21 @@ WorkSystemLevel WorkModel::getWorkSystemLevel(WorkType workType) const noexcept
 // 获取当前工作系统的加成效果
 float WorkModel::getDropRateMultiplier(WorkType workType) const noexcept
 {
-    WorkSystemLevel level = getWorkSystemLevel(workType);
-    return m_workSystemBonuses[workType][level].dropRateMultiplier;
+    return getDropRateMultiplier(workType, getWorkSystemLevel(workType));
 }
 
 float WorkModel::getQualityBonus(WorkType workType) const noexcept
 {
-    WorkSystemLevel level = getWorkSystemLevel(workType);
+    return getQualityBonus(workType, getWorkSystemLevel(workType));
+}
+
+float WorkModel::getDropRateMultiplier(WorkType workType, WorkSystemLevel level) const noexcept
+{
+    return m_workSystemBonuses[workType][level].dropRateMultiplier;
+}
+
+float WorkModel::getQualityBonus(WorkType workType, WorkSystemLevel level) const noexcept
+{
     return m_workSystemBonuses[workType][level].qualityBonus;
 }
 
@@ -446,98 +291,349 @@ QVector<int> WorkModel::getUnlockedItems(WorkType workType) const noexcept
     return m_workSystemBonuses[workType][level].unlockedItems;
 }
 
-// 新增方法：返回奖励物品ID而不是直接添加到背包
-QVector<int> WorkModel::generateSunshineRewards()
+void WorkModel::loadLootTablesFromCSV(const QString &csvPath)
+{
+    StartupProfiler::Scope profile("csv:loot_tables");
+    LootTableRows rows;
+    if (!LootTableLoader::loadFromCSV(csvPath, rows))
+    {
+        return;
+    }
+
+    m_lootRows = rows;
+    rebuildLootTables();
+}
+
+// 按各等级的加成把掉落表配置编译为别名表
+void WorkModel::rebuildLootTables()
+{
+    m_lootTables.clear();
+
+    for (auto typeIt = m_lootRows.constBegin(); typeIt != m_lootRows.constEnd(); ++typeIt)
+    {
+        const WorkType workType = typeIt.key();
+        const QMap<int, std::vector<LootEntry>> &levelRows = typeIt.value();
+
+        for (int lv = static_cast<int>(WorkSystemLevel::Basic); lv <= static_cast<int>(WorkSystemLevel::Master); ++lv)
+        {
+            const WorkSystemLevel level = static_cast<WorkSystemLevel>(lv);
+            const WorkSystemBonus &bonus = m_workSystemBonuses[workType][level];
+
+            if (levelRows.contains(lv))
+            {
+                // 该等级单独配置的掉落表，品质已在配置中体现，不再平移
+                m_lootTables[workType][level] = LootTable::compile(levelRows[lv], 0.0, bonus.dropRateMultiplier);
+            }
+            else if (levelRows.contains(0))
+            {
+                m_lootTables[workType][level] = LootTable::compile(levelRows[0], bonus.qualityBonus, bonus.dropRateMultiplier);
+            }
+        }
+    }
+}
+
+const LootTable *WorkModel::getLootTable(WorkType workType, WorkSystemLevel level) const noexcept
+{
+    auto typeIt = m_lootTables.constFind(workType);
+    if (typeIt == m_lootTables.constEnd())
+    {
+        return nullptr;
+    }
+    auto levelIt = typeIt->constFind(level);
+    if (levelIt == typeIt->constEnd() || levelIt->isEmpty())
+    {
+        return nullptr;
+    }
+    return &levelIt.value();
+}
+
+LootDrop WorkModel::drawLoot(WorkType workType, RandomEngine &rng) const noexcept
+{
+    const LootTable *table = getLootTable(workType, getWorkSystemLevel(workType));
+    return table ? table->draw(rng) : LootDrop();
+}
+
+// 生成一次打工奖励：抽样一次，同一结果既发送添加物品事件也作为返回值
+QVector<int> WorkModel::generateRewards(WorkType workType)
 {
     QVector<int> rewards;
-    
-    // 获取当前光合作用系统的加成效果
-    float dropRateMultiplier = getDropRateMultiplier(WorkType::Photosynthesis);
-    float qualityBonus = getQualityBonus(WorkType::Photosynthesis);
 
-    // 阳光物品ID范围：6-10 (微光阳光到神圣阳光)
-    // 基础概率：普通60%，稀有25%，史诗12%，传说3%
-    // 应用品质加成后调整概率
+    LootDrop drop = drawLoot(workType, *m_rng);
+    if (drop.count <= 0)
+    {
+        qDebug() << "未配置掉落表，工作类型:" << static_cast<int>(workType);
+        return rewards;
+    }
+
+    // 触发添加物品事件
+    AddItemEvent itemEvent;
+    itemEvent.itemId = drop.itemId;
+    itemEvent.count = drop.count;
+    EventMgr::GetInstance().SendEvent(itemEvent);
+
+    // 添加到奖励列表
+    rewards.fill(drop.itemId, drop.count);
+
+    qDebug() << "打工产出物品! 物品ID:" << drop.itemId << "数量:" << drop.count
+             << "(等级加成: x" << getDropRateMultiplier(workType)
+             << ", 品质加成: +" << (getQualityBonus(workType) * 100) << "%)";
 
-    QRandomGenerator *rng = QRandomGenerator::global();
-    int random = rng->bounded(100); // 0-99
+    return rewards;
+}
 
-    // 应用品质加成，提高高品质物品的概率
-    float adjustedRandom = random - (qualityBonus * 100);
-    if (adjustedRandom < 0)
-        adjustedRandom = 0;
+void WorkModel::grantBatchRewards(WorkType workType, qint64 cycles)
+{
+    const WorkInfo *workInfo = getWorkInfo(workType);
+    if (!workInfo || cycles <= 0)
+    {
+        return;
+    }
 
-    int sunshineId;
-    int count = 1;
+    // 经验一次性发放
+    AddExperienceEvent expEvent;
+    expEvent.experience = static_cast<int>(qMin<qint64>(workInfo->experienceReward * cycles, std::numeric_limits<int>::max()));
+    EventMgr::GetInstance().SendEvent(expEvent);
 
-    if (adjustedRandom < 60)
+    const LootTable *table = getLootTable(workType, getWorkSystemLevel(workType));
+    if (!table)
     {
-        // 基础概率60%获得微光阳光 (ID=6, 普通)
-        sunshineId = 6;
-        count = rng->bounded(1, 4); // 1-3个
+        return;
     }
-    else if (adjustedRandom < 85)
+
+    // 批量抽样，只统计每种结果的次数，再折算为每种物品的总数
+    std::vector<uint64_t> hits;
+    table->drawCounts(*m_rng, static_cast<uint64_t>(cycles), hits);
+
+    QMap<int, qint64> totals;
+    const std::vector<LootTable::Outcome> &outcomes = table->outcomes();
+    for (size_t i = 0; i < outcomes.size(); ++i)
     {
-        // 25% 概率获得温暖阳光 (ID=7, 稀有)
-        sunshineId = 7;
-        count = rng->bounded(1, 3); // 1-2个
+        if (hits[i] > 0)
+        {
+            totals[outcomes[i].itemId] += static_cast<qint64>(hits[i]) * outcomes[i].count;
+        }
     }
-    else if (adjustedRandom < 97)
+
+    AddItemBatchEvent batchEvent;
+    for (auto it = totals.constBegin(); it != totals.constEnd(); ++it)
     {
-        // 12% 概率获得炽热阳光或灿烂阳光 (ID=8或9, 史诗)
-        sunshineId = rng->bounded(8, 10); // 8或9
-        count = 1;
+        AddItemEvent item;
+        item.itemId = it.key();
+        item.count = static_cast<int>(qMin<qint64>(it.value(), std::numeric_limits<int>::max()));
+        batchEvent.items.push_back(item);
+    }
+    EventMgr::GetInstance().SendEvent(batchEvent);
+}
+
+int WorkModel::catchUpOfflineProgress(qint64 nowMs) noexcept
+{
+    if (m_currentStatus != WorkStatus::Working)
+    {
+        return 0;
+    }
+
+    const WorkInfo *workInfo = getWorkInfo(m_currentWorkType);
+    if (!workInfo || workInfo->workDuration <= 0)
+    {
+        m_currentStatus = WorkStatus::Idle;
+        fireWorkStatusUpdate();
+        return 0;
+    }
+
+    const qint64 durationMs = static_cast<qint64>(workInfo->workDuration) * 1000;
+    qint64 elapsed = nowMs - m_cycleStartTime;
+    if (elapsed < 0)
+    {
+        elapsed = 0; // 系统时间被回拨，从现在重新计时
+    }
+
+    // 直接计算完成的周期数，不逐秒回放
+    qint64 cycles = elapsed / durationMs;
+    if (!m_continuousMode && cycles > 1)
+    {
+        cycles = 1;
+    }
+
+    if (cycles > 0)
+    {
+        qDebug() << "离线结算：" << workInfo->name << "完成" << cycles << "轮";
+        grantBatchRewards(m_currentWorkType, cycles);
+    }
+
+    if (m_continuousMode || cycles == 0)
+    {
+        // 继续当前周期，保留已经过去的进度
+        const qint64 progress = m_continuousMode ? elapsed % durationMs : elapsed;
+        startCycle(durationMs - progress);
+        emit workStarted(m_currentWorkType);
     }
     else
     {
-        // 3% 概率获得神圣阳光 (ID=10, 传说)
-        sunshineId = 10;
-        count = 1;
+        m_currentStatus = WorkStatus::Idle;
+        m_deadline = QDeadlineTimer();
+        emit workStopped();
     }
 
-    // 应用掉落率倍数
-    int finalCount = static_cast<int>(count * dropRateMultiplier);
-    if (finalCount < 1)
-        finalCount = 1;
+    fireWorkStatusUpdate();
+    return static_cast<int>(qMin<qint64>(cycles, std::numeric_limits<int>::max()));
+}
 
-    // 添加到奖励列表
-    for (int i = 0; i < finalCount; ++i)
+QJsonObject WorkModel::toJson() const
+{
+    QJsonObject json;
+    json["version"] = "1.0";
+    json["status"] = static_cast<int>(m_currentStatus);
+    json["workType"] = static_cast<int>(m_currentWorkType);
+    json["continuousMode"] = m_continuousMode;
+    json["cycleStartTime"] = static_cast<double>(m_cycleStartTime);
+
+    QJsonObject levelsJson;
+    for (auto it = m_workSystemLevels.constBegin(); it != m_workSystemLevels.constEnd(); ++it)
     {
-        rewards.append(sunshineId);
+        levelsJson[QString::number(static_cast<int>(it.key()))] = static_cast<int>(it.value());
     }
+    json["workSystemLevels"] = levelsJson;
+    return json;
+}
 
-    // 继续触发添加物品事件（保持向后兼容）
-    generateSunshine();
-    
-    return rewards;
+void WorkModel::fromJson(const QJsonObject &json)
+{
+    // 先恢复等级，离线结算要用对应等级的掉落表
+    QJsonObject levelsJson = json["workSystemLevels"].toObject();
+    for (auto it = levelsJson.constBegin(); it != levelsJson.constEnd(); ++it)
+    {
+        int level = it.value().toInt(static_cast<int>(WorkSystemLevel::Basic));
+        if (level >= static_cast<int>(WorkSystemLevel::Basic) && level <= static_cast<int>(WorkSystemLevel::Master))
+        {
+            setWorkSystemLevel(static_cast<WorkType>(it.key().toInt()), static_cast<WorkSystemLevel>(level));
+        }
+    }
+
+    WorkType workType = static_cast<WorkType>(json["workType"].toInt());
+    if (!getWorkInfo(workType))
+    {
+        return;
+    }
+
+    m_currentWorkType = workType;
+    m_currentStatus = static_cast<WorkStatus>(json["status"].toInt(static_cast<int>(WorkStatus::Idle)));
+    m_continuousMode = json["continuousMode"].toBool();
+    m_cycleStartTime = static_cast<qint64>(json["cycleStartTime"].toDouble());
+    m_deadline = QDeadlineTimer();
+    m_workTimer->stop();
 }
 
-QVector<int> WorkModel::generateMineralRewards()
+WorkModel::SaveSnapshot WorkModel::saveSnapshot() const
 {
-    QVector<int> rewards;
-    
-    // 继续触发添加物品事件（保持向后兼容）
-    generateMinerals();
-    
-    // 简化实现，可以后续完善
-    QRandomGenerator *rng = QRandomGenerator::global();
-    int mineralId = rng->bounded(11, 16); // 矿石ID范围：11-15
-    rewards.append(mineralId);
-    
-    return rewards;
+    return SaveSnapshot{m_currentStatus, m_currentWorkType, m_continuousMode, m_cycleStartTime, m_workSystemLevels};
 }
 
-QVector<int> WorkModel::generateWoodRewards()
+// 二进制存档字段：1 状态 2 打工类型 3 连续模式 4 周期开始时间（毫秒） 5 工作类型数组 6 对应等级数组
+void WorkModel::writeBinary(const SaveSnapshot &snapshot, BinaryWriter &out)
 {
-    QVector<int> rewards;
-    
-    // 继续触发添加物品事件（保持向后兼容）
-    generateWoods();
-    
-    // 简化实现，可以后续完善
-    QRandomGenerator *rng = QRandomGenerator::global();
-    int woodId = rng->bounded(16, 21); // 木材ID范围：16-20
-    rewards.append(woodId);
-    
-    return rewards;
-}
\ No newline at end of file
+    out.writeUInt(1, static_cast<uint64_t>(snapshot.status));
+    out.writeUInt(2, static_cast<uint64_t>(snapshot.workType));
+    out.writeBool(3, snapshot.continuousMode);
+    out.writeInt(4, snapshot.cycleStartTime);
+
+    std::vector<uint64_t> workTypes;
+    std::vector<uint64_t> levels;
+    for (auto it = snapshot.workSystemLevels.constBegin(); it != snapshot.workSystemLevels.constEnd(); ++it)
+    {
+        workTypes.push_back(static_cast<uint64_t>(it.key()));
+        levels.push_back(static_cast<uint64_t>(it.value()));
+    }
+    out.writePackedUInts(5, workTypes);
+    out.writePackedUInts(6, levels);
+}
+
+void WorkModel::readBinary(BinaryReader &in)
+{
+    WorkStatus status = WorkStatus::Idle;
+    WorkType workType = WorkType::Photosynthesis;
+    bool continuousMode = false;
+    qint64 cycleStartTime = 0;
+    std::vector<uint64_t> workTypes;
+    std::vector<uint64_t> levels;
+
+    while (in.next())
+    {
+        switch (in.field())
+        {
+        case 1: status = static_cast<WorkStatus>(in.readUInt()); break;
+        case 2: workType = static_cast<WorkType>(in.readUInt()); break;
+        case 3: continuousMode = in.readBool(); break;
+        case 4: cycleStartTime = in.readInt(); break;
+        case 5: in.readPackedUInts(workTypes); break;
+        case 6: in.readPackedUInts(levels); break;
+        default: break;
+        }
+    }
+    if (!in.isValid())
+    {
+        return;
+    }
+
+    // 与 fromJson 相同：先恢复等级，再恢复打工状态
+    for (size_t i = 0; i < workTypes.size() && i < levels.size(); ++i)
+    {
+        const int level = static_cast<int>(levels[i]);
+        if (level >= static_cast<int>(WorkSystemLevel::Basic) && level <= static_cast<int>(WorkSystemLevel::Master))
+        {
+            setWorkSystemLevel(static_cast<WorkType>(workTypes[i]), static_cast<WorkSystemLevel>(level));
+        }
+    }
+
+    if (!getWorkInfo(workType))
+    {
+        return;
+    }
+
+    m_currentWorkType = workType;
+    m_currentStatus = status;
+    m_continuousMode = continuousMode;
+    m_cycleStartTime = cycleStartTime;
+    m_deadline = QDeadlineTimer();
+    m_workTimer->stop();
+}
+
+void WorkModel::saveToFile(const QString &filename) const
+{
+    QString appDataPath = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
+    QDir dir(appDataPath);
+    if (!dir.exists())
+    {
+        dir.mkpath(appDataPath);
+    }
+
+    QFile file(appDataPath + "/" + filename);
+    if (file.open(QIODevice::WriteOnly))
+    {
+        file.write(QJsonDocument(toJson()).toJson());
+        file.close();
+    }
+    else
+    {
+        qDebug() << "无法保存打工数据:" << file.fileName();
+    }
+}
+
+void WorkModel::loadFromFile(const QString &filename)
+{
+    QString appDataPath = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
+    QFile file(appDataPath + "/" + filename);
+    if (!file.open(QIODevice::ReadOnly))
+    {
+        return; // 文件不存在，使用默认值
+    }
+
+    QJsonDocument doc = QJsonDocument::fromJson(file.readAll());
+    file.close();
+
+    if (!doc.isObject())
+    {
+        qDebug() << "打工数据JSON格式错误";
+        return;
+    }
+    fromJson(doc.object());
+}
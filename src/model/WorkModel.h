@@ -2,10 +2,15 @@
 #define WORKMODEL_H
 
 #include "../common/PropertyTrigger.h"
+#include "../common/BinaryCodec.h"
 #include "../common/PropertyIds.h"
 #include "../common/Types.h"
 #include "../common/base/WorkInfo.h"
+#include "../common/RandomService.h"
+#include "LootTable.h"
+#include "LootTableLoader.h"
 #include <QTimer>
+#include <QDeadlineTimer>
 #include <QObject>
 #include <QJsonObject>
 #include <QJsonArray>
@@ -49,10 +54,21 @@ public:
         return m_currentWorkType;
     }
 
-    // 获取剩余工作时间
+    // 获取剩余工作时间(秒)，按截止时间即时计算
     int getRemainingTime() const noexcept
     {
-        return m_remainingTime;
+        return static_cast<int>((getRemainingTimeMs() + 999) / 1000);
+    }
+
+    qint64 getRemainingTimeMs() const noexcept
+    {
+        return m_currentStatus == WorkStatus::Working ? m_deadline.remainingTime() : 0;
+    }
+
+    // 当前周期的截止时间（单调时钟），界面据此自行绘制进度
+    QDeadlineTimer getDeadline() const noexcept
+    {
+        return m_deadline;
     }
 
     // 是否处于连续工作模式
@@ -77,8 +93,61 @@ public:
     // 获取当前工作系统的加成效果
     float getDropRateMultiplier(WorkType workType) const noexcept;
     float getQualityBonus(WorkType workType) const noexcept;
+    float getDropRateMultiplier(WorkType workType, WorkSystemLevel level) const noexcept;
+    float getQualityBonus(WorkType workType, WorkSystemLevel level) const noexcept;
     QVector<int> getUnlockedItems(WorkType workType) const noexcept;
 
+    // 掉落表
+    void loadLootTablesFromCSV(const QString &csvPath);
+    const LootTable *getLootTable(WorkType workType, WorkSystemLevel level) const noexcept;
+    const LootTableRows &getLootRows() const noexcept
+    {
+        return m_lootRows;
+    }
+    LootDrop drawLoot(WorkType workType, RandomEngine &rng) const noexcept; // 按当前等级抽取一次掉落
+
+    // 离线结算：按墙钟时间直接算出错过的完整周期数，批量发放奖励，返回结算的周期数
+    int catchUpOfflineProgress(qint64 nowMs) noexcept;
+
+    // 数据持久化（打工状态、周期开始时间和工作系统等级）
+    QJsonObject toJson() const;
+    void fromJson(const QJsonObject &json);
+    void readBinary(BinaryReader &in);
+
+    // 存档快照：等级表隐式共享，复制只增加引用计数，可以交给后台线程序列化
+    struct SaveSnapshot
+    {
+        WorkStatus status;
+        WorkType workType;
+        bool continuousMode;
+        qint64 cycleStartTime;
+        QMap<WorkType, WorkSystemLevel> workSystemLevels;
+    };
+    SaveSnapshot saveSnapshot() const;
+    static void writeBinary(const SaveSnapshot &snapshot, BinaryWriter &out);
+    void writeBinary(BinaryWriter &out) const
+    {
+        writeBinary(saveSnapshot(), out);
+    }
+
+    // 自上次存档以来打工状态或等级是否被修改
+    bool isDirty() const noexcept
+    {
+        return m_dirty;
+    }
+    void clearDirty() noexcept
+    {
+        m_dirty = false;
+    }
+    void saveToFile(const QString &filename) const;
+    void loadFromFile(const QString &filename);
+
+    // 注入随机数引擎（默认使用RandomService的打工流），用于测试和模拟回放
+    void setRandomEngine(RandomEngine *engine) noexcept
+    {
+        m_rng = engine ? engine : &RandomService::GetInstance().stream(RandomStream::Work);
+    }
+
 signals:
     void workSystemLevelChanged(WorkType workType, WorkSystemLevel newLevel);
     void workCompleted(WorkType workType, const QVector<int>& rewards);
@@ -92,14 +161,14 @@ private:
     void initializeWorkTypes();
     void initializeWorkSystemBonuses(); // 初始化工作系统加成效果
     void fireWorkStatusUpdate();
-    void generateSunshine(); // 生成随机阳光物品
-    void generateMinerals(); // 生成随机矿石物品
-    void generateWoods();    // 生成随机木头物品
-    
-    // 新增方法：返回奖励物品ID而不是直接添加到背包
-    QVector<int> generateSunshineRewards();
-    QVector<int> generateMineralRewards();
-    QVector<int> generateWoodRewards();
+    void rebuildLootTables(); // 按等级加成编译掉落表
+    void startCycle(qint64 durationMs); // 开始（或继续）一个周期，剩余durationMs毫秒
+
+    // 生成一次打工奖励（发送添加物品事件并返回奖励物品ID）
+    QVector<int> generateRewards(WorkType workType);
+
+    // 一次性发放多轮打工的经验和物品（批量抽样，背包和经验各更新一次）
+    void grantBatchRewards(WorkType workType, qint64 cycles);
 
 private:
     QVector<WorkInfo> m_workTypes; // 所有打工类型
@@ -107,10 +176,13 @@ private:
 
     WorkStatus m_currentStatus; // 当前打工状态
     WorkType m_currentWorkType; // 当前打工类型
-    int m_remainingTime;        // 剩余工作时间(秒)
+    QDeadlineTimer m_deadline;  // 当前周期的截止时间（单调时钟）
     bool m_continuousMode;      // 连续工作模式
+    qint64 m_cycleStartTime;    // 当前周期开始的墙钟时间(毫秒)，用于离线结算
+    bool m_dirty = false;       // 有未保存的修改
 
-    QTimer *m_workTimer; // 工作定时器
+    QTimer *m_workTimer; // 周期完成定时器（单次触发）
+    RandomEngine *m_rng; // 奖励随机数引擎（不持有）
 
     // 工作系统等级数据
     QMap<WorkType, WorkSystemLevel> m_workSystemLevels;
@@ -123,6 +195,10 @@ private:
         QVector<int> unlockedItems;
     };
     QMap<WorkType, QMap<WorkSystemLevel, WorkSystemBonus>> m_workSystemBonuses;
+
+    // 掉落表配置和按等级编译后的别名表
+    LootTableRows m_lootRows;
+    QMap<WorkType, QMap<WorkSystemLevel, LootTable>> m_lootTables;
 };
 
 #endif // WORKMODEL_H
\ No newline at end of file
@@ -0,0 +1,189 @@
+#include "X11DesktopObstacleProvider.h"
+
+#ifdef DESKTOPPET_HAVE_X11
+
+#include <QDebug>
+#include <unistd.h>
+// Xlib 定义了 None/Bool/Status 等宏，放在 Qt 头文件之后包含
+#include <X11/Xatom.h>
+#include <X11/Xlib.h>
+#include <X11/Xutil.h>
+
+namespace {
+
+// 读取窗口上的 32 位属性（CARDINAL/WINDOW/ATOM 数组），失败时返回空
+std::vector<unsigned long> readLongProperty(Display* display, Window window, Atom property, Atom type)
+{
+    std::vector<unsigned long> values;
+    Atom actualType = 0;
+    int actualFormat = 0;
+    unsigned long count = 0;
+    unsigned long bytesAfter = 0;
+    unsigned char* data = nullptr;
+    if (XGetWindowProperty(display, window, property, 0, 1 << 16, False, type, &actualType,
+                           &actualFormat, &count, &bytesAfter, &data) == Success && data) {
+        if (actualType == type && actualFormat == 32) {
+            // 格式为32时 Xlib 按 long 存放
+            const unsigned long* items = reinterpret_cast<const unsigned long*>(data);
+            values.assign(items, items + count);
+        }
+        XFree(data);
+    }
+    return values;
+}
+
+QString windowTitle(Display* display, Window window)
+{
+    char* name = nullptr;
+    QString title;
+    if (XFetchName(display, window, &name) && name) {
+        title = QString::fromLocal8Bit(name);
+        XFree(name);
+    }
+    return title;
+}
+
+// 枚举期间窗口随时可能被关闭，之后对它的请求会返回 BadWindow/BadMatch，
+// 而 Xlib 默认的错误处理函数会直接结束进程；整个枚举期间换成只记录这两类错误的处理函数
+bool s_requestFailed = false;
+XErrorHandler s_previousHandler = nullptr;
+
+int recordWindowError(Display* display, XErrorEvent* event)
+{
+    if (event->error_code == BadWindow || event->error_code == BadMatch) {
+        s_requestFailed = true;
+        return 0;
+    }
+    return s_previousHandler ? s_previousHandler(display, event) : 0;
+}
+
+class ScopedErrorHandler
+{
+public:
+    explicit ScopedErrorHandler(Display* display)
+        : m_display(display)
+    {
+        XSync(m_display, False);
+        s_requestFailed = false;
+        s_previousHandler = XSetErrorHandler(recordWindowError);
+    }
+
+    ~ScopedErrorHandler()
+    {
+        // 先等服务器处理完已发出的请求，迟到的错误仍由这里的处理函数接收
+        XSync(m_display, False);
+        XSetErrorHandler(s_previousHandler);
+        s_previousHandler = nullptr;
+    }
+
+    ScopedErrorHandler(const ScopedErrorHandler&) = delete;
+    ScopedErrorHandler& operator=(const ScopedErrorHandler&) = delete;
+
+    // 返回并清除上次调用以来是否有请求失败；用到的查询都会等待回复，错误在返回前已经交给处理函数
+    bool takeFailed()
+    {
+        const bool failed = s_requestFailed;
+        s_requestFailed = false;
+        return failed;
+    }
+
+private:
+    Display* m_display;
+};
+
+} // namespace
+
+X11DesktopObstacleProvider::X11DesktopObstacleProvider()
+    : m_display(XOpenDisplay(nullptr))
+{
+}
+
+X11DesktopObstacleProvider::~X11DesktopObstacleProvider()
+{
+    if (m_display) {
+        XCloseDisplay(m_display);
+    }
+}
+
+QVector<DesktopIconInfo> X11DesktopObstacleProvider::enumerate()
+{
+    QVector<DesktopIconInfo> obstacles;
+    if (!m_display) {
+        return obstacles;
+    }
+
+    ScopedErrorHandler errors(m_display);
+    const Window root = DefaultRootWindow(m_display);
+    const Atom clientListAtom = XInternAtom(m_display, "_NET_CLIENT_LIST_STACKING", False);
+    const Atom pidAtom = XInternAtom(m_display, "_NET_WM_PID", False);
+    const Atom typeAtom = XInternAtom(m_display, "_NET_WM_WINDOW_TYPE", False);
+    const Atom desktopTypeAtom = XInternAtom(m_display, "_NET_WM_WINDOW_TYPE_DESKTOP", False);
+    const Atom dockTypeAtom = XInternAtom(m_display, "_NET_WM_WINDOW_TYPE_DOCK", False);
+
+    std::vector<unsigned long> windows = readLongProperty(m_display, root, clientListAtom, XA_WINDOW);
+    if (windows.empty()) {
+        // 没有 EWMH 窗口管理器：直接取根窗口的子窗口
+        Window rootReturn = 0;
+        Window parentReturn = 0;
+        Window* children = nullptr;
+        unsigned int childCount = 0;
+        if (XQueryTree(m_display, root, &rootReturn, &parentReturn, &children, &childCount)) {
+            windows.assign(children, children + childCount);
+            if (children) {
+                XFree(children);
+            }
+        }
+    }
+
+    const unsigned long ownPid = static_cast<unsigned long>(getpid());
+    for (unsigned long window : windows) {
+        // 前一个窗口提前跳过时可能留下错误标记，每个窗口单独判断
+        errors.takeFailed();
+        XWindowAttributes attributes;
+        if (!XGetWindowAttributes(m_display, window, &attributes) || attributes.map_state != IsViewable) {
+            continue;
+        }
+
+        const std::vector<unsigned long> pid = readLongProperty(m_display, window, pidAtom, XA_CARDINAL);
+        if (!pid.empty() && pid[0] == ownPid) {
+            continue;
+        }
+        bool skip = false;
+        for (unsigned long type : readLongProperty(m_display, window, typeAtom, XA_ATOM)) {
+            skip = skip || type == desktopTypeAtom || type == dockTypeAtom;
+        }
+        if (skip) {
+            continue;
+        }
+
+        // 窗口坐标相对父窗口（通常是窗口管理器的边框），换算到根窗口坐标
+        int rootX = 0;
+        int rootY = 0;
+        Window child = 0;
+        XTranslateCoordinates(m_display, window, root, 0, 0, &rootX, &rootY, &child);
+
+        DesktopIconInfo obstacle;
+        obstacle.rect = QRect(rootX, rootY, attributes.width, attributes.height);
+        obstacle.text = windowTitle(m_display, window);
+        if (errors.takeFailed()) {
+            // 查询途中窗口被关闭，得到的位置和标题不可信
+            continue;
+        }
+        obstacle.id = window;
+        obstacle.index = obstacles.size();
+        obstacle.isVisible = true;
+        obstacles.append(obstacle);
+    }
+    return obstacles;
+}
+
+std::unique_ptr<IDesktopObstacleProvider> createX11ObstacleProvider()
+{
+    auto provider = std::make_unique<X11DesktopObstacleProvider>();
+    if (!provider->isConnected()) {
+        return nullptr;
+    }
+    return provider;
+}
+
+#endif // DESKTOPPET_HAVE_X11
@@ -0,0 +1,41 @@
+#ifndef __X11_DESKTOP_OBSTACLE_PROVIDER_H__
+#define __X11_DESKTOP_OBSTACLE_PROVIDER_H__
+
+#include "DesktopObstacleProvider.h"
+
+#ifdef DESKTOPPET_HAVE_X11
+
+typedef struct _XDisplay Display;
+
+/**
+ * Linux/X11 障碍物来源：把其他程序的顶层窗口当作障碍物
+ * 优先读取窗口管理器维护的 _NET_CLIENT_LIST_STACKING，不支持 EWMH 时退回 XQueryTree 遍历根窗口的子窗口
+ * 特意用堆叠顺序而不是 _NET_CLIENT_LIST 的映射顺序：两种来源都是从底到顶排列，障碍物的 index 与窗口层次一致
+ * 跳过本进程的窗口、未映射的窗口以及桌面/停靠栏类型的窗口
+ * 使用独立的 X 连接，不依赖 Qt 当前使用的平台插件
+ */
+class X11DesktopObstacleProvider : public IDesktopObstacleProvider
+{
+public:
+    // 连接失败时 isConnected() 为 false，enumerate() 返回空列表
+    X11DesktopObstacleProvider();
+    ~X11DesktopObstacleProvider() override;
+
+    X11DesktopObstacleProvider(const X11DesktopObstacleProvider&) = delete;
+    X11DesktopObstacleProvider& operator=(const X11DesktopObstacleProvider&) = delete;
+
+    bool isConnected() const { return m_display != nullptr; }
+
+    const char* name() const override { return "x11"; }
+    QVector<DesktopIconInfo> enumerate() override;
+
+private:
+    Display* m_display;
+};
+
+// 连接不上显示服务器时返回 nullptr
+std::unique_ptr<IDesktopObstacleProvider> createX11ObstacleProvider();
+
+#endif // DESKTOPPET_HAVE_X11
+
+#endif // __X11_DESKTOP_OBSTACLE_PROVIDER_H__
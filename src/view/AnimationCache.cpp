@@ -0,0 +1,171 @@
+#include "AnimationCache.h"
+#include "../common/SpriteSheet.h"
+#include <QImage>
+#include <QImageReader>
+#include <QDebug>
+#include <algorithm>
+
+namespace
+{
+
+// 没有写帧时长或时长为0的 GIF 按10毫秒处理，避免定时器空转
+const int MIN_FRAME_DELAY = 10;
+
+bool readImage(const QString &path, QVector<QImage> &images, QVector<int> &delays, int &loopCount)
+{
+    QImageReader reader(path);
+    loopCount = reader.loopCount();
+    QImage image;
+    while (reader.read(&image))
+    {
+        images.append(image);
+        delays.append(std::max(MIN_FRAME_DELAY, reader.nextImageDelay()));
+        if (!reader.supportsAnimation())
+        {
+            break;
+        }
+    }
+    if (images.isEmpty())
+    {
+        qDebug() << "Failed to decode animation" << path << ":" << reader.errorString();
+        return false;
+    }
+    return true;
+}
+
+// 精灵图集：读一次图集，按帧表切出每一帧
+bool readSpriteSheet(const QString &path, QVector<QImage> &images, QVector<int> &delays, int &loopCount)
+{
+    SpriteSheet sheet;
+    if (!SpriteSheet::load(path, sheet))
+    {
+        return false;
+    }
+    const QImage atlas(sheet.imagePath);
+    if (atlas.isNull())
+    {
+        qDebug() << "Failed to load sprite atlas" << sheet.imagePath;
+        return false;
+    }
+    for (const SpriteFrame &frame : sheet.frames)
+    {
+        if (!atlas.rect().contains(frame.rect))
+        {
+            qDebug() << "Sprite frame" << frame.rect << "is outside atlas" << sheet.imagePath;
+            images.clear();
+            delays.clear();
+            return false;
+        }
+        images.append(atlas.copy(frame.rect));
+        delays.append(std::max(MIN_FRAME_DELAY, frame.duration));
+    }
+    loopCount = sheet.loopCount;
+    return true;
+}
+
+// 两帧（同为预乘 ARGB32）之间像素不同的最小矩形；大小不同时取两者的并
+QRect changedRect(const QImage &from, const QImage &to)
+{
+    if (from.size() != to.size())
+    {
+        return from.rect().united(to.rect());
+    }
+    int left = to.width();
+    int right = -1;
+    int top = -1;
+    int bottom = -1;
+    for (int y = 0; y < to.height(); ++y)
+    {
+        const uint32_t *a = reinterpret_cast<const uint32_t *>(from.constScanLine(y));
+        const uint32_t *b = reinterpret_cast<const uint32_t *>(to.constScanLine(y));
+        int first = 0;
+        while (first < to.width() && a[first] == b[first])
+        {
+            ++first;
+        }
+        if (first == to.width())
+        {
+            continue;
+        }
+        int last = to.width() - 1;
+        while (a[last] == b[last])
+        {
+            --last;
+        }
+        left = std::min(left, first);
+        right = std::max(right, last);
+        top = top < 0 ? y : top;
+        bottom = y;
+    }
+    return top < 0 ? QRect() : QRect(left, top, right - left + 1, bottom - top + 1);
+}
+
+} // namespace
+
+int AnimationFrames::frameAt(qint64 elapsedMs) const noexcept
+{
+    if (frames.size() <= 1 || totalDuration <= 0)
+    {
+        return 0;
+    }
+    if (loopCount >= 0 && elapsedMs >= qint64(totalDuration) * (loopCount + 1))
+    {
+        return frames.size() - 1;
+    }
+    int t = int(elapsedMs % totalDuration);
+    for (int i = 0; i < delays.size(); ++i)
+    {
+        if (t < delays[i])
+        {
+            return i;
+        }
+        t -= delays[i];
+    }
+    return frames.size() - 1;
+}
+
+std::shared_ptr<const AnimationFrames> AnimationCache::get(const QString &path, const QSize &targetSize)
+{
+    const ImageKey key{path, targetSize.isValid() ? targetSize : QSize()};
+    if (const auto *cached = m_cache.find(key))
+    {
+        return *cached;
+    }
+
+    std::shared_ptr<const AnimationFrames> animation = decode(path, key.size);
+    m_cache.insert(key, animation, animation->bytes);
+    return animation;
+}
+
+std::shared_ptr<const AnimationFrames> AnimationCache::decode(const QString &path, const QSize &targetSize)
+{
+    auto animation = std::make_shared<AnimationFrames>();
+    QVector<QImage> images;
+    if (!(SpriteSheet::isSpriteSheetPath(path) ? readSpriteSheet(path, images, animation->delays, animation->loopCount)
+                                               : readImage(path, images, animation->delays, animation->loopCount)))
+    {
+        animation->delays.clear();
+        return animation;
+    }
+
+    // 缩放并统一转换为预乘 ARGB32：光栅绘制时直接混合，不需要每次绘制再转换
+    for (QImage &image : images)
+    {
+        if (targetSize.isValid() && image.size() != targetSize)
+        {
+            image = image.scaled(targetSize, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+        }
+        image = image.convertToFormat(QImage::Format_ARGB32_Premultiplied);
+    }
+
+    for (int i = 0; i < images.size(); ++i)
+    {
+        const QImage &image = images[i];
+        const QImage &previous = images[i == 0 ? images.size() - 1 : i - 1];
+        animation->changed.append(images.size() == 1 ? image.rect() : changedRect(previous, image));
+        animation->frames.append(QPixmap::fromImage(image));
+        animation->totalDuration += animation->delays[i];
+        animation->bytes += image.sizeInBytes();
+    }
+    return animation;
+}
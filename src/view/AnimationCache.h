@@ -0,0 +1,61 @@
+#ifndef __ANIMATION_CACHE_H__
+#define __ANIMATION_CACHE_H__
+
+#include <QPixmap>
+#include <QRect>
+#include <QSize>
+#include <QString>
+#include <QVector>
+#include <cstdint>
+#include <memory>
+#include "../common/LruCache.h"
+#include "../common/Singleton.h"
+#include "ImageKey.h"
+
+// 解码好的一个动画（静态图片是只有一帧的动画），每帧已按目标大小缩放好并转换为预乘 ARGB，绘制时不再转换格式
+struct AnimationFrames
+{
+    QVector<QPixmap> frames;
+    QVector<int> delays;   // 每帧显示的毫秒数
+    QVector<QRect> changed; // 每帧相对上一帧有变化的区域（帧坐标），第0帧相对最后一帧；换帧时只重绘这块
+    int totalDuration = 0; // 播放一轮的总毫秒数
+    int loopCount = -1;    // 与 QMovie 一致：-1 无限循环，n 表示首轮之后再重复 n 次
+    int64_t bytes = 0;     // 所有帧占用的内存
+
+    bool isEmpty() const noexcept { return frames.isEmpty(); }
+    bool isAnimated() const noexcept { return frames.size() > 1; }
+
+    // 开始播放后经过 elapsedMs 毫秒时应显示的帧；有限循环播完后停在最后一帧
+    int frameAt(qint64 elapsedMs) const noexcept;
+};
+
+// 动画帧缓存：按 (路径, 目标大小) 缓存解码并缩放好的全部帧，切换动画时不再重新解码 GIF、重新缩放图片
+// 路径可以是 GIF/静态图片，也可以是精灵图集的 JSON 帧表（见 SpriteSheet）
+// 总内存超过预算时淘汰最久未用的动画；缓存返回 shared_ptr，正在播放的动画被淘汰后仍然有效
+// QPixmap 只能在 GUI 线程使用，缓存也只在 GUI 线程访问
+class AnimationCache : public Singleton<AnimationCache>
+{
+    friend class Singleton<AnimationCache>;
+
+public:
+    static constexpr int64_t DEFAULT_BUDGET = 64 * 1024 * 1024;
+
+    // targetSize 无效时保持原始大小，否则保持宽高比缩放到 targetSize 以内
+    // 读取失败返回空动画（同样会被缓存，不会反复尝试）
+    std::shared_ptr<const AnimationFrames> get(const QString &path, const QSize &targetSize = QSize());
+
+    void setBudget(int64_t bytes) { m_cache.setBudget(bytes); }
+    int64_t usedBytes() const noexcept { return m_cache.usedBytes(); }
+    int64_t hits() const noexcept { return m_cache.hits(); }
+    int64_t misses() const noexcept { return m_cache.misses(); }
+    void clear() { m_cache.clear(); }
+
+    static std::shared_ptr<const AnimationFrames> decode(const QString &path, const QSize &targetSize);
+
+private:
+    AnimationCache() : m_cache(DEFAULT_BUDGET) {}
+
+    LruCache<ImageKey, std::shared_ptr<const AnimationFrames>, ImageKeyHash> m_cache;
+};
+
+#endif
@@ -6,10 +6,10 @@
 #include <QGroupBox>
 #include <QMouseEvent>
 #include <QDebug>
-#include <QPixmapCache>
+#include "ImageLoader.h"
 
-// 静态图片缓存
-static QHash<QString, QPixmap> s_iconCache;
+// 背包图标的显示大小
+static const QSize ICON_SIZE(50, 50);
 
 // ===================== ItemSlot 实现 =====================
 
@@ -70,27 +70,25 @@ void ItemSlot::setItem(const BackpackItemInfo &item, const ItemDisplayInfo &disp
     m_itemCategory = displayInfo.category;
     m_itemRarity = displayInfo.rarity;
 
-    // 设置图标 - 使用缓存优化加载
-    QPixmap pixmap;
-    
-    // 先检查缓存
-    if (s_iconCache.contains(displayInfo.iconPath)) {
-        pixmap = s_iconCache.value(displayInfo.iconPath);
-    } else {
-        // 加载并缓存图片
-        pixmap = QPixmap(displayInfo.iconPath);
-        if (!pixmap.isNull()) {
-            // 预先缩放并缓存
-            pixmap = pixmap.scaled(50, 50, Qt::KeepAspectRatio, Qt::SmoothTransformation);
-            s_iconCache.insert(displayInfo.iconPath, pixmap);
+    // 设置图标 - 后台解码并缩放，未加载完成前显示占位符
+    if (m_iconPath != displayInfo.iconPath || m_iconLabel->pixmap().isNull()) {
+        m_iconPath = displayInfo.iconPath;
+        const QString path = displayInfo.iconPath;
+        const bool ready = ImageLoader::GetInstance().load(path, ICON_SIZE, this, [this, path](const QPixmap &pixmap) {
+            // 解码期间格子可能已换成别的物品
+            if (m_iconPath != path) {
+                return;
+            }
+            if (!pixmap.isNull()) {
+                m_iconLabel->setPixmap(pixmap);
+            } else {
+                m_iconLabel->setText(path);
+            }
+        });
+        if (!ready) {
+            m_iconLabel->setText("…");
         }
     }
-    
-    if (!pixmap.isNull()) {
-        m_iconLabel->setPixmap(pixmap);
-    } else {
-        m_iconLabel->setText(displayInfo.iconPath);
-    }
 
     // 设置数量 - 改进数量显示
     if (m_itemCount > 1)
@@ -118,6 +116,7 @@ void ItemSlot::clearItem()
     m_itemDescription.clear();
     m_itemCategory.clear();
     m_itemRarity.clear();
+    m_iconPath.clear();
     m_iconLabel->clear();
     m_countLabel->hide();
     setToolTip("");
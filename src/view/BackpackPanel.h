@@ -62,6 +62,7 @@ private:
     QString m_itemDescription;
     QString m_itemCategory;
     QString m_itemRarity;
+    QString m_iconPath; // 当前显示（或正在加载）的图标
     
     static const int GRID_SIZE = 5;
 };
@@ -1,7 +1,12 @@
 #include "CollectionItemWidget.h"
 #include <QPainterPath>
+#include <QStyle>
 #include <QToolTip>
 #include <QEnterEvent>
+#include "ImageLoader.h"
+
+// 图标区域：控件四周各留 8 像素
+static const int ICON_MARGIN = 8;
 
 CollectionItemWidget::CollectionItemWidget(const CollectionItemInfo &info, QWidget *parent)
     : QWidget(parent)
@@ -12,22 +17,7 @@ CollectionItemWidget::CollectionItemWidget(const CollectionItemInfo &info, QWidg
     setFixedSize(WIDGET_SIZE, WIDGET_SIZE);
     setMouseTracking(true);
     
-    // 加载图标
-    if (!m_info.iconPath.isEmpty()) {
-        m_iconPixmap = QPixmap(m_info.iconPath);
-        if (m_iconPixmap.isNull()) {
-            qDebug() << "无法加载图标:" << m_info.iconPath << "，尝试使用备用图片";
-            // 尝试使用测试图片作为备用
-            m_iconPixmap = QPixmap(":/resources/img/Test1.png");
-            if (m_iconPixmap.isNull()) {
-                qDebug() << "备用图片也无法加载";
-            }
-        } else {
-            qDebug() << "成功加载图标:" << m_info.iconPath;
-        }
-    }
-    
-    // 设置工具提示
+    // 设置工具提示并加载图标
     updateInfo(info);
 }
 
@@ -36,13 +26,12 @@ void CollectionItemWidget::updateInfo(const CollectionItemInfo &info)
     m_info = info;
     m_needsRepaint = true;
     
-    // 重新加载图标
-    if (!m_info.iconPath.isEmpty()) {
-        m_iconPixmap = QPixmap(m_info.iconPath);
-        if (m_iconPixmap.isNull()) {
-            qDebug() << "更新时无法加载图标:" << m_info.iconPath;
-            // 尝试使用测试图片作为备用
-            m_iconPixmap = QPixmap(":/resources/img/Test1.png");
+    // 图标变化时重新加载（后台解码，完成前绘制名称占位）
+    if (m_info.iconPath != m_iconPath) {
+        m_iconPath = m_info.iconPath;
+        m_iconPixmap = QPixmap();
+        if (!m_iconPath.isEmpty()) {
+            loadIcon(m_iconPath);
         }
     }
     
@@ -75,6 +64,27 @@ void CollectionItemWidget::updateInfo(const CollectionItemInfo &info)
     update();
 }
 
+void CollectionItemWidget::loadIcon(const QString &path)
+{
+    const QSize iconSize(WIDGET_SIZE - 2 * ICON_MARGIN, WIDGET_SIZE - 2 * ICON_MARGIN);
+    const QString iconPath = m_iconPath;
+    ImageLoader::GetInstance().load(path, iconSize, this, [this, path, iconPath](const QPixmap &pixmap) {
+        // 加载期间图标可能已经换了
+        if (iconPath != m_iconPath) {
+            return;
+        }
+        if (pixmap.isNull() && path != FALLBACK_ICON) {
+            qDebug() << "无法加载图标:" << path << "，尝试使用备用图片";
+            // 尝试使用测试图片作为备用
+            loadIcon(FALLBACK_ICON);
+            return;
+        }
+        m_iconPixmap = pixmap;
+        m_needsRepaint = true;
+        update();
+    });
+}
+
 void CollectionItemWidget::paintEvent(QPaintEvent *event)
 {
     Q_UNUSED(event)
@@ -141,7 +151,9 @@ void CollectionItemWidget::drawBackground(QPainter &painter)
 
 void CollectionItemWidget::drawIcon(QPainter &painter)
 {
-    QRect iconRect = this->rect().adjusted(8, 8, -8, -8);
+    QRect iconRect = this->rect().adjusted(ICON_MARGIN, ICON_MARGIN, -ICON_MARGIN, -ICON_MARGIN);
+    // 图标已按比例缩放到图标区域以内，居中绘制
+    const QRect pixmapRect = QStyle::alignedRect(layoutDirection(), Qt::AlignCenter, m_iconPixmap.size(), iconRect);
     
     if (m_info.status == CollectionStatus::Unknown) {
         // 未发现状态：绘制问号
@@ -152,7 +164,7 @@ void CollectionItemWidget::drawIcon(QPainter &painter)
         // 已发现状态：半透明显示
         if (!m_iconPixmap.isNull()) {
             painter.setOpacity(0.5);
-            painter.drawPixmap(iconRect, m_iconPixmap.scaled(iconRect.size(), Qt::KeepAspectRatio, Qt::SmoothTransformation));
+            painter.drawPixmap(pixmapRect, m_iconPixmap);
             painter.setOpacity(1.0);
         } else {
             // 没有图标时显示占位符
@@ -163,7 +175,7 @@ void CollectionItemWidget::drawIcon(QPainter &painter)
     } else {
         // 已收集状态：完整显示
         if (!m_iconPixmap.isNull()) {
-            painter.drawPixmap(iconRect, m_iconPixmap.scaled(iconRect.size(), Qt::KeepAspectRatio, Qt::SmoothTransformation));
+            painter.drawPixmap(pixmapRect, m_iconPixmap);
         } else {
             // 没有图标时显示占位符
             painter.setPen(QPen(QColor(80, 80, 80), 1));
@@ -40,10 +40,14 @@ private:
     
     QColor getRarityColor(CollectionRarity rarity) const;
     QPixmap getStatusIcon(CollectionStatus status) const;
+    void loadIcon(const QString &path);
+
+    static constexpr const char *FALLBACK_ICON = ":/resources/img/Test1.png";
     
     CollectionItemInfo m_info;
     bool m_isHovered;
-    QPixmap m_iconPixmap;
+    QString m_iconPath;   // 当前图标路径，异步加载回来时用来判断是否已过期
+    QPixmap m_iconPixmap; // 已缩放到图标区域大小，加载完成前为空
     QPixmap m_cachedPixmap;
     bool m_needsRepaint;
 };
@@ -0,0 +1,26 @@
+#ifndef __IMAGE_KEY_H__
+#define __IMAGE_KEY_H__
+
+#include <QHash>
+#include <QSize>
+#include <QString>
+#include <cstdint>
+
+// 解码缓存的键：图片路径 + 缩放目标大小（无效大小表示原始大小）
+struct ImageKey
+{
+    QString path;
+    QSize size;
+
+    bool operator==(const ImageKey &other) const { return path == other.path && size == other.size; }
+};
+
+struct ImageKeyHash
+{
+    size_t operator()(const ImageKey &key) const noexcept
+    {
+        return qHash(key.path) ^ (size_t(uint32_t(key.size.width())) * 31 + size_t(uint32_t(key.size.height())));
+    }
+};
+
+#endif
@@ -0,0 +1,101 @@
+#include "ImageLoader.h"
+#include <QImageReader>
+#include <QMetaObject>
+#include <QThread>
+#include <QDebug>
+
+ImageLoader::ImageLoader()
+    : m_cache(DEFAULT_BUDGET)
+{
+    // 解码线程不占满所有核心，给 GUI 线程和自动存档留出余量
+    m_pool.setMaxThreadCount(qMax(1, QThread::idealThreadCount() / 2));
+}
+
+ImageLoader::~ImageLoader()
+{
+    m_pool.clear();
+    m_pool.waitForDone();
+}
+
+bool ImageLoader::load(const QString &path, const QSize &size, QObject *receiver, Callback callback)
+{
+    if (m_shutDown)
+    {
+        return false;
+    }
+
+    const ImageKey key{path, size.isValid() ? size : QSize()};
+    if (const QPixmap *pixmap = m_cache.find(key))
+    {
+        callback(*pixmap);
+        return true;
+    }
+
+    auto pending = m_pending.find(key);
+    if (pending != m_pending.end())
+    {
+        pending->second.push_back({receiver, std::move(callback)});
+        return false;
+    }
+    m_pending[key].push_back({receiver, std::move(callback)});
+
+    m_pool.start([this, key]() {
+        const QImage image = decode(key.path, key.size);
+        QMetaObject::invokeMethod(&m_context, [this, key, image]() { deliver(key, image); }, Qt::QueuedConnection);
+    });
+    return false;
+}
+
+void ImageLoader::shutdown()
+{
+    m_shutDown = true;
+    m_pool.clear();
+    m_pool.waitForDone();
+    m_pending.clear();
+    m_cache.clear();
+}
+
+QImage ImageLoader::decode(const QString &path, const QSize &size)
+{
+    QImageReader reader(path);
+    QImage image;
+    if (!reader.read(&image))
+    {
+        qDebug() << "无法加载图片:" << path << reader.errorString();
+        return QImage();
+    }
+    if (size.isValid() && image.size() != size)
+    {
+        image = image.scaled(size, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+    }
+    // 与窗口缓冲区格式一致，转成 QPixmap 和绘制时都不需要再转换
+    return image.convertToFormat(QImage::Format_ARGB32_Premultiplied);
+}
+
+void ImageLoader::deliver(const ImageKey &key, const QImage &image)
+{
+    // 关闭前已经投递、关闭后才执行的结果：不能再往清空的缓存里放 QPixmap
+    if (m_shutDown)
+    {
+        return;
+    }
+
+    // 读取失败的结果同样缓存，避免每次打开面板都重试
+    const QPixmap pixmap = QPixmap::fromImage(image);
+    m_cache.insert(key, pixmap, image.sizeInBytes());
+
+    auto pending = m_pending.find(key);
+    if (pending == m_pending.end())
+    {
+        return;
+    }
+    std::vector<Waiter> waiters = std::move(pending->second);
+    m_pending.erase(pending);
+    for (Waiter &waiter : waiters)
+    {
+        if (waiter.receiver)
+        {
+            waiter.callback(pixmap);
+        }
+    }
+}
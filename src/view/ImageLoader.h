@@ -0,0 +1,67 @@
+#ifndef __IMAGE_LOADER_H__
+#define __IMAGE_LOADER_H__
+
+#include <QImage>
+#include <QObject>
+#include <QPixmap>
+#include <QPointer>
+#include <QSize>
+#include <QString>
+#include <QThreadPool>
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+#include "../common/LruCache.h"
+#include "../common/Singleton.h"
+#include "ImageKey.h"
+
+// 异步图片加载：在专用线程池里用 QImageReader 解码成 QImage 并缩放，结果投递回 GUI 线程转换成 QPixmap
+// 按 (路径, 目标大小) 缓存缩放好的图片，总内存超过预算时淘汰最久未用的；同一张图正在解码时的重复请求合并为一次
+// 打开面板时只显示占位内容，图片解码完成后再填上，GUI 线程不再等待解码
+// 除工作线程内部外，所有接口只在 GUI 线程调用
+class ImageLoader : public Singleton<ImageLoader>
+{
+    friend class Singleton<ImageLoader>;
+
+public:
+    using Callback = std::function<void(const QPixmap &)>;
+
+    static constexpr int64_t DEFAULT_BUDGET = 16 * 1024 * 1024;
+
+    // 已缓存时立即调用 callback 并返回true；否则提交后台解码，完成后在 GUI 线程调用 callback，返回false
+    // size 无效时保持原始大小，否则保持宽高比缩放到 size 以内；读取失败时回调空的 QPixmap
+    // receiver 不能为空，它析构后不再回调
+    bool load(const QString &path, const QSize &size, QObject *receiver, Callback callback);
+
+    void setBudget(int64_t bytes) { m_cache.setBudget(bytes); }
+    int64_t usedBytes() const noexcept { return m_cache.usedBytes(); }
+
+    // 退出前调用：放弃排队的解码，等待正在解码的完成，清空缓存（QPixmap 需要在 QApplication 析构前释放）
+    // 之后的 load() 不再提交解码，已经投递到 GUI 线程的结果也直接丢弃
+    void shutdown();
+
+    // 工作线程中执行：解码第一帧并缩放
+    static QImage decode(const QString &path, const QSize &size);
+
+private:
+    ImageLoader();
+    ~ImageLoader() override;
+
+    struct Waiter
+    {
+        QPointer<QObject> receiver;
+        Callback callback;
+    };
+
+    void deliver(const ImageKey &key, const QImage &image);
+
+private:
+    QThreadPool m_pool;
+    QObject m_context; // 工作线程向 GUI 线程投递结果的目标对象
+    LruCache<ImageKey, QPixmap, ImageKeyHash> m_cache;
+    std::unordered_map<ImageKey, std::vector<Waiter>, ImageKeyHash> m_pending; // 正在解码的图片及等待它的请求
+    bool m_shutDown = false;
+};
+
+#endif
@@ -3,18 +3,19 @@
 #include "../common/EventMgr.h"
 #include "../common/EventDefine.h"
 #include "../common/CommandParameters.h"
+#include "../common/StartupProfiler.h"
+#include "../common/FrameClock.h"
+#include "../common/SpriteSheet.h"
 #include <QApplication>
 #include <QScreen>
 #include <QHBoxLayout>
-#include <QMovie>
-#include <QPixmap>
 #include <QDebug>
 
 // 定义静态变量
 bool PetMainWindow::isAutoMovementActive = false;
 
 PetMainWindow::PetMainWindow(CommandManager& command_manager, QWidget *parent)
-    : QWidget(parent), petLabel(nullptr), contextMenu(nullptr), dragUpdateTimer(nullptr), currentMovie(nullptr), isDragging(false), wasAutoMovingBeforeDrag(false), m_position_ptr(nullptr), m_animation_ptr(nullptr), m_size_ptr(nullptr), m_command_manager(command_manager)
+    : QWidget(parent), petView(nullptr), contextMenu(nullptr), dragUpdateTimer(nullptr), frameTimer(nullptr), isDragging(false), wasAutoMovingBeforeDrag(false), m_position_ptr(nullptr), m_animation_ptr(nullptr), m_size_ptr(nullptr), m_position_channel(nullptr), m_command_manager(command_manager)
 {
     setupUI();
     setupContextMenu();
@@ -24,6 +25,12 @@ PetMainWindow::PetMainWindow(CommandManager& command_manager, QWidget *parent)
     dragUpdateTimer->setSingleShot(true);
     dragUpdateTimer->setInterval(16); // 约60fps的更新频率
     connect(dragUpdateTimer, &QTimer::timeout, this, &PetMainWindow::updateDragPosition);
+
+    // 帧定时器只在自动移动期间运行，空闲时不唤醒
+    frameTimer = new QTimer(this);
+    frameTimer->setTimerType(Qt::PreciseTimer);
+    frameTimer->setInterval(16); // 启动时按窗口所在屏幕的刷新率调整
+    connect(frameTimer, &QTimer::timeout, this, &PetMainWindow::sampleFramePosition);
 }
 
 void PetMainWindow::setupUI()
@@ -36,15 +43,14 @@ void PetMainWindow::setupUI()
     QHBoxLayout *layout = new QHBoxLayout(this);
     layout->setContentsMargins(0, 0, 0, 0);
 
-    petLabel = new QLabel(this);
-    petLabel->setAlignment(Qt::AlignCenter);
-    layout->addWidget(petLabel);
+    petView = new PetSpriteWidget(this);
+    layout->addWidget(petView);
 
-    // 修复：使用成员变量管理QMovie对象
-    currentMovie = new QMovie(":/resources/gif/spider.gif", QByteArray(), this);
     currentAnimationPath = ":/resources/gif/spider.gif";
-    petLabel->setMovie(currentMovie);
-    currentMovie->start();
+    {
+        StartupProfiler::Scope profile("decode:" + currentAnimationPath);
+        petView->set_animation(AnimationCache::GetInstance().get(currentAnimationPath));
+    }
 
     resize(200, 200);
 }
@@ -133,50 +139,25 @@ void PetMainWindow::update_ui()
         resize(*m_size_ptr);
     }
 
-    // 更新动画或图片 - 修复内存泄漏问题
+    // 更新动画或图片：帧来自共享缓存，切换回用过的动画不再重新解码和缩放
     if (m_animation_ptr && !m_animation_ptr->isEmpty())
     {
+        // GIF 和精灵图集保持原始大小播放，静态图片保持宽高比缩放到宠物大小
+        QSize targetSize;
+        if (!m_animation_ptr->endsWith(".gif") && !SpriteSheet::isSpriteSheetPath(*m_animation_ptr) && m_size_ptr)
+        {
+            targetSize = *m_size_ptr;
+        }
+
         // 检查是否需要更新动画（避免重复加载相同动画）
-        if (currentAnimationPath != *m_animation_ptr)
+        if (currentAnimationPath != *m_animation_ptr || currentAnimationSize != targetSize)
         {
             currentAnimationPath = *m_animation_ptr;
+            currentAnimationSize = targetSize;
 
-            if (m_animation_ptr->endsWith(".gif"))
-            {
-                // 清理旧的QMovie对象
-                if (currentMovie)
-                {
-                    currentMovie->stop();
-                    currentMovie->deleteLater();
-                    currentMovie = nullptr;
-                }
-
-                // 创建新的QMovie对象
-                currentMovie = new QMovie(*m_animation_ptr, QByteArray(), this);
-                petLabel->setMovie(currentMovie);
-                currentMovie->start();
-            }
-            else
-            {
-                // 处理静态图片 - 清理QMovie对象
-                if (currentMovie)
-                {
-                    currentMovie->stop();
-                    currentMovie->deleteLater();
-                    currentMovie = nullptr;
-                }
-
-                // 清除petLabel的movie，设置静态图片
-                petLabel->setMovie(nullptr);
-
-                QPixmap pixmap(*m_animation_ptr);
-                if (!pixmap.isNull() && m_size_ptr)
-                {
-                    // 根据设定的大小缩放图片，保持宽高比
-                    pixmap = pixmap.scaled(*m_size_ptr, Qt::KeepAspectRatio, Qt::SmoothTransformation);
-                }
-                petLabel->setPixmap(pixmap);
-            }
+            // 首次使用时同步解码全部帧
+            StartupProfiler::Scope profile("decode:" + *m_animation_ptr);
+            petView->set_animation(AnimationCache::GetInstance().get(currentAnimationPath, currentAnimationSize));
         }
     }
 }
@@ -268,6 +249,14 @@ void PetMainWindow::mouseReleaseEvent(QMouseEvent *event)
     }
 }
 
+void PetMainWindow::paintEvent(QPaintEvent *event)
+{
+    QWidget::paintEvent(event);
+
+    // 启动剖析：第一次绘制即首帧可见
+    StartupProfiler::instance().mark("first_frame");
+}
+
 // Callbacks - 按照Book项目的模式实现
 void PetMainWindow::switch_to_spider_cb(void *pv)
 {
@@ -421,6 +410,29 @@ void PetMainWindow::updateDragPosition()
     }
 }
 
+void PetMainWindow::sampleFramePosition()
+{
+    QPoint position;
+    if (m_position_channel && !isDragging && m_position_channel->take(position))
+    {
+        move(position);
+    }
+}
+
+void PetMainWindow::setFrameTickActive(bool active)
+{
+    if (active && m_position_channel)
+    {
+        frameTimer->start(frameIntervalMs(screen()));
+    }
+    else
+    {
+        frameTimer->stop();
+        // 取走停止前最后一次更新
+        sampleFramePosition();
+    }
+}
+
 void PetMainWindow::notification_cb(uint32_t id, void *p)
 {
     PetMainWindow *pThis = (PetMainWindow *)p;
@@ -433,6 +445,10 @@ void PetMainWindow::notification_cb(uint32_t id, void *p)
             pThis->move(*pThis->m_position_ptr);
         }
         break;
+    case PROP_ID_PET_MOVING:
+        // 位置通道开始连续移动时按帧取样，停下后停掉定时器，静止时不空转
+        pThis->setFrameTickActive(pThis->m_position_channel && pThis->m_position_channel->isMoving());
+        break;
     case PROP_ID_PET_SIZE:
         // 尺寸变化时只更新尺寸，不重新加载动画
         if (pThis->m_size_ptr) {
@@ -2,33 +2,27 @@
 #define __PET_MAIN_WINDOW_H__
 
 #include <QWidget>
-#include <QLabel>
 #include <QMenu>
 #include <QAction>
 #include <QContextMenuEvent>
 #include <QMouseEvent>
+#include <QPaintEvent>
 #include <QPoint>
 #include <QSize>
 #include <QTimer>
-#include <QMovie>
 #include "../common/CommandBase.h"
 #include "../common/CommandManager.h"
 #include "../common/PropertyTrigger.h"
+#include "../common/PositionChannel.h"
+#include "AnimationCache.h"
+#include "PetSpriteWidget.h"
 
 class PetMainWindow : public QWidget
 {
 public:
     explicit PetMainWindow(CommandManager& command_manager, QWidget *parent = nullptr);
     PetMainWindow(const PetMainWindow&) = delete;
-    ~PetMainWindow() noexcept
-    {
-        // 清理QMovie资源
-        if (currentMovie) {
-            currentMovie->stop();
-            currentMovie->deleteLater();
-            currentMovie = nullptr;
-        }
-    }
+    ~PetMainWindow() noexcept = default;
 
     PetMainWindow& operator=(const PetMainWindow&) = delete;
 
@@ -48,6 +42,12 @@ public:
         m_size_ptr = p;
     }
 
+    // 自动移动期间的位置来源，窗口在帧定时器上取样
+    void set_position_channel(PositionChannel *channel) noexcept
+    {
+        m_position_channel = channel;
+    }
+
     // Notification
     PropertyNotification get_notification() const noexcept
     {
@@ -62,6 +62,7 @@ protected:
     void mousePressEvent(QMouseEvent *event) override;
     void mouseMoveEvent(QMouseEvent *event) override;
     void mouseReleaseEvent(QMouseEvent *event) override;
+    void paintEvent(QPaintEvent *event) override;
 
 private:
     // Callbacks - 使用C风格回调函数，就像Book项目
@@ -77,19 +78,22 @@ private:
     static void stop_auto_movement_cb(void *pv);
     static void exit_cb(void *pv);
     void updateDragPosition(); // 定时器更新拖动位置
+    void sampleFramePosition(); // 帧定时器：从位置通道取样并移动窗口
+    void setFrameTickActive(bool active);
 
 private:
     // Notification
     static void notification_cb(uint32_t id, void *p);
 
 private:
-    QLabel *petLabel;
+    PetSpriteWidget *petView; // 绘制宠物动画帧
     QMenu *contextMenu;
     QTimer *dragUpdateTimer; // 拖动更新定时器
+    QTimer *frameTimer;      // 自动移动期间的帧定时器
     
-    // 资源管理 - 防止内存泄漏
-    QMovie *currentMovie; // 当前的动画对象
+    // 当前动画：帧来自 AnimationCache，切换回用过的动画时不再解码
     QString currentAnimationPath; // 当前动画路径，用于避免重复加载
+    QSize currentAnimationSize;   // 当前动画的缩放目标（GIF 保持原始大小）
     
     // Mouse dragging
     bool isDragging;
@@ -102,6 +106,7 @@ private:
     const QPoint* m_position_ptr;
     const QString* m_animation_ptr;
     const QSize* m_size_ptr;
+    PositionChannel* m_position_channel;
 
     // Command Manager
     CommandManager& m_command_manager;
@@ -0,0 +1,100 @@
+#include "PetSpriteWidget.h"
+#include <QPainter>
+
+PetSpriteWidget::PetSpriteWidget(QWidget *parent)
+    : QWidget(parent), m_frameTimer(nullptr), m_frame(0), m_completedLoops(0)
+{
+    // 不填充背景：透明窗口里未被帧覆盖的像素保持透明
+    setAttribute(Qt::WA_NoSystemBackground);
+
+    m_frameTimer = new QTimer(this);
+    m_frameTimer->setSingleShot(true);
+    connect(m_frameTimer, &QTimer::timeout, this, &PetSpriteWidget::showNextFrame);
+}
+
+void PetSpriteWidget::set_animation(std::shared_ptr<const AnimationFrames> animation)
+{
+    m_frameTimer->stop();
+    m_animation = std::move(animation);
+    m_frame = 0;
+    m_completedLoops = 0;
+
+    m_frameSize = QSize(0, 0);
+    if (m_animation)
+    {
+        for (const QPixmap &frame : m_animation->frames)
+        {
+            m_frameSize = m_frameSize.expandedTo(frame.size());
+        }
+    }
+    // 帧大小变化时让布局重新计算，窗口比帧小时整帧仍能显示
+    updateGeometry();
+    update();
+
+    if (m_animation && m_animation->isAnimated())
+    {
+        m_frameTimer->start(m_animation->delays[0]);
+    }
+}
+
+QSize PetSpriteWidget::sizeHint() const
+{
+    return m_frameSize;
+}
+
+QSize PetSpriteWidget::minimumSizeHint() const
+{
+    return m_frameSize;
+}
+
+void PetSpriteWidget::showNextFrame()
+{
+    if (!m_animation || !m_animation->isAnimated())
+    {
+        return;
+    }
+
+    int next = m_frame + 1;
+    if (next >= m_animation->frames.size())
+    {
+        // 一轮播完：有限循环次数用完后停在最后一帧
+        ++m_completedLoops;
+        if (m_animation->loopCount >= 0 && m_completedLoops > m_animation->loopCount)
+        {
+            return;
+        }
+        next = 0;
+    }
+
+    // 只重绘新帧与上一帧不同的矩形；两帧大小不同时居中位置也不同，重绘两帧覆盖的范围
+    const QPixmap &from = m_animation->frames[m_frame];
+    const QPixmap &to = m_animation->frames[next];
+    const QRect dirty = from.size() == to.size()
+                            ? m_animation->changed[next].translated(frameOrigin(next))
+                            : QRect(frameOrigin(m_frame), from.size()).united(QRect(frameOrigin(next), to.size()));
+    m_frame = next;
+    if (!dirty.isEmpty())
+    {
+        update(dirty);
+    }
+    m_frameTimer->start(m_animation->delays[m_frame]);
+}
+
+QPoint PetSpriteWidget::frameOrigin(int frame) const
+{
+    const QPixmap &pixmap = m_animation->frames[frame];
+    return QPoint((width() - pixmap.width()) / 2, (height() - pixmap.height()) / 2);
+}
+
+void PetSpriteWidget::paintEvent(QPaintEvent *event)
+{
+    if (!m_animation || m_animation->isEmpty())
+    {
+        return;
+    }
+
+    // 帧已经是预乘 ARGB，光栅后端直接混合到窗口缓冲区；裁剪到需要重绘的区域
+    QPainter painter(this);
+    painter.setClipRegion(event->region());
+    painter.drawPixmap(frameOrigin(m_frame), m_animation->frames[m_frame]);
+}
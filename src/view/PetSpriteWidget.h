@@ -0,0 +1,47 @@
+#ifndef __PET_SPRITE_WIDGET_H__
+#define __PET_SPRITE_WIDGET_H__
+
+#include <QWidget>
+#include <QPaintEvent>
+#include <QPixmap>
+#include <QPoint>
+#include <QSize>
+#include <QTimer>
+#include <memory>
+#include "AnimationCache.h"
+
+// 宠物动画控件：在 paintEvent 里直接绘制 AnimationCache 中预乘 ARGB 的帧（居中显示）
+// 取代 QLabel + QMovie：播放时不再调用 GIF 解码器，换帧时只重绘与上一帧不同的区域
+class PetSpriteWidget : public QWidget
+{
+public:
+    explicit PetSpriteWidget(QWidget *parent = nullptr);
+
+    // 从第0帧开始播放；传入空动画时清空显示
+    void set_animation(std::shared_ptr<const AnimationFrames> animation);
+
+    // 动画中最大一帧的大小，布局据此给控件留出完整显示一帧的空间
+    QSize sizeHint() const override;
+    QSize minimumSizeHint() const override;
+
+    int current_frame() const noexcept
+    {
+        return m_frame;
+    }
+
+protected:
+    void paintEvent(QPaintEvent *event) override;
+
+private:
+    void showNextFrame(); // 换帧定时器：切到下一帧并重绘变化的区域
+    QPoint frameOrigin(int frame) const;
+
+private:
+    QTimer *m_frameTimer; // 按每帧的时长单次触发
+    std::shared_ptr<const AnimationFrames> m_animation;
+    QSize m_frameSize; // 各帧宽高的最大值
+    int m_frame;
+    int m_completedLoops;
+};
+
+#endif
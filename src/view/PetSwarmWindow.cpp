@@ -0,0 +1,227 @@
+#include "PetSwarmWindow.h"
+#include "../common/FrameClock.h"
+#include <QCursor>
+#include <QPainter>
+#include <QRegion>
+#include <QDebug>
+#include <algorithm>
+
+PetSwarmWindow::PetSwarmWindow(PetSwarm &swarm, QWidget *parent)
+    : QWidget(parent), m_swarm(swarm), m_frameTimer(nullptr), m_walkFrameIndex(-1), m_interactFrameIndex(-1), m_framesChanged(true), m_stepTotalUs(0.0), m_stepMaxUs(0.0), m_stepCount(0), m_frameTotalUs(0.0), m_frameMaxUs(0.0), m_frameCount(0), m_paintPending(false)
+{
+    // 纯显示用的覆盖层：不抢焦点、鼠标事件穿透到下面的窗口
+    setWindowFlags(Qt::FramelessWindowHint | Qt::WindowStaysOnTopHint | Qt::Tool | Qt::WindowTransparentForInput);
+    setAttribute(Qt::WA_TranslucentBackground);
+    setAttribute(Qt::WA_TransparentForMouseEvents);
+    setAttribute(Qt::WA_ShowWithoutActivating);
+    setGeometry(m_swarm.screens().bounds());
+
+    m_frameTimer = new QTimer(this);
+    m_frameTimer->setTimerType(Qt::PreciseTimer);
+    connect(m_frameTimer, &QTimer::timeout, this, &PetSwarmWindow::tick);
+}
+
+PetSwarmWindow::~PetSwarmWindow() noexcept
+{
+    stop();
+}
+
+void PetSwarmWindow::set_animations(const QString &walk_path, const QString &interact_path)
+{
+    AnimationCache &cache = AnimationCache::GetInstance();
+    m_walkAnimation = cache.get(walk_path, m_swarm.petSize());
+    m_interactAnimation = cache.get(interact_path, m_swarm.petSize());
+    m_walkFrameIndex = -1;
+    m_interactFrameIndex = -1;
+    m_animationClock.start();
+}
+
+void PetSwarmWindow::start()
+{
+    if (!m_animationClock.isValid())
+    {
+        m_animationClock.start();
+    }
+    m_frameTimer->start(frameIntervalMs(screen()));
+    m_frameClock.start();
+    m_reportClock.start();
+    show();
+}
+
+void PetSwarmWindow::stop()
+{
+    m_frameTimer->stop();
+    m_frameClock.invalidate();
+}
+
+void PetSwarmWindow::update_screens()
+{
+    // 窗口原点可能改变，上一帧记录的位置已不对应窗口坐标，整体重绘一次
+    setGeometry(m_swarm.screens().bounds());
+    m_lastRects.clear();
+    m_framesChanged = true;
+    if (m_frameTimer->isActive())
+    {
+        m_frameTimer->setInterval(frameIntervalMs(screen()));
+    }
+}
+
+void PetSwarmWindow::tick()
+{
+    // 所有宠物在同一次 step 中推进，按实际经过的时间计算；鼠标作为碰撞体参与检测
+    const double dt = m_frameClock.restart() / 1000.0;
+    m_tickClock.start();
+    m_paintPending = false;
+    m_swarm.setCursor(QCursor::pos());
+    m_swarm.step(dt);
+    const double stepUs = m_tickClock.nsecsElapsed() / 1000.0;
+    m_stepTotalUs += stepUs;
+    m_stepMaxUs = std::max(m_stepMaxUs, stepUs);
+    ++m_stepCount;
+
+    updateAnimationFrames();
+    if (m_framesChanged)
+    {
+        m_framesChanged = false;
+        m_paintPending = true;
+        update();
+    }
+    else
+    {
+        // 只重绘宠物上一帧和这一帧覆盖的区域
+        QRegion dirty;
+        const QPoint origin = geometry().topLeft();
+        for (int i = 0; i < m_swarm.size(); ++i)
+        {
+            const QRect rect = m_swarm.rect(i).translated(-origin);
+            if (i >= m_lastRects.size() || rect != m_lastRects[i])
+            {
+                dirty += rect;
+                if (i < m_lastRects.size())
+                {
+                    dirty += m_lastRects[i];
+                }
+            }
+        }
+        // 切换动画的宠物即使没动也要重绘
+        for (int i : m_swarm.changed())
+        {
+            dirty += m_swarm.rect(i).translated(-origin);
+        }
+        if (!dirty.isEmpty())
+        {
+            m_paintPending = true;
+            update(dirty);
+        }
+    }
+
+    m_lastRects.resize(m_swarm.size());
+    const QPoint origin = geometry().topLeft();
+    for (int i = 0; i < m_swarm.size(); ++i)
+    {
+        m_lastRects[i] = m_swarm.rect(i).translated(-origin);
+    }
+
+    // 没有需要重绘的区域时这一帧到此结束
+    if (!m_paintPending)
+    {
+        recordFrameTime();
+    }
+
+    if (m_reportClock.elapsed() >= 5000)
+    {
+        reportFrameTime();
+    }
+}
+
+void PetSwarmWindow::recordFrameTime()
+{
+    if (!m_tickClock.isValid())
+    {
+        return;
+    }
+    const double frameUs = m_tickClock.nsecsElapsed() / 1000.0;
+    m_tickClock.invalidate();
+    m_frameTotalUs += frameUs;
+    m_frameMaxUs = std::max(m_frameMaxUs, frameUs);
+    ++m_frameCount;
+}
+
+void PetSwarmWindow::reportFrameTime()
+{
+    if (m_frameCount > 0 && m_stepCount > 0)
+    {
+        qDebug() << "Swarm of" << m_swarm.size() << "pets: frame avg" << m_frameTotalUs / m_frameCount
+                 << "us, max" << m_frameMaxUs << "us over" << m_frameCount << "frames;"
+                 << "step avg" << m_stepTotalUs / m_stepCount << "us, max" << m_stepMaxUs << "us,"
+                 << "bumps" << m_swarm.bumpCount() << "follows" << m_swarm.followCount();
+    }
+    m_stepTotalUs = 0.0;
+    m_stepMaxUs = 0.0;
+    m_stepCount = 0;
+    m_frameTotalUs = 0.0;
+    m_frameMaxUs = 0.0;
+    m_frameCount = 0;
+    m_reportClock.restart();
+}
+
+void PetSwarmWindow::updateAnimationFrames()
+{
+    const qint64 elapsed = m_animationClock.isValid() ? m_animationClock.elapsed() : 0;
+    if (m_walkAnimation && !m_walkAnimation->isEmpty())
+    {
+        const int index = m_walkAnimation->frameAt(elapsed);
+        if (index != m_walkFrameIndex)
+        {
+            m_walkFrameIndex = index;
+            m_walkFrame = m_walkAnimation->frames[index];
+            m_framesChanged = true;
+        }
+    }
+    if (m_interactAnimation && !m_interactAnimation->isEmpty())
+    {
+        const int index = m_interactAnimation->frameAt(elapsed);
+        if (index != m_interactFrameIndex)
+        {
+            m_interactFrameIndex = index;
+            m_interactFrame = m_interactAnimation->frames[index];
+            m_framesChanged = true;
+        }
+    }
+}
+
+const QPixmap &PetSwarmWindow::frameFor(SwarmPetState state) const
+{
+    if (state == SwarmPetState::Interacting && !m_interactFrame.isNull())
+    {
+        return m_interactFrame;
+    }
+    return m_walkFrame;
+}
+
+void PetSwarmWindow::paintEvent(QPaintEvent *event)
+{
+    QPainter painter(this);
+    const QRect exposed = event->rect();
+    const QPoint origin = geometry().topLeft();
+    for (int i = 0; i < m_swarm.size(); ++i)
+    {
+        const QRect rect = m_swarm.rect(i).translated(-origin);
+        if (!exposed.intersects(rect))
+        {
+            continue;
+        }
+        const QPixmap &frame = frameFor(m_swarm.state(i));
+        // 保持比例缩放后的帧在宠物区域内居中
+        painter.drawPixmap(rect.x() + (rect.width() - frame.width()) / 2,
+                           rect.y() + (rect.height() - frame.height()) / 2, frame);
+    }
+    painter.end();
+
+    // 同一帧的多次重绘只记第一次；被合并到下一帧的重绘会在下一次 tick() 时重新计时
+    if (m_paintPending)
+    {
+        m_paintPending = false;
+        recordFrameTime();
+    }
+}
@@ -0,0 +1,74 @@
+#ifndef __PET_SWARM_WINDOW_H__
+#define __PET_SWARM_WINDOW_H__
+
+#include <QWidget>
+#include <QElapsedTimer>
+#include <QPaintEvent>
+#include <QPixmap>
+#include <QRect>
+#include <QTimer>
+#include <QVector>
+#include <memory>
+#include "../model/PetSwarm.h"
+#include "AnimationCache.h"
+
+// 群体宠物的显示窗口：一个覆盖所有屏幕、不接收鼠标的透明窗口，画出所有额外的宠物
+// 模拟和绘制共用一个帧定时器，每帧调用一次 PetSwarm::step()，只重绘宠物移动经过的区域
+// 所有宠物共用 AnimationCache 中按宠物大小缩放好的帧，换帧由同一个帧定时器按经过的时间决定
+class PetSwarmWindow : public QWidget
+{
+public:
+    explicit PetSwarmWindow(PetSwarm &swarm, QWidget *parent = nullptr);
+    PetSwarmWindow(const PetSwarmWindow &) = delete;
+    ~PetSwarmWindow() noexcept;
+
+    PetSwarmWindow &operator=(const PetSwarmWindow &) = delete;
+
+    // 移动/停留时和交互时播放的动画
+    void set_animations(const QString &walk_path, const QString &interact_path);
+
+    void start();
+    void stop();
+
+    // 屏幕信息变化后调用：覆盖层重新覆盖所有屏幕并整体重绘
+    void update_screens();
+
+protected:
+    void paintEvent(QPaintEvent *event) override;
+
+private:
+    void tick();
+    void reportFrameTime();
+    void recordFrameTime();
+    void updateAnimationFrames();
+    const QPixmap &frameFor(SwarmPetState state) const;
+
+private:
+    PetSwarm &m_swarm;
+    QTimer *m_frameTimer;
+    QElapsedTimer m_frameClock;
+
+    std::shared_ptr<const AnimationFrames> m_walkAnimation;
+    std::shared_ptr<const AnimationFrames> m_interactAnimation;
+    QElapsedTimer m_animationClock;
+    int m_walkFrameIndex;
+    int m_interactFrameIndex;
+    QPixmap m_walkFrame;       // 缩放到宠物大小的当前帧
+    QPixmap m_interactFrame;
+    bool m_framesChanged;      // 动画换帧后整个窗口重绘
+
+    QVector<QRect> m_lastRects; // 上一帧每只宠物在窗口中的位置
+
+    // 帧耗时统计，定期输出到调试日志：step 只计模拟，帧耗时从 tick() 开始到这一帧的 paintEvent() 结束
+    double m_stepTotalUs;
+    double m_stepMaxUs;
+    int m_stepCount;
+    double m_frameTotalUs;
+    double m_frameMaxUs;
+    int m_frameCount;
+    QElapsedTimer m_tickClock;
+    bool m_paintPending;       // 本帧请求了重绘，帧耗时在 paintEvent() 结束时记录
+    QElapsedTimer m_reportClock;
+};
+
+#endif
@@ -2,6 +2,7 @@
 #include "../common/PropertyIds.h"
 #include "../common/CommandParameters.h"
 #include <QDebug>
+#include "ImageLoader.h"
 #include <QVBoxLayout>
 #include <QGroupBox>
 #include <QTextStream>
@@ -9,10 +10,14 @@
 // ===================== WorkItemWidget 实现 =====================
 
 WorkItemWidget::WorkItemWidget(const WorkInfo &workInfo, QWidget *parent)
-    : QWidget(parent), m_workInfo(workInfo), m_isWorking(false)
+    : QWidget(parent), m_workInfo(workInfo), m_isWorking(false), m_progressTimer(new QTimer(this))
 {
     setupUi();
     updateButtonStates();
+
+    // 进度条约每1%刷新一次，面板隐藏或空闲时不唤醒
+    m_progressTimer->setInterval(qMax(50, m_workInfo.workDuration * 10));
+    connect(m_progressTimer, &QTimer::timeout, this, &WorkItemWidget::refreshProgress);
 }
 
 void WorkItemWidget::setupUi()
@@ -49,19 +54,20 @@ void WorkItemWidget::setupUi()
         "    padding: 6px;"
         "}");
 
-    // 设置桌宠形态图片
-    QPixmap petPixmap(m_workInfo.petFormImage);
-    if (!petPixmap.isNull())
+    // 设置桌宠形态图片：后台解码并缩放，加载完成前先显示形态名称
+    m_petFormLabel->setText(m_workInfo.petForm);
+    ImageLoader::GetInstance().load(m_workInfo.petFormImage, QSize(68, 68), m_petFormLabel, [this](const QPixmap &petPixmap)
     {
-        petPixmap = petPixmap.scaled(68, 68, Qt::KeepAspectRatio, Qt::SmoothTransformation);
-        m_petFormLabel->setPixmap(petPixmap);
-    }
-    else
-    {
-        m_petFormLabel->setText(m_workInfo.petForm);
-        m_petFormLabel->setStyleSheet(m_petFormLabel->styleSheet() +
-                                      "font-size: 14px; font-weight: bold; color: #333333;");
-    }
+        if (!petPixmap.isNull())
+        {
+            m_petFormLabel->setPixmap(petPixmap);
+        }
+        else
+        {
+            m_petFormLabel->setStyleSheet(m_petFormLabel->styleSheet() +
+                                          "font-size: 14px; font-weight: bold; color: #333333;");
+        }
+    });
     mainLayout->addWidget(m_petFormLabel);
 
     // 中间：工作信息 - 重新调整布局
@@ -335,28 +341,63 @@ void WorkItemWidget::setupUi()
     mainLayout->addLayout(buttonLayout);
 }
 
-void WorkItemWidget::updateWorkStatus(WorkStatus status, WorkType currentType, int remainingTime)
+void WorkItemWidget::updateWorkStatus(WorkStatus status, WorkType currentType, const QDeadlineTimer& deadline)
 {
     m_isWorking = (status == WorkStatus::Working && currentType == m_workInfo.type);
+    m_deadline = deadline;
 
+    m_progressBar->setVisible(m_isWorking);
     if (m_isWorking)
     {
-        m_progressBar->setVisible(true);
+        refreshProgress();
+    }
 
-        // 计算进度百分比
-        int progress = 100;
-        if (m_workInfo.workDuration > 0)
+    updateProgressTimer();
+    updateButtonStates();
+}
+
+void WorkItemWidget::refreshProgress()
+{
+    // 计算进度百分比
+    int progress = 100;
+    const qint64 durationMs = static_cast<qint64>(m_workInfo.workDuration) * 1000;
+    if (durationMs > 0)
+    {
+        const qint64 remainingMs = qBound<qint64>(0, m_deadline.remainingTime(), durationMs);
+        progress = static_cast<int>(((durationMs - remainingMs) * 100) / durationMs);
+    }
+    m_progressBar->setValue(progress);
+}
+
+void WorkItemWidget::updateProgressTimer()
+{
+    if (m_isWorking && isVisible())
+    {
+        if (!m_progressTimer->isActive())
         {
-            progress = ((m_workInfo.workDuration - remainingTime) * 100) / m_workInfo.workDuration;
+            m_progressTimer->start();
         }
-        m_progressBar->setValue(progress);
     }
     else
     {
-        m_progressBar->setVisible(false);
+        m_progressTimer->stop();
     }
+}
 
-    updateButtonStates();
+void WorkItemWidget::showEvent(QShowEvent *event)
+{
+    QWidget::showEvent(event);
+    if (m_isWorking)
+    {
+        refreshProgress();
+    }
+    updateProgressTimer();
+}
+
+void WorkItemWidget::hideEvent(QHideEvent *event)
+{
+    QWidget::hideEvent(event);
+    updateProgressTimer();
 }
 
 void WorkItemWidget::updateButtonStates()
@@ -564,7 +605,21 @@ void WorkPanel::setupUi()
 void WorkPanel::updateWorkTypes(const QVector<WorkInfo>& workTypes)
 {
     m_workTypes = workTypes;
-    
+
+    // 工作类型没有变化时保留现有控件，只需刷新状态
+    if (!m_workItems.isEmpty() && m_workItems.size() == workTypes.size())
+    {
+        bool unchanged = true;
+        for (int i = 0; i < workTypes.size() && unchanged; ++i)
+        {
+            unchanged = (m_workItems[i]->getWorkType() == workTypes[i].type);
+        }
+        if (unchanged)
+        {
+            return;
+        }
+    }
+
     // 清理现有的工作项
     qDeleteAll(m_workItems);
     m_workItems.clear();
@@ -636,7 +691,7 @@ void WorkPanel::updateWorkItems()
     // 更新每个工作项的状态
     for (WorkItemWidget *item : m_workItems)
     {
-        item->updateWorkStatus(m_currentStatus.status, m_currentStatus.currentType, m_currentStatus.remainingTime);
+        item->updateWorkStatus(m_currentStatus.status, m_currentStatus.currentType, m_currentStatus.deadline);
     }
 }
 
@@ -10,6 +10,7 @@
 #include <QProgressBar>
 #include <QGroupBox>
 #include <QTimer>
+#include <QDeadlineTimer>
 #include <QPixmap>
 #include <QVector>
 #include <QScrollArea>
@@ -23,12 +24,12 @@ struct WorkStatusInfo
 {
     WorkStatus status;
     WorkType currentType;
-    int remainingTime;
+    QDeadlineTimer deadline; // 当前周期的截止时间，进度由界面按需计算
     QString statusText;
     
-    WorkStatusInfo() : status(WorkStatus::Idle), currentType(WorkType::Photosynthesis), remainingTime(0) {}
-    WorkStatusInfo(WorkStatus s, WorkType t, int time, const QString& text)
-        : status(s), currentType(t), remainingTime(time), statusText(text) {}
+    WorkStatusInfo() : status(WorkStatus::Idle), currentType(WorkType::Photosynthesis) {}
+    WorkStatusInfo(WorkStatus s, WorkType t, const QDeadlineTimer& d, const QString& text)
+        : status(s), currentType(t), deadline(d), statusText(text) {}
 };
 
 // 打工项控件
@@ -37,9 +38,13 @@ class WorkItemWidget : public QWidget
     Q_OBJECT
 public:
     explicit WorkItemWidget(const WorkInfo &workInfo, QWidget *parent = nullptr);
-    void updateWorkStatus(WorkStatus status, WorkType currentType, int remainingTime);
+    void updateWorkStatus(WorkStatus status, WorkType currentType, const QDeadlineTimer& deadline);
     WorkType getWorkType() const { return m_workInfo.type; }
 
+protected:
+    void showEvent(QShowEvent *event) override;
+    void hideEvent(QHideEvent *event) override;
+
 signals:
     void startWorkRequested(WorkType type);
     void stopWorkRequested();
@@ -47,10 +52,12 @@ signals:
 private slots:
     void onStartButtonClicked();
     void onStopButtonClicked();
+    void refreshProgress(); // 根据截止时间刷新进度条
 
 private:
     void setupUi();
     void updateButtonStates();
+    void updateProgressTimer(); // 只在可见且工作中时运行进度刷新定时器
     QString formatTime(int seconds);
 
 private:
@@ -69,6 +76,8 @@ private:
     QPushButton* m_stopButton;  // 停止按钮
     
     bool m_isWorking;           // 是否正在工作
+    QDeadlineTimer m_deadline;  // 当前周期截止时间
+    QTimer* m_progressTimer;    // 进度刷新定时器
 };
 
 // 打工面板主控件 - 完全解耦，不依赖任何ViewModel
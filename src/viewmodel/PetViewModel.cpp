@@ -1,13 +1,16 @@
 #include "PetViewModel.h"
 #include "../common/PropertyIds.h"
 #include "../common/CollectionManager.h"
+#include "../common/RandomService.h"
+#include "../model/CatalogCache.h"
+#include <QDateTime>
 
 PetViewModel::PetViewModel() noexcept
     : m_sp_work_model(std::make_shared<WorkModel>()),
       m_sp_backpack_model(std::make_shared<BackpackModel>()),
       m_sp_collection_model(std::make_shared<CollectionModel>()),
       m_sp_auto_movement_model(std::make_shared<AutoMovementModel>()),
-      m_sp_forge_model(std::make_shared<ForgeModel>()),
+      m_sp_forge_model(std::make_shared<ForgeModel>(nullptr, ForgeModel::DeferTables)),
       m_move_command(this),
       m_switch_pet_command(this),
       m_show_stats_panel_command(m_trigger),
@@ -25,44 +28,14 @@ PetViewModel::PetViewModel() noexcept
 {
     // 注册事件监听器
     EventMgr::GetInstance().RegisterEvent<AddItemEvent>(this);
+    EventMgr::GetInstance().RegisterEvent<AddItemBatchEvent>(this);
 
-    // 初始化图鉴系统
-    if (m_sp_collection_model)
-    {
-        // 加载图鉴物品配置
-        m_sp_collection_model->loadItemsFromCSV(":/resources/csv/collection_items.csv");
-        // 加载已保存的图鉴数据
-        m_sp_collection_model->loadFromFile("collection_data.json");
-
-        // 设置CollectionManager
-        CollectionManager::getInstance().setCollectionModel(m_sp_collection_model);
-    }
-
-    // 初始化背包系统（在图鉴系统初始化后）
-    if (m_sp_backpack_model)
+    // 设置锻造系统的依赖关系（配方表和存档在启动流水线中加载）
+    if (m_sp_forge_model)
     {
-        // 先加载已保存的背包数据
-        m_sp_backpack_model->loadFromFile("backpack_data.json");
-
-        // 如果没有保存的数据，则从图鉴系统初始化
-        if (m_sp_backpack_model->getItems().isEmpty())
-        {
-            m_sp_backpack_model->initializeFromCollection();
-        }
-
-        // 同步背包数据到图鉴系统
-        CollectionManager::getInstance().syncFromBackpack(m_sp_backpack_model->getItems());
-    }
-
-    // 初始化锻造系统
-    if (m_sp_forge_model) {
-        // 设置锻造系统的依赖关系
         m_sp_forge_model->setBackpackModel(m_sp_backpack_model);
         m_sp_forge_model->setCollectionModel(m_sp_collection_model);
         m_sp_forge_model->setWorkModel(m_sp_work_model);
-        
-        // 加载锻造数据
-        m_sp_forge_model->loadFromFile("forge_data.json");
     }
 
     // 注册所有命令到CommandManager
@@ -82,6 +55,118 @@ PetViewModel::PetViewModel() noexcept
     m_command_manager.register_command(CommandType::SHOW_WORK_UPGRADE_PANEL, &m_show_work_upgrade_panel_command);  // 注册工作升级面板命令
 }
 
+void PetViewModel::start_loading()
+{
+    if (m_startup.isStarted())
+    {
+        return;
+    }
+
+    // 后台：互不依赖的解析并发执行，结果交给对应的GUI阶段写入模型
+    auto catalog = std::make_shared<QMap<int, CollectionItemInfo>>();
+    auto tables = std::make_shared<ForgeModel::Tables>();
+    const auto parse_catalog = m_startup.addBackground("catalog", [catalog]() {
+        *catalog = CatalogCache::load(":/resources/csv/collection_items.csv",
+                                      SaveGame::fullPath(CatalogCache::DEFAULT_FILENAME));
+    });
+    const auto parse_save = m_startup.addBackground("save", [this]() { m_save_game.load(); });
+    const auto build_tables = m_startup.addBackground("recipes", [tables]() { *tables = ForgeModel::buildTables(); });
+
+    // GUI线程：按依赖顺序恢复各模型，面板通过 when_ready 等待对应阶段
+    m_startup.addStage(STAGE_RANDOM, {parse_save}, [this]() { load_random_state(); });
+    m_startup.addStage(STAGE_COLLECTION, {parse_catalog, parse_save}, [this, catalog]() {
+        m_sp_collection_model->setItemCatalog(*catalog);
+        load_collection_data();
+    });
+    m_startup.addStage(STAGE_BACKPACK, {parse_save}, [this]() { load_backpack_data(); });
+    m_startup.addStage(STAGE_FORGE, {build_tables, parse_save}, [this, tables]() {
+        m_sp_forge_model->setTables(std::move(*tables));
+        load_forge_data();
+    });
+    m_startup.addStage(STAGE_PET, {parse_save}, [this]() { load_pet_data(); });
+    m_startup.addStage(STAGE_JOURNAL, {}, [this]() { replay_journal(); });
+    m_startup.addStage(STAGE_WORK, {}, [this]() { load_work_data(); });
+    m_startup.addStage(STAGE_AUTOSAVE, {}, [this]() { start_autosave(); });
+    m_startup.start();
+}
+
+void PetViewModel::load_random_state()
+{
+    // 恢复随机数状态，保证奖励序列可以从存档继续复现
+    if (m_save_game.hasSection(SaveGame::SECTION_RANDOM))
+    {
+        if (!RandomService::isSeedPinned())
+        {
+            restore_section(
+                SaveGame::SECTION_RANDOM, [](BinaryReader &in) { RandomService::GetInstance().readBinary(in); },
+                [](const QJsonValue &json) { RandomService::GetInstance().fromJson(json.toObject()); });
+        }
+    }
+    else
+    {
+        RandomService::GetInstance().loadFromFile("random_state.json");
+    }
+}
+
+void PetViewModel::load_collection_data()
+{
+    if (!m_sp_collection_model)
+    {
+        return;
+    }
+
+    // 加载已保存的图鉴数据
+    if (!restore_section(
+            SaveGame::SECTION_COLLECTION, [this](BinaryReader &in) { m_sp_collection_model->readBinary(in); },
+            [this](const QJsonValue &json) { m_sp_collection_model->fromJson(json.toObject()); }))
+    {
+        m_sp_collection_model->loadFromFile("collection_data.json");
+    }
+
+    // 设置CollectionManager
+    CollectionManager::getInstance().setCollectionModel(m_sp_collection_model);
+}
+
+void PetViewModel::load_backpack_data()
+{
+    if (!m_sp_backpack_model)
+    {
+        return;
+    }
+
+    // 先加载已保存的背包数据
+    if (!restore_section(
+            SaveGame::SECTION_BACKPACK, [this](BinaryReader &in) { m_sp_backpack_model->readBinary(in); },
+            [this](const QJsonValue &json) { m_sp_backpack_model->fromJson(json.toArray()); }))
+    {
+        m_sp_backpack_model->loadFromFile("backpack_data.json");
+    }
+
+    // 如果没有保存的数据，则从图鉴系统初始化
+    if (m_sp_backpack_model->getItems().isEmpty())
+    {
+        m_sp_backpack_model->initializeFromCollection();
+    }
+
+    // 同步背包数据到图鉴系统
+    CollectionManager::getInstance().syncFromBackpack(m_sp_backpack_model->getItems());
+}
+
+void PetViewModel::load_forge_data()
+{
+    if (!m_sp_forge_model)
+    {
+        return;
+    }
+
+    if (!restore_section(
+            SaveGame::SECTION_FORGE, [this](BinaryReader &in) { m_sp_forge_model->readBinary(in); },
+            [this](const QJsonValue &json) { m_sp_forge_model->fromJson(json.toObject()); }))
+    {
+        m_sp_forge_model->loadFromFile("forge_data.json");
+    }
+}
+
 void PetViewModel::OnEvent(AddItemEvent event)
 {
     // 处理添加物品到背包事件
@@ -94,6 +179,343 @@ void PetViewModel::OnEvent(AddItemEvent event)
     qDebug() << "[PetViewModel] 物品已添加到背包并自动解锁图鉴";
 }
 
+void PetViewModel::OnEvent(AddItemBatchEvent event)
+{
+    if (!m_sp_backpack_model || event.items.empty())
+    {
+        return;
+    }
+
+    QVector<BackpackItemInfo> items;
+    items.reserve(static_cast<int>(event.items.size()));
+    for (const AddItemEvent &item : event.items)
+    {
+        items.append(BackpackItemInfo(item.itemId, item.count));
+    }
+
+    // 一次性加入背包，只触发一次背包更新
+    m_sp_backpack_model->addItems(items);
+}
+
+void PetViewModel::load_work_data(const QString &filename)
+{
+    if (!m_sp_work_model)
+    {
+        return;
+    }
+
+    if (!restore_section(
+            SaveGame::SECTION_WORK, [this](BinaryReader &in) { m_sp_work_model->readBinary(in); },
+            [this](const QJsonValue &json) { m_sp_work_model->fromJson(json.toObject()); }))
+    {
+        m_sp_work_model->loadFromFile(filename);
+    }
+    int cycles = m_sp_work_model->catchUpOfflineProgress(QDateTime::currentMSecsSinceEpoch());
+    if (cycles > 0)
+    {
+        qDebug() << "[PetViewModel] 离线期间完成打工" << cycles << "轮";
+    }
+
+    // 仍在打工则恢复工作形态
+    if (m_sp_work_model->getCurrentStatus() == WorkStatus::Working && m_sp_pet_model)
+    {
+        const WorkInfo *workInfo = m_sp_work_model->getWorkInfo(m_sp_work_model->getCurrentWorkType());
+        if (workInfo)
+        {
+            m_sp_pet_model->change_animation(workInfo->petFormImage);
+        }
+    }
+}
+
+bool PetViewModel::save_all_data(const QString &filename)
+{
+    // 数据还没加载完就保存会用空模型覆盖存档；在启动阶段内部调用时无法等待，放弃这次保存
+    if (!m_startup.waitForFinished())
+    {
+        qWarning() << "启动阶段尚未完成，跳过保存";
+        return false;
+    }
+
+    // 自动存档线程负责写默认存档，这里只提交快照，避免两个线程交替覆盖同一个文件
+    if (m_autosaver.isRunning() && filename == QLatin1String(SaveGame::DEFAULT_FILENAME))
+    {
+        m_autosaver.saveNow();
+        return true;
+    }
+
+    // 所有分区在同一时刻采集，整体原子写入；每个分区是顶层的一条嵌套消息
+    BinaryWriter out;
+    for (const auto &section : collect_save_sections(false))
+    {
+        out.beginMessage(section.first);
+        section.second(out);
+        out.endMessage();
+    }
+    if (!m_save_game.save(out, filename))
+    {
+        return false;
+    }
+    if (filename == QLatin1String(SaveGame::DEFAULT_FILENAME) && m_journal.isOpen())
+    {
+        m_journal.truncateThrough(m_journal_snapshot_seq);
+        m_journal_snapshot_seq = 0;
+    }
+    return true;
+}
+
+void PetViewModel::replay_journal()
+{
+    uint64_t snapshot_seq = 0;
+    if (m_save_game.hasBinarySection(SaveGame::SECTION_JOURNAL))
+    {
+        BinaryReader in = m_save_game.binarySection(SaveGame::SECTION_JOURNAL);
+        while (in.next())
+        {
+            if (in.field() == 1)
+            {
+                snapshot_seq = in.readUInt();
+            }
+        }
+    }
+
+    if (!m_journal.open(SaveGame::fullPath(SaveJournal::DEFAULT_FILENAME)))
+    {
+        return;
+    }
+    m_journal.advanceTo(snapshot_seq);
+
+    const int replayed = m_journal.replay(snapshot_seq, [this](SaveJournal::RecordType type, BinaryReader &in) {
+        switch (type)
+        {
+        case SaveJournal::BackpackItem:
+        case SaveJournal::BackpackClear:
+            if (m_sp_backpack_model)
+            {
+                m_sp_backpack_model->applyJournalRecord(type, in);
+            }
+            break;
+        case SaveJournal::CollectionItem:
+            if (m_sp_collection_model)
+            {
+                m_sp_collection_model->applyJournalRecord(type, in);
+            }
+            break;
+        case SaveJournal::PetProgress:
+            if (m_sp_pet_model)
+            {
+                m_sp_pet_model->apply_journal_record(type, in);
+            }
+            break;
+        case SaveJournal::ForgeHistoryItem:
+        case SaveJournal::ForgeLevel:
+            if (m_sp_forge_model)
+            {
+                m_sp_forge_model->applyJournalRecord(type, in);
+            }
+            break;
+        default:
+            break;
+        }
+    });
+    if (replayed > 0)
+    {
+        qDebug() << "[PetViewModel] 从存档日志恢复" << replayed << "条修改";
+    }
+
+    attach_journal(&m_journal);
+}
+
+void PetViewModel::attach_journal(SaveJournal *journal) noexcept
+{
+    if (m_sp_pet_model)
+    {
+        m_sp_pet_model->set_journal(journal);
+    }
+    if (m_sp_backpack_model)
+    {
+        m_sp_backpack_model->setJournal(journal);
+    }
+    if (m_sp_collection_model)
+    {
+        m_sp_collection_model->setJournal(journal);
+    }
+    if (m_sp_forge_model)
+    {
+        m_sp_forge_model->setJournal(journal);
+    }
+}
+
+void PetViewModel::compact_journal()
+{
+    if (m_journal_snapshot_seq != 0 && m_autosaver.writtenGeneration() >= m_journal_snapshot_generation)
+    {
+        m_journal.truncateThrough(m_journal_snapshot_seq);
+        m_journal_snapshot_seq = 0;
+    }
+}
+
+void PetViewModel::start_autosave()
+{
+    m_autosaver.start(SaveGame::fullPath(SaveGame::DEFAULT_FILENAME),
+                      [this](bool dirty_only) { return collect_save_sections(dirty_only); });
+}
+
+void PetViewModel::stop_autosave()
+{
+    // 启动中途退出时先把剩余阶段做完，否则会用未加载完的模型覆盖存档
+    // 退出流程不会在启动阶段内部发起，这里一定能等到全部完成
+    const bool loaded = m_startup.waitForFinished();
+    Q_ASSERT(loaded);
+    Q_UNUSED(loaded);
+
+    if (m_autosaver.isRunning())
+    {
+        m_autosaver.stop();
+        compact_journal();
+    }
+    else
+    {
+        save_all_data();
+    }
+
+    // 模型可能比ViewModel活得更久，停止后不再写日志
+    attach_journal(nullptr);
+    m_journal.close();
+}
+
+AutoSaver::Sections PetViewModel::collect_save_sections(bool dirty_only)
+{
+    compact_journal();
+
+    // 快照按值捕获进写入函数，之后GUI线程再修改模型会触发容器分离，不影响存档线程
+    AutoSaver::Sections sections;
+    if (m_sp_pet_model && (!dirty_only || m_sp_pet_model->is_dirty()))
+    {
+        sections[SaveGame::sectionField(SaveGame::SECTION_PET)] =
+            [snapshot = m_sp_pet_model->save_snapshot()](BinaryWriter &out) { PetModel::write_binary(snapshot, out); };
+        m_sp_pet_model->clear_dirty();
+    }
+    if (m_sp_backpack_model && (!dirty_only || m_sp_backpack_model->isDirty()))
+    {
+        sections[SaveGame::sectionField(SaveGame::SECTION_BACKPACK)] =
+            [snapshot = m_sp_backpack_model->saveSnapshot()](BinaryWriter &out) { BackpackModel::writeBinary(snapshot, out); };
+        m_sp_backpack_model->clearDirty();
+    }
+    if (m_sp_collection_model && (!dirty_only || m_sp_collection_model->isDirty()))
+    {
+        sections[SaveGame::sectionField(SaveGame::SECTION_COLLECTION)] =
+            [snapshot = m_sp_collection_model->saveSnapshot()](BinaryWriter &out) { CollectionModel::writeBinary(snapshot, out); };
+        m_sp_collection_model->clearDirty();
+    }
+    if (m_sp_work_model && (!dirty_only || m_sp_work_model->isDirty()))
+    {
+        sections[SaveGame::sectionField(SaveGame::SECTION_WORK)] =
+            [snapshot = m_sp_work_model->saveSnapshot()](BinaryWriter &out) { WorkModel::writeBinary(snapshot, out); };
+        m_sp_work_model->clearDirty();
+    }
+    if (m_sp_forge_model && (!dirty_only || m_sp_forge_model->isDirty()))
+    {
+        sections[SaveGame::sectionField(SaveGame::SECTION_FORGE)] =
+            [snapshot = m_sp_forge_model->saveSnapshot()](BinaryWriter &out) { ForgeModel::writeBinary(snapshot, out); };
+        m_sp_forge_model->clearDirty();
+    }
+
+    // 随机数状态只随打工/锻造推进，跟随其它分区一起保存
+    if (!dirty_only || !sections.empty())
+    {
+        sections[SaveGame::sectionField(SaveGame::SECTION_RANDOM)] =
+            [snapshot = RandomService::GetInstance().saveSnapshot()](BinaryWriter &out) { RandomService::writeBinary(snapshot, out); };
+
+        // 记下快照对应的日志位置，写盘后之前的日志记录就可以丢弃
+        const uint64_t seq = m_journal.lastSeq();
+        sections[SaveGame::sectionField(SaveGame::SECTION_JOURNAL)] = [seq](BinaryWriter &out) { out.writeUInt(1, seq); };
+        m_journal_snapshot_seq = seq;
+        m_journal_snapshot_generation = m_autosaver.submittedGeneration() + 1;
+    }
+    return sections;
+}
+
+bool PetViewModel::export_save_json(const QString &path)
+{
+    SaveGame snapshot;
+    if (m_sp_pet_model)
+    {
+        snapshot.setSection(SaveGame::SECTION_PET, m_sp_pet_model->to_json());
+    }
+    if (m_sp_backpack_model)
+    {
+        snapshot.setSection(SaveGame::SECTION_BACKPACK, m_sp_backpack_model->toJson());
+    }
+    if (m_sp_collection_model)
+    {
+        snapshot.setSection(SaveGame::SECTION_COLLECTION, m_sp_collection_model->toJson());
+    }
+    if (m_sp_work_model)
+    {
+        snapshot.setSection(SaveGame::SECTION_WORK, m_sp_work_model->toJson());
+    }
+    if (m_sp_forge_model)
+    {
+        snapshot.setSection(SaveGame::SECTION_FORGE, m_sp_forge_model->toJson());
+    }
+    snapshot.setSection(SaveGame::SECTION_RANDOM, RandomService::GetInstance().toJson());
+
+    return snapshot.saveJson(path);
+}
+
+bool PetViewModel::import_save_json(const QString &path)
+{
+    SaveGame snapshot;
+    if (!snapshot.loadFile(path))
+    {
+        return false;
+    }
+
+    // 只覆盖文件中存在的分区，随后立即写回二进制存档
+    if (m_sp_pet_model && snapshot.hasSection(SaveGame::SECTION_PET))
+    {
+        m_sp_pet_model->from_json(snapshot.section(SaveGame::SECTION_PET).toObject());
+    }
+    if (m_sp_backpack_model && snapshot.hasSection(SaveGame::SECTION_BACKPACK))
+    {
+        m_sp_backpack_model->fromJson(snapshot.section(SaveGame::SECTION_BACKPACK).toArray());
+    }
+    if (m_sp_collection_model && snapshot.hasSection(SaveGame::SECTION_COLLECTION))
+    {
+        m_sp_collection_model->fromJson(snapshot.section(SaveGame::SECTION_COLLECTION).toObject());
+    }
+    if (m_sp_work_model && snapshot.hasSection(SaveGame::SECTION_WORK))
+    {
+        m_sp_work_model->fromJson(snapshot.section(SaveGame::SECTION_WORK).toObject());
+    }
+    if (m_sp_forge_model && snapshot.hasSection(SaveGame::SECTION_FORGE))
+    {
+        m_sp_forge_model->fromJson(snapshot.section(SaveGame::SECTION_FORGE).toObject());
+    }
+    if (snapshot.hasSection(SaveGame::SECTION_RANDOM))
+    {
+        RandomService::GetInstance().fromJson(snapshot.section(SaveGame::SECTION_RANDOM).toObject());
+    }
+
+    return save_all_data();
+}
+
+bool PetViewModel::restore_section(const char *key, const std::function<void(BinaryReader &)> &from_binary,
+                                   const std::function<void(const QJsonValue &)> &from_json)
+{
+    if (m_save_game.hasBinarySection(key))
+    {
+        BinaryReader in = m_save_game.binarySection(key);
+        from_binary(in);
+        return true;
+    }
+    if (m_save_game.hasSection(key))
+    {
+        from_json(m_save_game.section(key));
+        return true;
+    }
+    return false;
+}
 
 void PetViewModel::notification_cb(uint32_t id, void *p)
 {
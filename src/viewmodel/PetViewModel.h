@@ -9,8 +9,13 @@
 #include "../model/ForgeModel.h"
 #include "../common/PropertyTrigger.h"
 #include "../common/CommandManager.h"
+#include "../common/SaveGame.h"
+#include "../common/AutoSaver.h"
+#include "../common/SaveJournal.h"
+#include "../common/StartupPipeline.h"
 #include "../common/EventMgr.h"
 #include "../common/EventDefine.h"
+#include <functional>
 #include "commands/MovePetCommand.h"
 #include "commands/SwitchPetCommand.h"
 #include "commands/ShowStatsPanelCommand.h"
@@ -28,17 +33,19 @@
 #include "../common/EventMgr.h"
 #include "../common/EventDefine.h"
 
-class PetViewModel : public EventListener<AddItemEvent>
+class PetViewModel : public EventListener<AddItemEvent>, public EventListener<AddItemBatchEvent>
 {
 public:
     // 响应事件的函数
     void OnEvent(AddItemEvent event) override;
+    void OnEvent(AddItemBatchEvent event) override;
     PetViewModel() noexcept;
     PetViewModel(const PetViewModel &) = delete;
     ~PetViewModel() noexcept
     {
         // 注销事件监听器
         EventMgr::GetInstance().UnregisterEvent<AddItemEvent>(this);
+        EventMgr::GetInstance().UnregisterEvent<AddItemBatchEvent>(this);
     }
 
     PetViewModel &operator=(const PetViewModel &) = delete;
@@ -74,6 +81,7 @@ public:
     // {
     //     m_isInMovingMode = false;
     // Properties
+    // 以下指针指向模型的实时数据，只在GUI线程上读取；需要一组互相一致的值或在其他线程读取时用 get_pet_snapshot()
     const QPoint *get_position() const noexcept
     {
         return &(m_sp_pet_model->get_info()->position);
@@ -115,6 +123,18 @@ public:
         return m_sp_pet_model ? &(m_sp_pet_model->get_info()->name) : nullptr;
     }
 
+    // 自动移动期间的高频位置通道
+    PositionChannel *get_position_channel() noexcept
+    {
+        return m_sp_pet_model ? &m_sp_pet_model->get_position_channel() : nullptr;
+    }
+
+    // 当前宠物的不可变快照，可以在任意线程持有
+    PetInfoSnapshot get_pet_snapshot() const noexcept
+    {
+        return m_sp_pet_model ? m_sp_pet_model->snapshot() : PetInfoSnapshot();
+    }
+
     // Commands - 通过CommandManager统一管理
     CommandManager &get_command_manager() noexcept
     {
@@ -284,6 +304,11 @@ public:
         return m_sp_work_model ? m_sp_work_model->getRemainingTime() : 0;
     }
 
+    QDeadlineTimer get_work_deadline() const noexcept
+    {
+        return m_sp_work_model ? m_sp_work_model->getDeadline() : QDeadlineTimer();
+    }
+
     bool is_continuous_work_mode() const noexcept
     {
         return m_sp_work_model ? m_sp_work_model->isContinuousMode() : false;
@@ -324,23 +349,71 @@ public:
         return m_sp_forge_model ? m_sp_forge_model->get_trigger() : empty_trigger;
     }
 
-    // 持久化方法
-    void save_pet_data(const QString &filename = "pet_data.json") const
+    // 启动流水线的GUI阶段，按依赖顺序执行
+    static constexpr const char *STAGE_RANDOM = "random";
+    static constexpr const char *STAGE_COLLECTION = "collection";
+    static constexpr const char *STAGE_BACKPACK = "backpack";
+    static constexpr const char *STAGE_FORGE = "forge";
+    static constexpr const char *STAGE_PET = "pet";
+    static constexpr const char *STAGE_JOURNAL = "journal";
+    static constexpr const char *STAGE_WORK = "work";
+    static constexpr const char *STAGE_AUTOSAVE = "autosave";
+
+    // 启动加载：图鉴配置、存档文件、配方表在线程池中并发解析，解析完成后在GUI线程按依赖顺序恢复各模型
+    // 立即返回，需在 set_pet_model 之后调用
+    void start_loading();
+
+    // 阻塞等待加载完成（导入/导出存档等需要完整数据的场合）
+    void wait_until_loaded()
     {
-        if (m_sp_pet_model)
-        {
-            m_sp_pet_model->save_to_file(filename);
-        }
+        m_startup.waitForFinished();
+    }
+
+    bool is_ready(const char *stage) const
+    {
+        return m_startup.isReady(stage);
+    }
+
+    // 阶段完成后在GUI线程调用 callback，已完成则立即调用
+    void when_ready(const char *stage, std::function<void()> callback)
+    {
+        m_startup.whenReady(stage, std::move(callback));
     }
 
+    // 持久化方法：所有模型写入同一个二进制存档快照，快照不存在时回退到JSON快照和旧的分文件存档
+    // 自动存档运行时只采集快照交给存档线程，不在GUI线程写盘
+    bool save_all_data(const QString &filename = SaveGame::DEFAULT_FILENAME);
+
+    // 打开存档日志并重放快照之后的记录，之后各模型的修改都会追加到日志（需在宠物数据加载后调用）
+    void replay_journal();
+
+    // 启动后台自动存档（需在所有数据加载完成后调用）
+    void start_autosave();
+
+    // 保存剩余的修改并停止自动存档；未启动时同步保存一次
+    void stop_autosave();
+
+    // 调试用：当前数据导出为JSON快照 / 从JSON快照导入并写回二进制存档
+    bool export_save_json(const QString &path);
+    bool import_save_json(const QString &path);
+
     void load_pet_data(const QString &filename = "pet_data.json")
     {
-        if (m_sp_pet_model)
+        if (!m_sp_pet_model)
+        {
+            return;
+        }
+        if (!restore_section(
+                SaveGame::SECTION_PET, [this](BinaryReader &in) { m_sp_pet_model->read_binary(in); },
+                [this](const QJsonValue &json) { m_sp_pet_model->from_json(json.toObject()); }))
         {
             m_sp_pet_model->load_from_file(filename);
         }
     }
 
+    // 加载打工状态并结算离线期间错过的打工周期（需在宠物数据加载后调用）
+    void load_work_data(const QString &filename = "work_data.json");
+
 private:
     // Notification
     static void notification_cb(uint32_t id, void *p);
@@ -348,6 +421,24 @@ private:
     // UI methods
     void showForgePanel();
 
+    // 采集各分区的存档快照；dirty_only 为 true 时只采集有修改的分区，采集后清除脏标记
+    AutoSaver::Sections collect_save_sections(bool dirty_only);
+
+    // 启动流水线中各模型的恢复阶段
+    void load_random_state();
+    void load_collection_data();
+    void load_backpack_data();
+    void load_forge_data();
+
+    // 快照写盘后丢弃日志中已经包含在快照里的记录
+    void compact_journal();
+
+    void attach_journal(SaveJournal *journal) noexcept;
+
+    // 按 二进制快照 -> JSON快照 的顺序恢复一个分区，快照中都没有时返回false
+    bool restore_section(const char *key, const std::function<void(BinaryReader &)> &from_binary,
+                         const std::function<void(const QJsonValue &)> &from_json);
+
 private:
     // Model
     std::shared_ptr<PetModel> m_sp_pet_model;
@@ -357,6 +448,13 @@ private:
     std::shared_ptr<AutoMovementModel> m_sp_auto_movement_model;
     std::shared_ptr<ForgeModel> m_sp_forge_model;
 
+    // 存档快照
+    SaveGame m_save_game;
+    AutoSaver m_autosaver;
+    SaveJournal m_journal;
+    uint64_t m_journal_snapshot_seq = 0;        // 最近提交的快照包含的日志序号
+    quint64 m_journal_snapshot_generation = 0;  // 该快照的提交代号
+
     // Commands
     CommandManager m_command_manager;
     MovePetCommand m_move_command;
@@ -376,6 +474,9 @@ private:
 
     // Trigger
     PropertyTrigger m_trigger;
+
+    // 启动流水线：后台阶段会访问存档快照，放在最后保证最先析构
+    StartupPipeline m_startup;
 };
 
 #endif
\ No newline at end of file
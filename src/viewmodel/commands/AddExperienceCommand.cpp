@@ -19,7 +19,7 @@ int AddExperienceCommand::exec(ICommandParameter* param)
     m_view_model->add_experience(exp_param->experience);
     
     // 自动保存
-    m_view_model->save_pet_data();
+    m_view_model->save_all_data();
     
     return 0;
 }
@@ -19,7 +19,7 @@ int AddMoneyCommand::exec(ICommandParameter* param)
     m_view_model->add_money(money_param->money);
     
     // 自动保存
-    m_view_model->save_pet_data();
+    m_view_model->save_all_data();
     
     return 0;
 }
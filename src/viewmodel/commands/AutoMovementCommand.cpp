@@ -35,8 +35,8 @@ int AutoMovementCommand::exec(ICommandParameter *p)
         {
             AutoMovementConfig config;
             config.mode = param->movementMode;
-            config.speed = 10;
-            config.updateInterval = 50;
+            config.maxSpeed = 200.0;
+            config.acceleration = 800.0;
             config.enableRandomPause = false;
             config.pauseProbability = 0;
             config.pauseDuration = 0;
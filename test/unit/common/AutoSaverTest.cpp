@@ -0,0 +1,84 @@
+#include <gtest/gtest.h>
+#include "../../../src/common/AutoSaver.h"
+#include "../../../src/common/SaveGame.h"
+#include <QTemporaryDir>
+
+namespace {
+
+// 模拟一个模型：值写在快照里，修改时置脏标记
+struct FakeModel {
+    uint64_t value = 0;
+    bool dirty = false;
+    int collects = 0;
+
+    AutoSaver::Sections collect(bool dirtyOnly) {
+        ++collects;
+        AutoSaver::Sections sections;
+        if (!dirtyOnly || dirty) {
+            sections[1] = [snapshot = value](BinaryWriter &out) { out.writeUInt(1, snapshot); };
+            dirty = false;
+        }
+        return sections;
+    }
+};
+
+uint64_t readSavedValue(const QString &path) {
+    SaveGame loaded;
+    EXPECT_TRUE(loaded.loadFile(path));
+    BinaryReader in = loaded.binarySection(SaveGame::SECTION_PET);
+    uint64_t value = 0;
+    while (in.next()) {
+        value = in.readUInt();
+    }
+    return value;
+}
+
+} // namespace
+
+TEST(AutoSaverTest, WritesLatestSnapshot) {
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    const QString path = dir.filePath("save_data.dps");
+
+    FakeModel model;
+    AutoSaver saver;
+    saver.start(path, [&](bool dirtyOnly) { return model.collect(dirtyOnly); }, 60000);
+    saver.flush();
+    EXPECT_EQ(readSavedValue(path), 0u);
+
+    // 快照按值保存，之后的修改不影响已提交的快照
+    for (int i = 1; i <= 100; ++i) {
+        model.value = uint64_t(i);
+        model.dirty = true;
+        saver.saveNow();
+    }
+    saver.stop();
+
+    EXPECT_EQ(readSavedValue(path), 100u);
+    // 连续提交会被合并，写盘次数不会超过提交次数
+    EXPECT_GE(saver.writeCount(), 2u);
+    EXPECT_LE(saver.writeCount(), 101u);
+}
+
+TEST(AutoSaverTest, StopSavesRemainingChanges) {
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    const QString path = dir.filePath("save_data.dps");
+
+    FakeModel model;
+    AutoSaver saver;
+    saver.start(path, [&](bool dirtyOnly) { return model.collect(dirtyOnly); }, 60000);
+    saver.flush();
+    const quint64 writes = saver.writeCount();
+
+    // 没有修改时停止不会再写盘
+    model.value = 7;
+    saver.stop();
+    EXPECT_EQ(saver.writeCount(), writes);
+    EXPECT_EQ(readSavedValue(path), 0u);
+
+    model.dirty = true;
+    saver.start(path, [&](bool dirtyOnly) { return model.collect(dirtyOnly); }, 60000);
+    saver.stop();
+    EXPECT_EQ(readSavedValue(path), 7u);
+}
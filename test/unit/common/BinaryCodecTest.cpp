@@ -0,0 +1,163 @@
+#include <gtest/gtest.h>
+#include "../../../src/common/BinaryCodec.h"
+#include <limits>
+
+namespace {
+
+BinaryReader openReader(const std::string &data) {
+    BinaryReader reader;
+    EXPECT_TRUE(reader.open(data.data(), data.size()));
+    return reader;
+}
+
+} // namespace
+
+TEST(BinaryCodecTest, ScalarsRoundTrip) {
+    BinaryWriter out;
+    out.writeUInt(1, 300);
+    out.writeInt(2, -123456789);
+    out.writeBool(3, true);
+    out.writeDouble(4, 3.25);
+    out.writeFixed64(5, std::numeric_limits<uint64_t>::max());
+    out.writeString(6, "小蜘蛛");
+    std::string data = out.finish(7);
+
+    BinaryReader in = openReader(data);
+    EXPECT_EQ(in.schemaVersion(), 7u);
+
+    ASSERT_TRUE(in.next());
+    EXPECT_EQ(in.field(), 1u);
+    EXPECT_EQ(in.readUInt(), 300u);
+    ASSERT_TRUE(in.next());
+    EXPECT_EQ(in.readInt(), -123456789);
+    ASSERT_TRUE(in.next());
+    EXPECT_TRUE(in.readBool());
+    ASSERT_TRUE(in.next());
+    EXPECT_EQ(in.readDouble(), 3.25);
+    ASSERT_TRUE(in.next());
+    EXPECT_EQ(in.readFixed64(), std::numeric_limits<uint64_t>::max());
+    ASSERT_TRUE(in.next());
+    EXPECT_EQ(in.readString(), "小蜘蛛");
+    EXPECT_FALSE(in.next());
+    EXPECT_TRUE(in.isValid());
+}
+
+TEST(BinaryCodecTest, RepeatedStringsStoredOnce) {
+    BinaryWriter out;
+    for (int i = 0; i < 100; ++i) {
+        out.writeString(1, ":/resources/gif/spider.gif");
+    }
+    std::string data = out.finish(1);
+    // 字符串只出现一次，每次引用2字节
+    EXPECT_LT(data.size(), 26u + 100u * 2u + 16u);
+
+    BinaryReader in = openReader(data);
+    int count = 0;
+    while (in.next()) {
+        EXPECT_EQ(in.readString(), ":/resources/gif/spider.gif");
+        ++count;
+    }
+    EXPECT_EQ(count, 100);
+}
+
+TEST(BinaryCodecTest, PackedArraysAndNestedMessages) {
+    BinaryWriter out;
+    out.beginMessage(1);
+    out.writePackedUInts(1, {1, 127, 128, 1u << 20});
+    out.writePackedInts(2, {-1, 0, 1, -1000000});
+    out.beginMessage(3);
+    out.writeString(1, "inner");
+    out.endMessage();
+    out.endMessage();
+    out.writeUInt(2, 42);
+    std::string data = out.finish(1);
+
+    BinaryReader in = openReader(data);
+    ASSERT_TRUE(in.next());
+    ASSERT_EQ(in.field(), 1u);
+    BinaryReader message = in.readMessage();
+
+    std::vector<uint64_t> uints;
+    std::vector<int64_t> ints;
+    std::string inner;
+    while (message.next()) {
+        switch (message.field()) {
+        case 1: message.readPackedUInts(uints); break;
+        case 2: message.readPackedInts(ints); break;
+        case 3: {
+            BinaryReader nested = message.readMessage();
+            while (nested.next()) {
+                inner = nested.readString();
+            }
+            break;
+        }
+        default: break;
+        }
+    }
+    EXPECT_EQ(uints, (std::vector<uint64_t>{1, 127, 128, 1u << 20}));
+    EXPECT_EQ(ints, (std::vector<int64_t>{-1, 0, 1, -1000000}));
+    EXPECT_EQ(inner, "inner");
+
+    ASSERT_TRUE(in.next());
+    EXPECT_EQ(in.readUInt(), 42u);
+    EXPECT_TRUE(in.isValid());
+}
+
+TEST(BinaryCodecTest, UnknownFieldsAreSkipped) {
+    // 新版本写入了旧版本不认识的字段9/10/11
+    BinaryWriter out;
+    out.writeUInt(1, 5);
+    out.writeString(9, "future");
+    out.writeDouble(10, 1.5);
+    out.beginMessage(11);
+    out.writeUInt(1, 99);
+    out.endMessage();
+    out.writeUInt(2, 6);
+    std::string data = out.finish(2);
+
+    BinaryReader in = openReader(data);
+    uint64_t a = 0;
+    uint64_t b = 0;
+    while (in.next()) {
+        switch (in.field()) {
+        case 1: a = in.readUInt(); break;
+        case 2: b = in.readUInt(); break;
+        default: break;
+        }
+    }
+    EXPECT_EQ(a, 5u);
+    EXPECT_EQ(b, 6u);
+    EXPECT_TRUE(in.isValid());
+}
+
+TEST(BinaryCodecTest, WireTypeMismatchReturnsDefault) {
+    BinaryWriter out;
+    out.writeString(1, "text");
+    out.writeUInt(2, 8);
+    std::string data = out.finish(1);
+
+    BinaryReader in = openReader(data);
+    ASSERT_TRUE(in.next());
+    EXPECT_EQ(in.readUInt(), 0u);
+    ASSERT_TRUE(in.next());
+    EXPECT_EQ(in.readUInt(), 8u);
+    EXPECT_TRUE(in.isValid());
+}
+
+TEST(BinaryCodecTest, RejectsBadHeaderAndTruncatedBody) {
+    BinaryReader in;
+    EXPECT_FALSE(in.open("JSON", 4));
+
+    BinaryWriter out;
+    out.writePackedUInts(1, std::vector<uint64_t>(100, 1000));
+    std::string data = out.finish(1);
+    data.resize(data.size() - 10);
+
+    BinaryReader truncated = openReader(data);
+    ASSERT_TRUE(truncated.next());
+    std::vector<uint64_t> values;
+    truncated.readPackedUInts(values);
+    EXPECT_TRUE(values.empty());
+    EXPECT_FALSE(truncated.isValid());
+    EXPECT_FALSE(truncated.next());
+}
@@ -0,0 +1,43 @@
+#include <gtest/gtest.h>
+#include "../../../src/common/ItemCatalog.h"
+
+// 编译期物品表在构建时从 collection_items.csv 生成，这里检查生成结果和索引
+static_assert(item_catalog::find(Items::SUNSHINE_WEAK)->category == CollectionCategory::Material,
+              "阳光应当是材料");
+static_assert(item_catalog::find(Items::WOOD_DIVINE)->rarity == CollectionRarity::Legendary,
+              "神木应当是传说稀有度");
+
+TEST(ItemCatalogTest, IndexMatchesItemIds) {
+    for (int i = 0; i < item_catalog::COUNT; ++i) {
+        const ItemMeta &meta = item_catalog::ITEMS[i];
+        ASSERT_EQ(item_catalog::find(meta.id), &meta);
+    }
+
+    int present = 0;
+    for (int id = 0; id <= item_catalog::MAX_ID; ++id) {
+        if (item_catalog::contains(id)) {
+            ++present;
+        }
+    }
+    EXPECT_EQ(present, item_catalog::COUNT);
+}
+
+TEST(ItemCatalogTest, UnknownIdsAreNotFound) {
+    EXPECT_EQ(item_catalog::find(-1), nullptr);
+    EXPECT_EQ(item_catalog::find(0), nullptr);
+    EXPECT_EQ(item_catalog::find(item_catalog::MAX_ID + 1), nullptr);
+}
+
+TEST(ItemCatalogTest, KeysResolveToCsvRows) {
+    const ItemMeta *sunshine = item_catalog::find(Items::SUNSHINE_HOT);
+    ASSERT_NE(sunshine, nullptr);
+    EXPECT_EQ(int(sunshine->id), 8);
+    EXPECT_STREQ(sunshine->name, "炽热阳光");
+    EXPECT_EQ(sunshine->rarity, CollectionRarity::Epic);
+
+    const ItemMeta *hourglass = item_catalog::find(Items::TIME_HOURGLASS);
+    ASSERT_NE(hourglass, nullptr);
+    EXPECT_TRUE(hourglass->hidden);
+    EXPECT_STREQ(item_catalog::categoryName(hourglass->category), "物品");
+    EXPECT_STREQ(item_catalog::rarityName(hourglass->rarity), "传说");
+}
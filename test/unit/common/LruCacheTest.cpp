@@ -0,0 +1,45 @@
+#include <gtest/gtest.h>
+#include "../../../src/common/LruCache.h"
+#include <memory>
+#include <string>
+
+// 按字节预算的 LRU：命中后移到最前、超出预算淘汰最久未用、被淘汰的值仍可被持有者使用
+TEST(LruCacheTest, EvictsLeastRecentlyUsedOverBudget) {
+    LruCache<std::string, int> cache(100);
+    cache.insert("walk", 1, 40);
+    cache.insert("kick", 2, 40);
+    ASSERT_NE(cache.find("walk"), nullptr); // walk 变为最近使用
+
+    cache.insert("idle", 3, 40);
+    EXPECT_EQ(cache.find("kick"), nullptr);
+    ASSERT_NE(cache.find("walk"), nullptr);
+    EXPECT_EQ(*cache.find("idle"), 3);
+    EXPECT_EQ(cache.usedBytes(), 80);
+    EXPECT_EQ(cache.evictions(), 1);
+    EXPECT_EQ(cache.hits(), 3);
+    EXPECT_EQ(cache.misses(), 1);
+
+    // 替换同一个键时按新的开销计算
+    cache.insert("walk", 4, 10);
+    EXPECT_EQ(*cache.find("walk"), 4);
+    EXPECT_EQ(cache.usedBytes(), 50);
+    EXPECT_EQ(cache.size(), 2);
+}
+
+TEST(LruCacheTest, KeepsNewestEntryEvenIfOversized) {
+    LruCache<int, std::shared_ptr<const std::string>> cache(100);
+    cache.insert(1, std::make_shared<const std::string>("small"), 30);
+    std::shared_ptr<const std::string> held = *cache.find(1);
+
+    cache.insert(2, std::make_shared<const std::string>("huge"), 500);
+    EXPECT_EQ(cache.size(), 1);
+    EXPECT_NE(cache.find(2), nullptr);
+    EXPECT_EQ(cache.find(1), nullptr);
+    EXPECT_EQ(*held, "small");
+
+    // 缩小预算时立即淘汰，只留下最近使用的
+    cache.insert(3, std::make_shared<const std::string>("tiny"), 1);
+    cache.setBudget(0);
+    EXPECT_EQ(cache.size(), 1);
+    EXPECT_NE(cache.find(3), nullptr);
+}
@@ -0,0 +1,107 @@
+#include <gtest/gtest.h>
+#include "../../../src/common/SaveGame.h"
+#include <QFile>
+#include <QJsonArray>
+#include <QTemporaryDir>
+
+TEST(SaveGameTest, SectionsRoundTrip) {
+    SaveGame save;
+    QJsonObject pet;
+    pet["currentPetType"] = 1;
+    save.setSection(SaveGame::SECTION_PET, pet);
+    save.setSection(SaveGame::SECTION_BACKPACK, QJsonArray{QJsonObject{{"itemId", 6}, {"count", 3}}});
+
+    SaveGame loaded;
+    ASSERT_TRUE(loaded.deserialize(save.serialize()));
+    EXPECT_TRUE(loaded.isLoaded());
+    EXPECT_EQ(loaded.version(), SaveGame::CURRENT_VERSION);
+    EXPECT_EQ(loaded.section(SaveGame::SECTION_PET).toObject()["currentPetType"].toInt(), 1);
+    EXPECT_EQ(loaded.section(SaveGame::SECTION_BACKPACK).toArray().size(), 1);
+    EXPECT_FALSE(loaded.hasSection(SaveGame::SECTION_FORGE));
+}
+
+TEST(SaveGameTest, RejectsTruncatedSnapshot) {
+    SaveGame save;
+    save.setSection(SaveGame::SECTION_WORK, QJsonObject{{"status", 1}});
+    QByteArray data = save.serialize();
+    data.chop(data.size() / 2);
+
+    SaveGame loaded;
+    EXPECT_FALSE(loaded.deserialize(data));
+    EXPECT_FALSE(loaded.isLoaded());
+}
+
+TEST(SaveGameTest, RejectsNonSnapshotJson) {
+    // 旧的分文件存档不是快照格式
+    SaveGame loaded;
+    EXPECT_FALSE(loaded.deserialize("[{\"itemId\":6,\"count\":3}]"));
+    EXPECT_FALSE(loaded.deserialize("{\"pets\":{}}"));
+}
+
+TEST(SaveGameTest, AtomicWriteReplacesWholeFile) {
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    const QString path = dir.filePath("save_data.json");
+
+    ASSERT_TRUE(SaveGame::writeFileAtomically(path, QByteArray(4096, 'a')));
+    ASSERT_TRUE(SaveGame::writeFileAtomically(path, "short"));
+
+    QFile file(path);
+    ASSERT_TRUE(file.open(QIODevice::ReadOnly));
+    EXPECT_EQ(file.readAll(), QByteArray("short"));
+}
+
+TEST(SaveGameTest, FailedWriteKeepsOldFile) {
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    const QString path = dir.filePath("save_data.json");
+    ASSERT_TRUE(SaveGame::writeFileAtomically(path, "old"));
+
+    // 目标目录不存在，写入失败时不能破坏已有文件
+    EXPECT_FALSE(SaveGame::writeFileAtomically(dir.filePath("missing/save_data.json"), "new"));
+
+    QFile file(path);
+    ASSERT_TRUE(file.open(QIODevice::ReadOnly));
+    EXPECT_EQ(file.readAll(), QByteArray("old"));
+}
+
+TEST(SaveGameTest, BinarySectionsRoundTrip) {
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    const QString path = dir.filePath("save_data.dps");
+
+    BinaryWriter out;
+    out.beginMessage(SaveGame::sectionField(SaveGame::SECTION_BACKPACK));
+    out.writePackedUInts(1, {6, 7});
+    out.writePackedUInts(2, {3, 4});
+    out.endMessage();
+    const std::string data = out.finish(SaveGame::CURRENT_VERSION);
+    ASSERT_TRUE(SaveGame::writeFileAtomically(path, QByteArray(data.data(), int(data.size()))));
+
+    SaveGame loaded;
+    ASSERT_TRUE(loaded.loadFile(path));
+    EXPECT_TRUE(loaded.hasBinarySection(SaveGame::SECTION_BACKPACK));
+    EXPECT_FALSE(loaded.hasSection(SaveGame::SECTION_PET));
+
+    BinaryReader backpack = loaded.binarySection(SaveGame::SECTION_BACKPACK);
+    std::vector<uint64_t> ids;
+    while (backpack.next()) {
+        if (backpack.field() == 1) {
+            backpack.readPackedUInts(ids);
+        }
+    }
+    EXPECT_EQ(ids, (std::vector<uint64_t>{6, 7}));
+}
+
+TEST(SaveGameTest, RejectsTruncatedBinarySnapshot) {
+    BinaryWriter out;
+    out.beginMessage(SaveGame::sectionField(SaveGame::SECTION_FORGE));
+    out.writePackedUInts(5, std::vector<uint64_t>(1000, 12));
+    out.endMessage();
+    std::string data = out.finish(SaveGame::CURRENT_VERSION);
+    data.resize(data.size() / 2);
+
+    SaveGame loaded;
+    EXPECT_FALSE(loaded.deserialize(QByteArray(data.data(), int(data.size()))));
+    EXPECT_FALSE(loaded.isLoaded());
+}
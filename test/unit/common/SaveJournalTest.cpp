@@ -0,0 +1,148 @@
+#include <gtest/gtest.h>
+#include "../../../src/common/SaveJournal.h"
+#include <QFile>
+#include <QTemporaryDir>
+#include <vector>
+
+namespace {
+
+BinaryWriter itemRecord(uint64_t id, uint64_t count) {
+    BinaryWriter record;
+    record.writeUInt(1, id);
+    record.writeUInt(2, count);
+    return record;
+}
+
+// 重放后得到的 (序号顺序的) 物品数量
+std::vector<uint64_t> replayCounts(const SaveJournal &journal, uint64_t afterSeq) {
+    std::vector<uint64_t> counts;
+    journal.replay(afterSeq, [&](SaveJournal::RecordType type, BinaryReader &in) {
+        EXPECT_EQ(type, SaveJournal::BackpackItem);
+        while (in.next()) {
+            if (in.field() == 2) {
+                counts.push_back(in.readUInt());
+            }
+        }
+    });
+    return counts;
+}
+
+} // namespace
+
+TEST(SaveJournalTest, ReplaysRecordsAfterSnapshot) {
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    const QString path = dir.filePath("save.journal");
+
+    SaveJournal journal;
+    ASSERT_TRUE(journal.open(path));
+    for (uint64_t i = 1; i <= 5; ++i) {
+        ASSERT_TRUE(journal.append(SaveJournal::BackpackItem, itemRecord(1001, i * 10)));
+    }
+    EXPECT_EQ(journal.lastSeq(), 5u);
+    journal.close();
+
+    // 重新打开后序号接着之前的记录
+    SaveJournal reopened;
+    ASSERT_TRUE(reopened.open(path));
+    EXPECT_EQ(reopened.lastSeq(), 5u);
+    EXPECT_EQ(replayCounts(reopened, 3), (std::vector<uint64_t>{40, 50}));
+}
+
+TEST(SaveJournalTest, DropsTornTail) {
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    const QString path = dir.filePath("save.journal");
+
+    SaveJournal journal;
+    ASSERT_TRUE(journal.open(path));
+    ASSERT_TRUE(journal.append(SaveJournal::BackpackItem, itemRecord(1001, 1)));
+    ASSERT_TRUE(journal.append(SaveJournal::BackpackItem, itemRecord(1001, 2)));
+    const qint64 size = journal.size();
+    journal.close();
+
+    // 模拟崩溃时最后一条记录只写了一半
+    QFile file(path);
+    ASSERT_TRUE(file.open(QIODevice::ReadWrite));
+    ASSERT_TRUE(file.resize(size - 3));
+    file.close();
+
+    SaveJournal reopened;
+    ASSERT_TRUE(reopened.open(path));
+    EXPECT_EQ(reopened.lastSeq(), 1u);
+    EXPECT_EQ(replayCounts(reopened, 0), (std::vector<uint64_t>{1}));
+
+    // 截掉残缺记录后可以继续追加
+    ASSERT_TRUE(reopened.append(SaveJournal::BackpackItem, itemRecord(1001, 3)));
+    EXPECT_EQ(replayCounts(reopened, 0), (std::vector<uint64_t>{1, 3}));
+}
+
+TEST(SaveJournalTest, StopsAtRecordWithHugeLength) {
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    const QString path = dir.filePath("save.journal");
+
+    SaveJournal journal;
+    ASSERT_TRUE(journal.open(path));
+    ASSERT_TRUE(journal.append(SaveJournal::BackpackItem, itemRecord(1001, 1)));
+    ASSERT_TRUE(journal.append(SaveJournal::BackpackItem, itemRecord(1001, 2)));
+    const qint64 size = journal.size();
+    journal.close();
+
+    // 损坏的记录：序号3、类型1、长度为 2^64-2（size + 4 会回绕成2），后面跟几个字节
+    QByteArray corrupt;
+    corrupt.append(char(0x03));
+    corrupt.append(char(0x01));
+    corrupt.append(char(0xFE));
+    for (int i = 0; i < 8; ++i) {
+        corrupt.append(char(0xFF));
+    }
+    corrupt.append(char(0x01));
+    corrupt.append("abcd");
+
+    QFile file(path);
+    ASSERT_TRUE(file.open(QIODevice::Append));
+    ASSERT_EQ(file.write(corrupt), corrupt.size());
+    file.close();
+
+    // 恢复停在最后一条完好的记录，残缺部分被截掉
+    SaveJournal reopened;
+    ASSERT_TRUE(reopened.open(path));
+    EXPECT_EQ(reopened.lastSeq(), 2u);
+    EXPECT_EQ(reopened.size(), size);
+    EXPECT_EQ(replayCounts(reopened, 0), (std::vector<uint64_t>{1, 2}));
+}
+
+TEST(SaveJournalTest, TruncateKeepsLaterRecords) {
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    const QString path = dir.filePath("save.journal");
+
+    SaveJournal journal;
+    ASSERT_TRUE(journal.open(path));
+    for (uint64_t i = 1; i <= 4; ++i) {
+        ASSERT_TRUE(journal.append(SaveJournal::BackpackItem, itemRecord(1001, i)));
+    }
+
+    ASSERT_TRUE(journal.truncateThrough(2));
+    EXPECT_EQ(replayCounts(journal, 0), (std::vector<uint64_t>{3, 4}));
+
+    ASSERT_TRUE(journal.truncateThrough(4));
+    EXPECT_EQ(journal.size(), 0);
+
+    // 清空后序号不回退
+    ASSERT_TRUE(journal.append(SaveJournal::BackpackItem, itemRecord(1001, 5)));
+    EXPECT_EQ(journal.lastSeq(), 5u);
+}
+
+TEST(SaveJournalTest, RejectsRecordsWithStrings) {
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+
+    SaveJournal journal;
+    ASSERT_TRUE(journal.open(dir.filePath("save.journal")));
+    BinaryWriter record;
+    record.writeString(1, "name");
+    EXPECT_FALSE(journal.append(SaveJournal::BackpackItem, record));
+    EXPECT_EQ(journal.lastSeq(), 0u);
+}
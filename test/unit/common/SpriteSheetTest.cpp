@@ -0,0 +1,46 @@
+#include <gtest/gtest.h>
+#include "../../../src/common/SpriteSheet.h"
+
+// 精灵图集帧表：解析、相对路径拼接、默认时长、非法帧表
+TEST(SpriteSheetTest, ParsesFrameTable) {
+    const QByteArray json = R"({
+        "image": "spider.png",
+        "loop": 2,
+        "frames": [
+            {"x": 0, "y": 0, "w": 400, "h": 97, "duration": 80},
+            {"x": 400, "y": 0, "w": 400, "h": 97}
+        ]
+    })";
+
+    SpriteSheet sheet;
+    ASSERT_TRUE(SpriteSheet::parse(json, ":/resources/sprite", sheet));
+    EXPECT_EQ(sheet.imagePath, QString(":/resources/sprite/spider.png"));
+    EXPECT_EQ(sheet.loopCount, 2);
+    ASSERT_EQ(sheet.frames.size(), 2);
+    EXPECT_EQ(sheet.frames[0].rect, QRect(0, 0, 400, 97));
+    EXPECT_EQ(sheet.frames[0].duration, 80);
+    EXPECT_EQ(sheet.frames[1].rect, QRect(400, 0, 400, 97));
+    EXPECT_EQ(sheet.frames[1].duration, SpriteSheet::DEFAULT_DURATION);
+
+    EXPECT_TRUE(SpriteSheet::isSpriteSheetPath(":/resources/sprite/spider.json"));
+    EXPECT_FALSE(SpriteSheet::isSpriteSheetPath(":/resources/gif/spider.gif"));
+}
+
+TEST(SpriteSheetTest, RoundTripsAndRejectsBadTables) {
+    SpriteSheet sheet;
+    sheet.frames = {{QRect(0, 0, 48, 45), 60}, {QRect(48, 0, 48, 45), 70}};
+
+    SpriteSheet loaded;
+    ASSERT_TRUE(SpriteSheet::parse(sheet.toJson("kicking.png"), QString(), loaded));
+    EXPECT_EQ(loaded.imagePath, QString("kicking.png"));
+    EXPECT_EQ(loaded.loopCount, -1);
+    ASSERT_EQ(loaded.frames.size(), 2);
+    EXPECT_EQ(loaded.frames[1].rect, QRect(48, 0, 48, 45));
+    EXPECT_EQ(loaded.frames[1].duration, 70);
+
+    // 解析失败时不修改输出
+    EXPECT_FALSE(SpriteSheet::parse("not json", QString(), loaded));
+    EXPECT_FALSE(SpriteSheet::parse(R"({"image": "a.png", "frames": []})", QString(), loaded));
+    EXPECT_FALSE(SpriteSheet::parse(R"({"image": "a.png", "frames": [{"x": 0, "y": 0, "w": 0, "h": 10}]})", QString(), loaded));
+    EXPECT_EQ(loaded.frames.size(), 2);
+}
@@ -0,0 +1,98 @@
+#include <gtest/gtest.h>
+#include "../../../src/common/StartupPipeline.h"
+#include <QString>
+#include <QStringList>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+TEST(StartupPipelineTest, StagesRunInDependencyOrder) {
+    StartupPipeline pipeline;
+    QStringList order;
+    std::atomic<int> parsed{0};
+
+    const auto slow = pipeline.addBackground("slow", [&parsed]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(30));
+        ++parsed;
+    });
+    const auto fast = pipeline.addBackground("fast", [&parsed]() { ++parsed; });
+
+    pipeline.addStage("first", {fast}, [&order]() { order << "first"; });
+    pipeline.addStage("second", {slow, fast}, [&order, &parsed]() {
+        EXPECT_EQ(parsed.load(), 2);
+        order << "second";
+    });
+    pipeline.addStage("third", {}, [&order]() { order << "third"; });
+
+    EXPECT_FALSE(pipeline.isReady("first"));
+    pipeline.start();
+    pipeline.waitForFinished();
+
+    EXPECT_TRUE(pipeline.isFinished());
+    EXPECT_EQ(order, (QStringList{"first", "second", "third"}));
+    EXPECT_TRUE(pipeline.isReady("slow"));
+    EXPECT_TRUE(pipeline.report().contains("second"));
+}
+
+TEST(StartupPipelineTest, BackgroundStagesRunConcurrently) {
+    StartupPipeline pipeline;
+    std::atomic<int> running{0};
+    std::atomic<int> peak{0};
+
+    std::vector<StartupPipeline::StageId> ids;
+    for (int i = 0; i < 3; ++i) {
+        ids.push_back(pipeline.addBackground(QString("load%1").arg(i), [&running, &peak]() {
+            const int now = ++running;
+            int expected = peak.load();
+            while (now > expected && !peak.compare_exchange_weak(expected, now)) {
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(30));
+            --running;
+        }));
+    }
+    pipeline.addStage("apply", ids, []() {});
+
+    pipeline.start();
+    pipeline.waitForFinished();
+    EXPECT_GT(peak.load(), 1);
+}
+
+TEST(StartupPipelineTest, WhenReadyRunsAfterStage) {
+    StartupPipeline pipeline;
+    bool loaded = false;
+    bool notified = false;
+
+    const auto parse = pipeline.addBackground("parse", []() {});
+    pipeline.addStage("model", {parse}, [&loaded]() { loaded = true; });
+    pipeline.start();
+
+    pipeline.whenReady("model", [&]() {
+        EXPECT_TRUE(loaded);
+        notified = true;
+    });
+    pipeline.waitForFinished();
+    EXPECT_TRUE(notified);
+
+    // 已就绪的阶段和不存在的阶段立即回调
+    int immediate = 0;
+    pipeline.whenReady("model", [&immediate]() { ++immediate; });
+    pipeline.whenReady("unknown", [&immediate]() { ++immediate; });
+    EXPECT_EQ(immediate, 2);
+}
+
+TEST(StartupPipelineTest, WaitInsideStageReturnsFalse) {
+    StartupPipeline pipeline;
+    bool nested = true;
+    bool laterRan = false;
+
+    pipeline.addStage("first", {}, [&]() { nested = pipeline.waitForFinished(); });
+    pipeline.addStage("second", {}, [&laterRan]() { laterRan = true; });
+
+    // 未启动时视为已完成
+    EXPECT_TRUE(pipeline.waitForFinished());
+
+    pipeline.start();
+    EXPECT_TRUE(pipeline.waitForFinished());
+    EXPECT_FALSE(nested);
+    EXPECT_TRUE(laterRan);
+}
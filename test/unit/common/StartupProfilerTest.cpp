@@ -0,0 +1,75 @@
+#include <gtest/gtest.h>
+#include "../../../src/common/StartupProfiler.h"
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTemporaryDir>
+#include <thread>
+#include <vector>
+
+TEST(StartupProfilerTest, WritesScopesAndMarksAsJson) {
+    StartupProfiler &profiler = StartupProfiler::instance();
+    profiler.enable();
+
+    {
+        StartupProfiler::Scope scope("test:gui");
+    }
+    std::thread([]() { StartupProfiler::Scope scope("test:worker"); }).join();
+    profiler.mark("test:mark");
+    profiler.mark("test:mark");
+    EXPECT_TRUE(profiler.hasMark("test:mark"));
+    EXPECT_FALSE(profiler.hasMark("test:gui"));
+
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    const QString path = dir.filePath("profile.json");
+    ASSERT_TRUE(profiler.writeJson(path));
+
+    QFile file(path);
+    ASSERT_TRUE(file.open(QIODevice::ReadOnly));
+    const QJsonArray entries = QJsonDocument::fromJson(file.readAll()).object()["entries"].toArray();
+
+    int marks = 0;
+    bool sawGui = false;
+    bool sawWorker = false;
+    for (const QJsonValue &value : entries) {
+        const QJsonObject entry = value.toObject();
+        const QString name = entry["name"].toString();
+        if (name == "test:mark") {
+            EXPECT_TRUE(entry["mark"].toBool());
+            ++marks;
+        } else if (name == "test:gui") {
+            EXPECT_GE(entry["duration_ms"].toDouble(), 0.0);
+            sawGui = true;
+        } else if (name == "test:worker") {
+            sawWorker = true;
+        }
+    }
+    EXPECT_EQ(marks, 1);
+    EXPECT_TRUE(sawGui);
+    EXPECT_TRUE(sawWorker);
+}
+
+TEST(StartupProfilerTest, ConcurrentMarksRecordedOnce) {
+    StartupProfiler &profiler = StartupProfiler::instance();
+    profiler.enable();
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 8; ++i) {
+        threads.emplace_back([&profiler]() {
+            for (int k = 0; k < 100; ++k) {
+                profiler.mark("test:race");
+            }
+        });
+    }
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+
+    int marks = 0;
+    for (const StartupProfiler::Entry &entry : profiler.entries()) {
+        marks += entry.mark && entry.name == "test:race" ? 1 : 0;
+    }
+    EXPECT_EQ(marks, 1);
+}
@@ -0,0 +1,64 @@
+#include <gtest/gtest.h>
+#include "../../../src/model/BroadPhase.h"
+#include <QRandomGenerator>
+#include <algorithm>
+
+// 排序扫描宽阶段：结果与逐对检测一致、按层过滤、移动后增量排序
+namespace {
+
+std::vector<CollisionPair> bruteForce(const std::vector<QRect>& rects, const std::vector<CollisionLayer>& layers) {
+    std::vector<CollisionPair> pairs;
+    for (int i = 0; i < static_cast<int>(rects.size()); ++i) {
+        for (int j = i + 1; j < static_cast<int>(rects.size()); ++j) {
+            if (!rects[i].isEmpty() && !rects[j].isEmpty() && SweepAndPrune::shouldTest(layers[i], layers[j]) &&
+                rects[i].intersects(rects[j])) {
+                pairs.push_back({i, j});
+            }
+        }
+    }
+    return pairs;
+}
+
+} // namespace
+
+TEST(BroadPhaseTest, MatchesBruteForceWhileEntitiesMove) {
+    QRandomGenerator rng(7);
+    std::vector<QRect> rects;
+    std::vector<CollisionLayer> layers;
+    SweepAndPrune broadPhase;
+    for (int i = 0; i < 300; ++i) {
+        const CollisionLayer layer = i % 5 == 0 ? CollisionLayer::Obstacle : CollisionLayer::Pet;
+        rects.push_back(QRect(rng.bounded(3000), rng.bounded(1000), rng.bounded(20, 200), rng.bounded(20, 200)));
+        layers.push_back(layer);
+        EXPECT_EQ(broadPhase.add(rects.back(), layer), i);
+    }
+
+    for (int frame = 0; frame < 30; ++frame) {
+        for (size_t i = 0; i < rects.size(); ++i) {
+            if (layers[i] == CollisionLayer::Pet) {
+                rects[i].translate(rng.bounded(-8, 9), rng.bounded(-8, 9));
+                broadPhase.update(static_cast<int>(i), rects[i]);
+            }
+        }
+        EXPECT_EQ(broadPhase.findPairs(), bruteForce(rects, layers)) << "frame " << frame;
+    }
+}
+
+TEST(BroadPhaseTest, LayersAndEmptyRectsAreFiltered) {
+    SweepAndPrune broadPhase;
+    const int pet = broadPhase.add(QRect(0, 0, 100, 100), CollisionLayer::Pet);
+    const int cursor = broadPhase.add(QRect(40, 40, 10, 10), CollisionLayer::Cursor);
+    const int iconA = broadPhase.add(QRect(50, 50, 48, 48), CollisionLayer::Obstacle);
+    broadPhase.add(QRect(60, 60, 48, 48), CollisionLayer::Obstacle);
+    const int hidden = broadPhase.add(QRect(), CollisionLayer::Pet);
+
+    // 鼠标和图标、图标和图标之间不检测，空的包围盒不参与
+    std::vector<CollisionPair> expected = {{pet, cursor}, {pet, iconA}, {pet, iconA + 1}};
+    EXPECT_EQ(broadPhase.findPairs(), expected);
+
+    // 移开之后不再相交
+    broadPhase.update(pet, QRect(500, 500, 100, 100));
+    broadPhase.update(hidden, QRect(0, 0, 60, 60));
+    expected = {{cursor, hidden}, {iconA, hidden}};
+    EXPECT_EQ(broadPhase.findPairs(), expected);
+}
@@ -0,0 +1,136 @@
+#include <gtest/gtest.h>
+#include "../../../src/model/CatalogCache.h"
+#include <QFile>
+#include <QTemporaryDir>
+
+namespace {
+
+const char *CSV =
+    "id,name,description,category,rarity,icon,detail,hidden\n"
+    "6,微光阳光,微弱的阳光,0,0,:/resources/img/sunshine.png,,false\n"
+    "7,温暖阳光,温暖的阳光,0,1,:/resources/img/sunshine.png,,false\n"
+    "201,隐藏成就,,3,3,:/resources/img/secret.png,:/resources/img/secret_big.png,true\n";
+
+void writeFile(const QString &path, const QByteArray &data) {
+    QFile file(path);
+    ASSERT_TRUE(file.open(QIODevice::WriteOnly));
+    file.write(data);
+}
+
+} // namespace
+
+TEST(CatalogCacheTest, BuildsCacheOnFirstLoadThenReadsIt) {
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    const QString csv = dir.filePath("items.csv");
+    const QString cache = dir.filePath("items.cache");
+    writeFile(csv, CSV);
+
+    const QMap<int, CollectionItemInfo> parsed = CatalogCache::load(csv, cache);
+    ASSERT_EQ(parsed.size(), 3);
+    ASSERT_TRUE(QFile::exists(cache));
+
+    QMap<int, CollectionItemInfo> cached;
+    ASSERT_TRUE(CatalogCache::read(cache, CatalogCache::hash(CSV), cached));
+    ASSERT_EQ(cached.size(), 3);
+    for (int id : {6, 7, 201}) {
+        EXPECT_EQ(cached[id].name, parsed[id].name);
+        EXPECT_EQ(cached[id].description, parsed[id].description);
+        EXPECT_EQ(cached[id].iconPath, parsed[id].iconPath);
+        EXPECT_EQ(cached[id].detailImagePath, parsed[id].detailImagePath);
+        EXPECT_EQ(cached[id].category, parsed[id].category);
+        EXPECT_EQ(cached[id].rarity, parsed[id].rarity);
+        EXPECT_EQ(cached[id].isHidden, parsed[id].isHidden);
+    }
+    EXPECT_EQ(cached[201].name, "隐藏成就");
+    EXPECT_TRUE(cached[201].isHidden);
+    EXPECT_EQ(cached[7].rarity, CollectionRarity::Rare);
+
+    // 缓存字符串引用映射内存，修改时会复制
+    QString name = cached[6].name;
+    name.append("+");
+    EXPECT_EQ(cached[6].name, "微光阳光");
+}
+
+TEST(CatalogCacheTest, RebuildsWhenCsvChanges) {
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    const QString csv = dir.filePath("items.csv");
+    const QString cache = dir.filePath("items.cache");
+    writeFile(csv, CSV);
+    CatalogCache::load(csv, cache);
+
+    const QByteArray changed = QByteArray(CSV) + "8,炽热阳光,炽热的阳光,0,2,:/resources/img/sunshine.png,,false\n";
+    writeFile(csv, changed);
+
+    QMap<int, CollectionItemInfo> stale;
+    EXPECT_FALSE(CatalogCache::read(cache, CatalogCache::hash(changed), stale));
+
+    const QMap<int, CollectionItemInfo> items = CatalogCache::load(csv, cache);
+    EXPECT_EQ(items.size(), 4);
+    QMap<int, CollectionItemInfo> rebuilt;
+    ASSERT_TRUE(CatalogCache::read(cache, CatalogCache::hash(changed), rebuilt));
+    EXPECT_EQ(rebuilt[8].name, "炽热阳光");
+}
+
+TEST(CatalogCacheTest, RejectsTruncatedCache) {
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    const QString csv = dir.filePath("items.csv");
+    const QString cache = dir.filePath("items.cache");
+    writeFile(csv, CSV);
+    CatalogCache::load(csv, cache);
+
+    QFile file(cache);
+    ASSERT_TRUE(file.open(QIODevice::ReadWrite));
+    ASSERT_TRUE(file.resize(file.size() - 8));
+    file.close();
+
+    QMap<int, CollectionItemInfo> items;
+    EXPECT_FALSE(CatalogCache::read(cache, CatalogCache::hash(CSV), items));
+    EXPECT_TRUE(items.isEmpty());
+
+    // 损坏的缓存会被重建
+    EXPECT_EQ(CatalogCache::load(csv, cache).size(), 3);
+}
+
+TEST(CatalogCacheTest, RejectsOutOfRangeEnums) {
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    const QString csv = dir.filePath("items.csv");
+    const QString cache = dir.filePath("items.cache");
+    writeFile(csv, CSV);
+    CatalogCache::load(csv, cache);
+
+    // 第一条记录的稀有度字节：文件头32字节 + id 4字节 + 类别1字节
+    QFile file(cache);
+    ASSERT_TRUE(file.open(QIODevice::ReadWrite));
+    ASSERT_TRUE(file.seek(32 + 4 + 1));
+    ASSERT_EQ(file.write(QByteArray(1, char(7))), 1);
+    file.close();
+
+    QMap<int, CollectionItemInfo> items;
+    EXPECT_FALSE(CatalogCache::read(cache, CatalogCache::hash(CSV), items));
+    EXPECT_TRUE(items.isEmpty());
+
+    const QMap<int, CollectionItemInfo> rebuilt = CatalogCache::load(csv, cache);
+    ASSERT_EQ(rebuilt.size(), 3);
+    EXPECT_EQ(rebuilt[6].rarity, CollectionRarity::Common);
+}
+
+TEST(CatalogCacheTest, RepeatedReadsShareOneMapping) {
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    const QString csv = dir.filePath("items.csv");
+    const QString cache = dir.filePath("items.cache");
+    writeFile(csv, CSV);
+    CatalogCache::load(csv, cache);
+
+    QMap<int, CollectionItemInfo> first;
+    QMap<int, CollectionItemInfo> second;
+    ASSERT_TRUE(CatalogCache::read(cache, CatalogCache::hash(CSV), first));
+    ASSERT_TRUE(CatalogCache::read(cache, CatalogCache::hash(CSV), second));
+
+    // 两次读取得到的字符串引用同一块映射内存
+    EXPECT_EQ(first[6].name.constData(), second[6].name.constData());
+}
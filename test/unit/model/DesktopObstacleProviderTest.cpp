@@ -0,0 +1,78 @@
+#include <gtest/gtest.h>
+#include "../../../src/model/DesktopObstacleProvider.h"
+
+// 障碍物刷新的增量比较：没有变化时不改写，增删时已交互标记跟随 id
+namespace {
+
+QVector<QRect> threeIcons() {
+    return {QRect(0, 0, 48, 48), QRect(100, 0, 48, 48), QRect(200, 0, 48, 48)};
+}
+
+} // namespace
+
+TEST(DesktopObstacleProviderTest, UnchangedRefreshIsNoOp) {
+    SyntheticObstacleProvider provider(threeIcons());
+    QVector<DesktopIconInfo> current;
+    std::vector<bool> interacted;
+
+    ObstacleDiff first = mergeObstacles(current, interacted, provider.enumerate());
+    EXPECT_EQ(first.added, 3);
+    EXPECT_TRUE(first.changed());
+    ASSERT_EQ(current.size(), 3);
+    ASSERT_EQ(interacted.size(), 3u);
+
+    interacted[1] = true;
+    ObstacleDiff second = mergeObstacles(current, interacted, provider.enumerate());
+    EXPECT_FALSE(second.changed());
+    EXPECT_TRUE(interacted[1]);
+}
+
+TEST(DesktopObstacleProviderTest, MovedObstacleUpdatesInPlace) {
+    SyntheticObstacleProvider provider(threeIcons());
+    QVector<DesktopIconInfo> current;
+    std::vector<bool> interacted;
+    mergeObstacles(current, interacted, provider.enumerate());
+    interacted[2] = true;
+
+    QVector<QRect> moved = threeIcons();
+    moved[2] = QRect(300, 300, 48, 48);
+    provider.setRects(moved);
+    ObstacleDiff diff = mergeObstacles(current, interacted, provider.enumerate());
+    EXPECT_EQ(diff.updated, 1);
+    EXPECT_FALSE(diff.reindexed);
+    EXPECT_EQ(current[2].rect, QRect(300, 300, 48, 48));
+    EXPECT_TRUE(interacted[2]);
+}
+
+TEST(DesktopObstacleProviderTest, InteractedFlagsFollowIdsAcrossRemoval) {
+    QVector<DesktopIconInfo> current;
+    std::vector<bool> interacted;
+    QVector<DesktopIconInfo> fresh;
+    for (int i = 0; i < 4; ++i) {
+        DesktopIconInfo info;
+        info.id = 10 + i;
+        info.rect = QRect(i * 100, 0, 48, 48);
+        fresh.append(info);
+    }
+    mergeObstacles(current, interacted, fresh);
+    interacted[3] = true; // id 13
+
+    // 去掉 id 11，并新增 id 20
+    fresh.remove(1);
+    DesktopIconInfo added;
+    added.id = 20;
+    added.rect = QRect(0, 500, 48, 48);
+    fresh.append(added);
+
+    ObstacleDiff diff = mergeObstacles(current, interacted, fresh);
+    EXPECT_EQ(diff.added, 1);
+    EXPECT_EQ(diff.removed, 1);
+    EXPECT_EQ(diff.updated, 0);
+    EXPECT_TRUE(diff.reindexed);
+    ASSERT_EQ(current.size(), 4);
+    ASSERT_EQ(interacted.size(), 4u);
+    for (int i = 0; i < current.size(); ++i) {
+        EXPECT_EQ(current[i].index, i);
+        EXPECT_EQ(interacted[i], current[i].id == 13);
+    }
+}
@@ -0,0 +1,69 @@
+#include <gtest/gtest.h>
+#include "../../../src/model/IconSpatialGrid.h"
+#include <algorithm>
+#include <random>
+#include <vector>
+
+// 网格查询结果必须与逐个计算距离的结果完全一致
+namespace {
+
+std::vector<int> bruteForce(const QVector<QRect>& rects, const QPoint& center, int radius) {
+    std::vector<int> result;
+    for (int i = 0; i < rects.size(); ++i) {
+        if (!rects[i].isValid()) {
+            continue;
+        }
+        const long long dx = rects[i].center().x() - center.x();
+        const long long dy = rects[i].center().y() - center.y();
+        if (dx * dx + dy * dy <= static_cast<long long>(radius) * radius) {
+            result.push_back(i);
+        }
+    }
+    return result;
+}
+
+std::vector<int> gridQuery(const IconSpatialGrid& grid, const QPoint& center, int radius) {
+    std::vector<int> result;
+    grid.query(center, radius, [&](int index) { result.push_back(index); });
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+} // namespace
+
+TEST(IconSpatialGridTest, MatchesBruteForceOnRandomLayouts) {
+    std::mt19937 rng(20240601);
+    std::uniform_int_distribution<int> coord(-200, 2200);
+    for (int layout = 0; layout < 20; ++layout) {
+        QVector<QRect> rects;
+        for (int i = 0; i < 500; ++i) {
+            // 混入少量不可见图标
+            rects.append(i % 37 == 0 ? QRect() : QRect(coord(rng), coord(rng), 48, 48));
+        }
+        const int radius = 20 + layout * 10;
+        IconSpatialGrid grid;
+        grid.build(rects, radius);
+
+        for (int q = 0; q < 200; ++q) {
+            const QPoint center(coord(rng), coord(rng));
+            ASSERT_EQ(gridQuery(grid, center, radius), bruteForce(rects, center, radius));
+        }
+    }
+}
+
+TEST(IconSpatialGridTest, QueriesOutsideAndOnBoundary) {
+    QVector<QRect> rects = {QRect(0, 0, 48, 48), QRect(100, 0, 48, 48), QRect(0, 100, 48, 48)};
+    IconSpatialGrid grid;
+    grid.build(rects, 50);
+    EXPECT_EQ(grid.size(), 3);
+
+    // 中心点为 (23,23)，半径恰好等于距离时算在范围内
+    EXPECT_EQ(gridQuery(grid, QPoint(73, 23), 50), (std::vector<int>{0, 1}));
+    EXPECT_EQ(gridQuery(grid, QPoint(23, -27), 50), (std::vector<int>{0}));
+    EXPECT_TRUE(gridQuery(grid, QPoint(23, -28), 50).empty());
+    EXPECT_TRUE(gridQuery(grid, QPoint(5000, 5000), 50).empty());
+    EXPECT_TRUE(gridQuery(grid, QPoint(-5000, 23), 50).empty());
+
+    grid.clear();
+    EXPECT_TRUE(gridQuery(grid, QPoint(23, 23), 50).empty());
+}
@@ -0,0 +1,188 @@
+#include <gtest/gtest.h>
+#include "../../../src/model/LootTable.h"
+#include <map>
+#include <vector>
+
+// 与 resources/csv/loot_tables.csv 及打工面板中公布的概率保持一致
+namespace {
+
+std::vector<LootEntry> sunshineEntries() {
+    // 普通60%，稀有25%，史诗12%（8/9各半），传说3%
+    return {
+        {0, 6, 60, 1, 3},
+        {1, 7, 25, 1, 2},
+        {2, 8, 6, 1, 1},
+        {2, 9, 6, 1, 1},
+        {3, 10, 3, 1, 1},
+    };
+}
+
+std::vector<LootEntry> mineralEntries() {
+    // 普通50%，稀有30%，史诗15%，传说5%
+    return {
+        {0, 11, 50, 2, 5},
+        {1, 12, 30, 1, 3},
+        {2, 13, 7.5, 1, 1},
+        {2, 14, 7.5, 1, 1},
+        {3, 15, 5, 1, 1},
+    };
+}
+
+std::vector<LootEntry> woodEntries() {
+    // 普通55%，稀有30%，史诗10%，传说5%
+    return {
+        {0, 16, 55, 2, 4},
+        {1, 17, 30, 1, 2},
+        {2, 18, 5, 1, 1},
+        {2, 19, 5, 1, 1},
+        {3, 20, 5, 1, 1},
+    };
+}
+
+// 对物品ID做卡方检验，返回卡方统计量
+double chiSquare(const LootTable& table, const std::map<int, double>& expected, int draws, uint64_t seed) {
+    RandomEngine rng(seed);
+    std::map<int, int> observed;
+    for (int i = 0; i < draws; ++i) {
+        observed[table.draw(rng).itemId]++;
+    }
+
+    double chi2 = 0.0;
+    for (const auto& kv : expected) {
+        const double e = kv.second * draws;
+        const double diff = observed[kv.first] - e;
+        chi2 += diff * diff / e;
+    }
+    return chi2;
+}
+
+// 自由度为4时 p=0.001 的临界值
+const double CHI2_CRITICAL_DF4 = 18.467;
+
+} // namespace
+
+TEST(AliasTableTest, ProbabilitiesMatchWeights) {
+    AliasTable table({1.0, 2.0, 3.0, 4.0});
+    ASSERT_EQ(table.size(), 4u);
+    for (uint32_t i = 0; i < 4; ++i) {
+        EXPECT_NEAR(table.probability(i), (i + 1) / 10.0, 1e-9);
+    }
+}
+
+TEST(AliasTableTest, ZeroWeightIsNeverDrawn) {
+    AliasTable table({0.0, 1.0, 0.0});
+    RandomEngine rng(1);
+    for (int i = 0; i < 10000; ++i) {
+        ASSERT_EQ(table.sample(rng), 1u);
+    }
+}
+
+TEST(LootTableTest, SunshineMatchesDocumentedPercentages) {
+    LootTable table = LootTable::compile(sunshineEntries(), 0.0, 1.0);
+    std::map<int, double> expected = {{6, 0.60}, {7, 0.25}, {8, 0.06}, {9, 0.06}, {10, 0.03}};
+
+    for (const auto& kv : expected) {
+        EXPECT_NEAR(table.itemProbability(kv.first), kv.second, 1e-12);
+    }
+    EXPECT_LT(chiSquare(table, expected, 1000000, 12345), CHI2_CRITICAL_DF4);
+}
+
+TEST(LootTableTest, MineralMatchesDocumentedPercentages) {
+    LootTable table = LootTable::compile(mineralEntries(), 0.0, 1.0);
+    std::map<int, double> expected = {{11, 0.50}, {12, 0.30}, {13, 0.075}, {14, 0.075}, {15, 0.05}};
+    EXPECT_LT(chiSquare(table, expected, 1000000, 23456), CHI2_CRITICAL_DF4);
+}
+
+TEST(LootTableTest, WoodMatchesDocumentedPercentages) {
+    LootTable table = LootTable::compile(woodEntries(), 0.0, 1.0);
+    std::map<int, double> expected = {{16, 0.55}, {17, 0.30}, {18, 0.05}, {19, 0.05}, {20, 0.05}};
+    EXPECT_LT(chiSquare(table, expected, 1000000, 34567), CHI2_CRITICAL_DF4);
+}
+
+TEST(LootTableTest, QualityBonusShiftsTowardsHigherTiers) {
+    // 高级光合作用：品质加成20%，抽样值整体+20个百分点
+    LootTable table = LootTable::compile(sunshineEntries(), 0.2, 1.0);
+
+    EXPECT_NEAR(table.itemProbability(6), 0.40, 1e-12);
+    EXPECT_NEAR(table.itemProbability(7), 0.25, 1e-12);
+    EXPECT_NEAR(table.itemProbability(8) + table.itemProbability(9), 0.12, 1e-12);
+    EXPECT_NEAR(table.itemProbability(10), 0.23, 1e-12);
+
+    std::map<int, double> expected = {{6, 0.40}, {7, 0.25}, {8, 0.06}, {9, 0.06}, {10, 0.23}};
+    EXPECT_LT(chiSquare(table, expected, 1000000, 45678), CHI2_CRITICAL_DF4);
+}
+
+TEST(LootTableTest, QualityBonusPerRarityProbabilities) {
+    // 矿物表 普通50%/稀有30%/史诗15%/传说5%，品质加成60%：
+    // 抽样值落在 [0.6, 1) 之后，普通档整体被移出，稀有只剩 [0.6, 0.8)，溢出的 0.6 全部归入传说
+    LootTable table = LootTable::compile(mineralEntries(), 0.6, 1.0);
+
+    EXPECT_NEAR(table.itemProbability(11), 0.00, 1e-12);
+    EXPECT_NEAR(table.itemProbability(12), 0.20, 1e-12);
+    EXPECT_NEAR(table.itemProbability(13), 0.075, 1e-12);
+    EXPECT_NEAR(table.itemProbability(14), 0.075, 1e-12);
+    EXPECT_NEAR(table.itemProbability(15), 0.65, 1e-12);
+
+    // 较小的加成只从普通档扣除，稀有和史诗保持不变，传说增加同样的量
+    LootTable small = LootTable::compile(mineralEntries(), 0.1, 1.0);
+    EXPECT_NEAR(small.itemProbability(11), 0.40, 1e-12);
+    EXPECT_NEAR(small.itemProbability(12), 0.30, 1e-12);
+    EXPECT_NEAR(small.itemProbability(13) + small.itemProbability(14), 0.15, 1e-12);
+    EXPECT_NEAR(small.itemProbability(15), 0.15, 1e-12);
+}
+
+TEST(LootTableTest, CountRangeAndDropMultiplier) {
+    // 挖矿普通矿石2-5个，大师级x3倍
+    LootTable table = LootTable::compile(mineralEntries(), 0.0, 3.0);
+    RandomEngine rng(7);
+
+    std::map<int, int> commonCounts;
+    for (int i = 0; i < 200000; ++i) {
+        LootDrop drop = table.draw(rng);
+        ASSERT_GE(drop.count, 3);
+        if (drop.itemId == 11) {
+            commonCounts[drop.count]++;
+        }
+    }
+
+    // 2-5个各占1/4，乘以3后为6/9/12/15
+    ASSERT_EQ(commonCounts.size(), 4u);
+    for (int count : {6, 9, 12, 15}) {
+        EXPECT_NEAR(commonCounts[count] / 200000.0, 0.125, 0.005);
+    }
+}
+
+TEST(LootTableTest, SameSeedGivesSameDrops) {
+    LootTable table = LootTable::compile(woodEntries(), 0.4, 2.0);
+    RandomEngine a(2024);
+    RandomEngine b(2024);
+    for (int i = 0; i < 1000; ++i) {
+        LootDrop x = table.draw(a);
+        LootDrop y = table.draw(b);
+        ASSERT_EQ(x.itemId, y.itemId);
+        ASSERT_EQ(x.count, y.count);
+    }
+}
+
+TEST(LootTableTest, BatchCountsMatchIndividualDraws) {
+    // 离线结算用的批量抽样与逐次抽样结果一致
+    LootTable table = LootTable::compile(sunshineEntries(), 0.2, 1.5);
+    RandomEngine a(777);
+    RandomEngine b(777);
+
+    std::vector<uint64_t> hits;
+    table.drawCounts(a, 40320, hits);
+
+    std::map<int, long long> batchTotals;
+    for (size_t i = 0; i < hits.size(); ++i) {
+        batchTotals[table.outcomes()[i].itemId] += static_cast<long long>(hits[i]) * table.outcomes()[i].count;
+    }
+
+    std::map<int, long long> singleTotals;
+    for (int i = 0; i < 40320; ++i) {
+        LootDrop drop = table.draw(b);
+        singleTotals[drop.itemId] += drop.count;
+    }
+
+    EXPECT_EQ(batchTotals, singleTotals);
+}
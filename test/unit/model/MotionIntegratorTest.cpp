@@ -0,0 +1,93 @@
+#include <gtest/gtest.h>
+#include "../../../src/model/MotionIntegrator.h"
+#include <cmath>
+
+// 运动积分器：不同帧率下轨迹一致，平滑起停且不越过目标
+namespace {
+
+double distance(const QPointF& a, const QPointF& b) {
+    return std::hypot(a.x() - b.x(), a.y() - b.y());
+}
+
+QPointF simulate(double hz, double seconds) {
+    MotionIntegrator motion;
+    motion.setLimits(200.0, 800.0);
+    motion.reset(QPointF(0, 0));
+    motion.setTarget(QPointF(300, 400));
+    const int frames = static_cast<int>(std::lround(seconds * hz));
+    for (int i = 0; i < frames; ++i) {
+        motion.step(1.0 / hz);
+    }
+    return motion.position();
+}
+
+} // namespace
+
+TEST(MotionIntegratorTest, TrajectoryIndependentOfFrameRate) {
+    // 行进途中的位置在 30/60/144Hz 下只相差不到一个像素
+    const QPointF at60 = simulate(60.0, 1.0);
+    EXPECT_LT(distance(simulate(30.0, 1.0), at60), 1.0);
+    EXPECT_LT(distance(simulate(144.0, 1.0), at60), 1.0);
+    EXPECT_GT(distance(at60, QPointF(0, 0)), 100.0);
+}
+
+TEST(MotionIntegratorTest, RespectsSpeedAndAccelerationAndStopsAtTarget) {
+    MotionIntegrator motion;
+    motion.setLimits(200.0, 800.0);
+    motion.reset(QPointF(10, 10));
+    motion.setTarget(QPointF(510, 10));
+
+    double lastSpeed = 0.0;
+    double lastX = 10.0;
+    for (int i = 0; i < 600 && !motion.hasArrived(); ++i) {
+        motion.step(1.0 / 120.0);
+        const double speed = std::hypot(motion.velocity().x(), motion.velocity().y());
+        EXPECT_LE(speed, 200.0 + 1e-9);
+        if (!motion.hasArrived()) {
+            // 停在目标上的最后一帧除外
+            EXPECT_LE(std::fabs(speed - lastSpeed), 800.0 / 120.0 + 1e-9);
+        }
+        EXPECT_LE(motion.position().x(), 510.0);
+        EXPECT_GE(motion.position().x(), lastX);
+        lastSpeed = speed;
+        lastX = motion.position().x();
+    }
+    EXPECT_TRUE(motion.hasArrived());
+    EXPECT_DOUBLE_EQ(motion.position().x(), 510.0);
+}
+
+TEST(MotionIntegratorTest, LongStallIsClamped) {
+    MotionIntegrator motion;
+    motion.setLimits(200.0, 800.0);
+    motion.reset(QPointF(0, 0));
+    motion.setTarget(QPointF(1000, 0));
+    // 长时间卡顿后的一帧只按 MAX_STEP 推进
+    motion.step(5.0);
+    EXPECT_LE(motion.position().x(), 200.0 * MotionIntegrator::MAX_STEP);
+    EXPECT_FALSE(motion.hasArrived());
+}
+
+TEST(MotionIntegratorTest, TargetBehindDoesNotTeleport) {
+    MotionIntegrator motion;
+    motion.setLimits(200.0, 800.0);
+    motion.reset(QPointF(0, 0));
+    motion.setTarget(QPointF(1000, 0));
+    for (int i = 0; i < 60; ++i) {
+        motion.step(1.0 / 60.0);
+    }
+    ASSERT_NEAR(motion.velocity().x(), 200.0, 1e-9);
+
+    // 目标换到身后2像素：这一步的位移超过2像素但方向相反，不能直接跳到目标上
+    const double x = motion.position().x();
+    motion.setTarget(QPointF(x - 2.0, 0));
+    motion.step(1.0 / 60.0);
+    EXPECT_GT(motion.position().x(), x);
+    EXPECT_FALSE(motion.hasArrived());
+
+    // 掉头后仍然停在目标上
+    for (int i = 0; i < 600 && !motion.hasArrived(); ++i) {
+        motion.step(1.0 / 60.0);
+    }
+    EXPECT_TRUE(motion.hasArrived());
+    EXPECT_DOUBLE_EQ(motion.position().x(), x - 2.0);
+}
@@ -0,0 +1,82 @@
+#include <gtest/gtest.h>
+#include "../../../src/model/NavGrid.h"
+
+// 导航网格：绕开障碍物、路径拉直、增量更新障碍物
+namespace {
+
+bool pathIsClear(const NavGrid& grid, const QPoint& start, const QVector<QPoint>& path) {
+    QPoint from = start;
+    for (const QPoint& to : path) {
+        if (!grid.isSegmentClear(from, to)) {
+            return false;
+        }
+        from = to;
+    }
+    return true;
+}
+
+} // namespace
+
+TEST(NavGridTest, StraightLineWithoutObstacles) {
+    NavGrid grid;
+    grid.reset(QRect(0, 0, 1920, 1080));
+    QVector<QPoint> path;
+    ASSERT_TRUE(grid.findPath(QPoint(100, 100), QPoint(1800, 900), path));
+    // 没有障碍物时拉直成一段直线
+    ASSERT_EQ(path.size(), 1);
+    EXPECT_EQ(path.back(), QPoint(1800, 900));
+}
+
+TEST(NavGridTest, DetoursAroundWall) {
+    NavGrid grid;
+    grid.reset(QRect(0, 0, 1920, 1080));
+    // 中间一堵竖墙，只在底部留出缺口
+    grid.setObstacles({QRect(900, 0, 100, 900)});
+
+    QVector<QPoint> path;
+    ASSERT_TRUE(grid.findPath(QPoint(200, 200), QPoint(1700, 200), path));
+    EXPECT_GT(path.size(), 1);
+    EXPECT_EQ(path.back(), QPoint(1700, 200));
+    EXPECT_TRUE(pathIsClear(grid, QPoint(200, 200), path));
+}
+
+TEST(NavGridTest, ObstacleUpdatesAreIncremental) {
+    NavGrid grid;
+    grid.reset(QRect(0, 0, 1920, 1080));
+    grid.setObstacles({QRect(900, 0, 100, 900), QRect(0, 0, 10, 10)});
+    const quint64 revision = grid.revision();
+
+    // 列表不变时不改动任何格子
+    grid.setObstacles({QRect(900, 0, 100, 900), QRect(0, 0, 10, 10)});
+    EXPECT_EQ(grid.revision(), revision);
+
+    // 移走墙后直线可达
+    grid.setObstacles({QRect(1500, 1000, 50, 50), QRect(0, 0, 10, 10)});
+    EXPECT_NE(grid.revision(), revision);
+    EXPECT_FALSE(grid.isBlocked(QPoint(950, 450)));
+    EXPECT_TRUE(grid.isBlocked(QPoint(5, 5)));
+    QVector<QPoint> path;
+    ASSERT_TRUE(grid.findPath(QPoint(200, 200), QPoint(1700, 200), path));
+    EXPECT_EQ(path.size(), 1);
+}
+
+TEST(NavGridTest, StartInsideObstacleStillFindsPath) {
+    NavGrid grid;
+    grid.reset(QRect(0, 0, 1920, 1080));
+    grid.setObstacles({QRect(0, 0, 1000, 1000)});
+    QVector<QPoint> path;
+    ASSERT_TRUE(grid.findPath(QPoint(500, 500), QPoint(1500, 500), path));
+    EXPECT_EQ(path.back(), QPoint(1500, 500));
+    EXPECT_FALSE(grid.findPath(QPoint(500, 500), QPoint(5000, 500), path));
+}
+
+TEST(NavGridTest, EnclosedGoalIsUnreachable) {
+    NavGrid grid;
+    grid.reset(QRect(0, 0, 1920, 1080), 64);
+    // 一圈障碍物围住目标所在的格子
+    grid.setObstacles({QRect(1344, 320, 320, 64), QRect(1344, 576, 320, 64),
+                       QRect(1344, 320, 64, 320), QRect(1600, 320, 64, 320)});
+    QVector<QPoint> path;
+    EXPECT_FALSE(grid.findPath(QPoint(200, 200), QPoint(1500, 500), path));
+    EXPECT_TRUE(path.isEmpty());
+}
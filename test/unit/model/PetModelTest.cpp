@@ -1,7 +1,10 @@
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
 #include "../../../src/model/PetModel.h"
+#include "../../../src/common/PropertyIds.h"
 #include "../../../../common/base/PetInfo.h"
+#include <atomic>
+#include <thread>
 
 using namespace testing;
 
@@ -184,4 +187,103 @@ TEST_F(PetModelTest, BoundaryValues) {
     callbackCount = 0;
     model.change_size(QSize(0, 0));
     EXPECT_EQ(callbackCount, 1);
-}
\ No newline at end of file
+}
+// 二进制存档往返测试
+TEST_F(PetModelTest, BinaryRoundTrip) {
+    model.change_position(TEST_POS);
+    model.add_money(1234);
+    model.change_pet_type(TEST_TYPE);
+    model.change_animation(TEST_ANIM);
+
+    BinaryWriter out;
+    model.write_binary(out);
+    std::string data = out.finish(1);
+
+    PetModel loaded;
+    BinaryReader in;
+    ASSERT_TRUE(in.open(data.data(), data.size()));
+    loaded.read_binary(in);
+
+    EXPECT_EQ(loaded.get_info()->petType, TEST_TYPE);
+    EXPECT_EQ(loaded.get_info()->position, TEST_POS);
+    EXPECT_EQ(loaded.get_info()->money, model.get_info()->money);
+    EXPECT_EQ(loaded.get_info()->currentAnimation, TEST_ANIM);
+}
+
+// 快照测试：发布后的快照不再变化，版本递增，读取线程总能拿到一致的数据
+TEST_F(PetModelTest, SnapshotIsImmutableAndVersioned) {
+    PetInfoSnapshot before = model.snapshot();
+    ASSERT_NE(before, nullptr);
+
+    model.add_money(100);
+    model.change_position(TEST_POS);
+    PetInfoSnapshot after = model.snapshot();
+
+    EXPECT_EQ(before->money, 0);
+    EXPECT_EQ(before->position, QPoint(100, 100));
+    EXPECT_EQ(after->money, 100);
+    EXPECT_EQ(after->position, TEST_POS);
+    EXPECT_GT(after->version, before->version);
+
+    // 当前宠物的数据只保存一份，切换回来后仍然保留，位置等全局设置不随切换变化
+    model.change_pet_type(TEST_TYPE);
+    EXPECT_EQ(model.snapshot()->money, 0);
+    EXPECT_EQ(model.snapshot()->position, TEST_POS);
+    model.change_pet_type(PetType::Spider);
+    EXPECT_EQ(model.snapshot()->money, 100);
+    EXPECT_EQ(model.get_info()->money, 100);
+}
+
+TEST_F(PetModelTest, SnapshotReadableFromOtherThreads) {
+    std::atomic<bool> done{false};
+    std::atomic<bool> consistent{true};
+    std::thread reader([&]() {
+        quint64 lastVersion = 0;
+        while (!done.load()) {
+            PetInfoSnapshot info = model.snapshot();
+            // 每次修改同时改变 x 和 y，快照中两者必须相等
+            if (info->version < lastVersion || info->position.x() != info->position.y()) {
+                consistent = false;
+            }
+            lastVersion = info->version;
+        }
+    });
+
+    for (int i = 1; i <= 2000; ++i) {
+        model.change_position(QPoint(i * 3, i * 3));
+    }
+    done = true;
+    reader.join();
+
+    EXPECT_TRUE(consistent.load());
+}
+
+// 位置快速通道：连续移动不触发通知，提交时补发一次
+TEST_F(PetModelTest, StreamPositionBypassesNotifications) {
+    PositionChannel &channel = model.get_position_channel();
+    QPoint sampled;
+    ASSERT_TRUE(channel.take(sampled));
+    EXPECT_EQ(sampled, QPoint(100, 100));
+    EXPECT_FALSE(channel.take(sampled));
+
+    for (int i = 1; i <= 10; ++i) {
+        model.stream_position(QPoint(100 + i, 100));
+    }
+    EXPECT_EQ(callbackCount, 0);
+    EXPECT_EQ(model.get_info()->position, QPoint(110, 100));
+    EXPECT_EQ(model.snapshot()->position, QPoint(100, 100));
+
+    // 多次写入只取最后一次
+    ASSERT_TRUE(channel.take(sampled));
+    EXPECT_EQ(sampled, QPoint(110, 100));
+    EXPECT_FALSE(channel.take(sampled));
+
+    model.commit_position();
+    EXPECT_EQ(callbackCount, 1);
+    EXPECT_EQ(lastPropertyId, PROP_ID_PET_POSITION);
+    EXPECT_EQ(model.snapshot()->position, QPoint(110, 100));
+
+    // 没有新的快速更新时提交不触发
+    model.commit_position();
+    EXPECT_EQ(callbackCount, 1);
+}
@@ -0,0 +1,194 @@
+#include <gtest/gtest.h>
+#include "../../../src/model/PetSwarm.h"
+#include "../../../src/common/EventMgr.h"
+#include "../../../src/common/EventDefine.h"
+
+// 群体宠物：批量移动停留在屏幕内、图标交互、同一种子结果可复现、相撞和跟随鼠标事件
+namespace {
+
+QVector<ScreenInfo> twoScreens() {
+    ScreenInfo left;
+    left.geometry = QRect(0, 0, 1920, 1080);
+    ScreenInfo right;
+    right.geometry = QRect(1920, 0, 1920, 1080);
+    return {left, right};
+}
+
+void run(PetSwarm& swarm, double seconds) {
+    for (double t = 0.0; t < seconds; t += 1.0 / 60.0) {
+        swarm.step(1.0 / 60.0);
+    }
+}
+
+} // namespace
+
+TEST(PetSwarmTest, PetsStayOnScreenAndKeepMoving) {
+    PetSwarm swarm(1);
+    swarm.setScreens(twoScreens());
+    swarm.setPetSize(QSize(100, 100));
+    swarm.spawnRandom(50);
+    ASSERT_EQ(swarm.size(), 50);
+
+    QVector<QPoint> start;
+    for (int i = 0; i < swarm.size(); ++i) {
+        start.append(swarm.position(i));
+    }
+
+    int moved = 0;
+    for (int frame = 0; frame < 600; ++frame) {
+        swarm.step(1.0 / 60.0);
+        for (int i = 0; i < swarm.size(); ++i) {
+            const QPoint pos = swarm.position(i);
+            ASSERT_EQ(swarm.screens().constrain(pos), pos) << "pet " << i << " frame " << frame;
+        }
+    }
+    for (int i = 0; i < swarm.size(); ++i) {
+        moved += swarm.position(i) != start[i] ? 1 : 0;
+    }
+    EXPECT_EQ(moved, swarm.size());
+}
+
+TEST(PetSwarmTest, InteractionsChangeStateAndAreReported) {
+    PetSwarm swarm(2);
+    ScreenInfo screen;
+    screen.geometry = QRect(0, 0, 800, 600);
+    swarm.setScreens({screen});
+    swarm.setPetSize(QSize(100, 100));
+    SwarmConfig config;
+    config.interactionProbability = 100;
+    config.interactionSeconds = 0.5f;
+    swarm.setConfig(config);
+
+    // 图标正好在宠物中心，第一帧就开始交互
+    const int pet = swarm.spawn(QPoint(200, 200));
+    swarm.setObstacles({QRect(226, 226, 48, 48)});
+    swarm.step(1.0 / 60.0);
+    EXPECT_EQ(swarm.state(pet), SwarmPetState::Interacting);
+    ASSERT_EQ(swarm.changed().size(), 1u);
+    EXPECT_EQ(swarm.changed()[0], pet);
+    EXPECT_EQ(swarm.interactionCount(), 1);
+
+    // 交互结束后恢复移动，离开之前不会再与同一个图标交互
+    run(swarm, 0.6);
+    EXPECT_EQ(swarm.state(pet), SwarmPetState::Walking);
+    swarm.step(1.0 / 60.0);
+    EXPECT_EQ(swarm.interactionCount(), 1);
+}
+
+TEST(PetSwarmTest, SameSeedProducesSameSimulation) {
+    PetSwarm a(42);
+    PetSwarm b(42);
+    for (PetSwarm* swarm : {&a, &b}) {
+        swarm->setScreens(twoScreens());
+        swarm->setObstacles({QRect(300, 300, 48, 48), QRect(2500, 600, 48, 48)});
+        swarm->spawnRandom(20);
+        run(*swarm, 5.0);
+    }
+    for (int i = 0; i < a.size(); ++i) {
+        EXPECT_EQ(a.position(i), b.position(i));
+        EXPECT_EQ(a.state(i), b.state(i));
+    }
+}
+
+namespace {
+
+struct ContactRecorder : EventListener<PetBumpEvent>, EventListener<PetFollowCursorEvent> {
+    ContactRecorder() {
+        EventMgr::GetInstance().RegisterEvent<PetBumpEvent>(this);
+        EventMgr::GetInstance().RegisterEvent<PetFollowCursorEvent>(this);
+    }
+    ~ContactRecorder() override {
+        EventMgr::GetInstance().UnregisterEvent<PetBumpEvent>(this);
+        EventMgr::GetInstance().UnregisterEvent<PetFollowCursorEvent>(this);
+    }
+    void OnEvent(PetBumpEvent event) override { bumps.push_back({event.pet, event.other}); }
+    void OnEvent(PetFollowCursorEvent event) override { followers.push_back(event.pet); }
+
+    std::vector<std::pair<int, int>> bumps;
+    std::vector<int> followers;
+};
+
+} // namespace
+
+TEST(PetSwarmTest, BumpsAndCursorContactsAreSentOnce) {
+    ContactRecorder recorder;
+    PetSwarm swarm(3);
+    ScreenInfo screen;
+    screen.geometry = QRect(0, 0, 1920, 1080);
+    swarm.setScreens({screen});
+    swarm.setPetSize(QSize(100, 100));
+
+    // 两只重叠的宠物：只在开始接触的那一帧发送一次
+    const int a = swarm.spawn(QPoint(500, 500));
+    const int b = swarm.spawn(QPoint(550, 520));
+    swarm.step(1.0 / 60.0);
+    ASSERT_EQ(recorder.bumps.size(), 1u);
+    EXPECT_EQ(recorder.bumps[0], std::make_pair(a, b));
+    swarm.step(1.0 / 60.0);
+    EXPECT_EQ(swarm.bumpCount(), 1);
+
+    // 鼠标碰到宠物后宠物开始跟随
+    const int c = swarm.spawn(QPoint(1500, 300));
+    swarm.setCursor(QPoint(1550, 350));
+    swarm.step(1.0 / 60.0);
+    ASSERT_EQ(recorder.followers.size(), 1u);
+    EXPECT_EQ(recorder.followers[0], c);
+    EXPECT_EQ(swarm.state(c), SwarmPetState::Following);
+
+    // 鼠标移开后宠物追过去，中心停在鼠标上
+    swarm.setCursor(QPoint(1300, 400));
+    run(swarm, 2.0);
+    EXPECT_EQ(swarm.position(c), QPoint(1250, 350));
+    EXPECT_EQ(swarm.followCount(), 1);
+}
+
+TEST(PetSwarmTest, RemovedScreenPullsPetsBack) {
+    PetSwarm swarm(6);
+    swarm.setScreens(twoScreens());
+    swarm.setPetSize(QSize(100, 100));
+    swarm.spawnRandom(40);
+    run(swarm, 1.0);
+
+    // 拔掉右边的屏幕：所有宠物立即回到左边，之后也不再走出去
+    swarm.setScreens({twoScreens()[0]});
+    const QRect left(0, 0, 1920, 1080);
+    for (int i = 0; i < swarm.size(); ++i) {
+        EXPECT_TRUE(left.contains(swarm.rect(i))) << "pet " << i;
+    }
+    for (int frame = 0; frame < 600; ++frame) {
+        swarm.step(1.0 / 60.0);
+        for (int i = 0; i < swarm.size(); ++i) {
+            ASSERT_TRUE(left.contains(swarm.rect(i))) << "pet " << i << " frame " << frame;
+        }
+    }
+}
+
+TEST(PetSwarmTest, SpawningKeepsExistingCursorContacts) {
+    ContactRecorder recorder;
+    PetSwarm swarm(7);
+    ScreenInfo screen;
+    screen.geometry = QRect(0, 0, 1920, 1080);
+    swarm.setScreens({screen});
+    swarm.setPetSize(QSize(100, 100));
+    SwarmConfig config;
+    config.followSeconds = 0.05f;
+    swarm.setConfig(config);
+
+    const int a = swarm.spawn(QPoint(500, 500));
+    swarm.setCursor(QPoint(550, 550));
+    swarm.step(1.0 / 60.0);
+    ASSERT_EQ(recorder.followers.size(), 1u);
+
+    // 跟随结束后宠物仍然碰着鼠标，这时再加一只宠物（重建宽阶段）不能把它当成新接触
+    for (int i = 0; i < 20 && swarm.state(a) == SwarmPetState::Following; ++i) {
+        swarm.step(1.0 / 60.0);
+    }
+    ASSERT_EQ(swarm.state(a), SwarmPetState::Walking);
+    ASSERT_TRUE(swarm.rect(a).contains(QPoint(550, 550)));
+
+    swarm.spawn(QPoint(1500, 300));
+    swarm.step(1.0 / 60.0);
+    EXPECT_EQ(recorder.followers.size(), 1u);
+    EXPECT_EQ(swarm.state(a), SwarmPetState::Walking);
+    EXPECT_EQ(swarm.followCount(), 1);
+}
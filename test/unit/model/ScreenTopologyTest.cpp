@@ -0,0 +1,57 @@
+#include <gtest/gtest.h>
+#include "../../../src/model/ScreenTopology.h"
+
+// 多屏拓扑：跨屏移动、外侧边缘约束、屏幕之间的空隙
+namespace {
+
+ScreenInfo makeScreen(const QRect& geometry, const QRect& available = QRect()) {
+    ScreenInfo info;
+    info.geometry = geometry;
+    info.availableGeometry = available;
+    return info;
+}
+
+} // namespace
+
+TEST(ScreenTopologyTest, PetCanStraddleAdjacentScreens) {
+    ScreenTopology topology;
+    topology.setScreens({makeScreen(QRect(0, 0, 1920, 1080), QRect(0, 0, 1920, 1040)),
+                         makeScreen(QRect(1920, 0, 2560, 1440))});
+    topology.setPetSize(QSize(200, 200));
+
+    EXPECT_EQ(topology.bounds(), QRect(0, 0, 4480, 1440));
+    EXPECT_EQ(topology.screenAt(QPoint(100, 100)), 0);
+    EXPECT_EQ(topology.screenAt(QPoint(2000, 1200)), 1);
+
+    // 横跨两块屏幕的位置保持不变
+    EXPECT_EQ(topology.constrain(QPoint(1850, 400)), QPoint(1850, 400));
+    // 外侧边缘：宠物完整留在屏幕内，主屏底部让出任务栏
+    EXPECT_EQ(topology.constrain(QPoint(-50, 400)), QPoint(0, 400));
+    EXPECT_EQ(topology.constrain(QPoint(300, 1000)), QPoint(300, 840));
+    EXPECT_EQ(topology.constrain(QPoint(4400, 1300)), QPoint(4280, 1240));
+}
+
+TEST(ScreenTopologyTest, GapsBecomeDeadZonesAndProjectToNearestScreen) {
+    // 副屏比主屏矮，并且向下错开
+    ScreenTopology topology;
+    topology.setScreens({makeScreen(QRect(0, 0, 1920, 1080)), makeScreen(QRect(1920, 600, 1280, 720))});
+    topology.setPetSize(QSize(100, 100));
+
+    // 外接矩形中副屏上方和主屏下方的区域不属于任何屏幕
+    ASSERT_EQ(topology.deadZones().size(), 2);
+    EXPECT_EQ(topology.deadZones()[0], QRect(1920, 0, 1280, 600));
+    EXPECT_EQ(topology.deadZones()[1], QRect(0, 1080, 1920, 240));
+
+    // 落在空隙里的位置投影回最近的可活动区域
+    const QPoint constrained = topology.constrain(QPoint(2500, 100));
+    EXPECT_EQ(constrained, QPoint(2500, 600));
+    EXPECT_EQ(topology.screenAt(QPoint(2500, 100)), 1);
+}
+
+TEST(ScreenTopologyTest, WalkableRectKeepsPetOnSingleScreen) {
+    ScreenTopology topology;
+    topology.setScreens({makeScreen(QRect(0, 0, 1920, 1080))});
+    topology.setPetSize(QSize(200, 200));
+    EXPECT_EQ(topology.walkableRect(0), QRect(0, 0, 1721, 881));
+    EXPECT_TRUE(topology.deadZones().isEmpty());
+}
@@ -0,0 +1,439 @@
+#include "WorkSimulator.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <thread>
+
+namespace
+{
+
+// 每次从任务队列领取的会话数，太小会在原子计数上竞争
+const long long SESSIONS_PER_CHUNK = 64;
+
+// 一次决策最多连续打工的周期数
+const long long MAX_CYCLES_PER_BATCH = 4096;
+
+} // namespace
+
+void SimulationData::finalize()
+{
+    // 物品ID上界
+    int maxItem = 0;
+    for (const SimWorkType &type : workTypes)
+    {
+        for (const SimWorkLevel &level : type.levels)
+        {
+            for (const LootTable::Outcome &o : level.table.outcomes())
+            {
+                maxItem = std::max(maxItem, o.itemId);
+            }
+        }
+    }
+    for (const SimRecipe &recipe : recipes)
+    {
+        maxItem = std::max(maxItem, recipe.outputItem);
+        for (const auto &input : recipe.inputs)
+        {
+            maxItem = std::max(maxItem, input.first);
+        }
+    }
+    for (const SimUpgrade &upgrade : upgrades)
+    {
+        for (const auto &material : upgrade.materials)
+        {
+            maxItem = std::max(maxItem, material.first);
+        }
+    }
+    itemCount = maxItem + 1;
+
+    // 期望产出速度（个/秒）
+    for (SimWorkType &type : workTypes)
+    {
+        for (SimWorkLevel &level : type.levels)
+        {
+            level.itemsPerSecond.assign(itemCount, 0.0);
+            for (const LootTable::Outcome &o : level.table.outcomes())
+            {
+                level.itemsPerSecond[o.itemId] += o.probability * o.count / type.durationSec;
+            }
+        }
+    }
+
+    // 升级索引
+    upgradeByLevel.assign(workTypes.size(), std::vector<int>());
+    for (size_t t = 0; t < workTypes.size(); ++t)
+    {
+        upgradeByLevel[t].assign(workTypes[t].levels.size(), -1);
+    }
+    for (size_t u = 0; u < upgrades.size(); ++u)
+    {
+        const SimUpgrade &upgrade = upgrades[u];
+        if (upgrade.workType >= 0 && upgrade.workType < int(workTypes.size()) &&
+            upgrade.fromLevel >= 0 && upgrade.fromLevel < int(upgradeByLevel[upgrade.workType].size()))
+        {
+            upgradeByLevel[upgrade.workType][upgrade.fromLevel] = int(u);
+        }
+    }
+
+    // 产出索引：同一物品有多个配方时取第一个
+    recipeForItem.assign(itemCount, -1);
+    for (size_t r = 0; r < recipes.size(); ++r)
+    {
+        if (recipeForItem[recipes[r].outputItem] < 0)
+        {
+            recipeForItem[recipes[r].outputItem] = int(r);
+        }
+    }
+
+    // 配方深度：输入全部只能打工获得的配方深度为1，越靠下游越深；循环依赖按1处理
+    std::vector<int> depth(recipes.size(), 0);
+    std::function<int(int)> depthOf = [&](int r) -> int {
+        if (depth[r] != 0)
+        {
+            return depth[r] < 0 ? 1 : depth[r];
+        }
+        depth[r] = -1;
+        int d = 1;
+        for (const auto &input : recipes[r].inputs)
+        {
+            const int upstream = recipeForItem[input.first];
+            if (upstream >= 0 && upstream != r)
+            {
+                d = std::max(d, depthOf(upstream) + 1);
+            }
+        }
+        depth[r] = d;
+        return d;
+    };
+
+    recipeOrder.clear();
+    for (size_t r = 0; r < recipes.size(); ++r)
+    {
+        depthOf(int(r));
+        recipeOrder.push_back(int(r));
+    }
+    std::stable_sort(recipeOrder.begin(), recipeOrder.end(),
+                     [&](int a, int b) { return depth[a] > depth[b]; });
+}
+
+struct WorkSimulator::Accumulator
+{
+    std::vector<uint64_t> itemInflow;
+    std::vector<uint64_t> forgeAttempts;
+    std::vector<uint64_t> forgeSuccesses;
+    std::vector<uint64_t> itemsConsumed;
+    std::vector<uint64_t> hits; // drawCounts 的临时缓冲
+
+    explicit Accumulator(const SimulationData &data)
+        : itemInflow(data.itemCount, 0), forgeAttempts(data.recipes.size(), 0),
+          forgeSuccesses(data.recipes.size(), 0), itemsConsumed(data.itemCount, 0)
+    {
+    }
+};
+
+uint64_t WorkSimulator::sessionSeed(uint64_t masterSeed, uint64_t sessionIndex) noexcept
+{
+    uint64_t state = masterSeed ^ (sessionIndex * 0xd1342543de82ef95ULL);
+    RandomEngine::splitmix64(state);
+    return RandomEngine::splitmix64(state);
+}
+
+// 玩家策略：
+// 1. 能升级就立即升级
+// 2. 把所有待升级所需的材料沿配方向上游展开，缺什么就锻造什么（不动用升级直接需要的库存）
+// 3. 打工选择“补齐所负责物品缺口耗时最长”的类型，一次连续打缺口的1/4，逼近后再重新决策
+SessionResult WorkSimulator::runSession(uint64_t seed, double maxHours, Accumulator &acc) const
+{
+    const SimulationData &data = m_data;
+    const size_t typeCount = data.workTypes.size();
+    RandomEngine rng(seed);
+
+    SessionResult result;
+    result.masterHours.assign(typeCount, -1.0);
+
+    std::vector<int> level(typeCount, 0);
+    std::vector<int64_t> inventory(data.itemCount, 0);
+    std::vector<int64_t> direct(data.itemCount, 0); // 待升级直接需要的数量
+    std::vector<double> need(data.itemCount, 0.0);  // 沿配方展开后的总需求
+
+    double seconds = 0.0;
+    const double maxSeconds = maxHours * 3600.0;
+
+    auto isMaster = [&](size_t t) { return level[t] + 1 >= int(data.workTypes[t].levels.size()); };
+
+    for (size_t t = 0; t < typeCount; ++t)
+    {
+        if (isMaster(t))
+        {
+            result.masterHours[t] = 0.0;
+        }
+    }
+
+    auto affordable = [&](const std::vector<std::pair<int, int>> &materials) {
+        for (const auto &m : materials)
+        {
+            if (inventory[m.first] < m.second)
+            {
+                return false;
+            }
+        }
+        return true;
+    };
+
+    auto consume = [&](const std::vector<std::pair<int, int>> &materials, int64_t times) {
+        for (const auto &m : materials)
+        {
+            inventory[m.first] -= m.second * times;
+            acc.itemsConsumed[m.first] += uint64_t(m.second * times);
+        }
+    };
+
+    auto computeNeed = [&]() {
+        std::fill(direct.begin(), direct.end(), 0);
+        for (size_t t = 0; t < typeCount; ++t)
+        {
+            const int u = isMaster(t) ? -1 : data.upgradeByLevel[t][level[t]];
+            if (u >= 0)
+            {
+                for (const auto &m : data.upgrades[u].materials)
+                {
+                    direct[m.first] += m.second;
+                }
+            }
+        }
+
+        for (int i = 0; i < data.itemCount; ++i)
+        {
+            need[i] = double(direct[i]);
+        }
+        for (int r : data.recipeOrder)
+        {
+            const SimRecipe &recipe = data.recipes[r];
+            const double deficit = need[recipe.outputItem] - double(inventory[recipe.outputItem]);
+            if (deficit <= 0.0 || recipe.successRate <= 0.0)
+            {
+                continue;
+            }
+            const double crafts = std::ceil(deficit / recipe.outputCount / recipe.successRate);
+            for (const auto &input : recipe.inputs)
+            {
+                need[input.first] += crafts * input.second;
+            }
+        }
+    };
+
+    // 升级和锻造，直到没有可做的事
+    auto settle = [&]() {
+        bool changed = true;
+        while (changed)
+        {
+            changed = false;
+
+            for (size_t t = 0; t < typeCount; ++t)
+            {
+                const int u = isMaster(t) ? -1 : data.upgradeByLevel[t][level[t]];
+                if (u >= 0 && affordable(data.upgrades[u].materials))
+                {
+                    consume(data.upgrades[u].materials, 1);
+                    ++level[t];
+                    if (isMaster(t))
+                    {
+                        result.masterHours[t] = seconds / 3600.0;
+                    }
+                    changed = true;
+                }
+            }
+
+            computeNeed();
+
+            for (int r : data.recipeOrder)
+            {
+                const SimRecipe &recipe = data.recipes[r];
+                const double deficit = need[recipe.outputItem] - double(inventory[recipe.outputItem]);
+                if (deficit <= 0.0 || recipe.successRate <= 0.0)
+                {
+                    continue;
+                }
+
+                // 只动用超出升级直接需要的部分
+                int64_t crafts = int64_t(std::ceil(deficit / recipe.outputCount / recipe.successRate));
+                for (const auto &input : recipe.inputs)
+                {
+                    const int64_t spare = inventory[input.first] - direct[input.first];
+                    crafts = std::min(crafts, spare > 0 ? spare / input.second : 0);
+                }
+                if (crafts <= 0)
+                {
+                    continue;
+                }
+
+                consume(recipe.inputs, crafts);
+                int64_t successes = 0;
+                for (int64_t i = 0; i < crafts; ++i)
+                {
+                    if (rng.generateDouble() <= recipe.successRate)
+                    {
+                        ++successes;
+                    }
+                }
+                inventory[recipe.outputItem] += successes * recipe.outputCount;
+                acc.forgeAttempts[r] += uint64_t(crafts);
+                acc.forgeSuccesses[r] += uint64_t(successes);
+                changed = true;
+                break;
+            }
+        }
+    };
+
+    size_t roundRobin = 0;
+    while (true)
+    {
+        settle();
+
+        bool allMaster = true;
+        for (size_t t = 0; t < typeCount; ++t)
+        {
+            allMaster = allMaster && isMaster(t);
+        }
+        if (allMaster)
+        {
+            result.allMasterHours = seconds / 3600.0;
+            break;
+        }
+        if (seconds >= maxSeconds)
+        {
+            break;
+        }
+
+        // 每个缺口物品归给当前产出最快的打工类型，累计补齐所需时间
+        std::vector<double> gatherSeconds(typeCount, 0.0);
+        for (int i = 0; i < data.itemCount; ++i)
+        {
+            const double deficit = need[i] - double(inventory[i]);
+            if (deficit <= 0.0)
+            {
+                continue;
+            }
+            int owner = -1;
+            double bestRate = 0.0;
+            for (size_t t = 0; t < typeCount; ++t)
+            {
+                const double rate = data.workTypes[t].levels[level[t]].itemsPerSecond[i];
+                if (rate > bestRate)
+                {
+                    bestRate = rate;
+                    owner = int(t);
+                }
+            }
+            if (owner >= 0)
+            {
+                gatherSeconds[owner] += deficit / bestRate;
+            }
+        }
+
+        size_t chosen = 0;
+        for (size_t t = 1; t < typeCount; ++t)
+        {
+            if (gatherSeconds[t] > gatherSeconds[chosen])
+            {
+                chosen = t;
+            }
+        }
+        if (gatherSeconds[chosen] <= 0.0)
+        {
+            // 缺的东西打工拿不到（配置问题），轮流打工直到时间上限
+            chosen = roundRobin++ % typeCount;
+        }
+
+        const SimWorkType &type = data.workTypes[chosen];
+        long long cycles = (long long)std::ceil(gatherSeconds[chosen] * 0.25 / type.durationSec);
+        cycles = std::max(1LL, std::min(cycles, MAX_CYCLES_PER_BATCH));
+        cycles = std::min(cycles, std::max(1LL, (long long)std::ceil((maxSeconds - seconds) / type.durationSec)));
+
+        const LootTable &table = type.levels[level[chosen]].table;
+        table.drawCounts(rng, uint64_t(cycles), acc.hits);
+        const std::vector<LootTable::Outcome> &outcomes = table.outcomes();
+        for (size_t o = 0; o < acc.hits.size(); ++o)
+        {
+            const int64_t gained = int64_t(acc.hits[o]) * outcomes[o].count;
+            inventory[outcomes[o].itemId] += gained;
+            acc.itemInflow[outcomes[o].itemId] += uint64_t(gained);
+        }
+        seconds += cycles * type.durationSec;
+    }
+
+    result.simulatedHours = seconds / 3600.0;
+    return result;
+}
+
+SimulationReport WorkSimulator::run(const SimulationParams &params) const
+{
+    const auto start = std::chrono::steady_clock::now();
+
+    SimulationReport report;
+    const long long sessionCount = std::max(0LL, params.sessions);
+    report.sessions.resize(size_t(sessionCount));
+
+    int threadCount = params.threads > 0 ? params.threads : int(std::thread::hardware_concurrency());
+    threadCount = std::max(1, threadCount);
+
+    const Accumulator empty(m_data);
+    std::vector<Accumulator> accumulators(size_t(threadCount), empty);
+    std::atomic<long long> nextSession(0);
+
+    auto worker = [&](int index) {
+        Accumulator &acc = accumulators[size_t(index)];
+        while (true)
+        {
+            const long long begin = nextSession.fetch_add(SESSIONS_PER_CHUNK);
+            if (begin >= sessionCount)
+            {
+                break;
+            }
+            const long long end = std::min(sessionCount, begin + SESSIONS_PER_CHUNK);
+            for (long long i = begin; i < end; ++i)
+            {
+                report.sessions[size_t(i)] = runSession(sessionSeed(params.seed, uint64_t(i)), params.maxHours, acc);
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (int i = 1; i < threadCount; ++i)
+    {
+        threads.emplace_back(worker, i);
+    }
+    worker(0);
+    for (std::thread &t : threads)
+    {
+        t.join();
+    }
+
+    // 整数累加与合并顺序无关；浮点总时长按会话序号求和，保证结果可复现
+    report.itemInflow.assign(m_data.itemCount, 0);
+    report.itemsConsumed.assign(m_data.itemCount, 0);
+    report.forgeAttempts.assign(m_data.recipes.size(), 0);
+    report.forgeSuccesses.assign(m_data.recipes.size(), 0);
+    for (const Accumulator &acc : accumulators)
+    {
+        for (int i = 0; i < m_data.itemCount; ++i)
+        {
+            report.itemInflow[i] += acc.itemInflow[i];
+            report.itemsConsumed[i] += acc.itemsConsumed[i];
+        }
+        for (size_t r = 0; r < m_data.recipes.size(); ++r)
+        {
+            report.forgeAttempts[r] += acc.forgeAttempts[r];
+            report.forgeSuccesses[r] += acc.forgeSuccesses[r];
+        }
+    }
+    for (const SessionResult &session : report.sessions)
+    {
+        report.totalHours += session.simulatedHours;
+    }
+
+    report.wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return report;
+}
@@ -0,0 +1,108 @@
+#ifndef __WORK_SIMULATOR_H__
+#define __WORK_SIMULATOR_H__
+
+#include "model/LootTable.h"
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+// 无界面的打工/锻造经济模拟
+// 模型本身依赖事件中心和QObject，不能跨线程使用；这里只从模型读出一份只读配置，
+// 每个线程拿着这份配置和自己的随机数引擎独立跑会话
+
+// 一种打工类型在某个等级下的配置
+struct SimWorkLevel
+{
+    LootTable table;
+    std::vector<double> itemsPerSecond; // 按物品ID索引的期望产出速度，用于决策
+};
+
+struct SimWorkType
+{
+    std::string name;
+    double durationSec = 10.0;
+    std::vector<SimWorkLevel> levels; // 下标0对应基础级
+};
+
+struct SimRecipe
+{
+    int recipeId = 0;
+    std::vector<std::pair<int, int>> inputs; // (物品ID, 数量)，催化剂同样消耗
+    int outputItem = 0;
+    int outputCount = 1;
+    double successRate = 1.0;
+};
+
+struct SimUpgrade
+{
+    int workType = 0; // SimulationData::workTypes 下标
+    int fromLevel = 0; // 0基
+    std::vector<std::pair<int, int>> materials;
+};
+
+struct SimulationData
+{
+    std::vector<SimWorkType> workTypes;
+    std::vector<SimRecipe> recipes;
+    std::vector<SimUpgrade> upgrades;
+    int itemCount = 0; // 物品ID上界（不含）
+
+    // 以下由 finalize() 生成
+    std::vector<std::vector<int>> upgradeByLevel; // [打工类型][当前等级] -> upgrades 下标，-1 表示没有
+    std::vector<int> recipeForItem;               // 物品ID -> 产出它的配方下标，-1 表示只能打工获得
+    std::vector<int> recipeOrder;                 // 配方按“先下游后上游”排序，用于展开需求
+
+    // 计算期望产出速度和各种索引
+    void finalize();
+};
+
+struct SimulationParams
+{
+    uint64_t seed = 0;
+    long long sessions = 100000;
+    int threads = 0;        // 0 表示使用全部核心
+    double maxHours = 2000; // 单个会话的模拟时长上限
+};
+
+// 单个会话的结果
+struct SessionResult
+{
+    std::vector<double> masterHours; // 每种打工达到大师级的时间，未达到为负
+    double allMasterHours = -1.0;
+    double simulatedHours = 0.0;
+};
+
+// 汇总结果：逐会话结果按会话序号存放，与线程数无关
+struct SimulationReport
+{
+    std::vector<SessionResult> sessions;
+    std::vector<uint64_t> itemInflow; // 打工获得的物品总数，按物品ID索引
+    std::vector<uint64_t> forgeAttempts; // 按配方下标
+    std::vector<uint64_t> forgeSuccesses;
+    std::vector<uint64_t> itemsConsumed; // 锻造和升级消耗的物品总数
+    double totalHours = 0.0;
+    double wallSeconds = 0.0;
+};
+
+class WorkSimulator
+{
+public:
+    explicit WorkSimulator(const SimulationData &data) noexcept
+        : m_data(data)
+    {
+    }
+
+    SimulationReport run(const SimulationParams &params) const;
+
+    // 会话i的随机种子只由主种子和i决定，所以结果不随线程数变化
+    static uint64_t sessionSeed(uint64_t masterSeed, uint64_t sessionIndex) noexcept;
+
+private:
+    struct Accumulator;
+    SessionResult runSession(uint64_t seed, double maxHours, Accumulator &acc) const;
+
+    const SimulationData &m_data;
+};
+
+#endif
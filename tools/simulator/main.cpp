@@ -0,0 +1,355 @@
+// 打工/锻造经济模拟器：无界面，多线程跑大量会话，用于平衡掉落率和升级消耗
+// 用法示例：
+//   work_simulator --sessions 1000000 --seed 42
+//   work_simulator --drop-scale 0.8,1,1.2 --upgrade-cost-scale 0.5,1 --csv sweep.csv
+// 同一组参数和种子的结果与线程数无关，可以直接比较
+#include "WorkSimulator.h"
+#include "model/ForgeModel.h"
+#include "model/WorkModel.h"
+#include "common/RandomService.h"
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QFile>
+#include <QStringList>
+#include <QTextStream>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+namespace
+{
+
+bool g_verbose = false;
+
+// 模型构造时会打印大量调试信息，默认只保留警告以上
+void messageFilter(QtMsgType type, const QMessageLogContext &, const QString &msg)
+{
+    if (type == QtDebugMsg || type == QtInfoMsg)
+    {
+        if (!g_verbose)
+        {
+            return;
+        }
+    }
+    std::fprintf(stderr, "%s\n", qPrintable(msg));
+}
+
+// 一组平衡参数，对模型中的配置做整体缩放
+struct BalanceKnobs
+{
+    double dropScale = 1.0;         // 各等级掉落倍数
+    double qualityScale = 1.0;      // 各等级品质加成
+    double upgradeCostScale = 1.0;  // 工作系统升级材料数量
+    double recipeCostScale = 1.0;   // 锻造材料数量
+    double forgeSuccess = -1.0;     // 覆盖所有配方成功率，负数表示使用配置
+};
+
+QVector<double> parseList(const QString &text, bool *ok)
+{
+    QVector<double> values;
+    *ok = true;
+    for (const QString &part : text.split(',', Qt::SkipEmptyParts))
+    {
+        bool partOk = false;
+        values.append(part.trimmed().toDouble(&partOk));
+        *ok = *ok && partOk;
+    }
+    *ok = *ok && !values.isEmpty();
+    return values;
+}
+
+int scaledCount(int count, double scale)
+{
+    return std::max(1, int(std::lround(count * scale)));
+}
+
+// 从模型读出只读配置；掉落表的编译方式与 WorkModel::rebuildLootTables 一致
+SimulationData buildSimulationData(const WorkModel &workModel, const ForgeModel &forgeModel, const BalanceKnobs &knobs)
+{
+    SimulationData data;
+    QMap<WorkType, int> typeIndex;
+
+    const LootTableRows &rows = workModel.getLootRows();
+    for (const WorkInfo &info : workModel.getWorkTypes())
+    {
+        SimWorkType type;
+        type.name = info.name.toStdString();
+        type.durationSec = std::max(1, info.workDuration);
+
+        const QMap<int, std::vector<LootEntry>> levelRows = rows.value(info.type);
+        for (int lv = static_cast<int>(WorkSystemLevel::Basic); lv <= static_cast<int>(WorkSystemLevel::Master); ++lv)
+        {
+            const WorkSystemLevel level = static_cast<WorkSystemLevel>(lv);
+            const double drop = workModel.getDropRateMultiplier(info.type, level) * knobs.dropScale;
+            const double quality = std::min(1.0, workModel.getQualityBonus(info.type, level) * knobs.qualityScale);
+
+            SimWorkLevel simLevel;
+            if (levelRows.contains(lv))
+            {
+                simLevel.table = LootTable::compile(levelRows[lv], 0.0, drop);
+            }
+            else if (levelRows.contains(0))
+            {
+                simLevel.table = LootTable::compile(levelRows[0], quality, drop);
+            }
+            type.levels.push_back(simLevel);
+        }
+
+        typeIndex[info.type] = int(data.workTypes.size());
+        data.workTypes.push_back(type);
+    }
+
+    for (const ForgeRecipe &recipe : forgeModel.getAllRecipes())
+    {
+        if (recipe.outputs.isEmpty())
+        {
+            continue;
+        }
+        // 多产出配方按第一个产出计算，现有配方都只有一个产出
+        SimRecipe simRecipe;
+        simRecipe.recipeId = recipe.recipeId;
+        simRecipe.outputItem = recipe.outputs[0].itemId;
+        simRecipe.outputCount = recipe.outputs[0].outputCount;
+        simRecipe.successRate = knobs.forgeSuccess >= 0.0 ? knobs.forgeSuccess : recipe.outputs[0].successRate;
+        for (const ForgeMaterial &m : recipe.materials)
+        {
+            simRecipe.inputs.emplace_back(m.itemId, scaledCount(m.requiredCount, knobs.recipeCostScale));
+        }
+        data.recipes.push_back(simRecipe);
+    }
+
+    for (const WorkSystemUpgrade &upgrade : forgeModel.getAllWorkUpgrades())
+    {
+        if (!typeIndex.contains(upgrade.workType))
+        {
+            continue;
+        }
+        SimUpgrade simUpgrade;
+        simUpgrade.workType = typeIndex[upgrade.workType];
+        simUpgrade.fromLevel = static_cast<int>(upgrade.currentLevel) - static_cast<int>(WorkSystemLevel::Basic);
+        for (const ForgeMaterial &m : upgrade.upgradeMaterials)
+        {
+            simUpgrade.materials.emplace_back(m.itemId, scaledCount(m.requiredCount, knobs.upgradeCostScale));
+        }
+        data.upgrades.push_back(simUpgrade);
+    }
+
+    data.finalize();
+    return data;
+}
+
+// 已排序数组的分位数（最近秩）
+double percentile(const std::vector<double> &sorted, double p)
+{
+    if (sorted.empty())
+    {
+        return 0.0;
+    }
+    size_t rank = size_t(std::ceil(p * sorted.size()));
+    rank = std::min(sorted.size(), std::max<size_t>(1, rank));
+    return sorted[rank - 1];
+}
+
+struct Distribution
+{
+    size_t reached = 0;
+    double mean = 0.0;
+    double p10 = 0.0;
+    double p50 = 0.0;
+    double p90 = 0.0;
+    double p99 = 0.0;
+};
+
+Distribution summarize(std::vector<double> values)
+{
+    Distribution d;
+    std::sort(values.begin(), values.end());
+    d.reached = values.size();
+    if (values.empty())
+    {
+        return d;
+    }
+    double sum = 0.0;
+    for (double v : values)
+    {
+        sum += v;
+    }
+    d.mean = sum / values.size();
+    d.p10 = percentile(values, 0.10);
+    d.p50 = percentile(values, 0.50);
+    d.p90 = percentile(values, 0.90);
+    d.p99 = percentile(values, 0.99);
+    return d;
+}
+
+void printDistribution(const char *label, const Distribution &d, size_t total)
+{
+    std::printf("  %-24s reached %6.2f%%  mean %9.2f  p10 %9.2f  p50 %9.2f  p90 %9.2f  p99 %9.2f\n", label,
+                total ? 100.0 * d.reached / total : 0.0, d.mean, d.p10, d.p50, d.p90, d.p99);
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("work_simulator");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("DesktopPet work/forge economy simulator");
+    parser.addHelpOption();
+    QCommandLineOption sessionsOption("sessions", "Number of simulated players.", "n", "100000");
+    QCommandLineOption seedOption("seed", "Master seed (default: random, printed in the report).", "seed");
+    QCommandLineOption threadsOption("threads", "Worker threads (0 = all cores).", "n", "0");
+    QCommandLineOption maxHoursOption("max-hours", "Per-session cap on simulated work hours.", "h", "2000");
+    QCommandLineOption lootOption("loot-csv", "Loot table CSV.", "path",
+                                  QStringLiteral(DESKTOPPET_SOURCE_DIR "/resources/csv/loot_tables.csv"));
+    QCommandLineOption dropOption("drop-scale", "Scale of per-level drop multipliers (comma list).", "list", "1");
+    QCommandLineOption qualityOption("quality-scale", "Scale of per-level quality bonus (comma list).", "list", "1");
+    QCommandLineOption upgradeOption("upgrade-cost-scale", "Scale of upgrade material counts (comma list).", "list", "1");
+    QCommandLineOption recipeOption("recipe-cost-scale", "Scale of recipe material counts (comma list).", "list", "1");
+    QCommandLineOption successOption("forge-success", "Override forge success rate (comma list, <0 keeps config).", "list", "-1");
+    QCommandLineOption csvOption("csv", "Append one summary row per grid point to this CSV file.", "path");
+    QCommandLineOption verboseOption("verbose", "Show model debug output.");
+    parser.addOptions({sessionsOption, seedOption, threadsOption, maxHoursOption, lootOption, dropOption, qualityOption,
+                       upgradeOption, recipeOption, successOption, csvOption, verboseOption});
+    parser.process(app);
+
+    g_verbose = parser.isSet(verboseOption);
+    qInstallMessageHandler(messageFilter);
+
+    SimulationParams params;
+    params.sessions = parser.value(sessionsOption).toLongLong();
+    params.threads = parser.value(threadsOption).toInt();
+    params.maxHours = parser.value(maxHoursOption).toDouble();
+    params.seed = parser.isSet(seedOption) ? parser.value(seedOption).toULongLong(nullptr, 0)
+                                           : RandomService::makeRandomSeed();
+
+    bool ok = true;
+    bool listOk = false;
+    const QVector<double> dropList = parseList(parser.value(dropOption), &listOk);
+    ok = ok && listOk;
+    const QVector<double> qualityList = parseList(parser.value(qualityOption), &listOk);
+    ok = ok && listOk;
+    const QVector<double> upgradeList = parseList(parser.value(upgradeOption), &listOk);
+    ok = ok && listOk;
+    const QVector<double> recipeList = parseList(parser.value(recipeOption), &listOk);
+    ok = ok && listOk;
+    const QVector<double> successList = parseList(parser.value(successOption), &listOk);
+    ok = ok && listOk;
+    if (!ok || params.sessions <= 0)
+    {
+        std::fprintf(stderr, "invalid arguments\n");
+        return 1;
+    }
+
+    // 模型只在主线程上读取一次配置
+    WorkModel workModel;
+    workModel.loadLootTablesFromCSV(parser.value(lootOption));
+    ForgeModel forgeModel;
+
+    QFile csvFile;
+    QTextStream csv;
+    if (parser.isSet(csvOption))
+    {
+        csvFile.setFileName(parser.value(csvOption));
+        const bool writeHeader = !csvFile.exists() || csvFile.size() == 0;
+        if (!csvFile.open(QIODevice::Append | QIODevice::Text))
+        {
+            std::fprintf(stderr, "failed to open %s\n", qPrintable(csvFile.fileName()));
+            return 1;
+        }
+        csv.setDevice(&csvFile);
+        if (writeHeader)
+        {
+            csv << "seed,sessions,maxHours,dropScale,qualityScale,upgradeCostScale,recipeCostScale,forgeSuccess,"
+                   "allMasterReached,allMasterP10,allMasterP50,allMasterP90,allMasterP99,itemsPerHour\n";
+        }
+    }
+
+    std::printf("seed 0x%016llx  sessions %lld  max %.0f h\n", (unsigned long long)params.seed, params.sessions,
+                params.maxHours);
+
+    for (double drop : dropList)
+    for (double quality : qualityList)
+    for (double upgrade : upgradeList)
+    for (double recipe : recipeList)
+    for (double success : successList)
+    {
+        BalanceKnobs knobs;
+        knobs.dropScale = drop;
+        knobs.qualityScale = quality;
+        knobs.upgradeCostScale = upgrade;
+        knobs.recipeCostScale = recipe;
+        knobs.forgeSuccess = success;
+
+        const SimulationData data = buildSimulationData(workModel, forgeModel, knobs);
+        const SimulationReport report = WorkSimulator(data).run(params);
+        const size_t total = report.sessions.size();
+
+        std::printf("\n== drop x%.2f  quality x%.2f  upgrade cost x%.2f  recipe cost x%.2f  forge success %s\n", drop,
+                    quality, upgrade, recipe, success >= 0.0 ? qPrintable(QString::number(success)) : "config");
+        std::printf("  %.2f s wall, %.0f sessions/s, %.3g simulated hours\n", report.wallSeconds,
+                    total / std::max(report.wallSeconds, 1e-9), report.totalHours);
+
+        std::printf("time to Master (hours of work):\n");
+        for (size_t t = 0; t < data.workTypes.size(); ++t)
+        {
+            std::vector<double> hours;
+            for (const SessionResult &s : report.sessions)
+            {
+                if (s.masterHours[t] >= 0.0)
+                {
+                    hours.push_back(s.masterHours[t]);
+                }
+            }
+            printDistribution(data.workTypes[t].name.c_str(), summarize(hours), total);
+        }
+        std::vector<double> allHours;
+        for (const SessionResult &s : report.sessions)
+        {
+            if (s.allMasterHours >= 0.0)
+            {
+                allHours.push_back(s.allMasterHours);
+            }
+        }
+        const Distribution all = summarize(allHours);
+        printDistribution("all", all, total);
+
+        std::printf("item inflow per hour of work:\n");
+        uint64_t inflowTotal = 0;
+        for (int i = 0; i < data.itemCount; ++i)
+        {
+            inflowTotal += report.itemInflow[i];
+            if (report.itemInflow[i] > 0 || report.itemsConsumed[i] > 0)
+            {
+                std::printf("  item %3d  gained %10.3f/h  consumed %10.3f/h\n", i,
+                            report.itemInflow[i] / std::max(report.totalHours, 1e-9),
+                            report.itemsConsumed[i] / std::max(report.totalHours, 1e-9));
+            }
+        }
+        const double itemsPerHour = inflowTotal / std::max(report.totalHours, 1e-9);
+
+        std::printf("forge:\n");
+        for (size_t r = 0; r < data.recipes.size(); ++r)
+        {
+            if (report.forgeAttempts[r] == 0)
+            {
+                continue;
+            }
+            std::printf("  recipe %3d  attempts/session %10.2f  success %6.2f%%\n", data.recipes[r].recipeId,
+                        double(report.forgeAttempts[r]) / total,
+                        100.0 * report.forgeSuccesses[r] / report.forgeAttempts[r]);
+        }
+
+        if (csvFile.isOpen())
+        {
+            csv << params.seed << ',' << params.sessions << ',' << params.maxHours << ',' << drop << ',' << quality << ','
+                << upgrade << ',' << recipe << ',' << success << ',' << double(all.reached) / total << ',' << all.p10
+                << ',' << all.p50 << ',' << all.p90 << ',' << all.p99 << ',' << itemsPerHour << '\n';
+            csv.flush();
+        }
+    }
+
+    return 0;
+}